@@ -7,6 +7,7 @@
 #include "SafeFile.h"
 #include "gps/RTC.h"
 #include "memory/MemAudit.h"
+#include <algorithm>
 #include <cstring> // memcpy
 
 #ifndef MESSAGE_TEXT_POOL_SIZE
@@ -87,35 +88,149 @@ static inline void assignTimestamp(StoredMessage &sm)
     }
 }
 
-// Generic push with cap (used by live + persisted queues)
-template <typename T> static inline void pushWithLimit(std::deque<T> &queue, const T &msg)
+MessageStore::MessageStore(const std::string &label)
 {
-    if (queue.size() >= MAX_MESSAGES_SAVED)
-        queue.pop_front();
-    queue.push_back(msg);
+    filename = "/Messages_" + label + ".msgs";
+    resetMessagePool(); // initialize text pool on boot
+    resetSlots();
 }
 
-template <typename T> static inline void pushWithLimit(std::deque<T> &queue, T &&msg)
+// Empty the arena: every slot on the free list, no threads
+void MessageStore::resetSlots()
 {
-    if (queue.size() >= MAX_MESSAGES_SAVED)
-        queue.pop_front();
-    queue.emplace_back(std::move(msg));
+    for (Slot s = 0; s < MAX_MESSAGES_SAVED; s++) {
+        slots[s] = Entry();
+        slots[s].next = (s + 1 < MAX_MESSAGES_SAVED) ? s + 1 : NO_SLOT;
+    }
+    for (auto &t : threads)
+        t = Thread();
+    freeList = 0;
+    head = tail = NO_SLOT;
+    count = 0;
+}
+
+// Take a free slot, recycling the oldest message when the arena is full
+MessageStore::Slot MessageStore::allocSlot()
+{
+    if (freeList == NO_SLOT)
+        unlink(head);
+    Slot s = freeList;
+    freeList = slots[s].next;
+    return s;
+}
+
+// Remove a message from both its lists and free its slot
+void MessageStore::unlink(Slot s)
+{
+    Entry &e = slots[s];
+    if (e.prev != NO_SLOT)
+        slots[e.prev].next = e.next;
+    else
+        head = e.next;
+    if (e.next != NO_SLOT)
+        slots[e.next].prev = e.prev;
+    else
+        tail = e.prev;
+
+    Thread &t = threads[e.thread];
+    if (e.threadPrev != NO_SLOT)
+        slots[e.threadPrev].threadNext = e.threadNext;
+    else
+        t.head = e.threadNext;
+    if (e.threadNext != NO_SLOT)
+        slots[e.threadNext].threadPrev = e.threadPrev;
+    else
+        t.tail = e.threadPrev;
+    if (--t.count == 0)
+        t = Thread();
+    count--;
+
+    // Already on flash: the next save logs its removal
+    if (e.seq <= savedSeq) {
+        if (numDeleted < MAX_MESSAGES_SAVED)
+            deletedSeqs[numDeleted++] = e.seq;
+        else
+            needsRewrite = true;
+    }
+
+    e = Entry();
+    e.next = freeList;
+    freeList = s;
 }
 
-MessageStore::MessageStore(const std::string &label)
+int MessageStore::findThread(bool direct, uint32_t key) const
 {
-    filename = "/Messages_" + label + ".msgs";
-    resetMessagePool(); // initialize text pool on boot
+    for (int i = 0; i < MAX_MESSAGES_SAVED; i++) {
+        if (threads[i].count && threads[i].direct == direct && threads[i].key == key)
+            return i;
+    }
+    return -1;
+}
+
+MessageStore::View MessageStore::threadView(int thread) const
+{
+    if (thread < 0)
+        return View(this, NO_SLOT, NO_SLOT, 0, true);
+    const Thread &t = threads[thread];
+    return View(this, t.head, t.tail, t.count, true);
+}
+
+// The other party of a DM
+uint32_t MessageStore::peerOf(const StoredMessage &msg) const
+{
+    return (msg.sender == nodeDB->getNodeNum()) ? msg.dest : msg.sender;
+}
+
+const StoredMessage *MessageStore::insert(const StoredMessage &msg, uint32_t seq)
+{
+    const Slot s = allocSlot();
+    Entry &e = slots[s];
+    e.msg = msg;
+    e.seq = seq;
+
+    e.prev = tail;
+    e.next = NO_SLOT;
+    if (tail != NO_SLOT)
+        slots[tail].next = s;
+    else
+        head = s;
+    tail = s;
+    count++;
+
+    const bool direct = msg.type == MessageType::DM_TO_US;
+    const uint32_t key = direct ? peerOf(msg) : msg.channelIndex;
+    int thread = findThread(direct, key);
+    if (thread < 0) {
+        // There are never more threads than messages, so one is free
+        for (thread = 0; threads[thread].count; thread++)
+            ;
+        threads[thread].key = key;
+        threads[thread].direct = direct;
+    }
+    Thread &t = threads[thread];
+    e.thread = thread;
+    e.threadPrev = t.tail;
+    e.threadNext = NO_SLOT;
+    if (t.tail != NO_SLOT)
+        slots[t.tail].threadNext = s;
+    else
+        t.head = s;
+    t.tail = s;
+    t.count++;
+
+    if (seq >= nextSeq)
+        nextSeq = seq + 1;
+    return &e.msg;
 }
 
 // Live message handling (RAM only)
 void MessageStore::addLiveMessage(StoredMessage &&msg)
 {
-    pushWithLimit(liveMessages, std::move(msg));
+    insert(msg, nextSeq);
 }
 void MessageStore::addLiveMessage(const StoredMessage &msg)
 {
-    pushWithLimit(liveMessages, msg);
+    insert(msg, nextSeq);
 }
 
 #if ENABLE_MESSAGE_PERSISTENCE
@@ -234,18 +349,91 @@ const StoredMessage *MessageStore::tryAddFromPacket(const meshtastic_MeshPacket
     sm.xeddsaSigned = packet.xeddsa_signed;
 #endif
 
-    addLiveMessage(sm);
+    const StoredMessage *stored = insert(sm, nextSeq);
 
 #if ENABLE_MESSAGE_PERSISTENCE
     markMessageStoreUnsaved();
 #endif
 
-    return &liveMessages.back();
+    return stored;
+}
+
+void MessageStore::setAckStatus(const StoredMessage &msg, AckStatus status)
+{
+    for (Entry &e : slots) {
+        if (&e.msg != &msg)
+            continue;
+        if (e.seq && e.msg.ackStatus != status) {
+            e.msg.ackStatus = status;
+            e.dirty = true;
+#if ENABLE_MESSAGE_PERSISTENCE
+            markMessageStoreUnsaved();
+#endif
+        }
+        return;
+    }
 }
 
 #if ENABLE_MESSAGE_PERSISTENCE
 
-// Compact, fixed-size on-flash representation using offset + length
+// Appending in place needs more than the truncate-on-write nRF54L15 shim offers; without it
+// every save is a full rewrite, as before.
+#if (defined(ARCH_ESP32) || defined(ARCH_NRF52) || defined(ARCH_RP2040) || defined(ARCH_PORTDUINO)) &&                          \
+    !defined(ARCH_NRF54L15)
+#define MESSAGE_LOG_CAN_APPEND 1
+// Adafruit LittleFS (nRF52) opens FILE_O_WRITE positioned at the end of an existing file;
+// the other backends take stdio modes.
+#if defined(ARCH_NRF52)
+#define MESSAGE_LOG_O_APPEND FILE_O_WRITE
+#else
+#define MESSAGE_LOG_O_APPEND "a"
+#endif
+#else
+#define MESSAGE_LOG_CAN_APPEND 0
+#endif
+
+#define MESSAGE_LOG_MAGIC 0x3147534Du // "MSG1"
+
+// Message file layout: this header, then ops. A snapshot is one OP_ADD per live message, oldest
+// first; saves append OP_DELETEs, then OP_UPDATEs and OP_ADDs for what changed since.
+struct MessageLogHeader {
+    uint32_t magic;    // MESSAGE_LOG_MAGIC
+    uint32_t reserved; // 0
+};
+
+enum MessageLogOpCode : uint8_t { OP_ADD = 1, OP_UPDATE = 2, OP_DELETE = 3 };
+
+struct __attribute__((packed)) MessageLogOp {
+    uint8_t op;   // MessageLogOpCode
+    uint32_t seq; // message the op applies to
+};
+
+// OP_ADD body, followed by textLength bytes of text
+struct __attribute__((packed)) MessageLogAdd {
+    uint32_t timestamp;
+    uint32_t sender;
+    uint32_t dest;
+    uint8_t channelIndex;
+    uint8_t isBootRelative;
+    uint8_t ackStatus;    // static_cast<uint8_t>(AckStatus)
+    uint8_t type;         // static_cast<uint8_t>(MessageType)
+    uint8_t xeddsaSigned; // 1 if packet carried a verified XEdDSA signature
+    uint8_t textLength;
+};
+static_assert(MAX_MESSAGE_SIZE <= 256, "textLength is stored in one byte");
+
+// OP_UPDATE body: the fields that change after a message is stored
+struct __attribute__((packed)) MessageLogUpdate {
+    uint32_t timestamp;
+    uint8_t isBootRelative;
+    uint8_t ackStatus;
+};
+
+// Past this the log is rewritten as a snapshot: twice a full history of maximum-length messages
+static constexpr uint32_t kMessageLogBudget =
+    sizeof(MessageLogHeader) + 2 * MAX_MESSAGES_SAVED * (sizeof(MessageLogOp) + sizeof(MessageLogAdd) + MAX_MESSAGE_SIZE);
+
+// Pre-log file format: a count byte, then this fixed-size record per message
 struct __attribute__((packed)) StoredMessageRecord {
     uint32_t timestamp;
     uint32_t sender;
@@ -259,29 +447,7 @@ struct __attribute__((packed)) StoredMessageRecord {
     char text[MAX_MESSAGE_SIZE]; // store actual text here
 };
 
-// Serialize one StoredMessage to flash
-static inline void writeMessageRecord(SafeFile &f, const StoredMessage &m)
-{
-    StoredMessageRecord rec = {};
-    rec.timestamp = m.timestamp;
-    rec.sender = m.sender;
-    rec.channelIndex = m.channelIndex;
-    rec.dest = m.dest;
-    rec.isBootRelative = m.isBootRelative;
-    rec.ackStatus = static_cast<uint8_t>(m.ackStatus);
-    rec.type = static_cast<uint8_t>(m.type);
-    rec.xeddsaSigned = m.xeddsaSigned ? 1 : 0;
-    rec.textLength = m.textLength;
-
-    // Copy the actual text into the record from RAM pool
-    const char *txt = getTextFromPool(m.textOffset);
-    strncpy(rec.text, txt, MAX_MESSAGE_SIZE - 1);
-    rec.text[MAX_MESSAGE_SIZE - 1] = '\0';
-
-    f.write(reinterpret_cast<const uint8_t *>(&rec), sizeof(rec));
-}
-
-// Deserialize one StoredMessage from flash; returns false on short read
+// Deserialize one StoredMessage from a pre-log file; returns false on short read
 static inline bool readMessageRecord(File &f, StoredMessage &m)
 {
     StoredMessageRecord rec = {};
@@ -296,16 +462,62 @@ static inline bool readMessageRecord(File &f, StoredMessage &m)
     m.ackStatus = static_cast<AckStatus>(rec.ackStatus);
     m.type = static_cast<MessageType>(rec.type);
     m.xeddsaSigned = rec.xeddsaSigned != 0;
-    m.textLength = rec.textLength;
 
-    // 💡 Re-store text into pool and update offset
+    // Re-store text into pool and update offset
     m.textLength = strnlen(rec.text, MAX_MESSAGE_SIZE - 1);
     m.textOffset = storeTextInPool(rec.text, m.textLength);
 
     return true;
 }
 
-void MessageStore::saveToFlash()
+static size_t addOpBytes(const StoredMessage &m)
+{
+    return sizeof(MessageLogOp) + sizeof(MessageLogAdd) + std::min<size_t>(m.textLength, MAX_MESSAGE_SIZE - 1);
+}
+
+// Serialize one op to flash. @return bytes written
+template <typename F> static size_t writeAddOp(F &f, uint32_t seq, const StoredMessage &m)
+{
+    uint8_t buf[sizeof(MessageLogOp) + sizeof(MessageLogAdd) + MAX_MESSAGE_SIZE];
+    MessageLogOp op = {OP_ADD, seq};
+    MessageLogAdd rec = {};
+    rec.timestamp = m.timestamp;
+    rec.sender = m.sender;
+    rec.dest = m.dest;
+    rec.channelIndex = m.channelIndex;
+    rec.isBootRelative = m.isBootRelative;
+    rec.ackStatus = static_cast<uint8_t>(m.ackStatus);
+    rec.type = static_cast<uint8_t>(m.type);
+    rec.xeddsaSigned = m.xeddsaSigned ? 1 : 0;
+    // Copy the actual text into the record from RAM pool
+    const char *txt = getTextFromPool(m.textOffset);
+    rec.textLength = strnlen(txt, std::min<size_t>(m.textLength, MAX_MESSAGE_SIZE - 1));
+
+    memcpy(buf, &op, sizeof(op));
+    memcpy(buf + sizeof(op), &rec, sizeof(rec));
+    memcpy(buf + sizeof(op) + sizeof(rec), txt, rec.textLength);
+    const size_t len = sizeof(op) + sizeof(rec) + rec.textLength;
+    return f.write(buf, len) == len ? len : 0;
+}
+
+template <typename F> static size_t writeUpdateOp(F &f, uint32_t seq, const StoredMessage &m)
+{
+    uint8_t buf[sizeof(MessageLogOp) + sizeof(MessageLogUpdate)];
+    MessageLogOp op = {OP_UPDATE, seq};
+    MessageLogUpdate rec = {m.timestamp, static_cast<uint8_t>(m.isBootRelative), static_cast<uint8_t>(m.ackStatus)};
+    memcpy(buf, &op, sizeof(op));
+    memcpy(buf + sizeof(op), &rec, sizeof(rec));
+    return f.write(buf, sizeof(buf)) == sizeof(buf) ? sizeof(buf) : 0;
+}
+
+template <typename F> static size_t writeDeleteOp(F &f, uint32_t seq)
+{
+    MessageLogOp op = {OP_DELETE, seq};
+    return f.write(reinterpret_cast<const uint8_t *>(&op), sizeof(op)) == sizeof(op) ? sizeof(op) : 0;
+}
+
+// Full rewrite: header plus one OP_ADD per live message. Also the compaction of the log.
+bool MessageStore::writeSnapshot()
 {
 #ifdef FSCom
     // Ensure root exists
@@ -315,19 +527,102 @@ void MessageStore::saveToFlash()
 
     SafeFile f(filename.c_str(), false);
 
+    size_t written = 0;
+    bool ok = true;
     spiLock->lock();
-    uint8_t count = static_cast<uint8_t>(liveMessages.size());
-    if (count > MAX_MESSAGES_SAVED)
-        count = MAX_MESSAGES_SAVED;
-    f.write(&count, 1);
-
-    for (uint8_t i = 0; i < count; ++i) {
-        writeMessageRecord(f, liveMessages[i]);
+    const MessageLogHeader header = {MESSAGE_LOG_MAGIC, 0};
+    ok = f.write(reinterpret_cast<const uint8_t *>(&header), sizeof(header)) == sizeof(header);
+    written = sizeof(header);
+    for (Slot s = head; ok && s != NO_SLOT; s = slots[s].next) {
+        const size_t n = writeAddOp(f, slots[s].seq, slots[s].msg);
+        ok = n != 0;
+        written += n;
     }
     spiLock->unlock();
 
-    f.close();
+    ok = f.close() && ok;
+    bytesWritten += written;
+    if (!ok) {
+        LOG_WARN("MessageStore: write of %s failed", filename.c_str());
+        needsRewrite = true;
+        return false;
+    }
+    fileBytes = written;
+#endif
+    for (Slot s = head; s != NO_SLOT; s = slots[s].next)
+        slots[s].dirty = false;
+    savedSeq = nextSeq - 1;
+    numDeleted = 0;
+    needsRewrite = false;
+    return true;
+}
+
+// Incremental save: log what changed since the last save, or rewrite when the log is due for it
+bool MessageStore::appendChanges()
+{
+    size_t delta = numDeleted * sizeof(MessageLogOp);
+    bool changed = numDeleted != 0;
+    for (Slot s = head; s != NO_SLOT; s = slots[s].next) {
+        if (slots[s].seq > savedSeq) {
+            delta += addOpBytes(slots[s].msg);
+            changed = true;
+        } else if (slots[s].dirty) {
+            delta += sizeof(MessageLogOp) + sizeof(MessageLogUpdate);
+            changed = true;
+        }
+    }
+    if (!changed && !needsRewrite)
+        return true;
+    if (!MESSAGE_LOG_CAN_APPEND || needsRewrite || fileBytes + delta > kMessageLogBudget)
+        return writeSnapshot();
+
+#if defined(FSCom) && MESSAGE_LOG_CAN_APPEND
+    size_t written = 0;
+    bool ok = false;
+    {
+        concurrency::LockGuard guard(spiLock);
+        auto f = FSCom.open(filename.c_str(), MESSAGE_LOG_O_APPEND);
+        if (f) {
+            ok = true;
+            // Deletions first: replaying them before the adds never overfills the arena
+            for (uint16_t i = 0; ok && i < numDeleted; i++) {
+                const size_t n = writeDeleteOp(f, deletedSeqs[i]);
+                ok = n != 0;
+                written += n;
+            }
+            for (Slot s = head; ok && s != NO_SLOT; s = slots[s].next) {
+                const Entry &e = slots[s];
+                size_t n = 1;
+                if (e.seq > savedSeq)
+                    n = writeAddOp(f, e.seq, e.msg);
+                else if (e.dirty)
+                    n = writeUpdateOp(f, e.seq, e.msg);
+                else
+                    continue;
+                ok = n != 0;
+                written += n;
+            }
+            f.close();
+        }
+    }
+    bytesWritten += written;
+    if (!ok) {
+        // Don't leave a partial op for the next append to land behind
+        LOG_WARN("MessageStore: append to %s failed, rewriting", filename.c_str());
+        return writeSnapshot();
+    }
+    fileBytes += written;
+    for (Slot s = head; s != NO_SLOT; s = slots[s].next)
+        slots[s].dirty = false;
+    savedSeq = nextSeq - 1;
+    numDeleted = 0;
 #endif
+    return true;
+}
+
+void MessageStore::saveToFlash()
+{
+    appendChanges();
 
     // Reset autosave state after any save
     g_messageStoreHasUnsavedChanges = false;
@@ -336,10 +631,16 @@ void MessageStore::saveToFlash()
 
 void MessageStore::loadFromFlash()
 {
-    std::deque<StoredMessage>().swap(liveMessages);
+    resetSlots();
     resetMessagePool(); // reset pool when loading
+    // Nothing loaded is on flash until the load says so, so the replay's deletes aren't logged again
+    savedSeq = 0;
+    numDeleted = 0;
+    needsRewrite = true;
+    fileBytes = 0;
 
 #ifdef FSCom
+    bool torn = false;
     {
         concurrency::LockGuard guard(spiLock);
 
@@ -350,20 +651,97 @@ void MessageStore::loadFromFlash()
         if (!f)
             return;
 
-        uint8_t count = 0;
-        f.readBytes(reinterpret_cast<char *>(&count), 1);
-        if (count > MAX_MESSAGES_SAVED)
-            count = MAX_MESSAGES_SAVED;
-
-        for (uint8_t i = 0; i < count; ++i) {
-            StoredMessage m;
-            if (!readMessageRecord(f, m))
-                break;
-            liveMessages.push_back(m);
+        MessageLogHeader header = {};
+        if (f.readBytes(reinterpret_cast<char *>(&header), sizeof(header)) == sizeof(header) &&
+            header.magic == MESSAGE_LOG_MAGIC) {
+            uint32_t pos = sizeof(header);
+            for (;;) {
+                MessageLogOp op;
+                const size_t got = f.readBytes(reinterpret_cast<char *>(&op), sizeof(op));
+                if (got == 0)
+                    break; // clean end
+                if (got != sizeof(op)) {
+                    torn = true;
+                    break;
+                }
+                if (op.op == OP_ADD) {
+                    MessageLogAdd rec;
+                    char text[MAX_MESSAGE_SIZE];
+                    if (f.readBytes(reinterpret_cast<char *>(&rec), sizeof(rec)) != sizeof(rec) ||
+                        rec.textLength >= MAX_MESSAGE_SIZE ||
+                        f.readBytes(text, rec.textLength) != rec.textLength) {
+                        torn = true;
+                        break;
+                    }
+                    StoredMessage m;
+                    m.timestamp = rec.timestamp;
+                    m.sender = rec.sender;
+                    m.dest = rec.dest;
+                    m.channelIndex = rec.channelIndex;
+                    m.isBootRelative = rec.isBootRelative;
+                    m.ackStatus = static_cast<AckStatus>(rec.ackStatus);
+                    m.type = static_cast<MessageType>(rec.type);
+                    m.xeddsaSigned = rec.xeddsaSigned != 0;
+                    m.textLength = rec.textLength;
+                    m.textOffset = storeTextInPool(text, rec.textLength);
+                    insert(m, op.seq);
+                    pos += sizeof(op) + sizeof(rec) + rec.textLength;
+                } else if (op.op == OP_UPDATE) {
+                    MessageLogUpdate rec;
+                    if (f.readBytes(reinterpret_cast<char *>(&rec), sizeof(rec)) != sizeof(rec)) {
+                        torn = true;
+                        break;
+                    }
+                    for (Slot s = head; s != NO_SLOT; s = slots[s].next) {
+                        if (slots[s].seq == op.seq) {
+                            slots[s].msg.timestamp = rec.timestamp;
+                            slots[s].msg.isBootRelative = rec.isBootRelative;
+                            slots[s].msg.ackStatus = static_cast<AckStatus>(rec.ackStatus);
+                            break;
+                        }
+                    }
+                    pos += sizeof(op) + sizeof(rec);
+                } else if (op.op == OP_DELETE) {
+                    for (Slot s = head; s != NO_SLOT; s = slots[s].next) {
+                        if (slots[s].seq == op.seq) {
+                            unlink(s);
+                            break;
+                        }
+                    }
+                    pos += sizeof(op);
+                } else {
+                    torn = true;
+                    break;
+                }
+            }
+            fileBytes = pos;
+            needsRewrite = torn;
+        } else {
+            // Pre-log format: rewritten as a log by the next save
+            f.seek(0);
+            uint8_t n = 0;
+            f.readBytes(reinterpret_cast<char *>(&n), 1);
+            if (n > MAX_MESSAGES_SAVED)
+                n = MAX_MESSAGES_SAVED;
+
+            for (uint8_t i = 0; i < n; ++i) {
+                StoredMessage m;
+                if (!readMessageRecord(f, m))
+                    break;
+                insert(m, nextSeq);
+            }
         }
 
         f.close();
     }
+    if (torn)
+        LOG_WARN("MessageStore: %s ends in a torn record, kept %u messages", filename.c_str(), (unsigned)count);
+
+    // Everything loaded is on flash now
+    savedSeq = nextSeq - 1;
+    numDeleted = 0;
+    for (Slot s = head; s != NO_SLOT; s = slots[s].next)
+        slots[s].dirty = false;
 
     if (pruneHiddenMessages())
         saveToFlash();
@@ -382,64 +760,52 @@ void MessageStore::loadFromFlash() {}
 // Clear all messages (RAM + persisted queue)
 void MessageStore::clearAllMessages()
 {
-    std::deque<StoredMessage>().swap(liveMessages);
+    resetSlots();
     resetMessagePool();
-
-#ifdef FSCom
-    SafeFile f(filename.c_str(), false);
-    uint8_t count = 0;
-
-    // SafeFile already does its own spiLock in its constructor and close().
-    // Avoid nesting spiLocks, as this will hang until watchdog reset!
-    {
-        concurrency::LockGuard guard(spiLock);
-        f.write(&count, 1); // write "0 messages"
-    }
-
-    f.close();
-#endif
+    numDeleted = 0;
 
 #if ENABLE_MESSAGE_PERSISTENCE
+    writeSnapshot(); // header only: "0 messages"
     g_messageStoreHasUnsavedChanges = false;
     g_lastAutoSaveMs = millis();
 #endif
 }
 
 // Internal helpers for targeted erasure.
-template <typename Predicate> static bool eraseFirstMatch(std::deque<StoredMessage> &deque, Predicate pred)
+template <typename Predicate> bool MessageStore::eraseFirstMatch(const View &view, Predicate pred)
 {
-    for (auto it = deque.begin(); it != deque.end(); ++it) {
+    for (auto it = view.begin(); it != view.end(); ++it) {
         if (pred(*it)) {
-            deque.erase(it);
+            unlink(it.slot);
             return true;
         }
     }
     return false;
 }
 
-template <typename Predicate> static void eraseAllMatches(std::deque<StoredMessage> &deque, Predicate pred)
+template <typename Predicate> void MessageStore::eraseAllMatches(const View &view, Predicate pred)
 {
-    for (auto it = deque.begin(); it != deque.end();) {
-        if (pred(*it)) {
-            it = deque.erase(it);
-        } else {
-            ++it;
-        }
+    for (auto it = view.begin(); it != view.end();) {
+        const Slot s = it.slot;
+        const bool erase = pred(*it);
+        ++it; // step off before the slot is freed
+        if (erase)
+            unlink(s);
     }
 }
 
 bool MessageStore::pruneHiddenMessages()
 {
-    const size_t before = liveMessages.size();
-    eraseAllMatches(liveMessages, [&](const StoredMessage &m) { return !isMessageVisible(m); });
-    return liveMessages.size() != before;
+    const size_t before = count;
+    eraseAllMatches(getMessages(), [&](const StoredMessage &m) { return !isMessageVisible(m); });
+    return count != before;
 }
 
 // Delete oldest message (RAM + persisted queue)
 void MessageStore::deleteOldestMessage()
 {
-    if (!liveMessages.empty()) {
-        liveMessages.pop_front();
+    if (head != NO_SLOT) {
+        unlink(head);
     }
     saveToFlash();
 }
@@ -447,83 +813,60 @@ void MessageStore::deleteOldestMessage()
 // Delete oldest message in a specific channel
 void MessageStore::deleteOldestMessageInChannel(uint8_t channel)
 {
-    auto pred = [channel](const StoredMessage &m) { return m.type == MessageType::BROADCAST && m.channelIndex == channel; };
-    eraseFirstMatch(liveMessages, pred);
+    eraseFirstMatch(getChannelMessages(channel), [](const StoredMessage &) { return true; });
     saveToFlash();
 }
 
 void MessageStore::deleteAllMessagesInChannel(uint8_t channel)
 {
-    auto pred = [channel](const StoredMessage &m) { return m.type == MessageType::BROADCAST && m.channelIndex == channel; };
-    eraseAllMatches(liveMessages, pred);
+    eraseAllMatches(getChannelMessages(channel), [](const StoredMessage &) { return true; });
     saveToFlash();
 }
 
 void MessageStore::deleteAllMessagesWithPeer(uint32_t peer)
 {
-    uint32_t local = nodeDB->getNodeNum();
-    auto pred = [&](const StoredMessage &m) {
-        if (m.type != MessageType::DM_TO_US)
-            return false;
-        uint32_t other = (m.sender == local) ? m.dest : m.sender;
-        return other == peer;
-    };
-    eraseAllMatches(liveMessages, pred);
+    eraseAllMatches(getDirectMessages(peer), [](const StoredMessage &) { return true; });
     saveToFlash();
 }
 
 void MessageStore::deleteAllMessagesFromNode(uint32_t nodeNum)
 {
-    const uint32_t local = nodeDB->getNodeNum();
-    auto pred = [&](const StoredMessage &m) {
-        if (m.sender == nodeNum)
-            return true;
-        if (m.type != MessageType::DM_TO_US)
-            return false;
-        return m.sender == local ? m.dest == nodeNum : m.sender == nodeNum;
-    };
-    eraseAllMatches(liveMessages, pred);
+    // Their DM thread, plus anything they sent to a channel
+    eraseAllMatches(getDirectMessages(nodeNum), [](const StoredMessage &) { return true; });
+    eraseAllMatches(getMessages(), [&](const StoredMessage &m) { return m.sender == nodeNum; });
     saveToFlash();
 }
 
 // Delete oldest message in a direct chat with a node
 void MessageStore::deleteOldestMessageWithPeer(uint32_t peer)
 {
-    auto pred = [peer](const StoredMessage &m) {
-        if (m.type != MessageType::DM_TO_US)
-            return false;
-        uint32_t other = (m.sender == nodeDB->getNodeNum()) ? m.dest : m.sender;
-        return other == peer;
-    };
-    eraseFirstMatch(liveMessages, pred);
+    eraseFirstMatch(getDirectMessages(peer), [](const StoredMessage &) { return true; });
     saveToFlash();
 }
 
-std::deque<StoredMessage> MessageStore::getChannelMessages(uint8_t channel) const
+MessageStore::View MessageStore::getChannelMessages(uint8_t channel) const
 {
-    std::deque<StoredMessage> result;
-    for (const auto &m : liveMessages) {
-        if (isMessageVisible(m) && m.type == MessageType::BROADCAST && m.channelIndex == channel) {
-            result.push_back(m);
-        }
-    }
-    return result;
+    return threadView(findThread(false, channel));
 }
 
-std::deque<StoredMessage> MessageStore::getDirectMessages() const
+MessageStore::View MessageStore::getDirectMessages(uint32_t peer) const
 {
-    std::deque<StoredMessage> result;
-    for (const auto &m : liveMessages) {
-        if (isMessageVisible(m) && m.type == MessageType::DM_TO_US) {
-            result.push_back(m);
-        }
+    return threadView(findThread(true, peer));
+}
+
+std::vector<uint32_t> MessageStore::getDirectPeers() const
+{
+    std::vector<uint32_t> peers;
+    for (int i = 0; i < MAX_MESSAGES_SAVED; i++) {
+        if (threads[i].count && threads[i].direct && hasVisibleMessages(threadView(i)))
+            peers.push_back(threads[i].key);
     }
-    return result;
+    return peers;
 }
 
-bool MessageStore::hasVisibleMessages() const
+bool MessageStore::hasVisibleMessages(const View &view) const
 {
-    for (const auto &m : liveMessages) {
+    for (const auto &m : view) {
         if (isMessageVisible(m))
             return true;
     }
@@ -541,16 +884,15 @@ void MessageStore::upgradeBootRelativeTimestamps()
 
     uint32_t bootNow = millis() / 1000;
 
-    auto fix = [&](std::deque<StoredMessage> &dq) {
-        for (auto &m : dq) {
-            if (m.isBootRelative && m.timestamp <= bootNow) {
-                uint32_t bootOffset = nowSecs - bootNow;
-                m.timestamp += bootOffset;
-                m.isBootRelative = false;
-            }
+    for (Slot s = head; s != NO_SLOT; s = slots[s].next) {
+        StoredMessage &m = slots[s].msg;
+        if (m.isBootRelative && m.timestamp <= bootNow) {
+            uint32_t bootOffset = nowSecs - bootNow;
+            m.timestamp += bootOffset;
+            m.isBootRelative = false;
+            slots[s].dirty = true;
         }
-    };
-    fix(liveMessages);
+    }
 }
 
 const char *MessageStore::getText(const StoredMessage &msg)
@@ -14,9 +14,11 @@
 #endif
 
 #include "mesh/generated/meshtastic/mesh.pb.h"
+#include <cstddef>
 #include <cstdint>
-#include <deque>
+#include <iterator>
 #include <string>
+#include <vector>
 
 // How many messages are stored (RAM + flash).
 // Define -DMESSAGE_HISTORY_LIMIT=N in build_flags to control memory usage.
@@ -84,20 +86,116 @@ struct StoredMessage {
     }
 };
 
+/**
+ * Message history for the screen UIs.
+ *
+ * Messages live in a fixed arena of MAX_MESSAGES_SAVED slots, threaded onto intrusive lists: one
+ * in arrival order, and one per conversation (broadcasts per channel, DMs per peer). The UI reads
+ * them through View, a pair of list ends walked in place, so drawing a thread costs O(messages in
+ * it) with no copies. Storing past the limit recycles the oldest slot; deletes unlink in O(1).
+ *
+ * Views and StoredMessage pointers stay valid until the message they refer to is deleted or
+ * recycled - i.e. until the next add or delete - like the deque iterators they replace.
+ *
+ * saveToFlash() appends only what changed since the last save (new messages, ACK/timestamp
+ * updates, deletions) to the message file; once that log outgrows twice a full history it is
+ * rewritten as a snapshot of the live messages.
+ */
 class MessageStore
 {
   public:
+    typedef uint16_t Slot;
+    static constexpr Slot NO_SLOT = 0xFFFF;
+
+    /// Bidirectional iterator over one of the store's lists, oldest to newest
+    class iterator
+    {
+      public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef StoredMessage value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const StoredMessage *pointer;
+        typedef const StoredMessage &reference;
+
+        iterator() = default;
+        reference operator*() const { return store->slots[slot].msg; }
+        pointer operator->() const { return &store->slots[slot].msg; }
+        iterator &operator++()
+        {
+            slot = thread ? store->slots[slot].threadNext : store->slots[slot].next;
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+        iterator &operator--()
+        {
+            slot = slot == NO_SLOT ? last : thread ? store->slots[slot].threadPrev : store->slots[slot].prev;
+            return *this;
+        }
+        iterator operator--(int)
+        {
+            iterator old = *this;
+            --*this;
+            return old;
+        }
+        bool operator==(const iterator &o) const { return slot == o.slot; }
+        bool operator!=(const iterator &o) const { return slot != o.slot; }
+
+      private:
+        friend class MessageStore;
+        iterator(const MessageStore *store, Slot slot, Slot last, bool thread)
+            : store(store), slot(slot), last(last), thread(thread)
+        {
+        }
+        const MessageStore *store = nullptr;
+        Slot slot = NO_SLOT;
+        Slot last = NO_SLOT; // where --end() lands
+        bool thread = false; // walk the conversation links rather than arrival order
+    };
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+
+    /// A list of messages in the store, oldest first. Includes hidden ones; see isMessageVisible().
+    class View
+    {
+      public:
+        iterator begin() const { return iterator(store, head, tail, thread); }
+        iterator end() const { return iterator(store, NO_SLOT, tail, thread); }
+        reverse_iterator rbegin() const { return reverse_iterator(end()); }
+        reverse_iterator rend() const { return reverse_iterator(begin()); }
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        const StoredMessage &front() const { return *begin(); }
+        const StoredMessage &back() const { return *--end(); }
+
+      private:
+        friend class MessageStore;
+        View(const MessageStore *store, Slot head, Slot tail, size_t count, bool thread)
+            : store(store), head(head), tail(tail), count(count), thread(thread)
+        {
+        }
+        const MessageStore *store;
+        Slot head, tail;
+        size_t count;
+        bool thread;
+    };
+
     explicit MessageStore(const std::string &label);
 
     // Live RAM methods (always current, used by UI and runtime)
     void addLiveMessage(StoredMessage &&msg);
     void addLiveMessage(const StoredMessage &msg); // convenience overload
-    const std::deque<StoredMessage> &getLiveMessages() const { return liveMessages; }
+    View getLiveMessages() const { return getMessages(); }
     // Add new messages from packets. Returns nullptr if the packet is filtered out.
     const StoredMessage *tryAddFromPacket(const meshtastic_MeshPacket &mp); // Incoming/outgoing -> RAM only
+    // Record the delivery result for a message in the store (saved with the next save)
+    void setAckStatus(const StoredMessage &msg, AckStatus status);
 
-    // Persistence methods (used only on boot/shutdown)
-    void saveToFlash();   // Save messages to flash
+    // Persistence methods
+    void saveToFlash();   // Append changes since the last save to flash (or rewrite it when due)
     void loadFromFlash(); // Load messages from flash
 
     // Clear all messages (RAM + persisted queue + text pool)
@@ -110,13 +208,15 @@ class MessageStore
     void deleteAllMessagesInChannel(uint8_t channel);
     void deleteAllMessagesWithPeer(uint32_t peer);
     void deleteAllMessagesFromNode(uint32_t nodeNum);
-    // Unified accessor (for UI code, defaults to RAM buffer)
-    const std::deque<StoredMessage> &getMessages() const { return liveMessages; }
-    bool hasVisibleMessages() const;
+    // Unified accessor (for UI code): every message in arrival order
+    View getMessages() const { return View(this, head, tail, count, false); }
+    bool hasVisibleMessages() const { return hasVisibleMessages(getMessages()); }
+    bool hasVisibleMessages(const View &view) const;
 
-    // Helper filters for future use
-    std::deque<StoredMessage> getChannelMessages(uint8_t channel) const; // Only broadcast messages on a channel
-    std::deque<StoredMessage> getDirectMessages() const;                 // Only direct messages
+    // Conversation views
+    View getChannelMessages(uint8_t channel) const; // Broadcast messages on a channel
+    View getDirectMessages(uint32_t peer) const;    // Direct messages to or from a peer
+    std::vector<uint32_t> getDirectPeers() const;   // Peers with a visible direct message, unordered
     bool shouldStorePacket(const meshtastic_MeshPacket &mp) const;
     bool isMessageVisible(const StoredMessage &msg) const;
 
@@ -129,10 +229,55 @@ class MessageStore
     // Allocate text into pool (used by sender-side code)
     static uint16_t storeText(const char *src, size_t len);
 
+    // Bytes the persisted history grew by since boot (appends + rewrites), for tests and stats
+    uint32_t getBytesWritten() const { return bytesWritten; }
+
   private:
+    struct Entry {
+        StoredMessage msg;
+        uint32_t seq = 0;          // persistence id, one higher per message stored; 0 while free
+        Slot prev = NO_SLOT;       // arrival order; the free list chains through next
+        Slot next = NO_SLOT;
+        Slot threadPrev = NO_SLOT; // within its conversation
+        Slot threadNext = NO_SLOT;
+        Slot thread = 0;           // index into threads[]
+        bool dirty = false;        // ACK/timestamp changed since the last save
+    };
+    // One conversation: a channel's broadcasts or the DMs with one peer. At most one per message.
+    struct Thread {
+        uint32_t key = 0; // channel index or peer NodeNum
+        bool direct = false;
+        Slot head = NO_SLOT, tail = NO_SLOT;
+        uint16_t count = 0; // 0 = unused
+    };
+
+    Entry slots[MAX_MESSAGES_SAVED];
+    Thread threads[MAX_MESSAGES_SAVED];
+    Slot head = NO_SLOT, tail = NO_SLOT, freeList = NO_SLOT;
+    uint16_t count = 0;
+    uint32_t nextSeq = 1;
+
+    // Persistence state: what the file on flash already holds
+    uint32_t savedSeq = 0;                    // messages up to this seq are in the file
+    uint32_t deletedSeqs[MAX_MESSAGES_SAVED]; // saved messages deleted since
+    uint16_t numDeleted = 0;
+    bool needsRewrite = true; // file missing, legacy or torn, or too many deletions to log
+    uint32_t fileBytes = 0;   // current size of the file
+    uint32_t bytesWritten = 0;
+    std::string filename; // Flash filename for persistence
+
+    void resetSlots();
+    Slot allocSlot();
+    void unlink(Slot s);
+    int findThread(bool direct, uint32_t key) const;
+    View threadView(int thread) const;
+    uint32_t peerOf(const StoredMessage &msg) const;
+    const StoredMessage *insert(const StoredMessage &msg, uint32_t seq);
+    template <typename Predicate> bool eraseFirstMatch(const View &view, Predicate pred);
+    template <typename Predicate> void eraseAllMatches(const View &view, Predicate pred);
     bool pruneHiddenMessages();
-    std::deque<StoredMessage> liveMessages; // Single in-RAM message buffer (also used for persistence)
-    std::string filename;                   // Flash filename for persistence
+    bool writeSnapshot();
+    bool appendChanges();
 };
 
 #if ENABLE_MESSAGE_PERSISTENCE
@@ -64,6 +64,10 @@ SerialConsole::SerialConsole() : StreamAPI(&Port), RedirectablePrint(&Port), con
     assert(!console);
     console = this;
     canWrite = false; // We don't send packets to our port until it has talked to us first
+#if STREAM_TX_BATCH_FRAMES > 1
+    // Config download is dozens of small frames; pack them so USB CDC / the tty sees a few large writes.
+    enableTxBatching();
+#endif
 
 #ifdef RP2040_SLOW_CLOCK
     Port.setTX(SERIAL2_TX);
@@ -220,19 +224,17 @@ bool SerialConsole::canEncodeLogRecord()
 #endif
 }
 
-/// Frame USB CDC output and retain any unwritten tail.
-bool SerialConsole::writeFrame(uint8_t *buf, size_t len, bool bestEffort)
+/// Write framed USB CDC output (one frame or a batch) and retain any unwritten tail.
+bool SerialConsole::writeFramedBytes(uint8_t *buf, size_t totalLen, bool bestEffort)
 {
 #ifdef IS_USB_SERIAL
-    if (len == 0 || !canWrite)
+    if (totalLen == 0 || !canWrite)
         return false;
 
-    const size_t totalLen = buildFrameHeader(buf, len);
-
     concurrency::LockGuard guard(&streamLock);
     return frameWriter.writeFrame(Port, buf, totalLen, bestEffort);
 #else
-    return StreamAPI::writeFrame(buf, len, bestEffort);
+    return StreamAPI::writeFramedBytes(buf, totalLen, bestEffort);
 #endif
 }
 
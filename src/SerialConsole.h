@@ -53,8 +53,8 @@ class SerialConsole : public StreamAPI, public RedirectablePrint, private concur
     virtual bool finishPendingFrame() override;
     /// Return whether the dedicated log buffer can be safely overwritten.
     virtual bool canEncodeLogRecord() override;
-    /// Write or retain one framed USB CDC message.
-    virtual bool writeFrame(uint8_t *buf, size_t len, bool bestEffort) override;
+    /// Write or retain framed USB CDC output (one message or a batch).
+    virtual bool writeFramedBytes(uint8_t *buf, size_t totalLen, bool bestEffort) override;
 
   private:
     /// On USB CDC targets, keep console TX non-blocking unless a host is draining the
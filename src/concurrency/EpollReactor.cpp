@@ -0,0 +1,169 @@
+#include "concurrency/EpollReactor.h"
+
+#if HAS_EPOLL_REACTOR
+
+#include "concurrency/OSThread.h"
+#include "configuration.h"
+
+#include <climits>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace concurrency
+{
+
+EpollReactor mainReactor;
+
+// Events handled per epoll_wait(); more ready fds than this are picked up on the next pass
+static constexpr int MAX_EVENTS = 16;
+
+static void wakeThread(void *ctx, uint32_t)
+{
+    static_cast<OSThread *>(ctx)->setIntervalFromNow(0);
+}
+
+EpollReactor::~EpollReactor()
+{
+    int fd = wakeFd.exchange(-1);
+    if (fd >= 0)
+        ::close(fd);
+    if (epollFd >= 0)
+        ::close(epollFd);
+}
+
+bool EpollReactor::begin()
+{
+    if (epollFd >= 0)
+        return true;
+
+    int ep = epoll_create1(EPOLL_CLOEXEC);
+    if (ep < 0)
+        return false;
+    int ev = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (ev < 0) {
+        ::close(ep);
+        return false;
+    }
+
+    struct epoll_event e = {};
+    e.events = EPOLLIN;
+    e.data.fd = ev;
+    if (epoll_ctl(ep, EPOLL_CTL_ADD, ev, &e) != 0) {
+        ::close(ev);
+        ::close(ep);
+        return false;
+    }
+
+    epollFd = ep;
+    wakeFd.store(ev);
+    return true;
+}
+
+EpollReactor::Watch *EpollReactor::find(int fd)
+{
+    for (auto &w : watches)
+        if (w.fd == fd)
+            return &w;
+    return nullptr;
+}
+
+bool EpollReactor::watch(int fd, Callback cb, void *ctx, uint32_t events)
+{
+    if (fd < 0 || !cb || !begin())
+        return false;
+
+    struct epoll_event e = {};
+    e.events = (events ? events : EPOLLIN) | EPOLLET;
+    e.data.fd = fd;
+
+    Watch *w = find(fd);
+    // An fd that was closed without unwatch() left the epoll set on its own; its number may now be a new file
+    int op = w ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (epoll_ctl(epollFd, op, fd, &e) != 0) {
+        if (op == EPOLL_CTL_MOD && errno == ENOENT)
+            op = EPOLL_CTL_ADD;
+        else if (op == EPOLL_CTL_ADD && errno == EEXIST)
+            op = EPOLL_CTL_MOD;
+        else {
+            LOG_WARN("epoll: can't watch fd %d (errno %d)", fd, errno);
+            return false;
+        }
+        if (epoll_ctl(epollFd, op, fd, &e) != 0) {
+            LOG_WARN("epoll: can't watch fd %d (errno %d)", fd, errno);
+            return false;
+        }
+    }
+
+    if (w) {
+        w->cb = cb;
+        w->ctx = ctx;
+    } else {
+        watches.push_back({fd, cb, ctx});
+    }
+    return true;
+}
+
+bool EpollReactor::watchForThread(int fd, OSThread *thread)
+{
+    return watch(fd, wakeThread, thread, EPOLLIN | EPOLLRDHUP);
+}
+
+void EpollReactor::unwatch(int fd, const void *ctx)
+{
+    for (auto it = watches.begin(); it != watches.end(); ++it) {
+        if (it->fd == fd && it->ctx == ctx) {
+            // Fails harmlessly with EBADF/ENOENT if the owner already closed the fd
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+            watches.erase(it);
+            return;
+        }
+    }
+}
+
+bool EpollReactor::wait(uint32_t msec)
+{
+    if (!begin())
+        return false;
+
+    struct epoll_event events[MAX_EVENTS];
+    int timeout = msec > (uint32_t)INT_MAX ? INT_MAX : (int)msec;
+    int n = epoll_wait(epollFd, events, MAX_EVENTS, timeout);
+    if (n < 0)
+        return errno == EINTR; // a signal is as good as an interrupt; the scheduler re-checks its threads
+
+    const int ev = wakeFd.load();
+    for (int i = 0; i < n; i++) {
+        int fd = events[i].data.fd;
+        if (fd == ev) {
+            uint64_t count;
+            while (::read(ev, &count, sizeof(count)) > 0) {
+            }
+            interruptWakeups++;
+            continue;
+        }
+        // A callback may unwatch (or watch) fds, so look each one up again rather than holding pointers into watches
+        Watch *w = find(fd);
+        if (w) {
+            fdWakeups++;
+            w->cb(w->ctx, events[i].events);
+        }
+    }
+    return n > 0;
+}
+
+void EpollReactor::wake()
+{
+    int fd = wakeFd.load();
+    if (fd >= 0) {
+        uint64_t one = 1;
+        // Only fails with EAGAIN when the counter is saturated, which means a wakeup is already pending
+        ssize_t r = ::write(fd, &one, sizeof(one));
+        (void)r;
+    }
+}
+
+} // namespace concurrency
+
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Linux meshtasticd only: the main loop sleeps in epoll_wait() instead of on a condition variable, so a ready socket,
+// tty or GPIO line event fd wakes the scheduler directly. Windows, macOS and wasm builds keep the semaphore sleep.
+#if defined(ARCH_PORTDUINO) && defined(__linux__) && !defined(ARCH_PORTDUINO_WASM) && !defined(MESHTASTIC_EXCLUDE_EPOLL)
+#define HAS_EPOLL_REACTOR 1
+#else
+#define HAS_EPOLL_REACTOR 0
+#endif
+
+#if HAS_EPOLL_REACTOR
+
+#include <atomic>
+#include <vector>
+
+namespace concurrency
+{
+
+class OSThread;
+
+/**
+ * Waits for file descriptors and InterruptableDelay wakeups in one epoll_wait().
+ *
+ * mainDelay sleeps here on Linux: interrupt() (a queue push, a radio ISR from the gpiod thread) bumps an eventfd, and a
+ * registered fd becoming ready runs its callback on the main thread and ends the wait early, so the next
+ * runOrDelay() pass sees whatever the callback woke.
+ *
+ * Registrations are edge triggered: they are a hint that there is something new to read, not a replacement for the
+ * owner's own read loop. An owner that leaves data unread is not woken again until more arrives, so a stalled reader
+ * can't turn the main loop into a busy spin.
+ *
+ * watch()/unwatch() and wait() run on the main thread only; wake() may be called from any thread.
+ */
+class EpollReactor
+{
+  public:
+    /// Runs on the main thread with the epoll event mask (EPOLLIN, EPOLLHUP, ...) that fired
+    typedef void (*Callback)(void *ctx, uint32_t events);
+
+    EpollReactor() {}
+    ~EpollReactor();
+
+    EpollReactor(const EpollReactor &) = delete;
+    EpollReactor &operator=(const EpollReactor &) = delete;
+
+    /// Create the epoll and wake fds if needed. Returns false if the kernel refused, callers then fall back to polling.
+    bool begin();
+
+    /**
+     * Call `cb(ctx, events)` whenever `fd` becomes ready for `events` (EPOLLIN by default). Re-watching an fd replaces
+     * its callback. `ctx` also identifies the owner for unwatch().
+     */
+    bool watch(int fd, Callback cb, void *ctx, uint32_t events = 0);
+
+    /// Wake `thread` (run it on the next scheduler pass) whenever `fd` has new input or hangs up
+    bool watchForThread(int fd, OSThread *thread);
+
+    /// Stop watching `fd`, but only if `ctx` still owns it (the fd number may have been reused since)
+    void unwatch(int fd, const void *ctx);
+
+    /**
+     * Sleep up to `msec` or until an fd is ready or wake() is called, then dispatch the ready fds.
+     * @return true if something woke us before the timeout
+     */
+    bool wait(uint32_t msec);
+
+    /// End the current (or next) wait() early. Thread and signal safe.
+    void wake();
+
+    size_t numWatched() const { return watches.size(); }
+
+    /// Wakeups caused by a watched fd / by wake(), for the loop timing report
+    uint32_t getFdWakeups() const { return fdWakeups; }
+    uint32_t getInterruptWakeups() const { return interruptWakeups; }
+
+  private:
+    struct Watch {
+        int fd;
+        Callback cb;
+        void *ctx;
+    };
+
+    int epollFd = -1;
+    std::atomic<int> wakeFd{-1}; // read by wake() on other threads
+    std::vector<Watch> watches;
+    uint32_t fdWakeups = 0;
+    uint32_t interruptWakeups = 0;
+
+    Watch *find(int fd);
+};
+
+extern EpollReactor mainReactor;
+
+} // namespace concurrency
+
+#endif
@@ -1,4 +1,5 @@
 #include "concurrency/InterruptableDelay.h"
+#include "concurrency/EpollReactor.h"
 #include "configuration.h"
 
 namespace concurrency
@@ -15,6 +16,12 @@ bool InterruptableDelay::delay(uint32_t msec)
 {
     // LOG_DEBUG("delay %u ", msec);
 
+#if HAS_EPOLL_REACTOR
+    // Sleep in epoll so watched sockets/ttys/GPIO lines wake us too; interrupt() pokes the reactor's eventfd
+    if (mainReactor.begin())
+        return !mainReactor.wait(msec);
+#endif
+
     // sem take will return false if we timed out (i.e. were not interrupted)
     bool r = semaphore.take(msec);
 
@@ -24,11 +31,17 @@ bool InterruptableDelay::delay(uint32_t msec)
 
 void InterruptableDelay::interrupt()
 {
+#if HAS_EPOLL_REACTOR
+    mainReactor.wake();
+#endif
     semaphore.give();
 }
 
 IRAM_ATTR void InterruptableDelay::interruptFromISR(BaseType_t *pxHigherPriorityTaskWoken)
 {
+#if HAS_EPOLL_REACTOR
+    mainReactor.wake();
+#endif
     semaphore.giveFromISR(pxHigherPriorityTaskWoken);
 }
 
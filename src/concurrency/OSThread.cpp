@@ -17,16 +17,16 @@ bool OSThread::showWaiting = false;
 
 const OSThread *OSThread::currentThread;
 
-ThreadController mainController, timerController;
+Scheduler mainController, timerController;
 InterruptableDelay mainDelay;
 
 void OSThread::setup()
 {
-    mainController.ThreadName = "mainController";
-    timerController.ThreadName = "timerController";
+    mainController.name = "mainController";
+    timerController.name = "timerController";
 }
 
-OSThread::OSThread(const char *_name, uint32_t period, ThreadController *_controller)
+OSThread::OSThread(const char *_name, uint32_t period, Scheduler *_controller)
     : Thread(NULL, period), controller(_controller)
 {
     assertIsSetup();
@@ -55,6 +55,23 @@ void OSThread::setIntervalFromNow(unsigned long _interval)
 
     // Cache the next run based on the last_run
     _cached_next_run = millis() + interval;
+
+    markRescheduled();
+}
+
+IRAM_ATTR void OSThread::setInterval(unsigned long _interval)
+{
+    Thread::setInterval(_interval);
+    markRescheduled();
+}
+
+IRAM_ATTR void OSThread::markRescheduled()
+{
+    // The scheduler re-sorts the running thread itself once run() returns
+    if (controller && currentThread != this) {
+        rescheduled = true;
+        controller->markRescheduled();
+    }
 }
 
 bool OSThread::shouldRun(unsigned long time)
@@ -82,7 +99,16 @@ void OSThread::run()
     auto heap = memGet.getFreeHeap();
 #endif
     currentThread = this;
+    // How far past its scheduled time we got to this thread (before runned() moves the schedule on)
+    int32_t late = (int32_t)(millis() - _cached_next_run);
+    uint32_t start = micros();
     auto newDelay = runOnce();
+    uint32_t spent = micros() - start;
+    runCount++;
+    runTimeUs += spent;
+#if MESHTASTIC_THREAD_PROFILE
+    threadprof::record(profSlot, ThreadName.c_str(), spent, late > 0 ? (uint32_t)late : 0);
+#endif
 #ifdef DEBUG_HEAP
     auto newHeap = memGet.getFreeHeap();
     if (newHeap < heap)
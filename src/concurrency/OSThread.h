@@ -4,13 +4,14 @@
 #include <stdint.h>
 
 #include "Thread.h"
-#include "ThreadController.h"
 #include "concurrency/InterruptableDelay.h"
+#include "concurrency/Scheduler.h"
+#include "concurrency/ThreadProfiler.h"
 
 namespace concurrency
 {
 
-extern ThreadController mainController, timerController;
+extern Scheduler mainController, timerController;
 extern InterruptableDelay mainDelay;
 
 #define RUN_SAME -1
@@ -30,7 +31,25 @@ extern InterruptableDelay mainDelay;
  */
 class OSThread : public Thread
 {
-    ThreadController *controller;
+    friend class Scheduler;
+
+    Scheduler *controller;
+
+    // Scheduler bookkeeping, only touched by the Scheduler (except `rescheduled`, see setInterval())
+    enum SchedState : uint8_t { SCHED_NONE, SCHED_HEAP, SCHED_PARKED, SCHED_DUE };
+    int64_t deadline = 0; // next run, in the scheduler's 64-bit millis
+    int16_t heapPos = -1;
+    SchedState where = SCHED_NONE;
+    volatile bool rescheduled = false;
+
+    uint32_t runCount = 0;
+    uint64_t runTimeUs = 0;
+#if MESHTASTIC_THREAD_PROFILE
+    int8_t profSlot = -1; // ThreadProfiler row
+#endif
+
+    unsigned long nextRunMillis() const { return _cached_next_run; }
+    void markRescheduled();
 
     /// Show debugging info for disabled threads
     static bool showDisabled;
@@ -45,7 +64,7 @@ class OSThread : public Thread
     /// For debug printing only (might be null)
     static const OSThread *currentThread;
 
-    OSThread(const char *name, uint32_t period = 0, ThreadController *controller = &mainController);
+    OSThread(const char *name, uint32_t period = 0, Scheduler *controller = &mainController);
 
     virtual ~OSThread();
 
@@ -60,6 +79,16 @@ class OSThread : public Thread
      */
     void setIntervalFromNow(unsigned long _interval);
 
+    /**
+     * Wait a specified number msecs starting from the last time we were run. Hides Thread::setInterval() so the
+     * scheduler hears about the new run time; safe to call from an ISR.
+     */
+    void setInterval(unsigned long _interval);
+
+    /// How many times runOnce() has been called, and the total time spent in it
+    uint32_t getRunCount() const { return runCount; }
+    uint64_t getRunTimeUs() const { return runTimeUs; }
+
   protected:
     /**
      * The method that will be called each time our thread gets a chance to run
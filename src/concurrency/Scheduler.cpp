@@ -0,0 +1,227 @@
+#include "concurrency/Scheduler.h"
+#include "concurrency/OSThread.h"
+#include "configuration.h"
+
+namespace concurrency
+{
+
+bool Scheduler::add(OSThread *t)
+{
+    for (int i = 0; i < MAX_THREADS; i++) {
+        if (threads[i] == t)
+            return true;
+    }
+    for (int i = 0; i < MAX_THREADS; i++) {
+        if (!threads[i]) {
+            threads[i] = t;
+            numThreads++;
+            updateClock();
+            setDeadline(t);
+            push(t);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Scheduler::remove(OSThread *t)
+{
+    for (int i = 0; i < MAX_THREADS; i++) {
+        if (threads[i] == t) {
+            threads[i] = nullptr;
+            numThreads--;
+            break;
+        }
+    }
+
+    switch (t->where) {
+    case OSThread::SCHED_HEAP:
+        removeAt(t->heapPos);
+        break;
+    case OSThread::SCHED_PARKED:
+        for (int i = 0; i < numParked; i++) {
+            if (parked[i] == t) {
+                parked[i] = parked[--numParked];
+                break;
+            }
+        }
+        break;
+    case OSThread::SCHED_DUE:
+        for (int i = 0; i < numDue; i++) {
+            if (due[i] == t)
+                due[i] = nullptr;
+        }
+        break;
+    default:
+        break;
+    }
+    t->where = OSThread::SCHED_NONE;
+    if (running == t)
+        running = nullptr;
+}
+
+void Scheduler::updateClock()
+{
+    uint32_t now = millis();
+    nowMs += (uint32_t)(now - lastMillis);
+    lastMillis = now;
+}
+
+/// Convert the thread's 32-bit next-run time (what Thread::shouldRun() compares against) into a 64-bit deadline
+void Scheduler::setDeadline(OSThread *t)
+{
+    int32_t remaining = (int32_t)(t->nextRunMillis() - lastMillis);
+    t->deadline = nowMs + remaining;
+}
+
+void Scheduler::place(int pos, OSThread *t)
+{
+    heap[pos] = t;
+    t->heapPos = pos;
+}
+
+void Scheduler::siftUp(int pos)
+{
+    OSThread *t = heap[pos];
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (heap[parent]->deadline <= t->deadline)
+            break;
+        place(pos, heap[parent]);
+        pos = parent;
+    }
+    place(pos, t);
+}
+
+void Scheduler::siftDown(int pos)
+{
+    OSThread *t = heap[pos];
+    for (;;) {
+        int child = 2 * pos + 1;
+        if (child >= heapSize)
+            break;
+        if (child + 1 < heapSize && heap[child + 1]->deadline < heap[child]->deadline)
+            child++;
+        if (t->deadline <= heap[child]->deadline)
+            break;
+        place(pos, heap[child]);
+        pos = child;
+    }
+    place(pos, t);
+}
+
+void Scheduler::push(OSThread *t)
+{
+    t->where = OSThread::SCHED_HEAP;
+    place(heapSize++, t);
+    siftUp(heapSize - 1);
+}
+
+void Scheduler::removeAt(int pos)
+{
+    OSThread *last = heap[--heapSize];
+    heap[heapSize] = nullptr;
+    if (pos < heapSize) {
+        place(pos, last);
+        siftDown(pos);
+        siftUp(last->heapPos);
+    }
+}
+
+void Scheduler::park(OSThread *t)
+{
+    t->where = OSThread::SCHED_PARKED;
+    parked[numParked++] = t;
+}
+
+void Scheduler::applyReschedules()
+{
+    // Clear the pass-wide flag before the per-thread ones: a setInterval() landing mid-scan sets it again
+    rescheduled = false;
+    for (int i = 0; i < MAX_THREADS; i++) {
+        OSThread *t = threads[i];
+        if (!t || !t->rescheduled)
+            continue;
+        t->rescheduled = false;
+        if (t->where == OSThread::SCHED_HEAP) {
+            setDeadline(t);
+            siftUp(t->heapPos);
+            siftDown(t->heapPos);
+        }
+        // Parked threads are re-keyed when they leave the parking list; due ones after they run
+    }
+}
+
+long Scheduler::runOrDelay()
+{
+    updateClock();
+    if (rescheduled)
+        applyReschedules();
+
+    // Threads someone re-enabled by writing `enabled` directly; their deadline has already passed
+    for (int i = 0; i < numParked;) {
+        OSThread *t = parked[i];
+        if (t->enabled) {
+            parked[i] = parked[--numParked];
+            setDeadline(t);
+            push(t);
+        } else {
+            i++;
+        }
+    }
+
+    // Take everything that is due off the heap first, so a thread asking to run again right away waits for the next pass
+    numDue = 0;
+    while (heapSize > 0 && heap[0]->deadline <= nowMs) {
+        OSThread *t = heap[0];
+        removeAt(0);
+        t->where = OSThread::SCHED_DUE;
+        due[numDue++] = t;
+    }
+
+    for (int i = 0; i < numDue; i++) {
+        OSThread *t = due[i];
+        if (!t)
+            continue; // removed by a thread that ran before it
+        due[i] = nullptr;
+
+        if (!t->shouldRun(lastMillis)) {
+            if (t->enabled) {
+                // Not actually due (e.g. rescheduled later by an earlier thread this pass)
+                setDeadline(t);
+                push(t);
+            } else {
+                park(t);
+            }
+            continue;
+        }
+
+        running = t;
+        uint64_t before = t->runTimeUs;
+        t->run(); // counts and times itself
+        totalRuns++;
+        if (running) {
+            totalRunTimeUs += t->runTimeUs - before;
+            t->where = OSThread::SCHED_NONE;
+            setDeadline(t);
+            push(t);
+        }
+        running = nullptr;
+        updateClock();
+    }
+    numDue = 0;
+
+    // Anything rescheduled while we ran (a queue push waking a reader) may now be due
+    if (rescheduled)
+        applyReschedules();
+    updateClock();
+
+    if (heapSize == 0)
+        return INT32_MAX;
+    int64_t remaining = heap[0]->deadline - nowMs;
+    if (remaining <= 0)
+        return 0;
+    return remaining > INT32_MAX ? INT32_MAX : (long)remaining;
+}
+
+} // namespace concurrency
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef MAX_THREADS
+#define MAX_THREADS 40
+#endif
+
+namespace concurrency
+{
+
+class OSThread;
+
+/**
+ * @brief Runs OSThreads in deadline order
+ *
+ * Replaces the ArduinoThread ThreadController scan, which asked every registered thread shouldRun() and then walked
+ * them all again for the next delay on each loop pass. Here threads sit in a binary min-heap keyed by their next run
+ * time, so a pass only touches the threads that are due and the delay is read off the top of the heap.
+ *
+ * setInterval()/setIntervalFromNow() may be called from ISRs and other tasks, so they don't touch the heap: they flag
+ * the thread and the next runOrDelay() re-sorts flagged threads before picking what is due. Code that flips `enabled`
+ * directly is handled too: a due thread found disabled is parked and re-checked each pass until it is enabled again.
+ *
+ * Each thread is run at most once per pass, like ThreadController, and every run is counted and timed on the thread
+ * (OSThread::getRunCount()/getRunTimeUs()).
+ *
+ * All methods except markRescheduled() run on the main loop only. Storage is fixed (MAX_THREADS), no allocation.
+ */
+class Scheduler
+{
+  public:
+    const char *name = nullptr;
+
+    Scheduler() {}
+
+    Scheduler(const Scheduler &) = delete;
+    Scheduler &operator=(const Scheduler &) = delete;
+
+    /// @return false if all MAX_THREADS slots are taken
+    bool add(OSThread *thread);
+
+    /// Forget a thread. Safe to call for a thread that is running or due to run later in the current pass.
+    void remove(OSThread *thread);
+
+    /**
+     * Run every thread whose time has come (each at most once) and return how many msec we may sleep before the next
+     * one is due.
+     */
+    long runOrDelay();
+
+    /// Registered thread in slot `index` (slots keep registration order and may have holes), or nullptr
+    OSThread *get(int index) const { return (index >= 0 && index < MAX_THREADS) ? threads[index] : nullptr; }
+
+    /// Number of registered threads; `cached` is accepted for ThreadController compatibility
+    int size(bool cached = true) const { return numThreads; }
+
+    /// Total OSThread runs and time spent in them since boot
+    uint32_t getTotalRuns() const { return totalRuns; }
+    uint64_t getTotalRunTimeUs() const { return totalRunTimeUs; }
+
+    /// Called by OSThread when its next run time changed. ISR safe.
+    void markRescheduled() { rescheduled = true; }
+
+  private:
+    OSThread *threads[MAX_THREADS] = {};
+    OSThread *heap[MAX_THREADS] = {};   // min-heap on OSThread::deadline
+    OSThread *parked[MAX_THREADS] = {}; // due but disabled
+    OSThread *due[MAX_THREADS] = {};    // popped for the pass in progress
+    int numThreads = 0;
+    int heapSize = 0;
+    int numParked = 0;
+    int numDue = 0;
+    OSThread *running = nullptr; // cleared by remove() if the running thread deletes itself
+
+    volatile bool rescheduled = false;
+
+    int64_t nowMs = 0; // millis() extended to 64 bits so deadlines never wrap
+    uint32_t lastMillis = 0;
+
+    uint32_t totalRuns = 0;
+    uint64_t totalRunTimeUs = 0;
+
+    void updateClock();
+    void setDeadline(OSThread *t);
+    void push(OSThread *t);
+    void removeAt(int pos);
+    void siftUp(int pos);
+    void siftDown(int pos);
+    void place(int pos, OSThread *t);
+    void park(OSThread *t);
+    void applyReschedules();
+};
+
+} // namespace concurrency
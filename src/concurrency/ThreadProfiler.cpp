@@ -0,0 +1,107 @@
+#include "ThreadProfiler.h"
+
+#if MESHTASTIC_THREAD_PROFILE
+
+#include "DebugConfiguration.h"
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+namespace threadprof
+{
+
+namespace
+{
+
+// Static storage only, zero-initialized; a row with an empty name is free.
+Row table[kMaxRows];
+size_t used;
+
+// Rows shown by logBreakdown(); the rest are in snapshot() and /json/report
+constexpr size_t kLogRows = 8;
+
+int8_t findOrRegister(const char *name)
+{
+    if (!name)
+        return -1;
+    for (size_t i = 0; i < used; i++) {
+        if (strncmp(table[i].name, name, kNameLen - 1) == 0)
+            return (int8_t)i;
+    }
+    if (used == kMaxRows)
+        return -1; // table full - bump kMaxRows if this ever happens
+    Row &r = table[used];
+    strncpy(r.name, name, kNameLen - 1);
+    r.name[kNameLen - 1] = '\0';
+    return (int8_t)used++;
+}
+
+} // namespace
+
+void record(int8_t &slot, const char *name, uint32_t spentUs, uint32_t lateMs)
+{
+    if (slot < 0) {
+        slot = findOrRegister(name);
+        if (slot < 0)
+            return;
+    }
+    Row &r = table[slot];
+    r.runs++;
+    r.totalUs += spentUs;
+    if (spentUs > r.maxUs)
+        r.maxUs = spentUs;
+    r.totalLateMs += lateMs;
+    if (lateMs > r.maxLateMs)
+        r.maxLateMs = lateMs;
+}
+
+size_t snapshot(Row *out, size_t max)
+{
+    size_t n = std::min(max, used);
+    // Order row indices rather than the live table: threads cache their slot
+    uint8_t order[kMaxRows];
+    for (size_t i = 0; i < used; i++)
+        order[i] = (uint8_t)i;
+    std::partial_sort(order, order + n, order + used,
+                      [](uint8_t a, uint8_t b) { return table[a].totalUs > table[b].totalUs; });
+    for (size_t i = 0; i < n; i++)
+        out[i] = table[order[i]];
+    return n;
+}
+
+void logBreakdown(const char *when)
+{
+    Row rows[kLogRows];
+    size_t n = snapshot(rows, kLogRows);
+    if (n == 0)
+        return;
+
+    // Worst case per row: 15-char name plus four counters (a 64-bit total on 64-bit hosts) stays under 90 bytes.
+    char line[kLogRows * 90 + 1];
+    size_t pos = 0;
+    for (size_t i = 0; i < n; i++) {
+        int written = snprintf(line + pos, sizeof(line) - pos, "%s%s=%lu/%lums/max%luus/late%lums", pos ? " " : "", rows[i].name,
+                               (unsigned long)rows[i].runs, (unsigned long)(rows[i].totalUs / 1000),
+                               (unsigned long)rows[i].maxUs, (unsigned long)rows[i].maxLateMs);
+        if (written < 0 || pos + written >= sizeof(line))
+            break;
+        pos += written;
+    }
+    LOG_INFO("ThreadProf[%s]: %s", when ? when : "?", line);
+}
+
+void reset()
+{
+    for (size_t i = 0; i < used; i++) {
+        Row &r = table[i];
+        r.runs = 0;
+        r.totalUs = 0;
+        r.maxUs = 0;
+        r.maxLateMs = 0;
+        r.totalLateMs = 0;
+    }
+}
+
+} // namespace threadprof
+
+#endif // MESHTASTIC_THREAD_PROFILE
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "configuration.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// ThreadProfiler: where the main loop's time goes, per OSThread.
+//
+// OSThread::run() reports every runOnce() here: how long it took and how late
+// it started relative to when it was scheduled. Rows are keyed by thread name,
+// so the four ServerAPI sessions or a thread deleted and re-created after a
+// config change accumulate into one row. logBreakdown() prints the heaviest
+// rows on one line, e.g.
+//   ThreadProf[stats]: Router=812/1430ms/max9100us/late40ms GPS=61/220ms/...
+// (runs / total runtime / longest run / worst late start).
+//
+// Storage is a fixed table; each OSThread caches its row index, so the per-run
+// cost is two micros() reads and a few adds. Main loop only - OSThreads never
+// run anywhere else.
+//
+// Compiled out (no-op inline stubs, so call sites need no #ifdefs) when
+// MESHTASTIC_THREAD_PROFILE is 0 - the default on STM32WL, the tightest flash
+// target, same as MESHTASTIC_MEM_AUDIT.
+#ifndef MESHTASTIC_THREAD_PROFILE
+#ifdef ARCH_STM32WL
+#define MESHTASTIC_THREAD_PROFILE 0
+#else
+#define MESHTASTIC_THREAD_PROFILE 1
+#endif
+#endif
+
+namespace threadprof
+{
+
+// Fixed table capacity - threads with new names beyond this are not profiled.
+constexpr size_t kMaxRows = 48;
+
+// Names longer than this are truncated (OSThread names are short literals).
+constexpr size_t kNameLen = 16;
+
+// One snapshot row, as returned by snapshot().
+struct Row {
+    char name[kNameLen];
+    uint32_t runs;        // runOnce() calls
+    uint64_t totalUs;     // time spent in them
+    uint32_t maxUs;       // longest single call
+    uint32_t maxLateMs;   // worst start past the scheduled time
+    uint64_t totalLateMs; // summed late starts, for the average
+};
+
+#if MESHTASTIC_THREAD_PROFILE
+
+// Account one runOnce() of thread `name`. `slot` is the caller's cached row
+// index (start at -1); it is filled in on first use.
+void record(int8_t &slot, const char *name, uint32_t spentUs, uint32_t lateMs);
+
+// Copy up to max rows into out, heaviest total runtime first; returns the number written.
+size_t snapshot(Row *out, size_t max);
+
+// Log the heaviest rows as a single LOG_INFO line, labeled with `when` ("stats", "admin", ...).
+void logBreakdown(const char *when);
+
+// Forget everything recorded so far (rows keep their slots).
+void reset();
+
+#else
+
+// No-op stubs so call sites compile away without #ifdefs.
+inline void record(int8_t &, const char *, uint32_t, uint32_t) {}
+inline size_t snapshot(Row *, size_t)
+{
+    return 0;
+}
+inline void logBreakdown(const char *) {}
+inline void reset() {}
+
+#endif // MESHTASTIC_THREAD_PROFILE
+
+} // namespace threadprof
@@ -1918,8 +1918,10 @@ std::unique_ptr<GPS> GPS::createGps()
     new_gps->tx_gpio = _tx_gpio;
 #ifdef ARCH_PORTDUINO
     // Skip chip-specific probing for gpsd - it's a generic NMEA stream.
-    if (!portduino_config.gpsd_host.empty())
+    if (!portduino_config.gpsd_host.empty()) {
         new_gps->gnssModel = GNSS_MODEL_GENERIC_NMEA;
+        gpsdSerial.setReaderThread(new_gps.get());
+    }
 #endif
 
     GpioVirtPin *virtPin = new GpioVirtPin();
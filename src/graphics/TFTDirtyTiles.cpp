@@ -0,0 +1,101 @@
+#include "TFTDirtyTiles.h"
+#include "TFTColorRegions.h"
+
+#include <string.h>
+
+namespace graphics
+{
+
+static bool tileChanged(const uint8_t *buffer, const uint8_t *previous, size_t len, bool fromBlank)
+{
+    if (!fromBlank)
+        return memcmp(buffer, previous, len) != 0;
+    for (size_t i = 0; i < len; i++) {
+        if (buffer[i])
+            return true;
+    }
+    return false;
+}
+
+const std::vector<TFTDirtyRect> &TFTDirtyTiles::collect(const uint8_t *buffer, const uint8_t *previous, uint16_t width,
+                                                        uint16_t height, bool fromBlank, uint32_t maxPixels)
+{
+    rects.clear();
+    open.clear();
+
+    for (uint32_t y = 0; y < height; y += kTileRows) {
+        const uint16_t rows = (height - y < kTileRows) ? height - y : kTileRows;
+        const size_t page = (y / kTileRows) * width;
+        nextOpen.clear();
+        size_t o = 0; // next candidate in open[], which is sorted by x like the runs below
+
+        uint32_t x = 0;
+        while (x < width) {
+            // Next run of dirty tiles on this page
+            while (x < width) {
+                const uint32_t w = (width - x < kTileWidth) ? width - x : kTileWidth;
+                if (tileChanged(buffer + page + x, previous + page + x, w, fromBlank))
+                    break;
+                x += w;
+            }
+            if (x >= width)
+                break;
+            const uint32_t runStart = x;
+            while (x < width) {
+                const uint32_t w = (width - x < kTileWidth) ? width - x : kTileWidth;
+                if (!tileChanged(buffer + page + x, previous + page + x, w, fromBlank))
+                    break;
+                x += w;
+            }
+            const uint16_t runWidth = x - runStart;
+
+            // Stack onto the rectangle above when it spans the same columns and still fits
+            while (o < open.size() && rects[open[o]].x < runStart)
+                o++;
+            if (o < open.size()) {
+                TFTDirtyRect &above = rects[open[o]];
+                if (above.x == runStart && above.width == runWidth &&
+                    (uint32_t)runWidth * (above.height + rows) <= maxPixels) {
+                    above.height += rows;
+                    nextOpen.push_back(open[o]);
+                    continue;
+                }
+            }
+            nextOpen.push_back(rects.size());
+            rects.push_back({static_cast<uint16_t>(runStart), static_cast<uint16_t>(y), runWidth, rows});
+        }
+        open.swap(nextOpen);
+    }
+    return rects;
+}
+
+void TFTDirtyTiles::stage(const uint8_t *buffer, uint16_t width, const TFTDirtyRect &rect, uint16_t onColorBe,
+                          uint16_t offColorBe, bool useColorRegions, uint16_t *out)
+{
+    for (uint32_t row = 0; row < rect.height; row++) {
+        const uint32_t y = rect.y + row;
+        const uint8_t mask = 1 << (y & 7);
+        const uint8_t *src = buffer + (y / kTileRows) * width + rect.x;
+        uint16_t *dst = out + row * rect.width;
+
+        // Defaults first: background pixels (the bulk of any frame) take no region lookup
+        for (uint32_t i = 0; i < rect.width; i++)
+            dst[i] = (src[i] & mask) ? onColorBe : offColorBe;
+
+        if (!useColorRegions)
+            continue;
+        // Then each region overlapping this row, in ascending index order so the highest wins
+        beginTFTColorRow(static_cast<int16_t>(y));
+        for (uint8_t k = 0; k < tftColorRowCount; k++) {
+            const TFTColorRegion &r = colorRegions[tftColorRowRegions[k]];
+            int32_t xs = r.x > rect.x ? r.x : rect.x;
+            int32_t xe = r.x + r.width;
+            if (xe > rect.x + rect.width)
+                xe = rect.x + rect.width;
+            for (int32_t xx = xs; xx < xe; xx++)
+                dst[xx - rect.x] = (src[xx - rect.x] & mask) ? r.onColorBe : r.offColorBe;
+        }
+    }
+}
+
+} // namespace graphics
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace graphics
+{
+
+struct TFTDirtyRect {
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+};
+
+/**
+ * Changed-area tracking for TFTDisplay::display().
+ *
+ * The OLEDDisplay framebuffer is page ordered: one byte holds a column of 8 rows. The screen is
+ * split into tiles of kTileWidth columns by one page; a tile is dirty when its bytes differ from
+ * the copy last sent to the panel (one memcmp per tile, so unchanged areas cost almost nothing).
+ * Dirty tiles next to each other in a page are merged into one rectangle, and rectangles with the
+ * same columns in consecutive pages are stacked while they still fit the staging buffer. Each
+ * rectangle is then rendered to RGB565 with stage() and sent with a single pushImage, instead of
+ * one transfer per changed row.
+ */
+class TFTDirtyTiles
+{
+  public:
+    static constexpr uint16_t kTileWidth = 32;
+    static constexpr uint16_t kTileRows = 8; // one OLEDDisplay page
+
+    /**
+     * Find what changed since `previous` and merge it into rectangles of at most maxPixels each.
+     * With fromBlank the panel was just cleared to the off color, so any tile with a set pixel counts.
+     * @return the rectangles, top to bottom; valid until the next collect()
+     */
+    const std::vector<TFTDirtyRect> &collect(const uint8_t *buffer, const uint8_t *previous, uint16_t width, uint16_t height,
+                                             bool fromBlank, uint32_t maxPixels);
+
+    /**
+     * Render one rectangle of the framebuffer into `out` as big-endian RGB565, rect.width pixels per
+     * row. With useColorRegions the registered TFT color regions are painted over the defaults,
+     * highest index winning as in resolveTFTColorPixel().
+     */
+    static void stage(const uint8_t *buffer, uint16_t width, const TFTDirtyRect &rect, uint16_t onColorBe, uint16_t offColorBe,
+                      bool useColorRegions, uint16_t *out);
+
+  private:
+    std::vector<TFTDirtyRect> rects;
+    std::vector<uint16_t> open;     // rects ending at the previous page, left to right
+    std::vector<uint16_t> nextOpen; // the same for the page being scanned
+};
+
+} // namespace graphics
@@ -1219,11 +1219,7 @@ TFTDisplay::TFTDisplay(uint8_t address, int sda, int scl, OLEDDISPLAY_GEOMETRY g
 
 TFTDisplay::~TFTDisplay()
 {
-    // Clean up allocated line pixel buffer to prevent memory leak
-    if (linePixelBuffer != nullptr) {
-        free(linePixelBuffer);
-        linePixelBuffer = nullptr;
-    }
+    // Clean up the staging buffer to prevent memory leak
     if (repaintChunkBuffer != nullptr) {
         free(repaintChunkBuffer);
         repaintChunkBuffer = nullptr;
@@ -1236,14 +1232,12 @@ void TFTDisplay::display(bool fromBlank)
 {
     concurrency::LockGuard g(spiLock);
 
-    uint32_t x, y;
-    uint32_t y_byteIndex;
-    uint8_t y_byteMask;
-    uint32_t x_FirstPixelUpdate;
-    uint32_t x_LastPixelUpdate;
-    bool isset, dblbuf_isset;
+#ifdef TFT_FRAME_STATS
+    const uint32_t frameStartUs = micros();
+#endif
+    uint32_t framePixels = 0;
+    uint32_t frameRects = 0;
     uint16_t colorTftWhite, colorTftBlack;
-    bool somethingChanged = false;
 
     // Theme defaults for non-role pixels.
     const uint16_t defaultOnColor = getThemeDefaultOnColor();
@@ -1273,44 +1267,15 @@ void TFTDisplay::display(bool fromBlank)
     // Repaint full frame only for those frames, then return to diff-based updates.
     if (forceFullColorRepaint) {
         for (uint32_t yStart = 0; yStart < displayHeight; yStart += kFullRepaintChunkRows) {
-            const uint32_t rowsThisChunk = min<uint32_t>(kFullRepaintChunkRows, displayHeight - yStart);
-            for (uint32_t row = 0; row < rowsThisChunk; row++) {
-                y = yStart + row;
-                y_byteIndex = (y / 8) * displayWidth;
-                y_byteMask = (1 << (y & 7));
-
-                uint16_t *chunkRow = repaintChunkBuffer + (row * displayWidth);
-
-                // Step 1: fill the whole row with the default colors. No per-pixel
-                // region scan, so background pixels (the bulk of the screen) are O(1).
-                for (x = 0; x < displayWidth; x++) {
-                    isset = (buffer[x + y_byteIndex] & y_byteMask) != 0;
-                    chunkRow[x] = isset ? colorTftWhite : colorTftBlack;
-                }
-
-                // Step 2: overprint each region overlapping this row, applied in
-                // ascending index order so the highest-index region wins (matches
-                // resolveTFTColorPixel precedence). Only region-covered pixels are
-                // re-touched, so total cost is ~screen + sum of region spans.
-                if (hasColorRegions) {
-                    graphics::beginTFTColorRow(static_cast<int16_t>(y));
-                    for (uint8_t k = 0; k < graphics::tftColorRowCount; k++) {
-                        const graphics::TFTColorRegion &r = graphics::colorRegions[graphics::tftColorRowRegions[k]];
-                        int32_t xs = r.x > 0 ? r.x : 0;
-                        int32_t xe = r.x + r.width;
-                        if (xe > (int32_t)displayWidth)
-                            xe = (int32_t)displayWidth;
-                        for (int32_t xx = xs; xx < xe; xx++) {
-                            isset = (buffer[xx + y_byteIndex] & y_byteMask) != 0;
-                            chunkRow[xx] = isset ? r.onColorBe : r.offColorBe;
-                        }
-                    }
-                }
-            }
+            const graphics::TFTDirtyRect chunk = {0, static_cast<uint16_t>(yStart), static_cast<uint16_t>(displayWidth),
+                                                  static_cast<uint16_t>(min<uint32_t>(kFullRepaintChunkRows,
+                                                                                      displayHeight - yStart))};
+            graphics::TFTDirtyTiles::stage(buffer, displayWidth, chunk, colorTftWhite, colorTftBlack, hasColorRegions,
+                                           repaintChunkBuffer);
 #if defined(HACKADAY_COMMUNICATOR)
-            tft->draw16bitBeRGBBitmap(0, yStart, repaintChunkBuffer, displayWidth, rowsThisChunk);
+            tft->draw16bitBeRGBBitmap(chunk.x, chunk.y, repaintChunkBuffer, chunk.width, chunk.height);
 #else
-            tft->pushImage(0, yStart, displayWidth, rowsThisChunk, repaintChunkBuffer);
+            tft->pushImage(chunk.x, chunk.y, chunk.width, chunk.height, repaintChunkBuffer);
 #endif
         }
 
@@ -1322,106 +1287,29 @@ void TFTDisplay::display(bool fromBlank)
         graphics::clearTFTColorRegions();
         return;
     }
-#endif
-
-    y = 0;
-    while (y < displayHeight) {
-        y_byteIndex = (y / 8) * displayWidth;
-        y_byteMask = (1 << (y & 7));
-
-        // Step 1: Do a quick scan of 8 rows together. This allows fast-forwarding over unchanged screen areas.
-        if (y_byteMask == 1) {
-            if (!forceFullRepaint) {
-                for (x = 0; x < displayWidth; x++) {
-                    if (buffer[x + y_byteIndex] != buffer_back[x + y_byteIndex])
-                        break;
-                }
-            } else {
-                for (x = 0; x < displayWidth; x++) {
-                    if (buffer[x + y_byteIndex] != 0)
-                        break;
-                }
-            }
-            if (x >= displayWidth) {
-                // No changed pixels found in these 8 rows, fast-forward to the next 8
-                y = y + 8;
-                continue;
-            }
-        }
-
-        // Step 2: Scan this row for changed span (first and last changed pixel).
-        uint32_t x_FirstChanged = 0;
-        for (x_FirstChanged = 0; x_FirstChanged < displayWidth; x_FirstChanged++) {
-            isset = buffer[x_FirstChanged + y_byteIndex] & y_byteMask;
-
-            if (!forceFullRepaint) {
-                // get src pixel in the page based ordering the OLED lib uses
-                dblbuf_isset = buffer_back[x_FirstChanged + y_byteIndex] & y_byteMask;
-                if (isset != dblbuf_isset) {
-                    break;
-                }
-            } else if (isset) {
-                break;
-            }
-        }
-
-        // Did we find a pixel that needs updating on this row?
-        if (x_FirstChanged < displayWidth) {
-            uint32_t x_LastChanged = displayWidth - 1;
-            while (x_LastChanged > x_FirstChanged) {
-                isset = buffer[x_LastChanged + y_byteIndex] & y_byteMask;
-                if (!forceFullRepaint) {
-                    dblbuf_isset = buffer_back[x_LastChanged + y_byteIndex] & y_byteMask;
-                    if (isset != dblbuf_isset) {
-                        break;
-                    }
-                } else if (isset) {
-                    break;
-                }
-                x_LastChanged--;
-            }
-
-            // Align the first pixel for update to an even number so the total alignment of
-            // the data will be at 32-bit boundary, which is required by GDMA SPI transfers.
-            x_FirstPixelUpdate = x_FirstChanged & ~1U;
-            x_LastPixelUpdate = x_LastChanged | 1U;
-            if (x_LastPixelUpdate >= displayWidth) {
-                x_LastPixelUpdate = displayWidth - 1;
-            }
-
-            // Step 3: Copy only the changed span into the pixel line buffer.
-#if GRAPHICS_TFT_COLORING_ENABLED
-            if (hasColorRegions)
-                graphics::beginTFTColorRow(static_cast<int16_t>(y));
-#endif
-            for (x = x_FirstPixelUpdate; x <= x_LastPixelUpdate; x++) {
-                isset = buffer[x + y_byteIndex] & y_byteMask;
-#if GRAPHICS_TFT_COLORING_ENABLED
-                if (hasColorRegions) {
-                    linePixelBuffer[x] =
-                        graphics::resolveTFTColorPixelRow(static_cast<int16_t>(x), isset, colorTftWhite, colorTftBlack);
-                } else {
-                    linePixelBuffer[x] = isset ? colorTftWhite : colorTftBlack;
-                }
 #else
-                linePixelBuffer[x] = isset ? colorTftWhite : colorTftBlack;
+    const bool hasColorRegions = false;
 #endif
-            }
+
+    // Collect the changed tiles, merged into rectangles no larger than the staging buffer, and send
+    // each one as a single block transfer. pushImage takes pixel data MSB first so the staged
+    // rectangle goes straight out the SPI port.
+    const std::vector<graphics::TFTDirtyRect> &rects = dirtyTiles.collect(
+        buffer, buffer_back, displayWidth, displayHeight, forceFullRepaint, displayWidth * kFullRepaintChunkRows);
+    for (const graphics::TFTDirtyRect &r : rects) {
+        graphics::TFTDirtyTiles::stage(buffer, displayWidth, r, colorTftWhite, colorTftBlack, hasColorRegions,
+                                       repaintChunkBuffer);
 #if defined(HACKADAY_COMMUNICATOR)
-            tft->draw16bitBeRGBBitmap(x_FirstPixelUpdate, y, &linePixelBuffer[x_FirstPixelUpdate],
-                                      (x_LastPixelUpdate - x_FirstPixelUpdate + 1), 1);
+        tft->draw16bitBeRGBBitmap(r.x, r.y, repaintChunkBuffer, r.width, r.height);
 #else
-            // Step 4: Send the changed pixels on this line to the screen as a single block transfer.
-            // This function accepts pixel data MSB first so it can dump the memory straight out the SPI port.
-            tft->pushImage(x_FirstPixelUpdate, y, (x_LastPixelUpdate - x_FirstPixelUpdate + 1), 1,
-                           &linePixelBuffer[x_FirstPixelUpdate]);
+        tft->pushImage(r.x, r.y, r.width, r.height, repaintChunkBuffer);
 #endif
-            somethingChanged = true;
-        }
-        y++;
+        framePixels += (uint32_t)r.width * r.height;
     }
+    frameRects = rects.size();
+
     // Copy the Buffer to the Back Buffer
-    if (somethingChanged)
+    if (frameRects)
         memcpy(buffer_back, buffer, displayBufferSize);
 
 #if GRAPHICS_TFT_COLORING_ENABLED
@@ -1431,6 +1319,24 @@ void TFTDisplay::display(bool fromBlank)
     lastDefaultOnColor = defaultOnColor;
     lastDefaultOffColor = defaultOffColor;
     graphics::clearTFTColorRegions();
+
+#ifdef TFT_FRAME_STATS
+    // Frame cost as seen by the panel backend (Panel_sdl on native-tft), averaged over frames that sent something
+    if (frameRects) {
+        statFrames++;
+        statUs += micros() - frameStartUs;
+        statRects += frameRects;
+        statPixels += framePixels;
+        if (statFrames == 64) {
+            LOG_DEBUG("TFT: %u.%03u ms/frame, %u rects/frame, %u px/frame", (unsigned)(statUs / statFrames / 1000),
+                      (unsigned)(statUs / statFrames % 1000), (unsigned)(statRects / statFrames),
+                      (unsigned)(statPixels / statFrames));
+            statFrames = statUs = statRects = statPixels = 0;
+        }
+    }
+#else
+    (void)framePixels;
+#endif
 }
 
 void TFTDisplay::sdlLoop()
@@ -1652,15 +1558,6 @@ bool TFTDisplay::connect()
 #endif
     tft->fillScreen(getThemeDefaultOffColor());
 
-    if (this->linePixelBuffer == NULL) {
-        this->linePixelBuffer = (uint16_t *)malloc(sizeof(uint16_t) * displayWidth);
-
-        if (!this->linePixelBuffer) {
-            LOG_ERROR("Not enough memory to create TFT line buffer\n");
-            return false;
-        }
-        memaudit::add("display", sizeof(uint16_t) * displayWidth);
-    }
     if (this->repaintChunkBuffer == NULL) {
         this->repaintChunkBuffer = (uint16_t *)malloc(sizeof(uint16_t) * displayWidth * kFullRepaintChunkRows);
 
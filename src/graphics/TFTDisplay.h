@@ -3,11 +3,12 @@
 #include <GpioLogic.h>
 #include <OLEDDisplay.h>
 
+#include "TFTDirtyTiles.h"
+
 /**
  * An adapter class that allows using the LovyanGFX library as if it was an OLEDDisplay implementation.
  *
  * Remaining TODO:
- * optimize display() to only draw changed pixels (see other OLED subclasses for examples)
  * Use the fast NRF52 SPI API rather than the slow standard arduino version
  *
  * turn radio back on - currently with both on spi bus is fucked? or are we leaving chip select asserted?
@@ -62,6 +63,16 @@ class TFTDisplay : public OLEDDisplay
     // Connect to the display
     virtual bool connect() override;
 
-    uint16_t *linePixelBuffer = nullptr;
+    // RGB565 staging area for one pushImage: a full-width band of kFullRepaintChunkRows rows,
+    // or one merged dirty rectangle of at most that many pixels
     uint16_t *repaintChunkBuffer = nullptr;
+    graphics::TFTDirtyTiles dirtyTiles;
+
+#ifdef TFT_FRAME_STATS
+    // Running totals for the periodic frame cost log in display()
+    uint32_t statFrames = 0;
+    uint32_t statUs = 0;
+    uint32_t statRects = 0;
+    uint32_t statPixels = 0;
+#endif
 };
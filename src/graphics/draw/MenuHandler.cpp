@@ -962,8 +962,7 @@ void menuHandler::messageViewModeMenu()
 
     // Channels with messages
     for (int ch = 0; ch < 8; ++ch) {
-        auto msgs = messageStore.getChannelMessages((uint8_t)ch);
-        if (!msgs.empty()) {
+        if (messageStore.hasVisibleMessages(messageStore.getChannelMessages((uint8_t)ch))) {
             char buf[40];
             const char *cname = channels.getName(ch);
             snprintf(buf, sizeof(buf), cname && cname[0] ? "#%s" : "#Ch%d", cname ? cname : "", ch);
@@ -977,8 +976,7 @@ void menuHandler::messageViewModeMenu()
     for (int ch : graphics::MessageRenderer::getSeenChannels()) {
         if (ch < 0 || ch >= 8)
             continue;
-        auto msgs = messageStore.getChannelMessages((uint8_t)ch);
-        if (msgs.empty())
+        if (!messageStore.hasVisibleMessages(messageStore.getChannelMessages((uint8_t)ch)))
             continue;
         int enc = encodeChannelId(ch);
         if (std::find(ids.begin(), ids.end(), enc) == ids.end()) {
@@ -992,11 +990,9 @@ void menuHandler::messageViewModeMenu()
     }
 
     // Gather unique peers
-    auto dms = messageStore.getDirectMessages();
     std::vector<uint32_t> uniquePeers;
-    for (const auto &m : dms) {
-        uint32_t peer = (m.sender == nodeDB->getNodeNum()) ? m.dest : m.sender;
-        if (peer != nodeDB->getNodeNum() && std::find(uniquePeers.begin(), uniquePeers.end(), peer) == uniquePeers.end())
+    for (uint32_t peer : messageStore.getDirectPeers()) {
+        if (peer != nodeDB->getNodeNum())
             uniquePeers.push_back(peer);
     }
     for (uint32_t peer : graphics::MessageRenderer::getSeenPeers()) {
@@ -401,28 +401,12 @@ void drawTextMessageFrame(OLEDDisplay *display, OLEDDisplayUiState *state, int16
     // Clear the unread message indicator when viewing the message
     hasUnreadMessage = false;
 
-    // Filter messages based on thread mode
-    std::deque<StoredMessage> filtered;
-    for (const auto &m : messageStore.getLiveMessages()) {
-        if (!messageStore.isMessageVisible(m))
-            continue;
-        bool include = false;
-        switch (currentMode) {
-        case ThreadMode::ALL:
-            include = true;
-            break;
-        case ThreadMode::CHANNEL:
-            if (m.type == MessageType::BROADCAST && (int)m.channelIndex == currentChannel)
-                include = true;
-            break;
-        case ThreadMode::DIRECT:
-            if (m.dest != NODENUM_BROADCAST && (m.sender == currentPeer || m.dest == currentPeer))
-                include = true;
-            break;
-        }
-        if (include)
-            filtered.push_back(m);
-    }
+    // The thread's own list in the store: walked in place, hidden messages skipped as we go
+    MessageStore::View filtered = messageStore.getMessages();
+    if (currentMode == ThreadMode::CHANNEL)
+        filtered = messageStore.getChannelMessages((uint8_t)currentChannel);
+    else if (currentMode == ThreadMode::DIRECT)
+        filtered = messageStore.getDirectMessages(currentPeer);
 
     display->clear();
     display->setTextAlignment(TEXT_ALIGN_LEFT);
@@ -474,7 +458,7 @@ void drawTextMessageFrame(OLEDDisplay *display, OLEDDisplayUiState *state, int16
     }
     }
 
-    if (filtered.empty()) {
+    if (!messageStore.hasVisibleMessages(filtered)) {
         // If current conversation is empty go back to ALL view
         if (currentMode != ThreadMode::ALL) {
             setThreadMode(ThreadMode::ALL);
@@ -511,6 +495,8 @@ void drawTextMessageFrame(OLEDDisplay *display, OLEDDisplayUiState *state, int16
 
     for (auto it = filtered.rbegin(); it != filtered.rend(); ++it) {
         const auto &m = *it;
+        if (!messageStore.isMessageVisible(m))
+            continue;
 
         // Channel / destination labeling
         char chanType[32] = "";
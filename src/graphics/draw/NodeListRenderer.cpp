@@ -3,6 +3,7 @@
 #include "CompassRenderer.h"
 #include "NodeDB.h"
 #include "NodeListRenderer.h"
+#include "NodeListView.h"
 #if !MESHTASTIC_EXCLUDE_STATUS
 #include "modules/StatusMessageModule.h"
 #endif
@@ -28,6 +29,10 @@ namespace graphics
 namespace NodeListRenderer
 {
 
+// Filtered node lists shared across frames; rebuilt only when NodeDB changes
+static NodeListView listedNodes(NodeListView::ALL_NODES, false);
+static NodeListView locatedNodes(NodeListView::POSITIONED_NODES, false);
+
 // Function moved from Screen.cpp to NodeListRenderer.cpp since it's primarily used here
 void drawScaledXBitmap16x16(int x, int y, int width, int height, const uint8_t *bitmapXBM, OLEDDisplay *display)
 {
@@ -627,27 +632,14 @@ void drawNodeListScreen(OLEDDisplay *display, OLEDDisplayUiState *state, int16_t
 
     int columnWidth = display->getWidth() / totalColumns;
 
-    int totalEntries = nodeDB->getNumMeshNodes();
     int totalRowsAvailable = (display->getHeight() - y) / rowYOffset;
     int numskipped = 0;
     int visibleNodeRows = totalRowsAvailable;
 
-    // Build filtered + ordered list
-    std::vector<int> drawList;
-    drawList.reserve(totalEntries);
-    for (int i = 0; i < totalEntries; i++) {
-        auto *n = nodeDB->getMeshNodeByIndex(i);
-
-        if (!n)
-            continue;
-        if (n->num == nodeDB->getNodeNum())
-            continue;
-        if (locationScreen && !nodeDB->hasNodePosition(n->num))
-            continue;
-
-        drawList.push_back(n->num);
-    }
-    totalEntries = drawList.size();
+    // Filtered + ordered list, cached until the DB changes
+    NodeListView &drawList = locationScreen ? locatedNodes : listedNodes;
+    drawList.refresh();
+    int totalEntries = drawList.size();
     int perPage = visibleNodeRows * totalColumns;
 
     int maxScroll = 0;
@@ -666,8 +658,7 @@ void drawNodeListScreen(OLEDDisplay *display, OLEDDisplayUiState *state, int16_t
     int rowCount = 0;
 
     for (int idx = startIndex; idx < endIndex; idx++) {
-        uint32_t nodeNum = drawList[idx];
-        auto *node = nodeDB->getMeshNode(nodeNum);
+        auto *node = drawList.node(idx);
         int xPos = x + (col * columnWidth);
         int yPos = y + yOffset;
 
@@ -3,6 +3,7 @@
 #if HAS_SCREEN
 #include "DisplayFormatters.h"
 #include "NodeDB.h"
+#include "NodeListView.h"
 #include "NotificationRenderer.h"
 #include "UIRenderer.h"
 #include "graphics/ScreenFonts.h"
@@ -41,6 +42,9 @@ extern bool hasUnreadMessage;
 
 namespace graphics
 {
+// Candidates for the menu node pickers (every node but ours), rebuilt only when NodeDB changes
+static NodeListView pickerNodes(NodeListView::ALL_NODES, false);
+
 int bannerSignalBars = -1;
 InputEvent NotificationRenderer::inEvent;
 int8_t NotificationRenderer::curSelected = 0;
@@ -560,7 +564,8 @@ void NotificationRenderer::drawNodePicker(OLEDDisplay *display, OLEDDisplayUiSta
 
     // === Layout Configuration ===
     constexpr uint16_t vPadding = 2;
-    alertBannerOptions = nodeDB->getNumMeshNodes() - 1;
+    pickerNodes.refresh();
+    alertBannerOptions = pickerNodes.size();
 
     // let the box drawing function calculate the widths?
 
@@ -629,7 +634,7 @@ void NotificationRenderer::drawNodePicker(OLEDDisplay *display, OLEDDisplayUiSta
     int scratchLineNum = 0;
     for (int i = firstOptionToShow; i < alertBannerOptions && linesShown < visibleTotalLines; i++, linesShown++) {
         char tempName[48] = {0};
-        meshtastic_NodeInfoLite *node = nodeDB->getMeshNodeByIndex(i + 1);
+        meshtastic_NodeInfoLite *node = pickerNodes.node(i);
         if (nodeInfoLiteHasUser(node)) {
             const char *rawName = nullptr;
             if (node->long_name[0]) {
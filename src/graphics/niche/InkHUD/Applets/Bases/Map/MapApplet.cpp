@@ -3,6 +3,8 @@
 #include "./MapApplet.h"
 #include "./MapTile.h"
 
+#include "mesh/NodeListView.h"
+
 #include <math.h>
 #include <string.h>
 
@@ -21,6 +23,9 @@ static int tileTyAt(int tileIndex);
 static int tileMetadataZoomCount();
 static int tileMetadataZoomAt(int index);
 
+// Nodes with a position, shared by every map applet; rebuilt only when NodeDB changes
+static NodeListView mappedNodes(NodeListView::POSITIONED_NODES, true);
+
 // Observe GPS position updates so the map redraws whenever a new location arrives.
 InkHUD::MapApplet::MapApplet()
 {
@@ -613,21 +618,18 @@ void InkHUD::MapApplet::getMapCenter(float *lat, float *lng)
         float yAvg = 0;
         float zAvg = 0;
 
-        // For each node in db
-        for (uint32_t i = 0; i < nodeDB->getNumMeshNodes(); i++) {
-            meshtastic_NodeInfoLite *node = nodeDB->getMeshNodeByIndex(i);
-
+        // For each node with a position
+        mappedNodes.refresh();
+        for (size_t i = 0; i < mappedNodes.size(); i++) {
             // Skip if no position
-            if (!nodeDB->hasValidPosition(node))
+            if (!mappedNodes.hasFix(i))
                 continue;
 
             // Skip if derived applet doesn't want to show this node on the map
-            if (!shouldDrawNode(node))
+            if (!shouldDrawNode(mappedNodes.node(i)))
                 continue;
 
-            meshtastic_PositionLite pos;
-            if (!nodeDB->copyNodePosition(node->num, pos))
-                continue;
+            const NodeListView::Coords &pos = mappedNodes.coords(i);
 
             // Latitude and Longitude of node, in radians
             float latRad = pos.latitude_i * (1e-7) * DEG_TO_RAD;
@@ -709,15 +711,14 @@ void InkHUD::MapApplet::getMapCenter(float *lat, float *lng)
         if (!centerIsOurNode) {
             uint32_t count = 0;
             float xAvg = 0, yAvg = 0, zAvg = 0;
-            for (uint32_t i = 0; i < nodeDB->getNumMeshNodes(); i++) {
-                meshtastic_NodeInfoLite *node = nodeDB->getMeshNodeByIndex(i);
-                if (!nodeDB->hasValidPosition(node) || !shouldDrawNode(node))
+            mappedNodes.refresh();
+            for (size_t i = 0; i < mappedNodes.size(); i++) {
+                meshtastic_NodeInfoLite *node = mappedNodes.node(i);
+                if (!mappedNodes.hasFix(i) || !shouldDrawNode(node))
                     continue;
                 if (!node->has_hops_away || node->hops_away != 0)
                     continue;
-                meshtastic_PositionLite pos;
-                if (!nodeDB->copyNodePosition(node->num, pos))
-                    continue;
+                const NodeListView::Coords &pos = mappedNodes.coords(i);
                 float latRad2 = pos.latitude_i * 1e-7 * DEG_TO_RAD;
                 float lngRad2 = pos.longitude_i * 1e-7 * DEG_TO_RAD;
                 xAvg += cosf(latRad2) * cosf(lngRad2);
@@ -744,17 +745,14 @@ void InkHUD::MapApplet::getMapCenter(float *lat, float *lng)
     float easternmost = lngCenter;
     float westernmost = lngCenter;
 
-    for (size_t i = 0; i < nodeDB->getNumMeshNodes(); i++) {
-        meshtastic_NodeInfoLite *node = nodeDB->getMeshNodeByIndex(i);
-
-        if (!nodeDB->hasValidPosition(node))
+    mappedNodes.refresh();
+    for (size_t i = 0; i < mappedNodes.size(); i++) {
+        if (!mappedNodes.hasFix(i))
             continue;
-        if (!shouldDrawNode(node))
+        if (!shouldDrawNode(mappedNodes.node(i)))
             continue;
 
-        meshtastic_PositionLite pos;
-        if (!nodeDB->copyNodePosition(node->num, pos))
-            continue;
+        const NodeListView::Coords &pos = mappedNodes.coords(i);
 
         float latNode = pos.latitude_i * 1e-7;
         float lngNode = pos.longitude_i * 1e-7;
@@ -923,9 +921,9 @@ void InkHUD::MapApplet::drawLabeledMarker(meshtastic_NodeInfoLite *node)
 // Check if we actually have enough nodes which would be shown on the map
 bool InkHUD::MapApplet::enoughMarkers()
 {
-    for (size_t i = 0; i < nodeDB->getNumMeshNodes(); i++) {
-        meshtastic_NodeInfoLite *node = nodeDB->getMeshNodeByIndex(i);
-        if (nodeDB->hasValidPosition(node) && shouldDrawNode(node))
+    mappedNodes.refresh();
+    for (size_t i = 0; i < mappedNodes.size(); i++) {
+        if (mappedNodes.hasFix(i) && shouldDrawNode(mappedNodes.node(i)))
             return true;
     }
     return false;
@@ -938,12 +936,13 @@ void InkHUD::MapApplet::calculateAllMarkers()
     // Clear old markers
     markers.clear();
 
-    // For each node in db
-    for (uint32_t i = 0; i < nodeDB->getNumMeshNodes(); i++) {
-        meshtastic_NodeInfoLite *node = nodeDB->getMeshNodeByIndex(i);
+    // For each node with a position
+    mappedNodes.refresh();
+    for (size_t i = 0; i < mappedNodes.size(); i++) {
+        meshtastic_NodeInfoLite *node = mappedNodes.node(i);
 
         // Skip if no position
-        if (!nodeDB->hasValidPosition(node))
+        if (!mappedNodes.hasFix(i))
             continue;
 
         // Skip if derived applet doesn't want to show this node on the map
@@ -959,10 +958,7 @@ void InkHUD::MapApplet::calculateAllMarkers()
         if (!node->has_hops_away)
             continue;
 
-        meshtastic_PositionLite pos;
-        if (!nodeDB->copyNodePosition(node->num, pos))
-            continue;
-
+        const NodeListView::Coords &pos = mappedNodes.coords(i);
         markers.push_back(calculateMarker(pos.latitude_i * 1e-7, pos.longitude_i * 1e-7, node->hops_away));
     }
 }
@@ -52,19 +52,13 @@ void InkHUD::ThreadedMessageApplet::onRender(bool full)
 
     int16_t msgB = height() - 1; // Vertical cursor for drawing. Messages are bottom-aligned to this value.
 
-    // Iterate the global store newest-first, showing only broadcast messages on our channel
-    const auto &allMessages = messageStore.getLiveMessages();
-    int msgIdx = (int)allMessages.size() - 1;
+    // Walk our channel's broadcasts in the global store, newest-first
+    const MessageStore::View channelMessages = messageStore.getChannelMessages(channelIndex);
+    auto msgIt = channelMessages.rbegin();
 
-    while (msgB >= (0 - fontSmall.lineHeight()) && msgIdx >= 0) {
+    while (msgB >= (0 - fontSmall.lineHeight()) && msgIt != channelMessages.rend()) {
 
-        const StoredMessage &m = allMessages.at(msgIdx);
-
-        // Skip messages that don't belong to this channel or are DMs
-        if (m.type != MessageType::BROADCAST || m.channelIndex != channelIndex) {
-            msgIdx--;
-            continue;
-        }
+        const StoredMessage &m = *msgIt;
 
         // Grab data for message
         bool outgoing = (m.sender == myNodeInfo.my_node_num);
@@ -149,7 +143,7 @@ void InkHUD::ThreadedMessageApplet::onRender(bool full)
         // Move cursor up: padding before next message
         msgB -= fontSmall.lineHeight() * 0.5;
 
-        msgIdx--;
+        ++msgIt;
     } // End of loop: drawing each message
 
     // Fade effect:
@@ -35,6 +35,7 @@
 #include "detect/ScanI2CTwoWire.h"
 #include <Wire.h>
 #endif
+#include "concurrency/ThreadProfiler.h"
 #include "detect/einkScan.h"
 #include "graphics/Screen.h"
 #include "main.h"
@@ -1202,6 +1203,7 @@ void setup()
 
     // Log the per-subsystem heap breakdown now that the big allocations are done
     memaudit::logBreakdown("boot");
+    threadprof::logBreakdown("boot");
 
     // We manually run this to update the NodeStatus
     nodeDB->notifyObservers(true);
@@ -8,6 +8,7 @@
 #include "NodeDB.h"
 #include "aes-ccm.h"
 #include "meshUtils.h"
+#include "security/SecureZero.h"
 #include <Crypto.h>
 #include <Curve25519.h>
 #include <RNG.h>
@@ -52,6 +53,7 @@ void CryptoEngine::generateKeyPair(uint8_t *pubKey, uint8_t *privKey)
 
     LOG_DEBUG("Generate Curve25519 keypair");
     Curve25519::dh1(public_key, private_key);
+    flushSharedKeyCache();
     memcpy(pubKey, public_key, sizeof(public_key));
     memcpy(privKey, private_key, sizeof(private_key));
 #if !(MESHTASTIC_EXCLUDE_XEDDSA)
@@ -74,6 +76,8 @@ bool CryptoEngine::regeneratePublicKey(uint8_t *pubKey, uint8_t *privKey)
             memset(pubKey, 0, 32);
             return false;
         }
+        if (memcmp(private_key, privKey, sizeof(private_key)) != 0)
+            flushSharedKeyCache();
         memcpy(private_key, privKey, sizeof(private_key));
         memcpy(public_key, pubKey, sizeof(public_key));
 #if !(MESHTASTIC_EXCLUDE_XEDDSA)
@@ -125,19 +129,31 @@ bool CryptoEngine::xeddsa_sign(uint32_t fromNode, uint32_t packetId, uint32_t po
     return true;
 }
 
+const uint8_t *CryptoEngine::edPubkeyFor(const uint8_t *curvePubkey)
+{
+    EdKeyCacheEntry *victim = &edKeyCache[0];
+    for (EdKeyCacheEntry &e : edKeyCache) {
+        if (e.lastUsed && memcmp(e.curvePubkey, curvePubkey, 32) == 0) {
+            e.lastUsed = ++edKeyCacheClock;
+            return e.edPubkey;
+        }
+        if (e.lastUsed < victim->lastUsed)
+            victim = &e;
+    }
+    curve_to_ed_pub(curvePubkey, victim->edPubkey);
+    memcpy(victim->curvePubkey, curvePubkey, 32);
+    victim->lastUsed = ++edKeyCacheClock;
+    return victim->edPubkey;
+}
+
 bool CryptoEngine::xeddsa_verify(const uint8_t *pubKey, uint32_t fromNode, uint32_t packetId, uint32_t portnum,
                                  const uint8_t *payload, size_t payloadLen, const uint8_t *signature)
 {
-    // Use cached Ed25519 key if the Curve25519 key matches, avoiding expensive field inversion
-    if (memcmp(pubKey, cached_curve_pubkey, 32) != 0) {
-        curve_to_ed_pub(pubKey, cached_ed_pubkey);
-        memcpy(cached_curve_pubkey, pubKey, 32);
-    }
     uint8_t sigBuf[MAX_BLOCKSIZE];
     size_t sigLen = buildSigningBuffer(sigBuf, sizeof(sigBuf), fromNode, packetId, portnum, payload, payloadLen);
     if (sigLen == 0)
         return false;
-    return XEdDSA::verify(signature, cached_ed_pubkey, sigBuf, sigLen);
+    return XEdDSA::verify(signature, edPubkeyFor(pubKey), sigBuf, sigLen);
 }
 
 void CryptoEngine::curve_to_ed_pub(const uint8_t *curve_pubkey, uint8_t *ed_pubkey)
@@ -237,10 +253,9 @@ bool CryptoEngine::encryptCurve25519(uint32_t toNode, uint32_t fromNode, meshtas
         LOG_DEBUG("Node %d or their public_key not found", toNode);
         return false;
     }
-    if (!setDHPublicKey(remotePublic.bytes)) {
+    if (!deriveSharedKey(remotePublic.bytes)) {
         return false;
     }
-    hash(shared_key, 32);
     initNonce(fromNode, packetNum, extraNonceTmp);
 
     // Calculate the shared secret with the destination node and encrypt
@@ -279,10 +294,9 @@ bool CryptoEngine::decryptCurve25519(uint32_t fromNode, meshtastic_NodeInfoLite_
     }
 
     // Calculate the shared secret with the sending node and decrypt
-    if (!setDHPublicKey(remotePublic.bytes)) {
+    if (!deriveSharedKey(remotePublic.bytes)) {
         return false;
     }
-    hash(shared_key, 32);
 
     initNonce(fromNode, packetNum, extraNonce);
     printBytes("Attempt decrypt with nonce: ", nonce, 13);
@@ -292,6 +306,8 @@ bool CryptoEngine::decryptCurve25519(uint32_t fromNode, meshtastic_NodeInfoLite_
 
 void CryptoEngine::setDHPrivateKey(uint8_t *_private_key)
 {
+    if (memcmp(private_key, _private_key, 32) != 0)
+        flushSharedKeyCache();
     memcpy(private_key, _private_key, 32);
 }
 
@@ -345,6 +361,36 @@ bool CryptoEngine::setDHPublicKey(uint8_t *pubKey)
     return true;
 }
 
+bool CryptoEngine::deriveSharedKey(uint8_t *remotePublic)
+{
+    SharedKeyCacheEntry *victim = &sharedKeyCache[0];
+    for (SharedKeyCacheEntry &e : sharedKeyCache) {
+        if (e.lastUsed && memcmp(e.remotePublic, remotePublic, 32) == 0) {
+            e.lastUsed = ++sharedKeyCacheClock;
+            memcpy(shared_key, e.sharedKey, 32);
+            return true;
+        }
+        if (e.lastUsed < victim->lastUsed)
+            victim = &e;
+    }
+
+    // Miss: do the scalar multiplication, then replace the least recently used peer. Failed (weak key) results are not cached.
+    if (!setDHPublicKey(remotePublic))
+        return false;
+    hash(shared_key, 32);
+    meshtastic_security::secure_zero(victim, sizeof(*victim));
+    memcpy(victim->remotePublic, remotePublic, 32);
+    memcpy(victim->sharedKey, shared_key, 32);
+    victim->lastUsed = ++sharedKeyCacheClock;
+    return true;
+}
+
+void CryptoEngine::flushSharedKeyCache()
+{
+    meshtastic_security::secure_zero(sharedKeyCache, sizeof(sharedKeyCache));
+    sharedKeyCacheClock = 0;
+}
+
 void CryptoEngine::setPendingPublicKey(uint32_t node, const uint8_t *key)
 {
     concurrency::LockGuard g(&pendingKeyLock);
@@ -378,6 +424,11 @@ void CryptoEngine::setKey(const CryptoKey &k)
 {
     LOG_DEBUG("Use AES%d key!", k.length * 8);
     key = k;
+#ifndef HAS_CUSTOM_CRYPTO_ENGINE
+    // Channels sets the key right before each encrypt/decrypt: build (or find) its schedule now
+    if (k.length > 0)
+        keyScheduleFor(k);
+#endif
 }
 
 /**
@@ -403,23 +454,70 @@ void CryptoEngine::decrypt(uint32_t fromNode, uint64_t packetId, size_t numBytes
     encryptPacket(fromNode, packetId, numBytes, bytes);
 }
 
-// Generic implementation of AES-CTR encryption.
-void CryptoEngine::encryptAESCtr(CryptoKey _key, uint8_t *_nonce, size_t numBytes, uint8_t *bytes)
+CryptoEngine::AesKeySchedule &CryptoEngine::keyScheduleFor(const CryptoKey &k)
 {
-    std::unique_ptr<CTRCommon> ctr;
-    if (_key.length == 16)
-        ctr = std::unique_ptr<CTRCommon>(new CTR<AES128>());
-    else
-        ctr = std::unique_ptr<CTRCommon>(new CTR<AES256>());
-    ctr->setKey(_key.bytes, _key.length);
-    static uint8_t scratch[MAX_BLOCKSIZE];
-    memcpy(scratch, bytes, numBytes);
-    memset(scratch + numBytes, 0,
-           sizeof(scratch) - numBytes); // Fill rest of buffer with zero (in case cypher looks at it)
-
-    ctr->setIV(_nonce, 16);
-    ctr->setCounterSize(4);
-    ctr->encrypt(bytes, scratch, numBytes);
+    auto matches = [&k](const AesKeySchedule &ks) {
+        return ks.key.length == k.length && memcmp(ks.key.bytes, k.bytes, k.length) == 0;
+    };
+    if (matches(keySchedules[lastKeySchedule]))
+        return keySchedules[lastKeySchedule];
+    for (uint8_t i = 0; i < AES_KEY_CACHE_SIZE; i++) {
+        if (matches(keySchedules[i])) {
+            lastKeySchedule = i;
+            return keySchedules[i];
+        }
+    }
+
+    lastKeySchedule = nextKeyScheduleVictim;
+    nextKeyScheduleVictim = (nextKeyScheduleVictim + 1) % AES_KEY_CACHE_SIZE;
+    AesKeySchedule &ks = keySchedules[lastKeySchedule];
+    ks.key = k;
+#if HAS_AES_CTR_ACCEL
+    if (aesCtrAccelAvailable()) {
+        aesCtrAccelExpandKey(ks.roundKeys, k.bytes, k.length == 16 ? 16 : 32);
+        return ks;
+    }
+#endif
+    // Reuse the evicted cipher when the key size matches, otherwise let its destructor wipe it
+    if (ks.cipher && ks.cipher->keySize() != (size_t)(k.length == 16 ? 16 : 32))
+        ks.cipher.reset();
+    if (!ks.cipher) {
+        if (k.length == 16)
+            ks.cipher.reset(new AES128());
+        else
+            ks.cipher.reset(new AES256());
+    }
+    ks.cipher->setKey(k.bytes, k.length);
+    return ks;
+}
+
+// Generic implementation of AES-CTR encryption: keystream is generated a whole block at a time from the cached schedule,
+// with the last four nonce bytes as a big-endian block counter (matching CTR<> with setCounterSize(4)).
+void CryptoEngine::encryptAESCtr(const CryptoKey &_key, uint8_t *_nonce, size_t numBytes, uint8_t *bytes)
+{
+    if (_key.length <= 0)
+        return;
+    AesKeySchedule &ks = keyScheduleFor(_key);
+#if HAS_AES_CTR_ACCEL
+    if (aesCtrAccelAvailable()) {
+        aesCtrAccelCrypt(ks.roundKeys, _nonce, bytes, numBytes);
+        return;
+    }
+#endif
+    uint8_t counter[16];
+    uint8_t stream[16];
+    memcpy(counter, _nonce, sizeof(counter));
+    while (numBytes > 0) {
+        ks.cipher->encryptBlock(stream, counter);
+        const size_t n = numBytes < sizeof(stream) ? numBytes : sizeof(stream);
+        for (size_t i = 0; i < n; i++)
+            bytes[i] ^= stream[i];
+        bytes += n;
+        numBytes -= n;
+        for (int i = 15; i >= 12; i--)
+            if (++counter[i] != 0)
+                break;
+    }
 }
 
 /**
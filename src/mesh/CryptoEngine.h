@@ -1,6 +1,7 @@
 #pragma once
 #include "AES.h"
 #include "CTR.h"
+#include "aes-ctr.h"
 #include "concurrency/LockGuard.h"
 #include "configuration.h"
 #include "mesh-pb-constants.h"
@@ -22,6 +23,30 @@ struct CryptoKey {
  */
 
 #define MAX_BLOCKSIZE 256
+
+// Signers whose Ed25519 form of the public key is kept, so signed traffic from many nodes skips curve_to_ed_pub's inversion
+#ifndef XEDDSA_KEY_CACHE_SIZE
+#ifdef ARCH_PORTDUINO
+#define XEDDSA_KEY_CACHE_SIZE 32
+#else
+#define XEDDSA_KEY_CACHE_SIZE 8
+#endif
+#endif
+
+// Peers whose derived PKI shared key is kept, so repeat DMs skip the X25519 scalar multiplication
+#ifndef PKI_SHARED_KEY_CACHE_SIZE
+#define PKI_SHARED_KEY_CACHE_SIZE 4
+#endif
+
+// Channel keys whose AES key schedule CryptoEngine keeps prebuilt. perhapsDecode tries every channel for each packet, so
+// portduino caches them all; small targets keep the primary plus one more.
+#ifndef AES_KEY_CACHE_SIZE
+#ifdef ARCH_PORTDUINO
+#define AES_KEY_CACHE_SIZE MAX_NUM_CHANNELS
+#else
+#define AES_KEY_CACHE_SIZE 2
+#endif
+#endif
 #define TEST_CURVE25519_FIELD_OPS // Exposes Curve25519::isWeakPoint() for testing keys
 #define XEDDSA_SIGNATURE_SIZE 64
 // Encoded size the signature adds to the Data protobuf: 1 tag byte (field 10 < 16) +
@@ -95,16 +120,45 @@ class CryptoEngine
      */
     virtual void encryptPacket(uint32_t fromNode, uint64_t packetId, size_t numBytes, uint8_t *bytes);
     virtual void decrypt(uint32_t fromNode, uint64_t packetId, size_t numBytes, uint8_t *bytes);
-    virtual void encryptAESCtr(CryptoKey key, uint8_t *nonce, size_t numBytes, uint8_t *bytes);
+    virtual void encryptAESCtr(const CryptoKey &key, uint8_t *nonce, size_t numBytes, uint8_t *bytes);
 #ifndef PIO_UNIT_TESTING
   protected:
 #endif
     /** Our per packet nonce */
     uint8_t nonce[16] = {0};
     CryptoKey key = {};
+
+    /** A key schedule built once per channel key, so per-packet AES-CTR skips the key expansion */
+    struct AesKeySchedule {
+        CryptoKey key = {{0}, -1};
+        std::unique_ptr<BlockCipher> cipher; ///< rweather AES128/AES256, unused when hardware AES is available
+#if HAS_AES_CTR_ACCEL
+        AesRoundKeys roundKeys;
+#endif
+    };
+    AesKeySchedule keySchedules[AES_KEY_CACHE_SIZE];
+    uint8_t lastKeySchedule = 0;
+    uint8_t nextKeyScheduleVictim = 0;
+
+    /** @return the cached schedule for `k`, building it over the oldest entry on a miss */
+    AesKeySchedule &keyScheduleFor(const CryptoKey &k);
 #if !(MESHTASTIC_EXCLUDE_PKI)
     uint8_t shared_key[32] = {0};
     uint8_t private_key[32] = {0};
+
+    /** SHA256 of the X25519 secret with one peer; lastUsed == 0 marks an empty slot */
+    struct SharedKeyCacheEntry {
+        uint8_t remotePublic[32];
+        uint8_t sharedKey[32];
+        uint32_t lastUsed;
+    };
+    SharedKeyCacheEntry sharedKeyCache[PKI_SHARED_KEY_CACHE_SIZE] = {};
+    uint32_t sharedKeyCacheClock = 0;
+
+    /** Set shared_key to the hashed DH secret with `remotePublic`, reusing a cached one when we have it (LRU) */
+    bool deriveSharedKey(uint8_t *remotePublic);
+    /** Wipe all cached shared keys, called whenever private_key changes */
+    void flushSharedKeyCache();
     uint32_t pendingKeyVerificationNode = 0;
     uint8_t pendingKeyVerificationPublicKey[32] = {0};
     bool hasPendingKeyVerificationKey = false;
@@ -113,9 +167,16 @@ class CryptoEngine
     uint8_t xeddsa_public_key[32] = {0};
     uint8_t xeddsa_private_key[32] = {0};
     void curve_to_ed_pub(const uint8_t *curve_pubkey, uint8_t *ed_pubkey);
-    // Single-entry cache for curve_to_ed_pub conversion (avoids expensive field inversion per packet)
-    uint8_t cached_curve_pubkey[32] = {0};
-    uint8_t cached_ed_pubkey[32] = {0};
+    // LRU cache of curve_to_ed_pub conversions (avoids an expensive field inversion per packet); lastUsed == 0 is empty
+    struct EdKeyCacheEntry {
+        uint8_t curvePubkey[32];
+        uint8_t edPubkey[32];
+        uint32_t lastUsed;
+    };
+    EdKeyCacheEntry edKeyCache[XEDDSA_KEY_CACHE_SIZE] = {};
+    uint32_t edKeyCacheClock = 0;
+    /** @return the Ed25519 public key for `curvePubkey`, converting (and caching) it on a miss */
+    const uint8_t *edPubkeyFor(const uint8_t *curvePubkey);
 #endif
 #endif
     /**
@@ -8,6 +8,9 @@
 #include <assert.h>
 
 std::vector<MeshModule *> *MeshModule::modules;
+std::vector<MeshModule::PortRoute> *MeshModule::portRoutes;
+std::vector<uint16_t> *MeshModule::fallbackRoutes;
+bool MeshModule::routesDirty = true;
 
 const meshtastic_MeshPacket *MeshModule::currentRequest;
 uint8_t MeshModule::numPeriodicModules = 0;
@@ -25,6 +28,7 @@ MeshModule::MeshModule(const char *_name, meshtastic_PortNum _ourPortNum) : name
         modules = new std::vector<MeshModule *>();
 
     modules->push_back(this);
+    routesDirty = true;
 }
 
 bool MeshModule::replyPortMatches(meshtastic_PortNum modulePort, const meshtastic_MeshPacket &mp)
@@ -40,6 +44,33 @@ MeshModule::~MeshModule()
     auto it = std::find(modules->begin(), modules->end(), this);
     assert(it != modules->end());
     modules->erase(it);
+    routesDirty = true;
+}
+
+/// Build the port -> modules table from dispatchPort(). Done lazily on the first packet after a (un)registration, because
+/// subclass constructors may still set ourPortNum or encryptedOk after MeshModule's constructor has run.
+void MeshModule::rebuildDispatchRoutes()
+{
+    if (!portRoutes) {
+        portRoutes = new std::vector<PortRoute>();
+        fallbackRoutes = new std::vector<uint16_t>();
+    }
+    portRoutes->clear();
+    fallbackRoutes->clear();
+
+    for (size_t i = 0; i < modules->size(); i++) {
+        const MeshModule &pi = *(*modules)[i];
+        const meshtastic_PortNum port = pi.dispatchPort();
+        // Encrypted packets carry no portnum, so encryptedOk modules must be offered everything
+        if (port == meshtastic_PortNum_UNKNOWN_APP || pi.encryptedOk)
+            fallbackRoutes->push_back(static_cast<uint16_t>(i));
+        else
+            portRoutes->push_back({static_cast<uint16_t>(port), static_cast<uint16_t>(i)});
+    }
+    std::sort(portRoutes->begin(), portRoutes->end());
+    routesDirty = false;
+
+    LOG_DEBUG("Module dispatch: %u port-routed, %u always asked", (unsigned)portRoutes->size(), (unsigned)fallbackRoutes->size());
 }
 
 // ⚠️ **Only call once** to set the initial delay before a module starts broadcasting periodically
@@ -109,14 +140,41 @@ void MeshModule::callModules(meshtastic_MeshPacket &mp, RxSource src)
     auto ourNodeNum = nodeDB->getNodeNum();
     bool toUs = isBroadcast(mp.to) || isToUs(&mp);
 
-    for (auto i = modules->begin(); i != modules->end(); ++i) {
-        auto &pi = **i;
+    if (routesDirty)
+        rebuildDispatchRoutes();
+
+    // Candidates are the modules routed to this packet's port plus the always-asked fallback list, merged back into
+    // registration order (which is also handling order: a STOP must still cut off every later module).
+    size_t route = 0, routeEnd = 0;
+    if (isDecoded) {
+        const uint16_t port = static_cast<uint16_t>(mp.decoded.portnum);
+        route = std::lower_bound(portRoutes->begin(), portRoutes->end(), port,
+                                 [](const PortRoute &r, uint16_t p) { return r.port < p; }) -
+                portRoutes->begin();
+        routeEnd = std::upper_bound(portRoutes->begin() + route, portRoutes->end(), port,
+                                    [](uint16_t p, const PortRoute &r) { return p < r.port; }) -
+                   portRoutes->begin();
+    }
+    size_t fallback = 0;
+    const size_t fallbackEnd = fallbackRoutes->size();
+
+    while (route < routeEnd || fallback < fallbackEnd) {
+        uint16_t order;
+        if (fallback >= fallbackEnd || (route < routeEnd && (*portRoutes)[route].order < (*fallbackRoutes)[fallback]))
+            order = (*portRoutes)[route++].order;
+        else
+            order = (*fallbackRoutes)[fallback++];
+        auto &pi = *(*modules)[order];
 
         pi.currentRequest = &mp;
         pi.ignoreRequest = false;
 
         /// We only call modules that are interested in the packet (and the message is destined to us or we are promiscious)
-        bool wantsPacket = (isDecoded || pi.encryptedOk) && (pi.isPromiscuous || toUs) && pi.wantPacket(&mp);
+        bool wantsPacket = false;
+        if ((isDecoded || pi.encryptedOk) && (pi.isPromiscuous || toUs)) {
+            pi.dispatchStats.offered++;
+            wantsPacket = pi.wantPacket(&mp);
+        }
 
         if ((src == RX_SRC_LOCAL) && !(pi.loopbackOk)) {
             // new case, monitor separately for now, then FIXME merge above
@@ -151,6 +209,7 @@ void MeshModule::callModules(meshtastic_MeshPacket &mp, RxSource src)
                 } else
                     printPacket("packet on wrong channel, but can't respond", &mp);
             } else {
+                pi.dispatchStats.handled++;
                 ProcessMessage handled = pi.handleReceived(mp);
 
                 pi.alterReceived(mp);
@@ -65,6 +65,12 @@ class MeshModule
     static std::vector<MeshModule *> *modules;
 
   public:
+    /// Per-module callModules() counters: packets offered to wantPacket(), and packets handed to handleReceived().
+    struct DispatchStats {
+        uint32_t offered = 0;
+        uint32_t handled = 0;
+    };
+
     /** Constructor
      * name is for debugging output
      */
@@ -78,6 +84,10 @@ class MeshModule
      */
     static void callModules(meshtastic_MeshPacket &mp, RxSource src = RX_SRC_RADIO);
 
+    const char *getName() const { return name; }
+    const DispatchStats &getDispatchStats() const { return dispatchStats; }
+    void resetDispatchStats() { dispatchStats = DispatchStats(); }
+
     static std::vector<MeshModule *> GetMeshModulesWithUIFrames(int startIndex);
     static void observeUIEvents(Observer<const UIFrameEvent *> *observer);
     static AdminMessageHandleResult handleAdminMessageForAllModules(const meshtastic_MeshPacket &mp,
@@ -160,6 +170,13 @@ class MeshModule
      */
     virtual bool wantPacket(const meshtastic_MeshPacket *p) = 0;
 
+    /**
+     * The only portnum for which wantPacket() can return true, so callModules() need not ask this module about any other
+     * port. UNKNOWN_APP (the default) means "ask me about every packet". Read once, after construction: a module that
+     * returns a port must not change it later. Modules with encryptedOk are always asked, whatever they return here.
+     */
+    virtual meshtastic_PortNum dispatchPort() const { return meshtastic_PortNum_UNKNOWN_APP; }
+
     /** Called to handle a particular incoming message
 
     @return ProcessMessage::STOP if you've guaranteed you've handled this message and no other handlers should be considered for
@@ -223,6 +240,26 @@ class MeshModule
 #endif
 
   private:
+    DispatchStats dispatchStats;
+
+    /// One (port, registration index) pair per module with a dispatchPort(); sorted so equal_range() finds a port's
+    /// modules in registration order.
+    struct PortRoute {
+        uint16_t port;
+        uint16_t order;
+        bool operator<(const PortRoute &other) const
+        {
+            return port != other.port ? port < other.port : order < other.order;
+        }
+    };
+    static std::vector<PortRoute> *portRoutes;
+    /// Registration indexes of the modules asked about every packet (no dispatchPort(), or encryptedOk).
+    static std::vector<uint16_t> *fallbackRoutes;
+    /// Set whenever a module registers or unregisters; the tables are rebuilt by the next callModules().
+    static bool routesDirty;
+
+    static void rebuildDispatchRoutes();
+
     /**
      * If any of the current chain of modules has already sent a reply, it will be here.  This is useful to allow
      * the RoutingModule to avoid sending redundant acks
@@ -28,11 +28,137 @@ bool CompareMeshPacketFunc(const meshtastic_MeshPacket *p1, const meshtastic_Mes
     return (p1p != p2p) ? (p1p > p2p) : (!isFromUs(p1) && isFromUs(p2));
 }
 
-MeshPacketQueue::MeshPacketQueue(size_t _maxLen) : maxLen(_maxLen) {}
+/// First rank of the late transmit window
+static constexpr uint16_t LATE_RANK = 0x200;
+
+/// @return the ordering class of a packet: a lower rank is sent first, equal ranks in FIFO order. This is
+/// CompareMeshPacketFunc folded into one number and must stay in step with it.
+static uint16_t packetRank(const meshtastic_MeshPacket *p)
+{
+    uint32_t pri = getPriority(p);
+    if (pri > 0xFF)
+        pri = 0xFF;
+    return (p->tx_after ? LATE_RANK : 0) | ((0xFF - pri) << 1) | (isFromUs(p) ? 1 : 0);
+}
+
+MeshPacketQueue::MeshPacketQueue(size_t _maxLen) : maxLen(_maxLen)
+{
+    assert(maxLen < NONE);
+
+    entries.reset(new Entry[maxLen]);
+    for (size_t i = 0; i < maxLen; i++)
+        entries[i].next = (i + 1 < maxLen) ? (uint16_t)(i + 1) : NONE;
+    freeHead = maxLen ? 0 : NONE;
+
+    // Load factor <= 0.5, like the PacketHistory index
+    size_t numBuckets = 1;
+    while (numBuckets < maxLen * 2)
+        numBuckets <<= 1;
+    buckets.reset(new uint16_t[numBuckets]);
+    std::fill(buckets.get(), buckets.get() + numBuckets, NONE);
+    bucketMask = (uint16_t)(numBuckets - 1);
+
+    fifos.reserve(4);
+}
+
+uint16_t MeshPacketQueue::bucketOf(NodeNum from, PacketId id) const
+{
+    uint32_t h = (from * 0x9E3779B9u) ^ id;
+    h ^= h >> 16;
+    return h & bucketMask;
+}
+
+size_t MeshPacketQueue::fifoIndex(uint16_t rank) const
+{
+    auto it = std::lower_bound(fifos.begin(), fifos.end(), rank, [](const RankFifo &f, uint16_t r) { return f.rank < r; });
+    return it - fifos.begin();
+}
+
+void MeshPacketQueue::insert(meshtastic_MeshPacket *p)
+{
+    uint16_t slot = freeHead;
+    assert(slot != NONE);
+    Entry &e = entries[slot];
+    freeHead = e.next;
+
+    e.packet = p;
+    e.seq = nextSeq++;
+    e.rank = packetRank(p);
+    e.next = NONE;
+
+    // Append to the FIFO of its rank, which keeps the stable order the sorted vector used to give us
+    size_t i = fifoIndex(e.rank);
+    if (i == fifos.size() || fifos[i].rank != e.rank) {
+        e.prev = NONE;
+        fifos.insert(fifos.begin() + i, RankFifo{e.rank, slot, slot});
+    } else {
+        RankFifo &f = fifos[i];
+        e.prev = f.tail;
+        entries[f.tail].next = slot;
+        f.tail = slot;
+    }
+
+    e.bucket = bucketOf(getFrom(p), p->id);
+    e.hashNext = buckets[e.bucket];
+    buckets[e.bucket] = slot;
+
+    count++;
+}
+
+meshtastic_MeshPacket *MeshPacketQueue::unlink(uint16_t slot)
+{
+    Entry &e = entries[slot];
+
+    size_t i = fifoIndex(e.rank);
+    assert(i < fifos.size() && fifos[i].rank == e.rank);
+    RankFifo &f = fifos[i];
+    if (e.prev != NONE)
+        entries[e.prev].next = e.next;
+    else
+        f.head = e.next;
+    if (e.next != NONE)
+        entries[e.next].prev = e.prev;
+    else
+        f.tail = e.prev;
+    if (f.head == NONE)
+        fifos.erase(fifos.begin() + i);
+
+    for (uint16_t *link = &buckets[e.bucket]; *link != NONE; link = &entries[*link].hashNext) {
+        if (*link == slot) {
+            *link = e.hashNext;
+            break;
+        }
+    }
+
+    auto *p = e.packet;
+    e.packet = NULL;
+    e.next = freeHead;
+    freeHead = slot;
+    count--;
+    return p;
+}
+
+uint16_t MeshPacketQueue::findSlot(NodeNum from, PacketId id, bool tx_normal, bool tx_late, uint8_t hop_limit_lt) const
+{
+    // Duplicates of one (from,id) can be queued (e.g. a normal and a late copy); pick the one nearest the front, as the old
+    // front-to-back scan did.
+    uint16_t best = NONE;
+    for (uint16_t slot = buckets[bucketOf(from, id)]; slot != NONE; slot = entries[slot].hashNext) {
+        const Entry &e = entries[slot];
+        auto p = e.packet;
+        if (getFrom(p) == from && p->id == id && ((tx_normal && !p->tx_after) || (tx_late && p->tx_after)) &&
+            (!hop_limit_lt || p->hop_limit < hop_limit_lt)) {
+            if (best == NONE || e.rank < entries[best].rank ||
+                (e.rank == entries[best].rank && (int32_t)(e.seq - entries[best].seq) < 0))
+                best = slot;
+        }
+    }
+    return best;
+}
 
 bool MeshPacketQueue::empty()
 {
-    return queue.empty();
+    return count == 0;
 }
 
 /**
@@ -68,7 +194,7 @@ void fixPriority(meshtastic_MeshPacket *p)
 bool MeshPacketQueue::enqueue(meshtastic_MeshPacket *p, bool *dropped)
 {
     // no space - try to replace a lower priority packet in the queue
-    if (queue.size() >= maxLen) {
+    if (count >= maxLen) {
         bool replaced = replaceLowerPriorityPacket(p);
         if (!replaced) {
             LOG_WARN("TX queue is full, and there is no lower-priority packet available to evict in favour of 0x%08x", p->id);
@@ -83,9 +209,7 @@ bool MeshPacketQueue::enqueue(meshtastic_MeshPacket *p, bool *dropped)
         *dropped = false;
     }
 
-    // Find the correct position using upper_bound to maintain a stable order
-    auto it = std::upper_bound(queue.begin(), queue.end(), p, CompareMeshPacketFunc);
-    queue.insert(it, p); // Insert packet at the found position
+    insert(p);
     return true;
 }
 
@@ -95,9 +219,7 @@ meshtastic_MeshPacket *MeshPacketQueue::dequeue()
         return NULL;
     }
 
-    auto *p = queue.front();
-    queue.erase(queue.begin()); // Remove the highest-priority packet
-    return p;
+    return unlink(fifos.front().head); // Remove the highest-priority packet
 }
 
 meshtastic_MeshPacket *MeshPacketQueue::getFront()
@@ -106,36 +228,21 @@ meshtastic_MeshPacket *MeshPacketQueue::getFront()
         return NULL;
     }
 
-    auto *p = queue.front();
-    return p;
+    return entries[fifos.front().head].packet;
 }
 
 /** Get a packet from this queue. Returns a pointer to the packet, or NULL if not found. */
 meshtastic_MeshPacket *MeshPacketQueue::getPacketFromQueue(NodeNum from, PacketId id)
 {
-    for (auto it = queue.begin(); it != queue.end(); it++) {
-        auto p = (*it);
-        if (getFrom(p) == from && p->id == id) {
-            return p;
-        }
-    }
-
-    return NULL;
+    uint16_t slot = findSlot(from, id);
+    return slot != NONE ? entries[slot].packet : NULL;
 }
 
 /** Attempt to find and remove a packet from this queue.  Returns a pointer to the removed packet, or NULL if not found */
 meshtastic_MeshPacket *MeshPacketQueue::remove(NodeNum from, PacketId id, bool tx_normal, bool tx_late, uint8_t hop_limit_lt)
 {
-    for (auto it = queue.begin(); it != queue.end(); it++) {
-        auto p = (*it);
-        if (getFrom(p) == from && p->id == id && ((tx_normal && !p->tx_after) || (tx_late && p->tx_after)) &&
-            (!hop_limit_lt || p->hop_limit < hop_limit_lt)) {
-            queue.erase(it);
-            return p;
-        }
-    }
-
-    return NULL;
+    uint16_t slot = findSlot(from, id, tx_normal, tx_late, hop_limit_lt);
+    return slot != NONE ? unlink(slot) : NULL;
 }
 
 /* Attempt to find a packet from this queue. Return true if it was found. */
@@ -151,16 +258,17 @@ bool MeshPacketQueue::find(const NodeNum from, const PacketId id)
 bool MeshPacketQueue::replaceLowerPriorityPacket(meshtastic_MeshPacket *p)
 {
 
-    if (queue.empty()) {
+    if (empty()) {
         return false; // No packets to replace
     }
 
     // Check if the packet at the back has a lower priority than the new packet
-    auto *backPacket = queue.back();
+    uint16_t backSlot = fifos.back().tail;
+    auto *backPacket = entries[backSlot].packet;
     if (!backPacket->tx_after && backPacket->priority < p->priority) {
         LOG_WARN("Dropping packet 0x%08x to make room in the TX queue for higher-priority packet 0x%08x", backPacket->id, p->id);
         // Remove the back packet
-        queue.pop_back();
+        unlink(backSlot);
         packetPool.release(backPacket);
         // Insert the new packet in the correct order
         enqueue(p);
@@ -168,19 +276,21 @@ bool MeshPacketQueue::replaceLowerPriorityPacket(meshtastic_MeshPacket *p)
     }
 
     if (backPacket->tx_after) {
-        // Check if there's a non-late packet with lower priority
-        auto it = queue.end();
-        auto refPacket = *--it;
-        for (; refPacket->tx_after && it != queue.begin(); refPacket = *--it)
-            ;
-        if (!refPacket->tx_after && refPacket->priority < p->priority) {
-            LOG_WARN("Dropping non-late packet 0x%08x to make room in the TX queue for higher-priority packet 0x%08x",
-                     refPacket->id, p->id);
-            queue.erase(it);
-            packetPool.release(refPacket);
-            // Insert the new packet in the correct order
-            enqueue(p);
-            return true;
+        // Check if there's a non-late packet with lower priority: the last one is the tail of the last FIFO ranked
+        // before the late window
+        size_t lateIndex = fifoIndex(LATE_RANK);
+        if (lateIndex > 0) {
+            uint16_t refSlot = fifos[lateIndex - 1].tail;
+            auto *refPacket = entries[refSlot].packet;
+            if (!refPacket->tx_after && refPacket->priority < p->priority) {
+                LOG_WARN("Dropping non-late packet 0x%08x to make room in the TX queue for higher-priority packet 0x%08x",
+                         refPacket->id, p->id);
+                unlink(refSlot);
+                packetPool.release(refPacket);
+                // Insert the new packet in the correct order
+                enqueue(p);
+                return true;
+            }
         }
     }
 
@@ -199,7 +309,7 @@ bool MeshPacketQueue::replaceLowerPriorityPacket(meshtastic_MeshPacket *p)
                          "with no TX delay",
                          backPacket->id, dt, p->id);
             }
-            queue.pop_back();
+            unlink(backSlot);
             packetPool.release(backPacket);
             // Insert the new packet in the correct order
             enqueue(p);
@@ -2,20 +2,67 @@
 
 #include "MeshTypes.h"
 
-#include <queue>
+#include <memory>
+#include <vector>
+
+/// @return "true" if "p1" is ordered before "p2" (packets that compare equal keep their insertion order)
+bool CompareMeshPacketFunc(const meshtastic_MeshPacket *p1, const meshtastic_MeshPacket *p2);
 
 /**
  * A priority queue of packets
+ *
+ * Packets are kept in one FIFO per ordering class of CompareMeshPacketFunc (late window, priority, from us), and the
+ * non-empty FIFOs are kept sorted, so both ends of the queue are O(1) and insertion keeps the stable order. All entries
+ * live in a slab allocated once at construction, and a (from,id) hash index lets remove() and find() skip the scan.
  */
 class MeshPacketQueue
 {
+    static constexpr uint16_t NONE = 0xFFFF;
+
+    struct Entry {
+        meshtastic_MeshPacket *packet;
+        uint32_t seq;      ///< insertion order, breaks ties between equal (from,id) matches
+        uint16_t rank;     ///< ordering class, see packetRank()
+        uint16_t prev;     ///< neighbours within the rank FIFO (or free list via `next`)
+        uint16_t next;
+        uint16_t bucket;   ///< hash bucket this entry is chained into
+        uint16_t hashNext; ///< next entry in the same bucket
+    };
+
+    /** The packets of one ordering class, oldest at `head` */
+    struct RankFifo {
+        uint16_t rank;
+        uint16_t head;
+        uint16_t tail;
+    };
+
     size_t maxLen;
-    std::vector<meshtastic_MeshPacket *> queue;
+    size_t count = 0;
+    uint32_t nextSeq = 0;
+    std::unique_ptr<Entry[]> entries;
+    uint16_t freeHead = NONE;
+    std::vector<RankFifo> fifos; ///< non-empty FIFOs, sorted by rank (front of the queue first)
+    std::unique_ptr<uint16_t[]> buckets;
+    uint16_t bucketMask = 0;
 
     /** Replace a lower priority package in the queue with 'mp' (provided there are lower pri packages). Return true if replaced.
      */
     bool replaceLowerPriorityPacket(meshtastic_MeshPacket *mp);
 
+    /** Link p into its FIFO and the hash index. The caller guarantees there is room. */
+    void insert(meshtastic_MeshPacket *p);
+
+    /** Unlink the entry in `slot` and return its packet */
+    meshtastic_MeshPacket *unlink(uint16_t slot);
+
+    /** @return the position in `fifos` of the FIFO for `rank` (or where it would be inserted) */
+    size_t fifoIndex(uint16_t rank) const;
+
+    uint16_t bucketOf(NodeNum from, PacketId id) const;
+
+    /** @return the slot of the earliest queued packet matching (from,id) and the remove() filters, or NONE */
+    uint16_t findSlot(NodeNum from, PacketId id, bool tx_normal = true, bool tx_late = true, uint8_t hop_limit_lt = 0) const;
+
   public:
     explicit MeshPacketQueue(size_t _maxLen);
 
@@ -28,7 +75,7 @@ class MeshPacketQueue
     bool empty();
 
     /** return amount of free packets in Queue */
-    size_t getFree() { return maxLen - queue.size(); }
+    size_t getFree() { return maxLen - count; }
 
     /** return total size of the Queue */
     size_t getMaxLen() { return maxLen; }
@@ -46,4 +93,4 @@ class MeshPacketQueue
 
     /* Attempt to find a packet from this queue. Return true if it was found. */
     bool find(const NodeNum from, const PacketId id);
-};
\ No newline at end of file
+};
@@ -12,6 +12,7 @@
 #include "Power.h"
 #include "PowerFSM.h"
 #include "TypeConversions.h"
+#include "concurrency/LockGuard.h"
 #include "gps/RTC.h"
 #include "graphics/draw/MessageRenderer.h"
 #include "main.h"
@@ -21,6 +22,7 @@
 #include "modules/NodeInfoModule.h"
 #include "modules/PositionModule.h"
 #include "modules/RoutingModule.h"
+#include <algorithm>
 #include <assert.h>
 #include <string>
 
@@ -67,10 +69,17 @@ Allocator<meshtastic_QueueStatus> &queueStatusPool = staticQueueStatusPool;
 #include "PositionPrecision.h"
 #include "Router.h"
 
+static void releaseFanoutPacket(meshtastic_MeshPacket *p)
+{
+    packetPool.release(p);
+}
+
 MeshService::MeshService()
 #ifdef ARCH_PORTDUINO
-    : toPhoneQueue(MAX_RX_TOPHONE), toPhoneQueueStatusQueue(MAX_RX_QUEUESTATUS_TOPHONE),
+    : toPhoneQueue(MAX_RX_TOPHONE), phoneFanout(releaseFanoutPacket), toPhoneQueueStatusQueue(MAX_RX_QUEUESTATUS_TOPHONE),
       toPhoneMqttProxyQueue(MAX_RX_MQTTPROXY_TOPHONE), toPhoneClientNotificationQueue(MAX_RX_NOTIFICATION_TOPHONE)
+#else
+    : phoneFanout(releaseFanoutPacket)
 #endif
 {
     lastQueueStatus = {0, 0, 16, 0};
@@ -164,18 +173,59 @@ void MeshService::reloadOwner(bool shouldSave)
     }
 }
 
+uint8_t MeshService::toPhoneRetention(const meshtastic_MeshPacket *p)
+{
+    if (p->which_payload_variant != meshtastic_MeshPacket_decoded_tag)
+        return 0;
+    switch (p->decoded.portnum) {
+    case meshtastic_PortNum_ADMIN_APP:
+    case meshtastic_PortNum_TEXT_MESSAGE_COMPRESSED_APP:
+        return 2;
+    case meshtastic_PortNum_POSITION_APP:
+    case meshtastic_PortNum_TELEMETRY_APP:
+    case meshtastic_PortNum_NODEINFO_APP:
+    case meshtastic_PortNum_NEIGHBORINFO_APP:
+        return 0;
+    default:
+        return isTextPayload(p) ? 2 : 1;
+    }
+}
+
+// One pass over the queue in place, oldest first: the first packet of the lowest retention class is the victim.
+// Only reached when the queue is full, under toPhoneLock.
+bool MeshService::makeRoomForPhone(uint8_t incomingRetention)
+{
+    int victim = -1;
+    uint8_t lowest = UINT8_MAX;
+    for (int i = 0; i < toPhoneQueue.numUsed() && lowest > 0; i++) {
+        const uint8_t retention = toPhoneRetention(toPhoneQueue.at(i));
+        if (retention < lowest) {
+            lowest = retention;
+            victim = i;
+        }
+    }
+    if (victim < 0 || lowest > incomingRetention)
+        return false;
+
+    meshtastic_MeshPacket *p = toPhoneQueue.removeAt(victim);
+    if (p->which_payload_variant == meshtastic_MeshPacket_decoded_tag)
+        LOG_WARN("ToPhone queue is full, discard oldest portnum=%d (retention %u)", p->decoded.portnum, (unsigned)lowest);
+    else
+        LOG_WARN("ToPhone queue is full, discard oldest encrypted packet from=0x%08x", (unsigned)p->from);
+    releaseToPool(p);
+    toPhoneDrops.evicted++;
+    return true;
+}
+
 // search the queue for a request id and return the matching nodenum
 NodeNum MeshService::getNodenumFromRequestId(uint32_t request_id)
 {
+    concurrency::LockGuard guard(&toPhoneLock);
     NodeNum nodenum = 0;
     for (int i = 0; i < toPhoneQueue.numUsed(); i++) {
-        meshtastic_MeshPacket *p = toPhoneQueue.dequeuePtr(0);
-        if (p->id == request_id) {
-            nodenum = p->to;
-            // make sure to continue this to make one full loop
-        }
-        // put it right back on the queue
-        toPhoneQueue.enqueue(p, 0);
+        const meshtastic_MeshPacket *p = toPhoneQueue.at(i);
+        if (p->id == request_id)
+            nodenum = p->to; // keep going, the newest match wins as before
     }
     return nodenum;
 }
@@ -304,6 +354,7 @@ ErrorCode MeshService::sendQueueStatusToPhone(const meshtastic_QueueStatus &qs,
     copied->res = res;
     copied->mesh_packet_id = mesh_packet_id;
 
+    concurrency::LockGuard guard(&toPhoneLock);
     if (toPhoneQueueStatusQueue.numFree() == 0) {
         LOG_INFO("tophone queue status queue is full, discard oldest");
         meshtastic_QueueStatus *d = toPhoneQueueStatusQueue.dequeuePtr(0);
@@ -434,7 +485,9 @@ void MeshService::sendToPhone(meshtastic_MeshPacket *p)
     // Withhold decoded nested payloads a strict phone decoder would reject; still-encrypted packets
     // pass through (the phone may hold the key).
     if (p->which_payload_variant == meshtastic_MeshPacket_decoded_tag && !phonePayloadIsDecodable(p->decoded)) {
-        LOG_WARN("Dropping undecodable portnum=%d payload from phone delivery (from=0x%08x)", p->decoded.portnum, p->from);
+        LOG_WARN("Dropping undecodable portnum=%d payload from phone delivery (from=0x%08x)", p->decoded.portnum,
+                 (unsigned)p->from);
+        toPhoneDrops.undecodable++;
         releaseToPool(p);
         fromNum++; // notify observers so the phone can resync
         return;
@@ -451,23 +504,21 @@ void MeshService::sendToPhone(meshtastic_MeshPacket *p)
 #endif
 #endif
 
-    if (toPhoneQueue.numFree() == 0) {
-        if (p->decoded.portnum == meshtastic_PortNum_TEXT_MESSAGE_APP ||
-            p->decoded.portnum == meshtastic_PortNum_RANGE_TEST_APP) {
-            LOG_WARN("ToPhone queue is full, discard oldest");
-            meshtastic_MeshPacket *d = toPhoneQueue.dequeuePtr(0);
-            if (d)
-                releaseToPool(d);
-        } else {
-            LOG_WARN("ToPhone queue is full, drop packet");
-            releaseToPool(p);
-            fromNum++; // Make sure to notify observers in case they are reconnected so they can get the packets
-            return;
-        }
+    concurrency::LockGuard guard(&toPhoneLock);
+    if (toPhoneQueue.numFree() == 0 && !makeRoomForPhone(toPhoneRetention(p))) {
+        if (p->which_payload_variant == meshtastic_MeshPacket_decoded_tag)
+            LOG_WARN("ToPhone queue is full of higher-retention packets, drop portnum=%d", p->decoded.portnum);
+        else
+            LOG_WARN("ToPhone queue is full of higher-retention packets, drop encrypted packet from=0x%08x", (unsigned)p->from);
+        toPhoneDrops.rejected++;
+        releaseToPool(p);
+        fromNum++; // Make sure to notify observers in case they are reconnected so they can get the packets
+        return;
     }
 
     if (toPhoneQueue.enqueue(p, 0) == false) {
         LOG_CRIT("Failed to queue a packet into toPhoneQueue!");
+        toPhoneDrops.enqueueFailed++;
         releaseToPool(p);
         fromNum++; // notify observers so phone can resync
         return;
@@ -478,6 +529,7 @@ void MeshService::sendToPhone(meshtastic_MeshPacket *p)
 void MeshService::sendMqttMessageToClientProxy(meshtastic_MqttClientProxyMessage *m)
 {
     LOG_DEBUG("Send mqtt message on topic '%s' to client for proxy", m->topic);
+    concurrency::LockGuard guard(&toPhoneLock);
     if (toPhoneMqttProxyQueue.numFree() == 0) {
         LOG_WARN("MqttClientProxyMessagePool queue is full, discard oldest");
         meshtastic_MqttClientProxyMessage *d = toPhoneMqttProxyQueue.dequeuePtr(0);
@@ -511,6 +563,7 @@ void MeshService::sendRoutingErrorResponse(meshtastic_Routing_Error error, const
 void MeshService::sendClientNotification(meshtastic_ClientNotification *n)
 {
     LOG_DEBUG("Send client notification to phone");
+    concurrency::LockGuard guard(&toPhoneLock);
     if (toPhoneClientNotificationQueue.numFree() == 0) {
         LOG_WARN("ClientNotification queue is full, discard oldest");
         meshtastic_ClientNotification *d = toPhoneClientNotificationQueue.dequeuePtr(0);
@@ -586,11 +639,82 @@ int MeshService::onGPSChanged(const meshtastic::GPSStatus *newStatus)
     return 0;
 }
 #endif
+meshtastic_MeshPacket *MeshService::getForPhone(const void *client)
+{
+    concurrency::LockGuard guard(&toPhoneLock);
+    // Clients are attached in PhoneAPI::handleStartConfig, which turns away any beyond MAX_PHONE_API_CLIENTS
+    return phoneFanout.peek(client, [this]() { return toPhoneQueue.dequeuePtr(0); });
+}
+
+void MeshService::releaseForPhone(const void *client, meshtastic_MeshPacket *p)
+{
+    if (!p)
+        return;
+    concurrency::LockGuard guard(&toPhoneLock);
+    if (!phoneFanout.done(client, p))
+        packetPool.release(p);
+}
+
+bool MeshService::attachPhoneClient(const void *client)
+{
+    concurrency::LockGuard guard(&toPhoneLock);
+    return phoneFanout.attach(client);
+}
+
+void MeshService::detachPhoneClient(const void *client)
+{
+    concurrency::LockGuard guard(&toPhoneLock);
+    phoneFanout.detach(client);
+}
+
+size_t MeshService::numPhoneClients()
+{
+    concurrency::LockGuard guard(&toPhoneLock);
+    return phoneFanout.numClients();
+}
+
+size_t MeshService::numPhoneFanoutBuffered()
+{
+    concurrency::LockGuard guard(&toPhoneLock);
+    return phoneFanout.numBuffered();
+}
+
+uint32_t MeshService::numPhoneFanoutSkipped()
+{
+    concurrency::LockGuard guard(&toPhoneLock);
+    return phoneFanout.getSkipped();
+}
+
 bool MeshService::isToPhoneQueueEmpty()
 {
+    concurrency::LockGuard guard(&toPhoneLock);
     return toPhoneQueue.isEmpty();
 }
 
+int MeshService::numToPhoneQueued()
+{
+    concurrency::LockGuard guard(&toPhoneLock);
+    return toPhoneQueue.numUsed();
+}
+
+meshtastic_QueueStatus *MeshService::getQueueStatusForPhone()
+{
+    concurrency::LockGuard guard(&toPhoneLock);
+    return toPhoneQueueStatusQueue.dequeuePtr(0);
+}
+
+meshtastic_MqttClientProxyMessage *MeshService::getMqttClientProxyMessageForPhone()
+{
+    concurrency::LockGuard guard(&toPhoneLock);
+    return toPhoneMqttProxyQueue.dequeuePtr(0);
+}
+
+meshtastic_ClientNotification *MeshService::getClientNotificationForPhone()
+{
+    concurrency::LockGuard guard(&toPhoneLock);
+    return toPhoneClientNotificationQueue.dequeuePtr(0);
+}
+
 uint32_t MeshService::GetTimeSinceMeshPacket(const meshtastic_MeshPacket *mp)
 {
     uint32_t now = getTime();
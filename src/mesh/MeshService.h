@@ -9,11 +9,13 @@
 #include "MeshRadio.h"
 #include "MeshTypes.h"
 #include "Observer.h"
+#include "PhoneFanout.h"
 #ifdef ARCH_PORTDUINO
 #include "PointerQueue.h"
 #else
 #include "StaticPointerQueue.h"
 #endif
+#include "concurrency/Lock.h"
 #include "mesh-pb-constants.h"
 #if defined(ARCH_PORTDUINO)
 #include "../platform/portduino/SimRadio.h"
@@ -38,16 +40,21 @@ class MeshService
     CallbackObserver<MeshService, const meshtastic::GPSStatus *> gpsObserver =
         CallbackObserver<MeshService, const meshtastic::GPSStatus *>(this, &MeshService::onGPSChanged);
 #endif
-    /// received packets waiting for the phone to process them
-    /// FIXME, change to a DropOldestQueue and keep a count of the number of dropped packets to ensure
-    /// we never hang because android hasn't been there in a while
+    /// received packets waiting for the phone to process them. Bounded drop-oldest (see sendToPhone): when full, the
+    /// oldest packet of the lowest retention class makes room, so a phone that was away gets the freshest traffic
+    /// and its text/admin packets last longest. Drops are counted in toPhoneDrops.
+    /// Both queue types support at()/removeAt(), so eviction takes a packet out of the middle in place.
     /// FIXME - save this to flash on deep sleep
 #ifdef ARCH_PORTDUINO
-    PointerQueue<meshtastic_MeshPacket> toPhoneQueue;
+    PointerQueue<meshtastic_MeshPacket> toPhoneQueue; // sized at runtime by MaxMessageQueue
 #else
     StaticPointerQueue<meshtastic_MeshPacket, MAX_RX_TOPHONE> toPhoneQueue;
 #endif
 
+    /// Every API client reads toPhoneQueue through its own cursor here, so concurrent clients (TCP sessions, BLE,
+    /// serial) all see each packet without per-client copies. Guarded by toPhoneLock, like the queue it pulls from.
+    PhoneFanout<meshtastic_MeshPacket, MAX_PHONE_FANOUT_PACKETS, MAX_PHONE_API_CLIENTS> phoneFanout;
+
     // keep list of QueueStatus packets to be send to the phone
 #ifdef ARCH_PORTDUINO
     PointerQueue<meshtastic_QueueStatus> toPhoneQueueStatusQueue;
@@ -69,9 +76,26 @@ class MeshService
     StaticPointerQueue<meshtastic_ClientNotification, MAX_RX_NOTIFICATION_TOPHONE> toPhoneClientNotificationQueue;
 #endif
 
+    /// Guards phoneFanout and the four to-phone queues above. They are filled (and drop their oldest entry when full) from the main
+    /// loop but drained by the API clients, and BLE reads from its own task (NimBLE, or the nRF52 authorize callback).
+    /// Neither queue type is safe across tasks on its own, so every enqueue, dequeue and in-place walk takes this lock.
+    concurrency::Lock toPhoneLock;
+
     // This holds the last QueueStatus send
     meshtastic_QueueStatus lastQueueStatus;
 
+  public:
+    /// Why packets bound for the phone never reached toPhoneQueue (see sendToPhone)
+    struct ToPhoneDropStats {
+        uint32_t evicted = 0;       // queue full: an older packet of equal or lower retention made room for a newer one
+        uint32_t rejected = 0;      // queue full of packets that outrank the incoming one, so it was dropped
+        uint32_t undecodable = 0;   // nested payload a strict phone decoder would reject
+        uint32_t enqueueFailed = 0; // enqueue failed even with room made (should not happen)
+    };
+
+  private:
+    ToPhoneDropStats toPhoneDrops;
+
     /// The current nonce for the newest packet which has been queued for the phone
     uint32_t fromNum = 0;
 
@@ -118,21 +142,44 @@ class MeshService
     /// Do idle processing (mostly processing messages which have been queued from the radio)
     void loop();
 
-    /// Return the next packet destined to the phone.  FIXME, somehow use fromNum to allow the phone to retry the
-    /// last few packets if needs to.
-    meshtastic_MeshPacket *getForPhone() { return toPhoneQueue.dequeuePtr(0); }
+    /// Return the next packet for API client `client` from the shared fan-out. The packet stays owned by MeshService
+    /// and valid until the client calls releaseForPhone().
+    meshtastic_MeshPacket *getForPhone(const void *client);
+
+    /// The client is done with a packet it got for the phone: fan-out packets advance its cursor, anything else (e.g.
+    /// Store & Forward replies) goes back to packetPool.
+    void releaseForPhone(const void *client, meshtastic_MeshPacket *p);
+
+    /// Give a connecting API client its fan-out cursor. @return false if MAX_PHONE_API_CLIENTS are already attached
+    bool attachPhoneClient(const void *client);
+
+    /// Drop the fan-out cursor of a closing API client.
+    void detachPhoneClient(const void *client);
+
+    size_t numPhoneClients();
+    size_t numPhoneFanoutBuffered();
+    uint32_t numPhoneFanoutSkipped();
+
+    /// Packets dropped on the way into toPhoneQueue, by reason
+    const ToPhoneDropStats &getToPhoneDropStats() const { return toPhoneDrops; }
+    int numToPhoneQueued();
+    int toPhoneQueueCapacity() const { return MAX_RX_TOPHONE; }
+
+    /// Retention class for toPhoneQueue eviction, higher is kept longer: 2 text and admin, 1 other decoded traffic,
+    /// 0 periodic position/telemetry/nodeinfo/neighborinfo broadcasts and still-encrypted packets.
+    static uint8_t toPhoneRetention(const meshtastic_MeshPacket *p);
 
     /// Allows the bluetooth handler to free packets after they have been sent
     void releaseToPool(meshtastic_MeshPacket *p) { packetPool.release(p); }
 
     /// Return the next QueueStatus packet destined to the phone.
-    meshtastic_QueueStatus *getQueueStatusForPhone() { return toPhoneQueueStatusQueue.dequeuePtr(0); }
+    meshtastic_QueueStatus *getQueueStatusForPhone();
 
     /// Return the next MqttClientProxyMessage packet destined to the phone.
-    meshtastic_MqttClientProxyMessage *getMqttClientProxyMessageForPhone() { return toPhoneMqttProxyQueue.dequeuePtr(0); }
+    meshtastic_MqttClientProxyMessage *getMqttClientProxyMessageForPhone();
 
     /// Return the next ClientNotification packet destined to the phone.
-    meshtastic_ClientNotification *getClientNotificationForPhone() { return toPhoneClientNotificationQueue.dequeuePtr(0); }
+    meshtastic_ClientNotification *getClientNotificationForPhone();
 
     // search the queue for a request id and return the matching nodenum
     NodeNum getNodenumFromRequestId(uint32_t request_id);
@@ -216,6 +263,10 @@ class MeshService
     /// Handle a packet that just arrived from the radio.  This method does _not_ free the provided packet.  If it
     /// needs to keep the packet around it makes a copy
     int handleFromRadio(const meshtastic_MeshPacket *p);
+
+    /// Full toPhoneQueue: evict the oldest packet of the lowest retention class queued, unless every queued packet
+    /// outranks `incomingRetention`. Caller holds toPhoneLock. @return true if a slot was freed
+    bool makeRoomForPhone(uint8_t incomingRetention);
     friend class RoutingModule;
 };
 
@@ -1,6 +1,7 @@
 #include "NextHopRouter.h"
 #include "MeshTypes.h"
 #include "meshUtils.h"
+#include <algorithm>
 #if !MESHTASTIC_EXCLUDE_TRACEROUTE
 #include "modules/TraceRouteModule.h"
 #endif
@@ -378,119 +379,159 @@ PendingPacket *NextHopRouter::startRetransmission(meshtastic_MeshPacket *p, uint
 int32_t NextHopRouter::doRetransmissions()
 {
     uint32_t now = millis();
-    int32_t d = INT32_MAX;
 
-    // FIXME, we should use a better datastructure rather than walking through this map.
-    // for(auto el: pending) {
-    for (auto it = pending.begin(), nextIt = it; it != pending.end(); it = nextIt) {
-        ++nextIt; // we use this odd pattern because we might be deleting it...
+    // Only the due packets (plus any stale heap entries in front of them) are touched. Each entry is popped before it
+    // is processed, because sending may start or stop other retransmissions and so push onto the heap.
+    while (!retransmitQueue.empty()) {
+        const RetransmitDeadline top = retransmitQueue.front();
+        auto it = pending.find(top.key);
+        if (it == pending.end() || it->second.nextTxMsec != top.nextTxMsec) {
+            popRetransmitDeadline(); // stopped or rescheduled since this entry was pushed
+            continue;
+        }
         auto &p = it->second;
-
-        bool stillValid = true; // assume we'll keep this record around
-
-        // FIXME, handle 51 day rolloever here!!!
-        if (p.nextTxMsec <= now) {
-            if (p.numRetransmissions == 0) {
-                if (isFromUs(p.packet)) {
-                    LOG_DEBUG("Reliable send failed, returning a nak for fr=0x%08x,to=0x%08x,id=0x%08x", p.packet->from,
-                              p.packet->to, p.packet->id);
-                    sendAckNak(meshtastic_Routing_Error_MAX_RETRANSMIT, getFrom(p.packet), p.packet->id, p.packet->channel);
-                }
-                // Note: we don't stop retransmission here, instead the Nak packet gets processed in sniffReceived
-                stopRetransmission(it->first);
-                stillValid = false; // just deleted it
-            } else {
-                LOG_DEBUG("Sending retransmission fr=0x%08x,to=0x%08x,id=0x%08x, tries left=%d", p.packet->from, p.packet->to,
-                          p.packet->id, p.numRetransmissions);
-
-                if (!isBroadcast(p.packet->to)) {
-                    if (p.numRetransmissions == 1) {
-                        // Last retransmission: this directed delivery went un-ACKed. Record the failure
-                        // (M3 - accumulates across DMs to age out a flapping/dead route) and reset
-                        // next_hop so the final try falls back to FloodingRouter.
-                        noteRouteFailure(p.packet->to);
+        if ((int32_t)(now - dueMsec(p)) < 0)
+            break; // earliest valid deadline is still in the future
+        popRetransmitDeadline();
+
+        if (p.numRetransmissions == 0) {
+            if (isFromUs(p.packet)) {
+                LOG_DEBUG("Reliable send failed, returning a nak for fr=0x%08x,to=0x%08x,id=0x%08x", p.packet->from,
+                          p.packet->to, p.packet->id);
+                sendAckNak(meshtastic_Routing_Error_MAX_RETRANSMIT, getFrom(p.packet), p.packet->id, p.packet->channel);
+            }
+            // Note: we don't stop retransmission here, instead the Nak packet gets processed in sniffReceived
+            stopRetransmission(top.key);
+        } else {
+            LOG_DEBUG("Sending retransmission fr=0x%08x,to=0x%08x,id=0x%08x, tries left=%d", p.packet->from, p.packet->to,
+                      p.packet->id, p.numRetransmissions);
+
+            if (!isBroadcast(p.packet->to)) {
+                if (p.numRetransmissions == 1) {
+                    // Last retransmission: this directed delivery went un-ACKed. Record the failure
+                    // (M3 - accumulates across DMs to age out a flapping/dead route) and reset
+                    // next_hop so the final try falls back to FloodingRouter.
+                    noteRouteFailure(p.packet->to);
+                    p.packet->next_hop = NO_NEXT_HOP_PREFERENCE;
+                    // Also reset it in the nodeDB
+                    meshtastic_NodeInfoLite *sentTo = nodeDB->getMeshNode(p.packet->to);
+                    if (sentTo) {
+                        LOG_INFO("Resetting next hop for packet with dest 0x%08x", p.packet->to);
+                        sentTo->next_hop = NO_NEXT_HOP_PREFERENCE;
+                    }
+#if HAS_TRAFFIC_MANAGEMENT
+                    if (trafficManagementModule) {
+                        trafficManagementModule->clearNextHop(p.packet->to);
+                    }
+#endif
+                    if (auto *copy = packetPool.allocCopy(*p.packet)) {
+                        if (FloodingRouter::send(copy) == ERRNO_SHOULD_RELEASE)
+                            packetPool.release(copy);
+                    }
+                } else {
+#if NEXTHOP_EARLY_FLOOD_ON_UNVERIFIED
+                    // M4 (gated): if the route isn't proven healthy, don't spend a second directed
+                    // attempt - start flooding one retry sooner to cut recovery latency. A verified
+                    // route (fresh, zero recent failures) keeps the unchanged directed-retry path so
+                    // the sparse-mesh happy path is untouched.
+                    RouteHealth *h = findRouteHealth(p.packet->to);
+                    bool verified = h && h->consecutiveFailures == 0 && !isRouteStale(*h, now);
+                    if (!verified) {
                         p.packet->next_hop = NO_NEXT_HOP_PREFERENCE;
-                        // Also reset it in the nodeDB
                         meshtastic_NodeInfoLite *sentTo = nodeDB->getMeshNode(p.packet->to);
-                        if (sentTo) {
-                            LOG_INFO("Resetting next hop for packet with dest 0x%08x", p.packet->to);
+                        if (sentTo)
                             sentTo->next_hop = NO_NEXT_HOP_PREFERENCE;
-                        }
-#if HAS_TRAFFIC_MANAGEMENT
-                        if (trafficManagementModule) {
-                            trafficManagementModule->clearNextHop(p.packet->to);
-                        }
-#endif
                         if (auto *copy = packetPool.allocCopy(*p.packet)) {
                             if (FloodingRouter::send(copy) == ERRNO_SHOULD_RELEASE)
                                 packetPool.release(copy);
                         }
                     } else {
-#if NEXTHOP_EARLY_FLOOD_ON_UNVERIFIED
-                        // M4 (gated): if the route isn't proven healthy, don't spend a second directed
-                        // attempt - start flooding one retry sooner to cut recovery latency. A verified
-                        // route (fresh, zero recent failures) keeps the unchanged directed-retry path so
-                        // the sparse-mesh happy path is untouched.
-                        RouteHealth *h = findRouteHealth(p.packet->to);
-                        bool verified = h && h->consecutiveFailures == 0 && !isRouteStale(*h, now);
-                        if (!verified) {
-                            p.packet->next_hop = NO_NEXT_HOP_PREFERENCE;
-                            meshtastic_NodeInfoLite *sentTo = nodeDB->getMeshNode(p.packet->to);
-                            if (sentTo)
-                                sentTo->next_hop = NO_NEXT_HOP_PREFERENCE;
-                            if (auto *copy = packetPool.allocCopy(*p.packet)) {
-                                if (FloodingRouter::send(copy) == ERRNO_SHOULD_RELEASE)
-                                    packetPool.release(copy);
-                            }
-                        } else {
-                            if (auto *copy = packetPool.allocCopy(*p.packet)) {
-                                if (NextHopRouter::send(copy) == ERRNO_SHOULD_RELEASE)
-                                    packetPool.release(copy);
-                            }
-                        }
-#else
                         if (auto *copy = packetPool.allocCopy(*p.packet)) {
                             if (NextHopRouter::send(copy) == ERRNO_SHOULD_RELEASE)
                                 packetPool.release(copy);
                         }
-#endif
                     }
-                } else {
-                    // Note: we call the superclass version because we don't want to have our version of send() add a new
-                    // retransmission record
+#else
                     if (auto *copy = packetPool.allocCopy(*p.packet)) {
-                        if (FloodingRouter::send(copy) == ERRNO_SHOULD_RELEASE)
+                        if (NextHopRouter::send(copy) == ERRNO_SHOULD_RELEASE)
                             packetPool.release(copy);
                     }
+#endif
+                }
+            } else {
+                // Note: we call the superclass version because we don't want to have our version of send() add a new
+                // retransmission record
+                if (auto *copy = packetPool.allocCopy(*p.packet)) {
+                    if (FloodingRouter::send(copy) == ERRNO_SHOULD_RELEASE)
+                        packetPool.release(copy);
                 }
-
-                // Queue again
-                --p.numRetransmissions;
-                setNextTx(&p);
             }
-        }
-
-        if (stillValid) {
-            // Update our desired sleep delay
-            int32_t t = p.nextTxMsec - now;
 
-            d = min(t, d);
+            // Queue again
+            --p.numRetransmissions;
+            setNextTx(&p);
         }
     }
 
-    return d;
+    if (retransmitQueue.empty())
+        return INT32_MAX;
+
+    // The loop above only stops on a valid entry, so the top is our next wakeup. Clamp at 0 in case sending above took
+    // long enough for it to become due.
+    int32_t d = (int32_t)(retransmitQueue.front().nextTxMsec + retransmitBias - now);
+    return d < 0 ? 0 : d;
 }
 
 void NextHopRouter::setNextTx(PendingPacket *pending)
 {
     assert(iface);
     auto d = iface->getRetransmissionMsec(pending->packet);
-    pending->nextTxMsec = millis() + d;
+    scheduleRetransmission(pending, millis() + d);
     LOG_DEBUG("Setting next retransmission in %u msecs: ", d);
     printPacket("", pending->packet);
     setReceivedMessage(); // Run ASAP, so we can figure out our correct sleep time
 }
 
+// Min-heap order on deadlines. Signed differences keep this correct across the 49.7-day millis() rollover.
+static bool retransmitDeadlineLater(const RetransmitDeadline &a, const RetransmitDeadline &b)
+{
+    return (int32_t)(a.nextTxMsec - b.nextTxMsec) > 0;
+}
+
+void NextHopRouter::scheduleRetransmission(PendingPacket *rec, uint32_t dueMsec)
+{
+    // Stale entries are normally shed as they reach the top; if they pile up (e.g. many ACKs for packets with long
+    // deadlines) rebuild from the live records so the heap stays proportional to `pending`.
+    if (retransmitQueue.size() >= 2 * pending.size() + 16) {
+        retransmitQueue.clear();
+        for (auto &el : pending)
+            retransmitQueue.emplace_back(el.second.nextTxMsec, el.first);
+        std::make_heap(retransmitQueue.begin(), retransmitQueue.end(), retransmitDeadlineLater);
+    }
+
+    rec->nextTxMsec = dueMsec - retransmitBias;
+    retransmitQueue.emplace_back(rec->nextTxMsec, GlobalPacketId(rec->packet));
+    std::push_heap(retransmitQueue.begin(), retransmitQueue.end(), retransmitDeadlineLater);
+}
+
+void NextHopRouter::popRetransmitDeadline()
+{
+    std::pop_heap(retransmitQueue.begin(), retransmitQueue.end(), retransmitDeadlineLater);
+    retransmitQueue.pop_back();
+}
+
+void NextHopRouter::delayRetransmissions(uint32_t msec, const GlobalPacketId *except)
+{
+    // Shifting every deadline by the same amount leaves the heap order intact, so it is just a change of bias
+    retransmitBias += msec;
+
+    if (except) {
+        PendingPacket *p = findPendingPacket(*except);
+        if (p)
+            scheduleRetransmission(p, dueMsec(*p) - msec);
+    }
+}
+
 // ---------------------------------------------------------------------------
 // M3: RAM route-health table. Bounded array with reuse-oldest eviction (same discipline as
 // PacketHistory). All age comparisons use unsigned subtraction so they survive the 49.7-day millis()
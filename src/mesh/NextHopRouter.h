@@ -3,6 +3,7 @@
 #include "FloodingRouter.h"
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 /**
  * An identifier for a globally unique message - a pair of the sending nodenum and the packet id assigned
@@ -33,7 +34,8 @@ struct GlobalPacketId {
 struct PendingPacket {
     meshtastic_MeshPacket *packet;
 
-    /** The next time we should try to retransmit this packet */
+    /** The next time we should try to retransmit this packet, minus NextHopRouter::retransmitBias (so a uniform airtime
+     * delay of every pending packet is a single addition). Use NextHopRouter::dueMsec() for the real millis() value. */
     uint32_t nextTxMsec = 0;
 
     /** Starts at NUM_RETRANSMISSIONS -1 and counts down.  Once zero it will be removed from the list */
@@ -43,6 +45,17 @@ struct PendingPacket {
     explicit PendingPacket(meshtastic_MeshPacket *p, uint8_t numRetransmissions);
 };
 
+/**
+ * An entry in NextHopRouter's deadline heap. Entries are never removed in place: when a retransmission is stopped or
+ * rescheduled the old entry stays behind and is discarded once it reaches the top and no longer matches the pending record.
+ */
+struct RetransmitDeadline {
+    uint32_t nextTxMsec; ///< PendingPacket::nextTxMsec at the time this entry was pushed
+    GlobalPacketId key;
+
+    RetransmitDeadline(uint32_t _nextTxMsec, const GlobalPacketId &_key) : nextTxMsec(_nextTxMsec), key(_key) {}
+};
+
 /**
  * RAM-only per-destination route health. Tracks how fresh a learned next_hop is and how many
  * consecutive directed deliveries to it have failed, so getNextHop() can proactively decay a stale or
@@ -125,6 +138,16 @@ class NextHopRouter : public FloodingRouter
      */
     std::unordered_map<GlobalPacketId, PendingPacket, GlobalPacketIdHashFunction> pending;
 
+    /**
+     * Min-heap of retransmission deadlines (earliest on top), kept alongside `pending` so doRetransmissions() only touches
+     * packets that are due. Ordered with rollover-safe signed differences, which is valid while all deadlines lie within
+     * ~24 days of each other (retransmission delays are seconds).
+     */
+    std::vector<RetransmitDeadline> retransmitQueue;
+
+    /** Added to every PendingPacket::nextTxMsec to get its real deadline; see delayRetransmissions() */
+    uint32_t retransmitBias = 0;
+
     /**
      * Per-destination route health (M3). Bounded array, reuse-oldest eviction. RAM-only.
      */
@@ -175,6 +198,21 @@ class NextHopRouter : public FloodingRouter
 
     void setNextTx(PendingPacket *pending);
 
+    /** Schedule `rec` (keyed in `pending` by GlobalPacketId(rec->packet)) to be retransmitted at millis() == dueMsec */
+    void scheduleRetransmission(PendingPacket *rec, uint32_t dueMsec);
+
+    /** Drop the earliest entry from retransmitQueue */
+    void popRetransmitDeadline();
+
+    /** @return the real millis() deadline of a pending packet */
+    uint32_t dueMsec(const PendingPacket &p) const { return p.nextTxMsec + retransmitBias; }
+
+    /**
+     * Push every pending retransmission back by `msec`, because during that airtime we could not have heard an (implicit)
+     * ACK. O(1) for the whole set; `except`, if given and pending, keeps its current deadline.
+     */
+    void delayRetransmissions(uint32_t msec, const GlobalPacketId *except = nullptr);
+
     // --- M3 route-health helpers (RAM-only). Protected so ReliableRouter (a subclass) can record
     // delivery success, and so the unit-test shim can reach them via `using`. All take `now` where
     // time matters so the decay logic is pure and testable without a clock mock. ---
@@ -181,16 +181,16 @@ uint32_t get_st7789_id(uint8_t cs, uint8_t sck, uint8_t mosi, uint8_t dc, uint8_
 namespace
 {
 #if !MESHTASTIC_EXCLUDE_POSITIONDB
-std::map<NodeNum, meshtastic_PositionLite> *s_decodePositionsTarget = nullptr;
+SatelliteStore<meshtastic_PositionLite> *s_decodePositionsTarget = nullptr;
 #endif
 #if !MESHTASTIC_EXCLUDE_TELEMETRYDB
-std::map<NodeNum, meshtastic_DeviceMetrics> *s_decodeTelemetryTarget = nullptr;
+SatelliteStore<meshtastic_DeviceMetrics> *s_decodeTelemetryTarget = nullptr;
 #endif
 #if !MESHTASTIC_EXCLUDE_ENVIRONMENTDB
-std::map<NodeNum, meshtastic_EnvironmentMetrics> *s_decodeEnvironmentTarget = nullptr;
+SatelliteStore<meshtastic_EnvironmentMetrics> *s_decodeEnvironmentTarget = nullptr;
 #endif
 #if !MESHTASTIC_EXCLUDE_STATUSDB
-std::map<NodeNum, meshtastic_StatusMessage> *s_decodeStatusTarget = nullptr;
+SatelliteStore<meshtastic_StatusMessage> *s_decodeStatusTarget = nullptr;
 #endif
 } // namespace
 
@@ -810,6 +810,7 @@ void NodeDB::installDefaultNodeDatabase()
     nodeDatabase.nodes = std::vector<meshtastic_NodeInfoLite>(MAX_NUM_NODES);
     numMeshNodes = 0;
     meshNodes = &nodeDatabase.nodes;
+    invalidateNodeIndex();
     concurrency::LockGuard satelliteGuard(&satelliteMutex);
 #if !MESHTASTIC_EXCLUDE_POSITIONDB
     nodePositions.clear();
@@ -1608,6 +1609,7 @@ void NodeDB::resetNodes(bool keepFavorites)
         }
         std::fill(nodeDatabase.nodes.begin() + 1, nodeDatabase.nodes.end(), meshtastic_NodeInfoLite());
     }
+    invalidateNodeIndex();
     (void)ourNum;
 #if WARM_NODE_COUNT > 0
     warmStore.clear(); // warm entries are never favorites; a DB reset clears them too
@@ -1636,6 +1638,7 @@ void NodeDB::removeNodeByNum(NodeNum nodeNum)
     }
     numMeshNodes -= removed;
     if (removed) {
+        invalidateNodeIndex();
         // Clear exactly the slots compaction vacated. Sizing this from `removed` (rather than a
         // fixed one) keeps it inside the vector when nothing matched and the store is full.
         const size_t first = numMeshNodes;
@@ -1718,6 +1721,50 @@ bool NodeDB::copyNodeStatus(NodeNum n, meshtastic_StatusMessage &out) const
 #endif
 }
 
+bool NodeDB::hasNodePosition(NodeNum n) const
+{
+#if MESHTASTIC_EXCLUDE_POSITIONDB
+    (void)n;
+    return false;
+#else
+    concurrency::LockGuard guard(&satelliteMutex);
+    return nodePositions.contains(n);
+#endif
+}
+
+bool NodeDB::hasNodeTelemetry(NodeNum n) const
+{
+#if MESHTASTIC_EXCLUDE_TELEMETRYDB
+    (void)n;
+    return false;
+#else
+    concurrency::LockGuard guard(&satelliteMutex);
+    return nodeTelemetry.contains(n);
+#endif
+}
+
+bool NodeDB::hasNodeEnvironment(NodeNum n) const
+{
+#if MESHTASTIC_EXCLUDE_ENVIRONMENTDB
+    (void)n;
+    return false;
+#else
+    concurrency::LockGuard guard(&satelliteMutex);
+    return nodeEnvironment.contains(n);
+#endif
+}
+
+bool NodeDB::hasNodeStatus(NodeNum n) const
+{
+#if MESHTASTIC_EXCLUDE_STATUSDB
+    (void)n;
+    return false;
+#else
+    concurrency::LockGuard guard(&satelliteMutex);
+    return nodeStatus.contains(n);
+#endif
+}
+
 std::vector<NodeNum> NodeDB::snapshotPositionNodeNums(NodeNum exclude) const
 {
 #if MESHTASTIC_EXCLUDE_POSITIONDB
@@ -1840,21 +1887,19 @@ bool NodeDB::enforceSatelliteCaps()
 
     (void)trim; // all four maps may be compiled out
 
-    // Approximate satellite heap usage: each std::map entry is one rb-tree node,
-    // value_type plus ~44 B of node overhead (parent/left/right pointers, color,
-    // allocator rounding on 32-bit targets - an estimate, not exact bookkeeping).
+    // Satellite heap usage: one block per store, capacity included
     size_t satBytes = 0;
 #if !MESHTASTIC_EXCLUDE_POSITIONDB
-    satBytes += nodePositions.size() * (sizeof(decltype(nodePositions)::value_type) + 44);
+    satBytes += nodePositions.bytes();
 #endif
 #if !MESHTASTIC_EXCLUDE_TELEMETRYDB
-    satBytes += nodeTelemetry.size() * (sizeof(decltype(nodeTelemetry)::value_type) + 44);
+    satBytes += nodeTelemetry.bytes();
 #endif
 #if !MESHTASTIC_EXCLUDE_ENVIRONMENTDB
-    satBytes += nodeEnvironment.size() * (sizeof(decltype(nodeEnvironment)::value_type) + 44);
+    satBytes += nodeEnvironment.bytes();
 #endif
 #if !MESHTASTIC_EXCLUDE_STATUSDB
-    satBytes += nodeStatus.size() * (sizeof(decltype(nodeStatus)::value_type) + 44);
+    satBytes += nodeStatus.bytes();
 #endif
     memaudit::set("satmaps", satBytes);
 
@@ -1922,6 +1967,7 @@ void NodeDB::cleanupMeshDB()
     numMeshNodes -= removed;
     std::fill(nodeDatabase.nodes.begin() + numMeshNodes, nodeDatabase.nodes.begin() + numMeshNodes + removed,
               meshtastic_NodeInfoLite());
+    invalidateNodeIndex();
     LOG_DEBUG("cleanupMeshDB purged %d entries", removed);
 }
 
@@ -2086,6 +2132,7 @@ void NodeDB::demoteOldestHotNodesToWarm()
                       return ka;
                   return a.last_heard > b.last_heard;
               });
+    invalidateNodeIndex();
 
     int demoted = 0;
     for (int i = keep; i < numMeshNodes; i++) {
@@ -2131,6 +2178,7 @@ void NodeDB::nodeDBSelfCare()
     // us, wherever the loaded file happened to place our row.
     if (selfNode && numMeshNodes > 0 && selfNode != &meshNodes->at(0)) {
         std::swap(meshNodes->at(0), *selfNode);
+        invalidateNodeIndex();
     }
 
 #if WARM_NODE_COUNT > 0
@@ -2146,6 +2194,7 @@ void NodeDB::nodeDBSelfCare()
     // has spare slots to append into (it indexes meshNodes->at(numMeshNodes++)).
     meshNodes->resize(MAX_NUM_NODES);
     memaudit::set("nodedb", MAX_NUM_NODES * sizeof(meshtastic_NodeInfoLite));
+    invalidateNodeIndex(); // demotion/truncation shrank the list and resize() may have moved it
 
     const bool satsTrimmed = enforceSatelliteCaps();
 
@@ -2155,8 +2204,10 @@ void NodeDB::nodeDBSelfCare()
     meshtastic_NodeInfoLite *info = getOrCreateMeshNode(self);
     if (info) {
         TypeConversions::CopyUserToNodeInfoLite(info, owner);
-        if (info != &meshNodes->at(0))
+        if (info != &meshNodes->at(0)) {
             std::swap(meshNodes->at(0), *info);
+            invalidateNodeIndex();
+        }
     }
 
     // One-shot rewrite: only when we healed something, and never while storage
@@ -2295,8 +2346,13 @@ void NodeDB::loadFromDisk()
         else
             installDefaultNodeDatabase();
     } else {
+#if HAS_NODEDB_JOURNAL
+        if (state == LoadFileResult::LOAD_SUCCESS)
+            replayNodeJournal();
+#endif
         meshNodes = &nodeDatabase.nodes;
         numMeshNodes = nodeDatabase.nodes.size();
+        invalidateNodeIndex();
         // Counts computed outside LOG_INFO() so cppcheck doesn't choke on #if in macro args.
         const unsigned posCount =
 #if !MESHTASTIC_EXCLUDE_POSITIONDB
@@ -2864,9 +2920,169 @@ bool NodeDB::saveNodeDatabaseToDisk()
     spiLock->unlock();
 #endif
 
+    bool ok;
+    {
+        concurrency::LockGuard guard(&satelliteMutex);
+        ok = appendNodeJournal() || saveNodeDatabaseSnapshot();
+    }
+
+#if WARM_NODE_COUNT > 0
+#ifdef ARCH_RP2040
+    // nodes.proto + warm.dat are written back-to-back without the loop running between them;
+    // reset the 8s HW watchdog so the second write gets a full budget (issue #10746).
+    watchdog_update();
+#endif
+    // Same cadence as the node DB; failure is logged but must not propagate -
+    // a false return from here would trigger saveToDisk()'s fsFormat() path.
+    warmStore.saveIfDirty();
+#endif
+    return ok;
+}
+
+bool NodeDB::appendNodeJournal()
+{
+#if HAS_NODEDB_JOURNAL
+#ifdef MESHTASTIC_ENCRYPTED_STORAGE
+    // The journal is plaintext: encrypted snapshots only, and drop any journal left from before lockdown
+    if (EncryptedStorage::isLockdownActive()) {
+        nodeJournal.discard();
+        return false;
+    }
+#endif
+    scanNodeJournal();
+    if (nodeJournal.wantsSnapshot())
+        return false;
+
+    // The journal only means something on top of its snapshot (gone after fsFormat(), for one)
+    bool haveSnapshot;
+    {
+        concurrency::LockGuard g(spiLock);
+        haveSnapshot = FSCom.exists(nodeDatabaseFileName);
+    }
+    return haveSnapshot && nodeJournal.appendPending();
+#else
+    return false;
+#endif
+}
+
+#if HAS_NODEDB_JOURNAL
+void NodeDB::scanNodeJournal()
+{
+    nodeJournal.beginScan();
+    for (const auto &n : nodeDatabase.nodes)
+        nodeJournal.scanMessage(NodeDBJournal::NODE, n.num, meshtastic_NodeInfoLite_fields, &n);
+#if !MESHTASTIC_EXCLUDE_POSITIONDB
+    for (const auto &kv : nodePositions)
+        nodeJournal.scanMessage(NodeDBJournal::POSITION, kv.first, meshtastic_PositionLite_fields, &kv.second);
+#endif
+#if !MESHTASTIC_EXCLUDE_TELEMETRYDB
+    for (const auto &kv : nodeTelemetry)
+        nodeJournal.scanMessage(NodeDBJournal::TELEMETRY, kv.first, meshtastic_DeviceMetrics_fields, &kv.second);
+#endif
+#if !MESHTASTIC_EXCLUDE_ENVIRONMENTDB
+    for (const auto &kv : nodeEnvironment)
+        nodeJournal.scanMessage(NodeDBJournal::ENVIRONMENT, kv.first, meshtastic_EnvironmentMetrics_fields, &kv.second);
+#endif
+#if !MESHTASTIC_EXCLUDE_STATUSDB
+    for (const auto &kv : nodeStatus)
+        nodeJournal.scanMessage(NodeDBJournal::STATUS, kv.first, meshtastic_StatusMessage_fields, &kv.second);
+#endif
+    nodeJournal.endScan();
+}
+
+void NodeDB::replayNodeJournal()
+{
+#ifdef MESHTASTIC_ENCRYPTED_STORAGE
+    if (EncryptedStorage::isLockdownActive()) {
+        nodeJournal.discard();
+        return;
+    }
+#endif
+    uint32_t size, hash;
+    if (!NodeDBJournal::hashFile(nodeDatabaseFileName, size, hash))
+        return;
+
+    // Records decode straight into the loaded structures; anything that doesn't decode is skipped and
+    // gets rewritten by the next save
+    auto apply = [](void *ctx, NodeDBJournal::Kind kind, NodeNum num, const uint8_t *payload, size_t len) {
+        NodeDB &db = *static_cast<NodeDB *>(ctx);
+        pb_istream_t stream = pb_istream_from_buffer(payload, payload ? len : 0);
+        switch (kind) {
+        case NodeDBJournal::NODE: {
+            auto &nodes = db.nodeDatabase.nodes;
+            auto it = std::find_if(nodes.begin(), nodes.end(), [num](const meshtastic_NodeInfoLite &n) { return n.num == num; });
+            if (!payload) {
+                if (it != nodes.end())
+                    nodes.erase(it);
+                break;
+            }
+            meshtastic_NodeInfoLite n = meshtastic_NodeInfoLite_init_default;
+            if (!pb_decode(&stream, meshtastic_NodeInfoLite_fields, &n))
+                break;
+            n.num = num;
+            if (it != nodes.end())
+                *it = n;
+            else if (nodes.size() < MAX_NUM_NODES)
+                nodes.push_back(n);
+            break;
+        }
+#if !MESHTASTIC_EXCLUDE_POSITIONDB
+        case NodeDBJournal::POSITION: {
+            meshtastic_PositionLite p = meshtastic_PositionLite_init_default;
+            if (!payload)
+                db.nodePositions.erase(num);
+            else if (pb_decode(&stream, meshtastic_PositionLite_fields, &p))
+                db.nodePositions[num] = p;
+            break;
+        }
+#endif
+#if !MESHTASTIC_EXCLUDE_TELEMETRYDB
+        case NodeDBJournal::TELEMETRY: {
+            meshtastic_DeviceMetrics m = meshtastic_DeviceMetrics_init_default;
+            if (!payload)
+                db.nodeTelemetry.erase(num);
+            else if (pb_decode(&stream, meshtastic_DeviceMetrics_fields, &m))
+                db.nodeTelemetry[num] = m;
+            break;
+        }
+#endif
+#if !MESHTASTIC_EXCLUDE_ENVIRONMENTDB
+        case NodeDBJournal::ENVIRONMENT: {
+            meshtastic_EnvironmentMetrics m = meshtastic_EnvironmentMetrics_init_default;
+            if (!payload)
+                db.nodeEnvironment.erase(num);
+            else if (pb_decode(&stream, meshtastic_EnvironmentMetrics_fields, &m))
+                db.nodeEnvironment[num] = m;
+            break;
+        }
+#endif
+#if !MESHTASTIC_EXCLUDE_STATUSDB
+        case NodeDBJournal::STATUS: {
+            meshtastic_StatusMessage m = meshtastic_StatusMessage_init_default;
+            if (!payload)
+                db.nodeStatus.erase(num);
+            else if (pb_decode(&stream, meshtastic_StatusMessage_fields, &m))
+                db.nodeStatus[num] = m;
+            break;
+        }
+#endif
+        default:
+            break;
+        }
+    };
+
+    concurrency::LockGuard guard(&satelliteMutex);
+    nodeJournal.replay(size, hash, apply, this);
+    // What is in RAM now is exactly snapshot + journal; later saves append against it
+    scanNodeJournal();
+    nodeJournal.adoptScan();
+}
+#endif // HAS_NODEDB_JOURNAL
+
+bool NodeDB::saveNodeDatabaseSnapshot()
+{
     // Project the maps into the on-disk vectors just before encoding; cleared
     // again on the way out so we don't carry duplicate state.
-    concurrency::LockGuard guard(&satelliteMutex);
 #if !MESHTASTIC_EXCLUDE_POSITIONDB
     nodeDatabase.positions.clear();
     nodeDatabase.positions.reserve(nodePositions.size());
@@ -2927,6 +3143,14 @@ bool NodeDB::saveNodeDatabaseToDisk()
     pb_get_encoded_size(&nodeDatabaseSize, meshtastic_NodeDatabase_fields, &nodeDatabase);
     bool ok = saveProto(nodeDatabaseFileName, nodeDatabaseSize, &meshtastic_NodeDatabase_msg, &nodeDatabase, false);
 
+#if HAS_NODEDB_JOURNAL
+    // Restart the journal against what we just wrote (appendNodeJournal() scanned it; not under lockdown)
+    uint32_t snapshotSize, snapshotHash;
+    if (ok && nodeJournal.hasScan() &&
+        NodeDBJournal::hashEncoded(meshtastic_NodeDatabase_fields, &nodeDatabase, snapshotSize, snapshotHash))
+        nodeJournal.snapshotWritten(snapshotSize, snapshotHash);
+#endif
+
     nodeDatabase.positions.clear();
     nodeDatabase.positions.shrink_to_fit();
     nodeDatabase.telemetry.clear();
@@ -2935,16 +3159,6 @@ bool NodeDB::saveNodeDatabaseToDisk()
     nodeDatabase.environment.shrink_to_fit();
     nodeDatabase.status.clear();
     nodeDatabase.status.shrink_to_fit();
-#if WARM_NODE_COUNT > 0
-#ifdef ARCH_RP2040
-    // nodes.proto + warm.dat are written back-to-back without the loop running between them;
-    // reset the 8s HW watchdog so the second write gets a full budget (issue #10746).
-    watchdog_update();
-#endif
-    // Same cadence as the node DB; failure is logged but must not propagate -
-    // a false return from here would trigger saveToDisk()'s fsFormat() path.
-    warmStore.saveIfDirty();
-#endif
     return ok;
 }
 
@@ -3572,45 +3786,9 @@ bool NodeDB::isFavorite(uint32_t nodeId)
 
 bool NodeDB::isFromOrToFavoritedNode(const meshtastic_MeshPacket &p)
 {
-    // This method is logically equivalent to:
-    //   return isFavorite(p.from) || isFavorite(p.to);
-    // but is more efficient by:
-    //   1. doing only one pass through the database, instead of two
-    //   2. exiting early when a favorite is found, or if both from and to have been seen
-
-    if (p.to == NODENUM_BROADCAST)
-        return isFavorite(p.from); // we never store NODENUM_BROADCAST in the DB, so we only need to check p.from
-
-    meshtastic_NodeInfoLite *lite = NULL;
-
-    bool seenFrom = false;
-    bool seenTo = false;
-
-    for (int i = 0; i < numMeshNodes; i++) {
-        lite = &meshNodes->at(i);
-
-        if (lite->num == p.from) {
-            if (nodeInfoLiteIsFavorite(lite))
-                return true;
-
-            seenFrom = true;
-        }
-
-        if (lite->num == p.to) {
-            if (nodeInfoLiteIsFavorite(lite))
-                return true;
-
-            seenTo = true;
-        }
-
-        if (seenFrom && seenTo)
-            return false; // we've seen both, and neither is a favorite, so we can stop searching early
-
-        // Note: if we knew that sortMeshDB was always called after any change to is_favorite, we could exit early after searching
-        // all favorited nodes first.
-    }
-
-    return false;
+    // Two indexed lookups now beat the old combined single pass over the whole DB.
+    // isFavorite() short-circuits NODENUM_BROADCAST, which we never store.
+    return isFavorite(p.from) || isFavorite(p.to);
 }
 
 void NodeDB::pause_sort(bool paused)
@@ -3622,29 +3800,51 @@ void NodeDB::sortMeshDB()
 {
     if (!sortingIsPaused && (lastSort == 0 || !Throttle::isWithinTimespanMs(lastSort, 1000 * 5))) {
         lastSort = millis();
-        bool changed = true;
-        while (changed) { // dumb reverse bubble sort, but probably not bad for what we're doing
-            changed = false;
-            for (int i = numMeshNodes - 1; i > 0; i--) { // lowest case this should examine is i == 1
-                if (meshNodes->at(i - 1).num == getNodeNum()) {
-                    // noop
-                } else if (meshNodes->at(i).num ==
-                           getNodeNum()) { // in the oddball case our own node num is not at location 0, put it there
-                    // TODO: Look for at(i-1) also matching own node num, and throw the DB in the trash
-                    std::swap(meshNodes->at(i), meshNodes->at(i - 1));
-                    changed = true;
-                } else if (nodeInfoLiteIsFavorite(&meshNodes->at(i)) && !nodeInfoLiteIsFavorite(&meshNodes->at(i - 1))) {
-                    std::swap(meshNodes->at(i), meshNodes->at(i - 1));
-                    changed = true;
-                } else if (!nodeInfoLiteIsFavorite(&meshNodes->at(i)) && nodeInfoLiteIsFavorite(&meshNodes->at(i - 1))) {
-                    // noop
-                } else if (meshNodes->at(i).last_heard > meshNodes->at(i - 1).last_heard) {
-                    std::swap(meshNodes->at(i), meshNodes->at(i - 1));
-                    changed = true;
-                }
+        const NodeNum self = getNodeNum();
+        // Same order the old reverse bubble sort produced: our own node first (even if the loaded
+        // file put it elsewhere), then favorites, then most recently heard. Strict, so the sort is
+        // stable for ties exactly like the adjacent-swap version was.
+        auto before = [self](const meshtastic_NodeInfoLite &a, const meshtastic_NodeInfoLite &b) {
+            if ((a.num == self) != (b.num == self))
+                return a.num == self;
+            if (nodeInfoLiteIsFavorite(&a) != nodeInfoLiteIsFavorite(&b))
+                return nodeInfoLiteIsFavorite(&a);
+            return a.last_heard > b.last_heard;
+        };
+
+        // Common case: nothing was heard out of order since the last pass - one linear check, no moves.
+        const auto first = meshNodes->begin();
+        const auto last = meshNodes->begin() + numMeshNodes;
+        if (std::is_sorted(first, last, before))
+            return;
+
+        // Sort a permutation of 16-bit slot numbers instead of swapping ~100-byte records around,
+        // then apply it cycle by cycle so every misplaced record is copied exactly once.
+        std::vector<uint16_t> order(numMeshNodes);
+        for (pb_size_t i = 0; i < numMeshNodes; i++)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(),
+                         [&](uint16_t a, uint16_t b) { return before((*meshNodes)[a], (*meshNodes)[b]); });
+
+        uint32_t moved = 0;
+        for (pb_size_t start = 0; start < numMeshNodes; start++) {
+            if (order[start] == start)
+                continue; // already in place, or placed by an earlier cycle
+            meshtastic_NodeInfoLite held = (*meshNodes)[start];
+            pb_size_t dst = start;
+            while (order[dst] != start) {
+                const pb_size_t src = order[dst];
+                (*meshNodes)[dst] = (*meshNodes)[src];
+                order[dst] = dst;
+                dst = src;
+                moved++;
             }
+            (*meshNodes)[dst] = held;
+            order[dst] = dst;
+            moved++;
         }
-        LOG_INFO("Sort took %u milliseconds", millis() - lastSort);
+        invalidateNodeIndex();
+        LOG_DEBUG("Sort took %u milliseconds (%u of %u nodes moved)", millis() - lastSort, moved, numMeshNodes);
     }
 }
 
@@ -3664,15 +3864,165 @@ std::string NodeDB::getNodeId() const
     return std::string(nodeId);
 }
 
-/// Find a node in our DB, return null for missing
-/// NOTE: This function might be called from an ISR
-meshtastic_NodeInfoLite *NodeDB::getMeshNode(NodeNum n)
+void NodeDB::invalidateNodeIndex()
+{
+    nodeListGeneration++;
+#if !MESHTASTIC_EXCLUDE_NODEDB_HASH
+    // Rebuild here, on the thread that changed the list, so lookups never write the index
+    concurrency::LockGuard guard(&nodeIndexLock);
+    nodeIndexRebuild();
+#endif
+}
+
+uint32_t NodeDB::getNodeListGeneration() const
+{
+#if !MESHTASTIC_EXCLUDE_POSITIONDB
+    // Both counters only grow, so the sum moves whenever either does
+    concurrency::LockGuard guard(&satelliteMutex);
+    return nodeListGeneration + nodePositions.generation();
+#else
+    return nodeListGeneration;
+#endif
+}
+
+#if !MESHTASTIC_EXCLUDE_NODEDB_HASH
+// Same xor-shift mixing as PacketHistory::hashSlot - NodeNums derived from MACs share long prefixes.
+uint32_t NodeDB::nodeIndexSlot(NodeNum n) const
+{
+    uint32_t h = n * 0x9E3779B9; // Fibonacci hashing constant
+    h ^= h >> 16;
+    h *= 0x45d9f3b;
+    h ^= h >> 16;
+    return h & nodeIndexMask;
+}
+
+bool NodeDB::nodeIndexInsert(NodeNum n, uint16_t slot)
+{
+    uint32_t bucket = nodeIndexSlot(n);
+    // Bounded probe: a full (corrupted) table reports failure instead of spinning
+    for (uint32_t i = 0; i < nodeIndexCapacity; i++) {
+        if (nodeIndex[bucket] == NODE_INDEX_EMPTY) {
+            nodeIndex[bucket] = slot;
+            return true;
+        }
+        bucket = (bucket + 1) & nodeIndexMask;
+    }
+    return false;
+}
+
+void NodeDB::lastByteLink(NodeNum n, uint16_t slot)
+{
+    const uint8_t b = getLastByteOfNodeNum(n);
+    lastByteNext[slot] = lastByteHead[b];
+    lastByteHead[b] = slot;
+}
+
+bool NodeDB::nodeIndexStale() const
+{
+    return nodeIndexDirty || nodeIndexData != meshNodes->data() || nodeIndexCount != numMeshNodes;
+}
+
+bool NodeDB::nodeIndexRebuild()
 {
+    // Stays stale (linear scan for readers) if the build below fails
+    nodeIndexDirty = true;
+    // Slot numbers must stay below the HASH_EMPTY-style sentinel
+    if (!meshNodes || numMeshNodes >= NODE_INDEX_EMPTY || numMeshNodes > meshNodes->size())
+        return false;
+
+    // Size for the cap rather than the current count so runtime appends never outgrow the table.
+    // Loads from larger-cap builds can briefly exceed MAX_NUM_NODES before nodeDBSelfCare() trims.
+    const uint32_t wanted = nextPowerOf2(std::max<uint32_t>(MAX_NUM_NODES, numMeshNodes) * 2);
+    if (wanted > nodeIndexCapacity) {
+        nodeIndex.reset(new uint16_t[wanted]);
+        lastByteNext.reset(new uint16_t[wanted / 2]);
+        if (!nodeIndex || !lastByteNext) {
+            LOG_ERROR("NodeDB - Index allocation failed for %u entries", wanted);
+            nodeIndex.reset();
+            lastByteNext.reset();
+            nodeIndexCapacity = 0;
+            nodeIndexMask = 0;
+            memaudit::set("nodeidx", 0);
+            return false;
+        }
+        nodeIndexCapacity = wanted;
+        nodeIndexMask = wanted - 1;
+        memaudit::set("nodeidx", sizeof(uint16_t) * (nodeIndexCapacity + nodeIndexCapacity / 2) + sizeof(lastByteHead));
+    }
+
+    memset(nodeIndex.get(), 0xFF, sizeof(uint16_t) * nodeIndexCapacity); // Fill with NODE_INDEX_EMPTY
+    memset(lastByteHead, 0xFF, sizeof(lastByteHead));
+    // Insert in slot order so a (corrupt) duplicate NodeNum resolves to the lowest slot, as the scan did
+    for (pb_size_t i = 0; i < numMeshNodes; i++) {
+        const NodeNum num = (*meshNodes)[i].num;
+        if (!nodeIndexInsert(num, (uint16_t)i))
+            return false;
+        lastByteLink(num, (uint16_t)i);
+    }
+    nodeIndexData = meshNodes->data();
+    nodeIndexCount = numMeshNodes;
+    nodeIndexDirty = false;
+    return true;
+}
+#endif
+
+int NodeDB::findMeshNodeSlot(NodeNum n) const
+{
+    if (!meshNodes)
+        return -1;
+
+#if !MESHTASTIC_EXCLUDE_NODEDB_HASH
+    // Read-only: the index is rebuilt where the list changes, never from a lookup (see getMeshNode())
+    {
+        concurrency::LockGuard guard(&nodeIndexLock);
+        if (!nodeIndexStale()) {
+            uint32_t bucket = nodeIndexSlot(n);
+            for (uint32_t i = 0; i < nodeIndexCapacity; i++) {
+                const uint16_t idx = nodeIndex[bucket];
+                if (idx == NODE_INDEX_EMPTY)
+                    return -1;
+                if (idx < numMeshNodes && (*meshNodes)[idx].num == n)
+                    return idx;
+                bucket = (bucket + 1) & nodeIndexMask;
+            }
+            return -1;
+        }
+    }
+#endif
+
+    // Linear scan (sole path when the index is excluded, fallback while it is stale or could not be built)
     for (int i = 0; i < numMeshNodes; i++)
         if (meshNodes->at(i).num == n)
-            return &meshNodes->at(i);
+            return i;
+    return -1;
+}
 
-    return NULL;
+void NodeDB::nodeIndexAppended(NodeNum n, pb_size_t slot)
+{
+    nodeListGeneration++;
+#if !MESHTASTIC_EXCLUDE_NODEDB_HASH
+    // Only extend an index that exactly described the store before this append; anything else
+    // (resize moved the buffer, earlier failed build) rebuilds it now.
+    concurrency::LockGuard guard(&nodeIndexLock);
+    if (nodeIndexDirty || nodeIndexData != meshNodes->data() || slot != nodeIndexCount || slot + 1 != numMeshNodes ||
+        !nodeIndexInsert(n, (uint16_t)slot)) {
+        nodeIndexRebuild();
+        return;
+    }
+    lastByteLink(n, (uint16_t)slot);
+    nodeIndexCount = numMeshNodes;
+#else
+    (void)n;
+    (void)slot;
+#endif
+}
+
+/// Find a node in our DB, return null for missing
+/// NOTE: takes nodeIndexLock, so not callable from an ISR
+meshtastic_NodeInfoLite *NodeDB::getMeshNode(NodeNum n)
+{
+    const int slot = findMeshNodeSlot(n);
+    return slot >= 0 ? &meshNodes->at(slot) : NULL;
 }
 
 ResolvedNode NodeDB::resolveLastByte(uint8_t lastByte, bool requireDirectNeighbor)
@@ -3681,23 +4031,23 @@ ResolvedNode NodeDB::resolveLastByte(uint8_t lastByte, bool requireDirectNeighbo
 
     // 0 is the NO_RELAY_NODE / NO_NEXT_HOP_PREFERENCE sentinel (also what MQTT-sourced packets carry
     // when hop_start==0). getLastByteOfNodeNum() never yields 0, so nothing can legitimately match.
-    if (lastByte == 0)
+    if (lastByte == 0 || !meshNodes)
         return result;
 
     const NodeNum self = getNodeNum();
     NodeNum firstMatch = 0;
     uint8_t matches = 0;
 
-    for (size_t i = 0; i < numMeshNodes; i++) {
-        const meshtastic_NodeInfoLite *node = &meshNodes->at(i);
-
+    // Returns true once a second relevant candidate makes the byte ambiguous - no further
+    // candidate can change that, so the caller stops early.
+    auto consider = [&](const meshtastic_NodeInfoLite *node) {
         // Candidate gate: never resolve to ourselves, the sentinels, or an ignored node.
         if (node->num == self || node->num == 0 || node->num == NODENUM_BROADCAST)
-            continue;
+            return false;
         if (nodeInfoLiteIsIgnored(node))
-            continue;
+            return false;
         if (getLastByteOfNodeNum(node->num) != lastByte) // cheapest discriminator last
-            continue;
+            return false;
 
         // Relevance gate: is this node a plausible relay for the requested scope?
         bool relevant;
@@ -3711,20 +4061,37 @@ ResolvedNode NodeDB::resolveLastByte(uint8_t lastByte, bool requireDirectNeighbo
             relevant = directNeighbor || nodeInfoLiteIsFavorite(node) || routerRole;
         }
         if (!relevant)
-            continue;
+            return false;
 
-        if (++matches == 1) {
+        if (++matches == 1)
             firstMatch = node->num;
-        } else {
-            // A second relevant candidate shares this byte: ambiguous. No further scanning can
-            // change that, so stop early and report the collision.
-            result.status = LastByteResolution::Ambiguous;
-            result.num = 0;
-            return result;
+        return matches > 1;
+    };
+
+    bool ambiguous = false;
+    bool scanned = false;
+#if !MESHTASTIC_EXCLUDE_NODEDB_HASH
+    {
+        concurrency::LockGuard guard(&nodeIndexLock);
+        if (!nodeIndexStale()) {
+            // Only the nodes sharing this byte - a handful even on dense meshes
+            for (uint16_t idx = lastByteHead[lastByte]; idx != NODE_INDEX_EMPTY && idx < numMeshNodes && !ambiguous;
+                 idx = lastByteNext[idx])
+                ambiguous = consider(&(*meshNodes)[idx]);
+            scanned = true;
         }
     }
+#endif
+    if (!scanned) {
+        for (size_t i = 0; i < numMeshNodes && !ambiguous; i++)
+            ambiguous = consider(&meshNodes->at(i));
+    }
 
-    if (matches == 1) {
+    if (ambiguous) {
+        // A second relevant candidate shares this byte: report the collision.
+        result.status = LastByteResolution::Ambiguous;
+        result.num = 0;
+    } else if (matches == 1) {
         result.status = LastByteResolution::Unique;
         result.num = firstMatch;
     }
@@ -3750,10 +4117,8 @@ bool NodeDB::isFull()
 
 uint32_t NodeDB::hotNodeLastHeard(NodeNum n) const
 {
-    for (int i = 0; i < numMeshNodes; i++)
-        if (meshNodes->at(i).num == n)
-            return meshNodes->at(i).last_heard;
-    return 0;
+    const int slot = findMeshNodeSlot(n);
+    return slot >= 0 ? meshNodes->at(slot).last_heard : 0;
 }
 
 bool NodeDB::copyPublicKeyAuthoritative(NodeNum n, meshtastic_NodeInfoLite_public_key_t &out)
@@ -3926,6 +4291,7 @@ meshtastic_NodeInfoLite *NodeDB::getOrCreateMeshNode(NodeNum n)
                     meshNodes->at(i) = meshNodes->at(i + 1);
                 }
                 (numMeshNodes)--;
+                invalidateNodeIndex();
             }
         }
         // Don't append past the end of the vector. The protected-node cap
@@ -3943,6 +4309,7 @@ meshtastic_NodeInfoLite *NodeDB::getOrCreateMeshNode(NodeNum n)
         // everything is missing except the nodenum
         memset(lite, 0, sizeof(*lite));
         lite->num = n;
+        nodeIndexAppended(n, numMeshNodes - 1);
 #if WARM_NODE_COUNT > 0
         // Re-admission: restore what the warm tier kept for this node
         WarmNodeEntry warm;
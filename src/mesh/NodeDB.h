@@ -5,12 +5,15 @@
 #include <algorithm>
 #include <assert.h>
 #include <map>
+#include <memory>
 #include <pb_encode.h>
 #include <string>
 #include <vector>
 
 #include "MeshTypes.h"
+#include "NodeDBJournal.h"
 #include "NodeStatus.h"
+#include "SatelliteStore.h"
 #include "WarmNodeStore.h"
 #include "concurrency/Lock.h"
 #include "configuration.h"
@@ -204,19 +207,19 @@ class NodeDB
     Observable<const meshtastic::NodeStatus *> newStatus;
     pb_size_t numMeshNodes;
 
-    // Satellite per-NodeNum maps. std::map avoids unordered_map's bucket-array
-    // preallocation; O(log N) lookup is fine at these sizes.
+    // Satellite per-NodeNum stores: sorted flat vectors, one heap block each
+    // (see SatelliteStore.h); O(log N) lookup is fine at these sizes.
 #if !MESHTASTIC_EXCLUDE_POSITIONDB
-    std::map<NodeNum, meshtastic_PositionLite> nodePositions;
+    SatelliteStore<meshtastic_PositionLite> nodePositions;
 #endif
 #if !MESHTASTIC_EXCLUDE_TELEMETRYDB
-    std::map<NodeNum, meshtastic_DeviceMetrics> nodeTelemetry;
+    SatelliteStore<meshtastic_DeviceMetrics> nodeTelemetry;
 #endif
 #if !MESHTASTIC_EXCLUDE_ENVIRONMENTDB
-    std::map<NodeNum, meshtastic_EnvironmentMetrics> nodeEnvironment;
+    SatelliteStore<meshtastic_EnvironmentMetrics> nodeEnvironment;
 #endif
 #if !MESHTASTIC_EXCLUDE_STATUSDB
-    std::map<NodeNum, meshtastic_StatusMessage> nodeStatus;
+    SatelliteStore<meshtastic_StatusMessage> nodeStatus;
 #endif
 
     bool keyIsLowEntropy = false;
@@ -302,7 +305,7 @@ class NodeDB
     std::string getNodeId() const;
 
     // @return last byte of a NodeNum, 0xFF if it ended at 0x00
-    uint8_t getLastByteOfNodeNum(NodeNum num) { return (uint8_t)((num & 0xFF) ? (num & 0xFF) : 0xFF); }
+    uint8_t getLastByteOfNodeNum(NodeNum num) const { return (uint8_t)((num & 0xFF) ? (num & 0xFF) : 0xFF); }
 
     /// if returns false, that means our node should send a DenyNodeNum response.  If true, we think the number is okay for use
     // bool handleWantNodeNum(NodeNum n);
@@ -345,6 +348,15 @@ class NodeDB
 
     virtual meshtastic_NodeInfoLite *getMeshNode(NodeNum n);
     size_t getNumMeshNodes() { return numMeshNodes; }
+
+    /// Rebuild the NodeNum -> slot index after meshNodes was reshuffled. NodeDB's own maintenance
+    /// paths call this; anything else that rewrites meshNodes/numMeshNodes in place (test mocks,
+    /// bulk loaders) must too, or getMeshNode() falls back to scanning until the next rebuild.
+    void invalidateNodeIndex();
+
+    /// Moves whenever the set or order of meshNodes, or the position store, may have changed
+    /// (bumped alongside the slot index). Lets renderers reuse a NodeListView between changes.
+    uint32_t getNodeListGeneration() const;
     /// Find a node in our DB, create an empty NodeInfoLite if missing (evicting
     /// the oldest non-protected node when full). Public so admin handlers can
     /// register a node we have not heard from yet (e.g. to block it by ID).
@@ -396,8 +408,8 @@ class NodeDB
     /// nodes that have aged out of the hot store.
     meshtastic_Config_DeviceConfig_Role getNodeRole(NodeNum n);
 
-    /// last_heard of a hot-store node, or 0 if absent. Plain scan of meshNodes
-    /// with no allocation side effects (unlike getOrCreateMeshNode).
+    /// last_heard of a hot-store node, or 0 if absent. Index lookup with no
+    /// allocation side effects (unlike getOrCreateMeshNode).
     uint32_t hotNodeLastHeard(NodeNum n) const;
 
     /**
@@ -410,6 +422,7 @@ class NodeDB
      *                                     distance allowed). Use when learning / preserving hops.
      * Ignored nodes, our own node, and the broadcast/0 sentinels are never candidates. On a tie the
      * result is Ambiguous (no tie-break) so callers fall back to flooding rather than misroute.
+     * Walks only the last-byte bucket of the node index, so cost is the bucket size, not the DB size.
      */
     ResolvedNode resolveLastByte(uint8_t lastByte, bool requireDirectNeighbor);
 
@@ -431,26 +444,11 @@ class NodeDB
     void setNodeStatus(NodeNum n, const meshtastic_StatusMessage &status);
     void touchNodePositionTime(NodeNum n, uint32_t time);
 
-    bool hasNodePosition(NodeNum n) const
-    {
-        meshtastic_PositionLite scratch;
-        return copyNodePosition(n, scratch);
-    }
-    bool hasNodeTelemetry(NodeNum n) const
-    {
-        meshtastic_DeviceMetrics scratch;
-        return copyNodeTelemetry(n, scratch);
-    }
-    bool hasNodeEnvironment(NodeNum n) const
-    {
-        meshtastic_EnvironmentMetrics scratch;
-        return copyNodeEnvironment(n, scratch);
-    }
-    bool hasNodeStatus(NodeNum n) const
-    {
-        meshtastic_StatusMessage scratch;
-        return copyNodeStatus(n, scratch);
-    }
+    // Existence checks: a lookup under the lock, no copy
+    bool hasNodePosition(NodeNum n) const;
+    bool hasNodeTelemetry(NodeNum n) const;
+    bool hasNodeEnvironment(NodeNum n) const;
+    bool hasNodeStatus(NodeNum n) const;
 
     void eraseNodeSatellites(NodeNum n);
 
@@ -564,12 +562,51 @@ class NodeDB
     uint32_t lastFullEvictionMs = 0; // when we last evicted to admit a new node, once the db is full
     uint32_t lastBackupAttempt = 0;  // when we last tried a backup automatically or manually
     uint32_t lastSort = 0;           // When last sorted the nodeDB
+    uint32_t nodeListGeneration = 0; // See getNodeListGeneration()
 
     /*
      * Internal boolean to track sorting paused
      */
     bool sortingIsPaused = false;
 
+#if !MESHTASTIC_EXCLUDE_NODEDB_HASH
+    // Open-addressing NodeNum -> meshNodes[] slot index for O(1) getMeshNode(), replacing the linear
+    // scan. Same linear-probing scheme as PacketHistory's hashIndex, load factor <= 0.5 of
+    // max(MAX_NUM_NODES, numMeshNodes). Appends are inserted in place; bulk reshuffles (sort,
+    // eviction, removal, cleanup, load) rebuild it in O(N) through invalidateNodeIndex(). Lookups
+    // only read it and fall back to the linear scan while it is stale; the (data, count) snapshot
+    // catches callers that resize meshNodes directly. getMeshNode() also runs on other tasks (BLE,
+    // API clients), so builds and index walks both hold nodeIndexLock; nothing else is taken under it.
+    static constexpr uint16_t NODE_INDEX_EMPTY = 0xFFFF;
+    std::unique_ptr<uint16_t[]> nodeIndex;
+    uint32_t nodeIndexCapacity = 0; // Always a power of 2
+    uint32_t nodeIndexMask = 0;     // nodeIndexCapacity - 1
+    bool nodeIndexDirty = true;
+    const meshtastic_NodeInfoLite *nodeIndexData = nullptr; // meshNodes->data() when last built
+    pb_size_t nodeIndexCount = 0;                            // numMeshNodes when last built
+
+    // Companion 256-bucket index keyed by getLastByteOfNodeNum(), so resolveLastByte() only walks the
+    // nodes sharing the on-wire byte. Intrusive chains: lastByteHead[b] is the first slot in bucket b,
+    // lastByteNext[slot] the next one (NODE_INDEX_EMPTY terminates). Built and extended together with
+    // nodeIndex; relevance (hops_away, role, freshness) is judged per query, so it never goes stale.
+    uint16_t lastByteHead[256];
+    std::unique_ptr<uint16_t[]> lastByteNext; // nodeIndexCapacity / 2 entries
+    mutable concurrency::Lock nodeIndexLock;
+
+    // The helpers below expect the caller to hold nodeIndexLock
+    uint32_t nodeIndexSlot(NodeNum n) const;
+    bool nodeIndexInsert(NodeNum n, uint16_t slot);
+    bool nodeIndexRebuild();
+    bool nodeIndexStale() const;
+    void lastByteLink(NodeNum n, uint16_t slot);
+#endif
+
+    /// Slot of node n in meshNodes[], or -1 if absent. Index lookup when available, linear scan otherwise.
+    int findMeshNodeSlot(NodeNum n) const;
+
+    /// Keep the index in sync after getOrCreateMeshNode() appended n at `slot` (no rebuild needed).
+    void nodeIndexAppended(NodeNum n, pb_size_t slot);
+
     /// pick a provisional nodenum we hope no one is using
     void pickNewNodeNum();
 
@@ -614,6 +651,11 @@ class NodeDB
     bool saveChannelsToDisk();
     bool saveDeviceStateToDisk();
     bool saveNodeDatabaseToDisk();
+    /// Encode the whole node database into nodes.proto. Caller holds satelliteMutex.
+    bool saveNodeDatabaseSnapshot();
+    /// Append what changed since the last save to the journal instead, when it is worth it.
+    /// @return false if a snapshot is needed. Caller holds satelliteMutex.
+    bool appendNodeJournal();
     void sortMeshDB();
 
     // Defined in NodeDBLegacyMigration.cpp. Decodes /prefs/nodes.proto via
@@ -625,6 +667,15 @@ class NodeDB
     // temp vectors. Must be paired - disarm before any other NodeDatabase decode.
     void armNodeDatabaseDecodeTargets();
     void disarmNodeDatabaseDecodeTargets();
+
+#if HAS_NODEDB_JOURNAL
+    // Delta journal next to nodes.proto - see NodeDBJournal.h
+    NodeDBJournal nodeJournal;
+    /// Feed every live node and satellite entry to the journal. Caller holds satelliteMutex.
+    void scanNodeJournal();
+    /// Apply the journal on top of the nodes.proto just loaded
+    void replayNodeJournal();
+#endif
 };
 
 extern NodeDB *nodeDB;
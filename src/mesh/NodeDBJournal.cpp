@@ -0,0 +1,401 @@
+#include "NodeDBJournal.h"
+
+#if HAS_NODEDB_JOURNAL
+
+#include "FSCommon.h"
+#include "SPILock.h"
+#include "memory/MemAudit.h"
+#include <algorithm>
+#include <pb_encode.h>
+
+#define NODEDB_JOURNAL_MAGIC 0x314C4A4Eu // "NJL1"
+
+// Adafruit LittleFS (nRF52) opens FILE_O_WRITE positioned at the end of an existing file;
+// the other backends take stdio modes.
+#if defined(ARCH_NRF52)
+#define JOURNAL_O_APPEND FILE_O_WRITE
+#else
+#define JOURNAL_O_APPEND "a"
+#endif
+
+// nodes.jnl layout: this header, then JournalRecord + payload pairs.
+struct JournalHeader {
+    uint32_t magic;    // NODEDB_JOURNAL_MAGIC
+    uint32_t baseSize; // encoded size of the nodes.proto snapshot the records apply to
+    uint32_t baseHash; // fingerprint of its bytes
+    uint32_t reserved; // 0; kept so the header stays 16 B
+};
+static_assert(sizeof(JournalHeader) == 16, "header layout is part of the journal format");
+
+struct JournalRecord {
+    uint8_t kind;   // NodeDBJournal::Kind
+    uint8_t flags;  // RECORD_REMOVE
+    uint16_t len;   // payload bytes that follow
+    uint32_t num;   // NodeNum the entry belongs to
+    uint32_t check; // fingerprint over the fields above and the payload
+};
+static_assert(sizeof(JournalRecord) == 12, "record layout is part of the journal format");
+
+static constexpr uint8_t RECORD_REMOVE = 0x01;
+
+// FNV-1a: cheap enough to run over every entry on every save, and incremental for streamed snapshots
+static constexpr uint32_t kHashSeed = 2166136261u;
+
+static uint32_t fnv1a(const void *data, size_t len, uint32_t h)
+{
+    const uint8_t *p = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static uint32_t recordCheck(const JournalRecord &r, const uint8_t *payload)
+{
+    uint32_t h = fnv1a(&r, offsetof(JournalRecord, check), kHashSeed);
+    return fnv1a(payload, r.len, h);
+}
+
+static bool hashWrite(pb_ostream_t *stream, const pb_byte_t *buf, size_t count)
+{
+    uint32_t *h = static_cast<uint32_t *>(stream->state);
+    *h = fnv1a(buf, count, *h);
+    return true;
+}
+
+namespace
+{
+struct ByNum {
+    template <typename A, typename B> bool operator()(const A &a, const B &b) const { return num(a) < num(b); }
+    template <typename T> static NodeNum num(const T &f) { return f.num; }
+    static NodeNum num(NodeNum n) { return n; }
+};
+} // namespace
+
+NodeDBJournal::~NodeDBJournal()
+{
+    memaudit::set("nodejnl", 0);
+}
+
+void NodeDBJournal::beginScan()
+{
+    clearScan();
+}
+
+void NodeDBJournal::scan(Kind kind, NodeNum num, const uint8_t *encoded, size_t len)
+{
+    if (kind >= KIND_COUNT)
+        return;
+    const uint32_t h = fnv1a(encoded, len, kHashSeed);
+    next[kind].push_back({num, h});
+    if (!primed)
+        return; // the next save is a snapshot anyway
+
+    const auto &old = prints[kind];
+    auto it = std::lower_bound(old.begin(), old.end(), num, ByNum());
+    if (it == old.end() || it->num != num || it->hash != h)
+        queue(kind, num, encoded, len);
+}
+
+void NodeDBJournal::scanMessage(Kind kind, NodeNum num, const pb_msgdesc_t *fields, const void *src)
+{
+    uint8_t buf[kMaxPayload];
+    pb_ostream_t stream = pb_ostream_from_buffer(buf, sizeof(buf));
+    if (!pb_encode(&stream, fields, src)) {
+        // Left out of the scan it would read as removed; a snapshot carries it instead
+        LOG_WARN("NodeDB journal: can't encode entry 0x%08x (%s)", num, PB_GET_ERROR(&stream));
+        forceSnapshot = true;
+        return;
+    }
+    scan(kind, num, buf, stream.bytes_written);
+}
+
+size_t NodeDBJournal::endScan()
+{
+    for (int k = 0; k < KIND_COUNT; k++) {
+        auto &seen = next[k];
+        std::sort(seen.begin(), seen.end(), ByNum());
+        if (!primed)
+            continue;
+        for (const auto &f : prints[k]) {
+            if (!std::binary_search(seen.begin(), seen.end(), f.num, ByNum()))
+                queue(static_cast<Kind>(k), f.num, nullptr, 0);
+        }
+    }
+    scanned = true;
+    return pending.size();
+}
+
+void NodeDBJournal::queue(Kind kind, NodeNum num, const uint8_t *payload, size_t len)
+{
+    if (pendingOverflow)
+        return;
+    // Once the delta would push the journal past its budget this save becomes a snapshot, so stop buffering
+    const uint32_t cap = budget();
+    const uint32_t room = journalBytes < cap ? cap - journalBytes : 0;
+    if (pending.size() + sizeof(JournalRecord) + len > room) {
+        pendingOverflow = true;
+        pending.clear();
+        pending.shrink_to_fit();
+        return;
+    }
+
+    JournalRecord r;
+    r.kind = kind;
+    r.flags = payload ? 0 : RECORD_REMOVE;
+    r.len = payload ? static_cast<uint16_t>(len) : 0;
+    r.num = num;
+    r.check = recordCheck(r, payload);
+
+    const uint8_t *hdr = reinterpret_cast<const uint8_t *>(&r);
+    pending.insert(pending.end(), hdr, hdr + sizeof(r));
+    if (r.len)
+        pending.insert(pending.end(), payload, payload + r.len);
+}
+
+bool NodeDBJournal::wantsSnapshot() const
+{
+    if (!primed || !scanned || forceSnapshot || pendingOverflow)
+        return true;
+    return journalBytes + pending.size() > budget();
+}
+
+uint32_t NodeDBJournal::budget() const
+{
+    return std::min(kMaxBudget, std::max(kMinBudget, baseSize / 2));
+}
+
+bool NodeDBJournal::appendPending()
+{
+    if (!primed || !scanned || pendingOverflow)
+        return false;
+    if (pending.empty()) {
+        commitScan(); // nothing changed: no flash write at all
+        return true;
+    }
+
+    bool ok = false;
+    {
+        concurrency::LockGuard g(spiLock);
+        // Gone behind our back (fsFormat() after a failed save, factory reset): a snapshot must restart it
+        if (FSCom.exists(fileName)) {
+            auto f = FSCom.open(fileName, JOURNAL_O_APPEND);
+            if (f) {
+                ok = (size_t)f.write(pending.data(), pending.size()) == pending.size();
+                f.close();
+            }
+        }
+    }
+    if (!ok) {
+        LOG_WARN("NodeDB journal: append to %s failed, falling back to a snapshot", fileName);
+        forceSnapshot = true; // a partial write left a torn tail
+        return false;
+    }
+
+    journalBytes += pending.size();
+    bytesAppended += pending.size();
+    appends++;
+    LOG_DEBUG("NodeDB journal: appended %u B (%u B total)", (unsigned)pending.size(), (unsigned)journalBytes);
+    commitScan();
+    return true;
+}
+
+bool NodeDBJournal::snapshotWritten(uint32_t snapshotSize, uint32_t snapshotHash)
+{
+    if (!scanned) {
+        discard();
+        return false;
+    }
+
+    JournalHeader h;
+    h.magic = NODEDB_JOURNAL_MAGIC;
+    h.baseSize = snapshotSize;
+    h.baseHash = snapshotHash;
+    h.reserved = 0;
+
+    bool ok = false;
+    {
+        concurrency::LockGuard g(spiLock);
+        // Remove rather than truncate: FILE_O_WRITE appends on Adafruit LittleFS
+        if (FSCom.exists(fileName))
+            FSCom.remove(fileName);
+        auto f = FSCom.open(fileName, FILE_O_WRITE);
+        if (f) {
+            ok = (size_t)f.write((const uint8_t *)&h, sizeof(h)) == sizeof(h);
+            f.close();
+        }
+    }
+    snapshots++;
+    if (!ok) {
+        LOG_WARN("NodeDB journal: can't restart %s, next save writes a snapshot too", fileName);
+        primed = false;
+        clearScan();
+        return false;
+    }
+
+    baseSize = snapshotSize;
+    journalBytes = sizeof(h);
+    forceSnapshot = false;
+    primed = true;
+    commitScan();
+    return true;
+}
+
+void NodeDBJournal::adoptScan()
+{
+    if (!scanned)
+        return;
+    if (!baseMatched) {
+        clearScan(); // no journal for this snapshot yet; the first save writes one
+        return;
+    }
+    primed = true;
+    commitScan();
+}
+
+void NodeDBJournal::discard()
+{
+    clearScan();
+    for (auto &p : prints) {
+        p.clear();
+        p.shrink_to_fit();
+    }
+    primed = false;
+    baseMatched = false;
+    forceSnapshot = false;
+    baseSize = 0;
+    journalBytes = 0;
+    {
+        concurrency::LockGuard g(spiLock);
+        if (FSCom.exists(fileName))
+            FSCom.remove(fileName);
+    }
+    reportMemory();
+}
+
+int NodeDBJournal::replay(uint32_t snapshotSize, uint32_t snapshotHash, ApplyFn apply, void *ctx)
+{
+    clearScan();
+    primed = false;
+    baseMatched = false;
+    forceSnapshot = false;
+    journalBytes = 0;
+
+    concurrency::LockGuard g(spiLock);
+    auto f = FSCom.open(fileName, FILE_O_READ);
+    if (!f)
+        return -1;
+
+    JournalHeader h;
+    if ((size_t)f.read((uint8_t *)&h, sizeof(h)) != sizeof(h) || h.magic != NODEDB_JOURNAL_MAGIC ||
+        h.baseSize != snapshotSize || h.baseHash != snapshotHash) {
+        f.close();
+        LOG_INFO("NodeDB journal: %s belongs to another snapshot, ignored", fileName);
+        return -1;
+    }
+    baseMatched = true;
+    baseSize = snapshotSize;
+
+    uint32_t pos = sizeof(h);
+    int applied = 0;
+    bool torn = false;
+    uint8_t payload[kMaxPayload];
+    for (;;) {
+        JournalRecord r;
+        const size_t got = (size_t)f.read((uint8_t *)&r, sizeof(r));
+        if (got == 0)
+            break; // clean end
+        if (got != sizeof(r) || r.kind >= KIND_COUNT || r.len > kMaxPayload ||
+            (r.len && (size_t)f.read(payload, r.len) != r.len) || recordCheck(r, payload) != r.check) {
+            torn = true;
+            break;
+        }
+        apply(ctx, static_cast<Kind>(r.kind), r.num, (r.flags & RECORD_REMOVE) ? nullptr : payload, r.len);
+        applied++;
+        pos += sizeof(r) + r.len;
+    }
+    f.close();
+
+    journalBytes = pos;
+    if (torn) {
+        // Appends would land behind the bad bytes; start over from a snapshot on the next save
+        forceSnapshot = true;
+        LOG_WARN("NodeDB journal: torn record at byte %u of %s, replayed %d before it", (unsigned)pos, fileName, applied);
+    } else {
+        LOG_INFO("NodeDB journal: replayed %d records (%u B) from %s", applied, (unsigned)pos, fileName);
+    }
+    return applied;
+}
+
+bool NodeDBJournal::hashEncoded(const pb_msgdesc_t *fields, const void *src, uint32_t &size, uint32_t &hash)
+{
+    uint32_t h = kHashSeed;
+    pb_ostream_t stream = PB_OSTREAM_SIZING;
+    stream.callback = hashWrite;
+    stream.state = &h;
+    stream.max_size = SIZE_MAX;
+    if (!pb_encode(&stream, fields, src))
+        return false;
+    size = stream.bytes_written;
+    hash = h;
+    return true;
+}
+
+bool NodeDBJournal::hashFile(const char *name, uint32_t &size, uint32_t &hash)
+{
+    concurrency::LockGuard g(spiLock);
+    auto f = FSCom.open(name, FILE_O_READ);
+    if (!f)
+        return false;
+    uint32_t h = kHashSeed;
+    uint32_t total = 0;
+    uint8_t buf[256];
+    for (;;) {
+        const int got = f.read(buf, sizeof(buf));
+        if (got <= 0)
+            break;
+        h = fnv1a(buf, got, h);
+        total += got;
+    }
+    f.close();
+    size = total;
+    hash = h;
+    return true;
+}
+
+void NodeDBJournal::commitScan()
+{
+    for (int k = 0; k < KIND_COUNT; k++) {
+        prints[k].swap(next[k]);
+        next[k].clear();
+        next[k].shrink_to_fit();
+    }
+    pending.clear();
+    pending.shrink_to_fit();
+    scanned = false;
+    pendingOverflow = false;
+    reportMemory();
+}
+
+void NodeDBJournal::clearScan()
+{
+    for (auto &n : next) {
+        n.clear();
+        n.shrink_to_fit();
+    }
+    pending.clear();
+    pending.shrink_to_fit();
+    scanned = false;
+    pendingOverflow = false;
+}
+
+void NodeDBJournal::reportMemory() const
+{
+    size_t bytes = 0;
+    for (const auto &p : prints)
+        bytes += p.capacity() * sizeof(Fingerprint);
+    memaudit::set("nodejnl", bytes);
+}
+
+#endif // HAS_NODEDB_JOURNAL
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "MeshTypes.h"
+#include "configuration.h"
+#include <pb.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Needs a filesystem that can append in place, so not on the nRF54L15 shim (it only
+// knows truncate-on-write) nor STM32WL (tightest flash target, like the audits).
+// Keyed on ARCH_* rather than FSCom so this header - included by NodeDB.h - stays
+// free of the filesystem headers.
+#if (defined(ARCH_ESP32) || defined(ARCH_NRF52) || defined(ARCH_RP2040) || defined(ARCH_PORTDUINO)) &&                          \
+    !defined(ARCH_NRF54L15) && !MESHTASTIC_EXCLUDE_NODEDB_JOURNAL
+#define HAS_NODEDB_JOURNAL 1
+#else
+#define HAS_NODEDB_JOURNAL 0
+#endif
+
+#if HAS_NODEDB_JOURNAL
+
+/**
+ * Append-only delta journal for /prefs/nodes.proto.
+ *
+ * A full node DB save re-encodes and rewrites every node and satellite entry,
+ * even when only a few last_heard/SNR values moved. Instead, each save scans the
+ * live entries (scan()), keeps a 32-bit fingerprint of each one's encoding, and
+ * appends only the entries whose fingerprint changed - plus tombstones for the
+ * ones that went away - to /prefs/nodes.jnl. Once the journal outgrows half the
+ * snapshot (clamped to kMinBudget..kMaxBudget) the caller writes a full snapshot
+ * instead and the journal restarts against it: that is the compaction.
+ *
+ * File layout: a 16 B header naming the snapshot it applies to (encoded size +
+ * fingerprint of its bytes), then records of a 12 B header and the nanopb
+ * encoding of the entry. At boot replay() checks the header against the
+ * snapshot actually on disk, so a crash between writing a snapshot and
+ * restarting the journal just drops the stale journal. A torn tail record ends
+ * the replay and forces the next save to be a snapshot.
+ *
+ * The journal is plaintext, so NodeDB keeps it out of the way (discard())
+ * whenever encrypted storage is active.
+ */
+class NodeDBJournal
+{
+  public:
+    /// What a record describes; satellites are keyed by the same NodeNum as the node.
+    enum Kind : uint8_t { NODE = 0, POSITION, TELEMETRY, ENVIRONMENT, STATUS, KIND_COUNT };
+
+    /// Largest entry encoding a record can carry (EnvironmentMetrics, 161 B, is the biggest today)
+    static constexpr size_t kMaxPayload = 192;
+    /// Journal size bounds before a save compacts into a snapshot
+    static constexpr uint32_t kMinBudget = 4 * 1024;
+    static constexpr uint32_t kMaxBudget = 32 * 1024;
+
+    /// Replay callback: payload is nullptr for a removal
+    using ApplyFn = void (*)(void *ctx, Kind kind, NodeNum num, const uint8_t *payload, size_t len);
+
+    explicit NodeDBJournal(const char *fileName = "/prefs/nodes.jnl") : fileName(fileName) {}
+    ~NodeDBJournal();
+    NodeDBJournal(const NodeDBJournal &) = delete;
+    NodeDBJournal &operator=(const NodeDBJournal &) = delete;
+
+    // ---- Per-save scan: beginScan(), scan() every live entry in any order, endScan() ----
+
+    void beginScan();
+    /// Note one live entry by its encoding; queues a record if it differs from what is on disk
+    void scan(Kind kind, NodeNum num, const uint8_t *encoded, size_t len);
+    /// scan() for a nanopb message, encoded on the stack
+    void scanMessage(Kind kind, NodeNum num, const pb_msgdesc_t *fields, const void *src);
+    /// Queue removals for entries not seen this scan. @return bytes the pending delta would append
+    size_t endScan();
+    bool hasScan() const { return scanned; }
+
+    /// True if this save should write a full snapshot rather than append the pending delta
+    bool wantsSnapshot() const;
+    /// Append the pending delta; on success the scanned state is the durable one
+    bool appendPending();
+    /// A snapshot of the scanned state was written: restart the journal against it
+    bool snapshotWritten(uint32_t snapshotSize, uint32_t snapshotHash);
+    /// The scanned state is already on disk (just loaded and replayed): adopt it without writing
+    void adoptScan();
+    /// Forget all state and remove the file
+    void discard();
+
+    /**
+     * Apply the journal on top of the snapshot identified by (size, hash) - see hashFile().
+     * @return records applied, or -1 if there is no journal for this snapshot
+     */
+    int replay(uint32_t snapshotSize, uint32_t snapshotHash, ApplyFn apply, void *ctx);
+
+    // ---- Snapshot identity ----
+
+    /// Fingerprint of a message's encoding, without buffering it
+    static bool hashEncoded(const pb_msgdesc_t *fields, const void *src, uint32_t &size, uint32_t &hash);
+    /// Fingerprint of a file's bytes; matches hashEncoded() of the message it was written from
+    static bool hashFile(const char *name, uint32_t &size, uint32_t &hash);
+
+    // ---- Stats since boot ----
+
+    uint32_t getJournalBytes() const { return journalBytes; }
+    uint32_t getBytesAppended() const { return bytesAppended; }
+    uint32_t getAppends() const { return appends; }
+    uint32_t getSnapshots() const { return snapshots; }
+
+  private:
+    struct Fingerprint {
+        NodeNum num;
+        uint32_t hash;
+    };
+
+    const char *fileName;
+    std::vector<Fingerprint> prints[KIND_COUNT]; // durable state, sorted by num
+    std::vector<Fingerprint> next[KIND_COUNT];   // state being scanned
+    std::vector<uint8_t> pending;                // records queued by the scan
+    bool primed = false;                         // prints[] match snapshot + journal on disk
+    bool scanned = false;                        // endScan() ran since the last commit
+    bool baseMatched = false;                    // replay() found a journal for the loaded snapshot
+    bool forceSnapshot = false;                  // torn tail or encode failure: rewrite everything
+    bool pendingOverflow = false;                // this scan's delta would take the journal past budget()
+    uint32_t baseSize = 0;                       // encoded size of the snapshot the journal applies to
+    uint32_t journalBytes = 0;                   // file size, header included
+
+    uint32_t bytesAppended = 0;
+    uint32_t appends = 0;
+    uint32_t snapshots = 0;
+
+    /// Journal size (header included) past which a save compacts: half the snapshot, clamped
+    uint32_t budget() const;
+    void queue(Kind kind, NodeNum num, const uint8_t *payload, size_t len);
+    void commitScan();
+    void clearScan();
+    void reportMemory() const;
+};
+
+#endif // HAS_NODEDB_JOURNAL
@@ -126,6 +126,7 @@ bool NodeDB::migrateLegacyNodeDatabase()
     nodeDatabase.version = DEVICESTATE_CUR_VER;
     meshNodes = &nodeDatabase.nodes;
     numMeshNodes = nodeDatabase.nodes.size();
+    invalidateNodeIndex();
     LOG_INFO("Migrated %u nodes from legacy -> v%u (positions: %u, telemetry: %u)", (unsigned)numMeshNodes, DEVICESTATE_CUR_VER,
              (unsigned)posCount, (unsigned)telCount);
     return true;
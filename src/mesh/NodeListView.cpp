@@ -0,0 +1,38 @@
+#include "NodeListView.h"
+#include "NodeDB.h"
+
+bool NodeListView::refresh()
+{
+    const uint32_t gen = nodeDB->getNodeListGeneration();
+    const NodeNum own = nodeDB->getNodeNum();
+    const size_t count = nodeDB->getNumMeshNodes();
+    if (built && gen == generation && own == ownNode && count == nodeCount)
+        return false;
+
+    slots.clear();
+    positions.clear();
+    for (size_t i = 0; i < count; i++) {
+        const meshtastic_NodeInfoLite *n = nodeDB->getMeshNodeByIndex(i);
+        if (!includeOwnNode && n->num == own)
+            continue;
+        if (filter == POSITIONED_NODES) {
+            meshtastic_PositionLite pos;
+            if (!nodeDB->copyNodePosition(n->num, pos))
+                continue;
+            positions.push_back({pos.latitude_i, pos.longitude_i});
+        }
+        slots.push_back((uint16_t)i);
+    }
+
+    built = true;
+    generation = gen;
+    ownNode = own;
+    nodeCount = count;
+    rebuilds++;
+    return true;
+}
+
+meshtastic_NodeInfoLite *NodeListView::node(size_t i) const
+{
+    return nodeDB->getMeshNodeByIndex(slots[i]);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "MeshTypes.h"
+#include "mesh/generated/meshtastic/deviceonly.pb.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Cached, filtered node list for the screen renderers.
+ *
+ * The node list screens and the InkHUD map walk every node on every frame, checking
+ * each for a position and then looking the visible ones up again by NodeNum. A
+ * NodeListView does that walk once and keeps the meshNodes[] slots (and, for
+ * POSITIONED_NODES, the coordinates) of the matching nodes in NodeDB order.
+ * refresh() rebuilds only when NodeDB::getNodeListGeneration() or our own NodeNum
+ * moved, so between DB changes a frame costs O(visible rows).
+ *
+ * Only membership and order are cached; node() hands back the live entry, so
+ * names, SNR, hops etc. are always current. Filters on those fields stay with
+ * the caller. Main-thread use only, like the rest of the UI.
+ */
+class NodeListView
+{
+  public:
+    enum Filter : uint8_t {
+        ALL_NODES,        ///< Every node
+        POSITIONED_NODES, ///< Nodes with an entry in the position store, coordinates cached
+    };
+
+    struct Coords {
+        int32_t latitude_i;
+        int32_t longitude_i;
+    };
+
+    NodeListView(Filter filter, bool includeOwnNode) : filter(filter), includeOwnNode(includeOwnNode) {}
+
+    /// Rebuild if NodeDB changed since the last call. @return true if it rebuilt
+    bool refresh();
+
+    size_t size() const { return slots.size(); }
+    bool empty() const { return slots.empty(); }
+
+    /// The i'th node of the view, straight from meshNodes[]
+    meshtastic_NodeInfoLite *node(size_t i) const;
+    /// Position of the i'th node as of the last rebuild (POSITIONED_NODES only)
+    const Coords &coords(size_t i) const { return positions[i]; }
+    /// Either coordinate set, the same test as NodeDB::hasValidPosition()
+    bool hasFix(size_t i) const { return positions[i].latitude_i != 0 || positions[i].longitude_i != 0; }
+
+    /// Rebuilds since boot, for tests and benchmarks
+    uint32_t getRebuilds() const { return rebuilds; }
+
+  private:
+    const Filter filter;
+    const bool includeOwnNode;
+
+    std::vector<uint16_t> slots;  // meshNodes[] slots, NodeDB order
+    std::vector<Coords> positions; // parallel to slots, POSITIONED_NODES only
+
+    bool built = false;
+    uint32_t generation = 0; // NodeDB::getNodeListGeneration() when built
+    NodeNum ownNode = 0;     // nodeDB->getNodeNum() when built
+    size_t nodeCount = 0;    // nodeDB->getNumMeshNodes() when built, catches unannounced refills
+    uint32_t rebuilds = 0;
+};
@@ -266,6 +266,13 @@ PhoneAPI::~PhoneAPI()
 
 void PhoneAPI::handleStartConfig()
 {
+    // Every API client reads mesh traffic through a cursor of its own; with all of them taken, turn this one away
+    // rather than let it sit connected and never see a packet
+    if (!service->attachPhoneClient(this)) {
+        LOG_WARN("Too many API clients (max %d), ignore want_config", MAX_PHONE_API_CLIENTS);
+        return;
+    }
+
     // Must be before setting state (because state is how we know !connected)
     if (!isConnected()) {
         onConnectionChanged(true);
@@ -336,11 +343,9 @@ void PhoneAPI::handleStartConfig()
 #endif
 
     LOG_INFO("Start API client config millis=%u", millis());
-    // Protect against concurrent BLE callbacks: they run in NimBLE's FreeRTOS task and also touch nodeInfoQueue.
+    // Protect against concurrent BLE callbacks: they run in NimBLE's FreeRTOS task and also touch the replay state.
     {
         concurrency::LockGuard guard(&nodeInfoMutex);
-        nodeInfoForPhone = {};
-        nodeInfoQueue.clear();
         replayQueue.clear();
         replayPositionOrder.clear();
         replayTelemetryOrder.clear();
@@ -378,6 +383,7 @@ void PhoneAPI::close()
         unobserve(&xModem.packetReady);
 #endif
         releasePhonePacket(); // Don't leak phone packets on shutdown
+        service->detachPhoneClient(this); // Other clients may still be reading the shared to-phone stream
         releaseQueueStatusPhonePacket();
         releaseMqttClientProxyPhonePacket();
         releaseClientNotification();
@@ -387,8 +393,6 @@ void PhoneAPI::close()
         // Clear cached node info under lock because NimBLE callbacks can still be draining it.
         {
             concurrency::LockGuard guard(&nodeInfoMutex);
-            nodeInfoForPhone = {};
-            nodeInfoQueue.clear();
             replayQueue.clear();
             replayPositionOrder.clear();
             replayTelemetryOrder.clear();
@@ -616,17 +620,8 @@ size_t PhoneAPI::getFromRadio(uint8_t *buf)
             auto info = TypeConversions::ConvertToNodeInfo(us);
             info.has_hops_away = false;
             info.is_favorite = true;
-            {
-                concurrency::LockGuard guard(&nodeInfoMutex);
-                nodeInfoForPhone = info;
-            }
             fromRadioScratch.which_payload_variant = meshtastic_FromRadio_node_info_tag;
             fromRadioScratch.node_info = info;
-            // Should allow us to resume sending NodeInfo in STATE_SEND_OTHER_NODEINFOS
-            {
-                concurrency::LockGuard guard(&nodeInfoMutex);
-                nodeInfoForPhone.num = 0;
-            }
         }
         if (config_nonce == SPECIAL_NONCE_ONLY_NODES) {
             // If client only wants node info, jump directly to sending nodes
@@ -946,41 +941,38 @@ size_t PhoneAPI::getFromRadio(uint8_t *buf)
         break;
 
     case STATE_SEND_OTHER_NODEINFOS: {
-        if (readIndex == 2) { //  readIndex==2 will be true for the first non-us node
+        if (readIndex == 1) { //  readIndex==1 will be true for the first non-us node
             LOG_INFO("Start sending nodeinfos millis=%u", millis());
         }
 
-        meshtastic_NodeInfo infoToSend = {};
+        // Other-node NodeInfos always go out thin (no bundled position/device_metrics); the post-config_complete_id
+        // replay drain delivers those as ordinary mesh packets. The record is encoded field by field straight into buf,
+        // skipping the NodeInfo conversion and fromRadioScratch, which matters for 1000+ node databases.
+        size_t numbytes = 0;
+        bool haveNode = false;
         {
             concurrency::LockGuard guard(&nodeInfoMutex);
-            if (nodeInfoForPhone.num == 0 && !nodeInfoQueue.empty()) {
-                // Serve the next cached node without re-reading from the DB iterator.
-                nodeInfoForPhone = nodeInfoQueue.front();
-                nodeInfoQueue.pop_front();
+            auto nextNode = nodeDB->readNextMeshNode(readIndex);
+            if (nextNode) {
+                haveNode = true;
+                bool isUs = nextNode->num == nodeDB->getNodeNum();
+                numbytes = TypeConversions::EncodeNodeInfoThinFromRadio(buf, meshtastic_FromRadio_size, nextNode, isUs,
+                                                                        isUs ? getValidTime(RTCQualityFromNet) : 0);
             }
-            infoToSend = nodeInfoForPhone;
-            if (infoToSend.num != 0)
-                nodeInfoForPhone = {};
         }
 
-        if (infoToSend.num != 0) {
-            // Just in case we stored a different user.id in the past, but should never happen going forward
-            sprintf(infoToSend.user.id, "!%08x", infoToSend.num);
-
-            fromRadioScratch.which_payload_variant = meshtastic_FromRadio_node_info_tag;
-            fromRadioScratch.node_info = infoToSend;
-            prefetchNodeInfos();
-        } else {
-            LOG_DEBUG("Done sending %d of %d nodeinfos millis=%u", readIndex, nodeDB->getNumMeshNodes(), millis());
-            nodeInfoMutex.lock();
-            nodeInfoQueue.clear();
-            nodeInfoMutex.unlock();
-            // Satellite-DB replay (positions/telemetry/environment/status) now happens
-            // *after* config_complete_id, interleaved with live traffic in STATE_SEND_PACKETS.
-            state = STATE_SEND_FILEMANIFEST;
-            return getFromRadio(buf);
+        if (haveNode) {
+            if (readIndex == 2 || readIndex % 20 == 0) {
+                LOG_DEBUG("nodeinfo: %d/%d", readIndex, nodeDB->getNumMeshNodes());
+            }
+            return numbytes;
         }
-        break;
+
+        LOG_DEBUG("Done sending %d of %d nodeinfos millis=%u", readIndex, nodeDB->getNumMeshNodes(), millis());
+        // Satellite-DB replay (positions/telemetry/environment/status) now happens
+        // *after* config_complete_id, interleaved with live traffic in STATE_SEND_PACKETS.
+        state = STATE_SEND_FILEMANIFEST;
+        return getFromRadio(buf);
     }
 
     case STATE_SEND_FILEMANIFEST: {
@@ -1158,7 +1150,7 @@ void PhoneAPI::sendConfigComplete()
 void PhoneAPI::releasePhonePacket()
 {
     if (packetForPhone) {
-        service->releaseToPool(packetForPhone); // we just copied the bytes, so don't need this buffer anymore
+        service->releaseForPhone(this, packetForPhone); // we just copied the bytes, so don't need this buffer anymore
         packetForPhone = NULL;
     }
 }
@@ -1171,41 +1163,6 @@ void PhoneAPI::releaseQueueStatusPhonePacket()
     }
 }
 
-void PhoneAPI::prefetchNodeInfos()
-{
-    bool added = false;
-    bool wasEmpty = false;
-    // Other-node NodeInfos always go out thin (no bundled position/device_metrics).
-    // The post-config_complete_id replay drain delivers those as ordinary mesh packets.
-    // Keep the queue topped up so BLE reads stay responsive even if DB fetches take a moment.
-    {
-        concurrency::LockGuard guard(&nodeInfoMutex);
-        wasEmpty = nodeInfoQueue.empty();
-        while (nodeInfoQueue.size() < kNodePrefetchDepth) {
-            auto nextNode = nodeDB->readNextMeshNode(readIndex);
-            if (!nextNode)
-                break;
-
-            auto info = TypeConversions::ConvertToNodeInfoThin(nextNode);
-            bool isUs = info.num == nodeDB->getNodeNum();
-            info.hops_away = isUs ? 0 : info.hops_away;
-            info.last_heard = isUs ? getValidTime(RTCQualityFromNet) : info.last_heard;
-            info.snr = isUs ? 0 : info.snr;
-            info.via_mqtt = isUs ? false : info.via_mqtt;
-            info.is_favorite = info.is_favorite || isUs;
-            nodeInfoQueue.push_back(info);
-            // Log progress here (at fetch time) so readIndex is accurate and each value logs only once.
-            if (readIndex == 2 || readIndex % 20 == 0) {
-                LOG_DEBUG("nodeinfo: %d/%d", readIndex, nodeDB->getNumMeshNodes());
-            }
-            added = true;
-        }
-    }
-
-    if (added && wasEmpty)
-        onNowHasData(0);
-}
-
 namespace
 {
 /// Derive a stable id for a replayed satellite-DB record. Unchanged history replayed on
@@ -1613,17 +1570,8 @@ bool PhoneAPI::available()
     case STATE_SEND_COMPLETE_ID:
         return true;
 
-    case STATE_SEND_OTHER_NODEINFOS: {
-        concurrency::LockGuard guard(&nodeInfoMutex);
-        if (nodeInfoQueue.empty()) {
-            // Drop the lock before prefetching; prefetchNodeInfos() will re-acquire it.
-            goto PREFETCH_NODEINFO;
-        }
-    }
+    case STATE_SEND_OTHER_NODEINFOS:
         return true; // Always say we have something, because we might need to advance our state machine
-    PREFETCH_NODEINFO:
-        prefetchNodeInfos();
-        return true;
     case STATE_SEND_PACKETS: {
         if (!queueStatusPacketForPhone)
             queueStatusPacketForPhone = service->getQueueStatusForPhone();
@@ -1657,7 +1605,7 @@ bool PhoneAPI::available()
 #endif
 
         if (!packetForPhone)
-            packetForPhone = service->getForPhone();
+            packetForPhone = service->getForPhone(this);
         hasPacket = !!packetForPhone;
         if (hasPacket)
             return true;
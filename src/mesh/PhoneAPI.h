@@ -82,8 +82,8 @@ class PhoneAPI
      */
     uint32_t fromRadioNum = 0;
 
-    /// We temporarily keep the packet here between the call to available and getFromRadio.  We will free it after the phone
-    /// downloads it
+    /// We temporarily keep the packet here between the call to available and getFromRadio.  We hand it back to
+    /// MeshService (releaseForPhone) after the phone downloads it; live mesh packets are shared with other clients.
     meshtastic_MeshPacket *packetForPhone = NULL;
 
     // file transfer packets destined for phone. Push it to the queue then free it.
@@ -98,13 +98,9 @@ class PhoneAPI
     // Keep ClientNotification packet just as packetForPhone
     meshtastic_ClientNotification *clientNotification = NULL;
 
-    /// We temporarily keep the nodeInfo here between the call to available and getFromRadio
-    meshtastic_NodeInfo nodeInfoForPhone = meshtastic_NodeInfo_init_default;
-    // Prefetched node info entries ready for immediate transmission to the phone.
-    std::deque<meshtastic_NodeInfo> nodeInfoQueue;
-    // Tunable size of the node info cache so we can keep BLE reads non-blocking.
-    static constexpr size_t kNodePrefetchDepth = 4;
-    // Protect nodeInfoForPhone + nodeInfoQueue because NimBLE callbacks run in a separate FreeRTOS task.
+    // Other-node NodeInfos are streamed straight from the NodeDB record into the transport buffer (see
+    // TypeConversions::EncodeNodeInfoThinFromRadio), so there is no per-node NodeInfo copy or prefetch queue.
+    // Protect readIndex + the replay state because NimBLE callbacks run in a separate FreeRTOS task.
     concurrency::Lock nodeInfoMutex;
 
     // Synthetic-packet replay queue (paced via prefetch).
@@ -275,7 +271,6 @@ class PhoneAPI
 
     void releaseQueueStatusPhonePacket();
 
-    void prefetchNodeInfos();
     void beginReplayPositions();
     void prefetchReplayPositions();
     void beginReplayTelemetry();
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Shares one stream of to-phone packets between several API clients (BLE, serial, HTTP, each TCP session), each reading
+ * at its own pace through a cursor instead of getting its own copy of every packet.
+ *
+ * Packets are pulled from the source (MeshService::toPhoneQueue) only when the fastest client has caught up with the
+ * newest one buffered here, so any backlog stays in the source queue where its retention-class eviction applies. A
+ * packet is freed once every attached client has moved past it. When the ring is full and the fastest client wants
+ * more, the oldest packet is dropped for the clients still behind it; they skip ahead and the skip is counted.
+ *
+ * A client that has peek()ed a packet but not yet finished with it pins it: the pointer stays valid until done() or
+ * detach(). A pin never stalls the others. If the ring overflows while its oldest packet is pinned, that packet leaves
+ * the ring anyway and is handed to the pinning clients alone, to be freed when the last of them lets go; they then
+ * carry on from the new oldest packet like any other lagging client. So at most Capacity packets are buffered, plus one
+ * per stalled client.
+ *
+ * Clients are identified by an opaque pointer (the PhoneAPI). attach() claims a cursor up front so the caller can turn
+ * away a client when all MaxClients are taken; peek() attaches on first use as well. Not thread safe; the owner
+ * serializes access.
+ */
+template <class T, size_t Capacity, size_t MaxClients> class PhoneFanout
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(MaxClients > 0, "MaxClients must be positive");
+
+    struct Entry {
+        T *p = nullptr;
+        uint8_t holds = 0; // clients currently pinning this packet
+    };
+
+    struct Cursor {
+        const void *client = nullptr;
+        uint32_t next = 0;    // sequence number of the next packet this client reads
+        bool holding = false; // pins the ring entry at `next`
+        T *orphan = nullptr;  // pinned packet that overflowed out of the ring, owned by the pinning clients
+    };
+
+    Entry ring[Capacity];
+    Cursor cursors[MaxClients];
+    uint32_t headSeq = 0; // oldest buffered packet
+    uint32_t tailSeq = 0; // one past the newest buffered packet
+    uint32_t skipped = 0;
+    void (*const releaseFn)(T *);
+
+    static bool before(uint32_t a, uint32_t b) { return (int32_t)(a - b) < 0; }
+
+    Entry &at(uint32_t seq) { return ring[seq & (Capacity - 1)]; }
+
+    Cursor *find(const void *client)
+    {
+        for (auto &c : cursors)
+            if (c.client == client)
+                return &c;
+        return nullptr;
+    }
+
+    Cursor *findOrAttach(const void *client)
+    {
+        if (Cursor *c = find(client))
+            return c;
+        for (auto &c : cursors) {
+            if (!c.client) {
+                // A new client starts at the oldest packet still buffered for the others
+                c.client = client;
+                c.next = headSeq;
+                c.holding = false;
+                return &c;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Drop the oldest buffered packet. Clients pinning it keep it as an orphan instead of it being freed.
+    void dropHead()
+    {
+        Entry &e = at(headSeq);
+        if (e.holds) {
+            for (auto &c : cursors) {
+                if (c.client && c.holding && c.next == headSeq) {
+                    c.orphan = e.p;
+                    c.holding = false;
+                    c.next = headSeq + 1;
+                }
+            }
+        } else {
+            releaseFn(e.p);
+        }
+        e = Entry();
+        headSeq++;
+    }
+
+    /// The client lets go of its orphan; the last holder frees it.
+    void releaseOrphan(Cursor *c)
+    {
+        T *p = c->orphan;
+        c->orphan = nullptr;
+        for (const auto &other : cursors)
+            if (other.orphan == p)
+                return;
+        releaseFn(p);
+    }
+
+    /// Free buffered packets every attached client has moved past.
+    void reclaim()
+    {
+        while (headSeq != tailSeq) {
+            for (const auto &c : cursors)
+                if (c.client && !before(headSeq, c.next))
+                    return;
+            releaseFn(at(headSeq).p);
+            at(headSeq) = Entry();
+            headSeq++;
+        }
+    }
+
+  public:
+    explicit PhoneFanout(void (*release)(T *)) : releaseFn(release) {}
+
+    PhoneFanout(const PhoneFanout &) = delete;
+    PhoneFanout &operator=(const PhoneFanout &) = delete;
+
+    /**
+     * Claim a cursor for `client` (a no-op if it already has one).
+     * @return false if every cursor slot is taken by other clients
+     */
+    bool attach(const void *client) { return findOrAttach(client) != nullptr; }
+
+    /**
+     * Return the next packet for `client`, calling `source()` for a new one when the client is at the newest buffered
+     * packet. The packet stays owned by the fan-out; hand it back with done().
+     * @return nullptr if nothing is waiting, or if every cursor slot is taken by other clients
+     */
+    template <typename Source> T *peek(const void *client, Source source)
+    {
+        Cursor *c = findOrAttach(client);
+        if (!c)
+            return nullptr;
+        if (c->orphan)
+            return c->orphan;
+        if (c->holding)
+            return at(c->next).p;
+
+        if (before(c->next, headSeq)) {
+            skipped += headSeq - c->next;
+            c->next = headSeq;
+        }
+        if (c->next == tailSeq) {
+            T *p = source();
+            if (!p)
+                return nullptr;
+            if (tailSeq - headSeq == Capacity)
+                dropHead();
+            at(tailSeq).p = p;
+            tailSeq++;
+        }
+
+        Entry &e = at(c->next);
+        e.holds++;
+        c->holding = true;
+        return e.p;
+    }
+
+    /**
+     * The client finished with the packet peek() returned and moves on to the next one.
+     * @return false if `p` is not this client's pinned packet (e.g. a packet from another source); the caller owns it
+     */
+    bool done(const void *client, T *p)
+    {
+        Cursor *c = find(client);
+        if (c && c->orphan && c->orphan == p) {
+            releaseOrphan(c); // `next` already points past it
+            reclaim();
+            return true;
+        }
+        if (!c || !c->holding || at(c->next).p != p)
+            return false;
+        at(c->next).holds--;
+        c->holding = false;
+        c->next++;
+        reclaim();
+        return true;
+    }
+
+    /// Forget `client`, dropping its pin. Packets only it still needed are freed.
+    void detach(const void *client)
+    {
+        Cursor *c = find(client);
+        if (!c)
+            return;
+        if (c->orphan)
+            releaseOrphan(c);
+        if (c->holding)
+            at(c->next).holds--;
+        *c = Cursor();
+        reclaim();
+    }
+
+    size_t numClients() const
+    {
+        size_t n = 0;
+        for (const auto &c : cursors)
+            n += c.client ? 1 : 0;
+        return n;
+    }
+
+    /// Packets held for clients that have not read them yet
+    size_t numBuffered() const { return tailSeq - headSeq; }
+
+    /// Packets slow clients never saw because the ring overflowed
+    uint32_t getSkipped() const { return skipped; }
+};
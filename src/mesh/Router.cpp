@@ -232,7 +232,8 @@ int32_t Router::runOnce()
  */
 void Router::enqueueReceivedMessage(meshtastic_MeshPacket *p)
 {
-    // Try enqueue until successful
+    // Try enqueue until successful. Dropping the oldest from this (producer) side is safe because the radio
+    // interfaces and Router::runOnce() both run on the main thread.
     while (!fromRadioQueue.enqueue(p, 0)) {
         meshtastic_MeshPacket *old_p;
         old_p = fromRadioQueue.dequeuePtr(0); // Dequeue and discard the oldest packet
@@ -785,6 +786,56 @@ static void adminKeyFallbackRefund()
 }
 #endif
 
+// Channel-trial cache for perhapsDecode(): which channel index last decoded a given sender on a given channel hash, so when
+// several of our channels share a hash the right PSK is tried first. Direct-mapped and hint-only: a wrong entry costs nothing
+// extra because that channel is skipped in the following scan. Protected by cryptLock, like the rest of perhapsDecode().
+struct DecodeTrialEntry {
+    NodeNum from;
+    ChannelHash hash;
+    uint8_t chIndexPlusOne; // 0 == empty
+};
+static constexpr size_t DECODE_TRIAL_CACHE_SIZE = 32; // power of two
+static DecodeTrialEntry decodeTrialCache[DECODE_TRIAL_CACHE_SIZE];
+static DecodeTrialStats decodeTrialStats;
+
+// First byte of every encoded meshtastic_Data we can accept: encoders write fields in tag order and portnum is field 1.
+static constexpr uint8_t DATA_PORTNUM_TAG = (meshtastic_Data_portnum_tag << 3) | PB_WT_VARINT;
+
+static DecodeTrialEntry &decodeTrialSlot(NodeNum from, ChannelHash hash)
+{
+    uint32_t h = (from ^ ((uint32_t)hash << 24)) * 0x9E3779B9u;
+    return decodeTrialCache[h >> 27];
+}
+
+/// @return the channel index that last decoded `from` on `hash`, or -1
+static int decodeTrialLookup(NodeNum from, ChannelHash hash)
+{
+    const DecodeTrialEntry &e = decodeTrialSlot(from, hash);
+    return (e.chIndexPlusOne && e.from == from && e.hash == hash) ? e.chIndexPlusOne - 1 : -1;
+}
+
+static void decodeTrialRemember(NodeNum from, ChannelHash hash, ChannelIndex chIndex)
+{
+    DecodeTrialEntry &e = decodeTrialSlot(from, hash);
+    e.from = from;
+    e.hash = hash;
+    e.chIndexPlusOne = chIndex + 1;
+}
+
+const DecodeTrialStats &getDecodeTrialStats()
+{
+    return decodeTrialStats;
+}
+
+#ifdef PIO_UNIT_TESTING
+void resetDecodeTrials()
+{
+    concurrency::LockGuard g(cryptLock);
+    decodeTrialStats = DecodeTrialStats();
+    memset(decodeTrialCache, 0, sizeof(decodeTrialCache));
+}
+#endif
+
 DecodeState perhapsDecode(meshtastic_MeshPacket *p)
 {
     concurrency::LockGuard g(cryptLock);
@@ -897,11 +948,32 @@ DecodeState perhapsDecode(meshtastic_MeshPacket *p)
 
     // assert(p->which_payloadVariant == MeshPacket_encrypted_tag);
     if (!decrypted) {
-        // Try to find a channel that works with this hash
-        for (chIndex = 0; chIndex < channels.getNumChannels(); chIndex++) {
+        // Try to find a channel that works with this hash. The channel that last decoded this sender on this hash goes
+        // first (trial -1), then every channel in index order, skipping the one already tried.
+        const int cachedIndex = decodeTrialLookup(p->from, p->channel);
+        for (int trial = cachedIndex >= 0 ? -1 : 0; trial < channels.getNumChannels(); trial++) {
+            if (trial == cachedIndex)
+                continue;
+            chIndex = trial < 0 ? cachedIndex : trial;
             // Try to use this hash/channel pair
             if (channels.decryptForHash(chIndex, p->channel)) {
                 matchedChannel = true;
+                decodeTrialStats.attempts++;
+
+                // Cheap pre-check: AES-CTR plaintext can be recovered a prefix at a time, so decrypt just the first two
+                // bytes and require the portnum tag with a non-zero value before paying for the full decrypt and pb_decode.
+                // A wrong PSK passes this only about once in 65536 tries.
+                uint8_t head[2];
+                if (rawSize >= sizeof(head)) {
+                    memcpy(head, p->encrypted.bytes, sizeof(head));
+                    crypto->decrypt(p->from, p->id, sizeof(head), head);
+                }
+                if (rawSize < sizeof(head) || head[0] != DATA_PORTNUM_TAG || head[1] == 0) {
+                    decodeTrialStats.preRejects++;
+                    LOG_DEBUG("No portnum in received mesh packet id=0x%08x (bad psk?)", p->id);
+                    continue;
+                }
+
                 // we have to copy into a scratch buffer, because these bytes are a union with the decoded protobuf. Create a
                 // fresh copy for each decrypt attempt.
                 memcpy(bytes, p->encrypted.bytes, rawSize);
@@ -923,6 +995,12 @@ DecodeState perhapsDecode(meshtastic_MeshPacket *p)
                     return DecodeState::DECODE_FAILURE;
 #endif
                 } else {
+                    if (trial < 0) {
+                        decodeTrialStats.cacheHits++;
+                    } else {
+                        decodeTrialStats.cacheMisses++;
+                        decodeTrialRemember(p->from, p->channel, chIndex);
+                    }
                     p->decoded = decodedtmp;
                     p->which_payload_variant = meshtastic_MeshPacket_decoded_tag; // change type to decoded
                     decrypted = true;
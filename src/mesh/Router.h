@@ -5,8 +5,8 @@
 #include "MeshTypes.h"
 #include "Observer.h"
 #include "PacketHistory.h"
-#include "PointerQueue.h"
 #include "RadioInterface.h"
+#include "SPSCPointerQueue.h"
 #include "concurrency/OSThread.h"
 #include <memory>
 
@@ -17,8 +17,8 @@ class Router : protected concurrency::OSThread, protected PacketHistory
 {
   private:
     /// Packets which have just arrived from the radio, ready to be processed by this service and possibly
-    /// forwarded to the phone.
-    PointerQueue<meshtastic_MeshPacket> fromRadioQueue;
+    /// forwarded to the phone. Lock-free: the radio side only enqueues, runOnce() only dequeues.
+    SPSCPointerQueue<meshtastic_MeshPacket> fromRadioQueue;
 
   protected:
     std::unique_ptr<RadioInterface> iface = nullptr;
@@ -174,6 +174,22 @@ enum class RoutingAuthVerdict { ACCEPT, OPAQUE_RELAY_ONLY, REJECT };
  */
 DecodeState perhapsDecode(meshtastic_MeshPacket *p);
 
+/** Channel-trial counters for perhapsDecode(), to measure what the (channel hash, sender) cache and the portnum pre-check save
+ * on busy channels. Hits and misses count channel-decoded packets only; attempts and preRejects count every channel tried. */
+struct DecodeTrialStats {
+    uint32_t cacheHits = 0;   ///< decoded by the channel remembered for this (hash, from) on the first try
+    uint32_t cacheMisses = 0; ///< decoded, but only after scanning (no entry, or the remembered channel failed)
+    uint32_t attempts = 0;    ///< channel decrypt attempts
+    uint32_t preRejects = 0;  ///< attempts rejected by the portnum tag check, without a full decrypt or pb_decode
+};
+
+/** @return perhapsDecode()'s channel-trial counters since boot */
+const DecodeTrialStats &getDecodeTrialStats();
+#ifdef PIO_UNIT_TESTING
+/** Zero the counters and forget every remembered channel */
+void resetDecodeTrials();
+#endif
+
 /** Apply receive authentication before routing state mutation; unknown-channel packets may remain opaque relay-only. */
 RoutingAuthVerdict passesRoutingAuthGate(meshtastic_MeshPacket *p);
 #ifdef PIO_UNIT_TESTING
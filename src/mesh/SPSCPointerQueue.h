@@ -0,0 +1,132 @@
+#pragma once
+
+#include "concurrency/OSThread.h"
+#include "freertosinc.h"
+#include <atomic>
+#include <cassert>
+
+/**
+ * A lock-free single-producer/single-consumer ring of pointers, with the same interface as PointerQueue and
+ * StaticPointerQueue.
+ *
+ * One context may enqueue (a task, a thread, or an ISR via enqueueFromISR) while another dequeues, with no lock and
+ * no RTOS call: head is written only by the consumer and tail only by the producer, each published with a release
+ * store and read with an acquire load, so plain 32-bit atomic loads/stores are all that is needed on every target.
+ *
+ * Anything else - dequeueing from the producer to drop the oldest entry, or rotating the queue in place - is only safe
+ * when producer and consumer run on the same thread (as Router's fromRadioQueue does, from the main loop). Queues with
+ * several consumers, such as MeshService's to-phone queues that BLE drains from its own task, need a lock instead.
+ *
+ * StaticCapacity > 0 keeps the ring inline (no allocation); StaticCapacity == 0 allocates `capacity` slots once in the
+ * constructor, for targets where the size is runtime configuration (portduino's MaxMessageQueue).
+ */
+template <class T, int StaticCapacity = 0> class SPSCPointerQueue
+{
+    static_assert(StaticCapacity >= 0, "StaticCapacity must not be negative");
+
+    // One slot is always left empty so head == tail means empty and never full
+    T *inlineSlots[StaticCapacity > 0 ? StaticCapacity + 1 : 1];
+    T **slots;
+    const uint32_t size; // slot count: capacity + 1
+
+    std::atomic<uint32_t> head{0}; // next slot to read; written by the consumer only
+    std::atomic<uint32_t> tail{0}; // next slot to write; written by the producer only
+    concurrency::OSThread *reader = nullptr;
+
+    uint32_t advance(uint32_t i) const { return (i + 1 == size) ? 0 : i + 1; }
+
+    bool push(T *x)
+    {
+        const uint32_t t = tail.load(std::memory_order_relaxed);
+        const uint32_t next = advance(t);
+        if (next == head.load(std::memory_order_acquire))
+            return false; // full
+        slots[t] = x;
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+  public:
+    SPSCPointerQueue() : slots(inlineSlots), size(StaticCapacity + 1)
+    {
+        static_assert(StaticCapacity > 0, "use SPSCPointerQueue(capacity) when StaticCapacity is 0");
+    }
+
+    explicit SPSCPointerQueue(int capacity)
+        : slots(StaticCapacity > 0 ? inlineSlots : new T *[capacity + 1]),
+          size(StaticCapacity > 0 ? StaticCapacity + 1 : capacity + 1)
+    {
+        assert(capacity > 0 && (StaticCapacity == 0 || capacity == StaticCapacity));
+    }
+
+    ~SPSCPointerQueue()
+    {
+        if (slots != inlineSlots)
+            delete[] slots;
+    }
+
+    SPSCPointerQueue(const SPSCPointerQueue &) = delete;
+    SPSCPointerQueue &operator=(const SPSCPointerQueue &) = delete;
+
+    int numUsed() const
+    {
+        const uint32_t h = head.load(std::memory_order_acquire);
+        const uint32_t t = tail.load(std::memory_order_acquire);
+        return static_cast<int>(t >= h ? t - h : size - h + t);
+    }
+
+    int numFree() const { return getMaxLen() - numUsed(); }
+
+    bool isEmpty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+
+    int getMaxLen() const { return static_cast<int>(size - 1); }
+
+    /** Never blocks: maxWait is accepted for PointerQueue compatibility. The reader is woken only after the entry is
+     * visible, so it can never wake to an empty queue. */
+    bool enqueue(T *x, TickType_t maxWait = portMAX_DELAY)
+    {
+        if (!push(x))
+            return false;
+        if (reader) {
+            reader->setInterval(0);
+            concurrency::mainDelay.interrupt();
+        }
+        return true;
+    }
+
+    bool enqueueFromISR(T *x, BaseType_t *higherPriWoken)
+    {
+        if (!push(x))
+            return false;
+        if (reader) {
+            reader->setInterval(0);
+            concurrency::mainDelay.interruptFromISR(higherPriWoken);
+        }
+        return true;
+    }
+
+    bool dequeue(T **p, TickType_t maxWait = portMAX_DELAY)
+    {
+        const uint32_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+            return false; // empty
+        *p = slots[h];
+        head.store(advance(h), std::memory_order_release);
+        return true;
+    }
+
+    // returns a ptr or null if the queue was empty
+    T *dequeuePtr(TickType_t maxWait = portMAX_DELAY)
+    {
+        T *p;
+        return dequeue(&p, maxWait) ? p : nullptr;
+    }
+
+    /**
+     * Set a thread that is reading from this queue
+     * If a message is pushed to this queue that thread will be scheduled to run ASAP.
+     *
+     * Note: thread will not be automatically enabled, just have its interval set to 0
+     */
+    void setReader(concurrency::OSThread *t) { reader = t; }
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "MeshTypes.h"
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+/**
+ * Per-NodeNum satellite storage for NodeDB (positions, telemetry, environment, status).
+ *
+ * A sorted flat vector of {NodeNum, value} pairs instead of a std::map: one heap block
+ * per store rather than one rb-tree node per entry, so a full store is a handful of
+ * allocations for the life of the device instead of MAX_SATELLITE_NODES small ones
+ * scattered across the nRF52 heap. The block grows by kGrowBy entries at a time
+ * (stores are capped at MAX_SATELLITE_NODES, so that is a few reallocations early
+ * on, then none) and is only released by clear().
+ *
+ * Lookups are a binary search; inserts and erases shift the tail, which at these
+ * sizes is a few KB of memmove at most. Keeps the std::map subset NodeDB uses
+ * (operator[] inserting a zeroed value, find/count/erase, iteration in NodeNum
+ * order over kv.first/kv.second) so callers read the same.
+ *
+ * Not thread-safe; NodeDB guards its stores with satelliteMutex.
+ */
+template <typename V> class SatelliteStore
+{
+  public:
+    using value_type = std::pair<NodeNum, V>;
+    using iterator = value_type *;
+    using const_iterator = const value_type *;
+
+    /// Entries added per reallocation
+    static constexpr size_t kGrowBy = 8;
+
+    iterator begin() { return entries.data(); }
+    iterator end() { return entries.data() + entries.size(); }
+    const_iterator begin() const { return entries.data(); }
+    const_iterator end() const { return entries.data() + entries.size(); }
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+
+    /// Heap bytes held, for memaudit
+    size_t bytes() const { return entries.capacity() * sizeof(value_type); }
+
+    /// Bumped by every call that can add, remove or write an entry (operator[], erase, clear),
+    /// so a cache built from the store can tell it is stale
+    uint32_t generation() const { return changes; }
+
+    iterator find(NodeNum n)
+    {
+        iterator it = lowerBound(n);
+        return (it != end() && it->first == n) ? it : end();
+    }
+    const_iterator find(NodeNum n) const
+    {
+        const_iterator it = lowerBound(n);
+        return (it != end() && it->first == n) ? it : end();
+    }
+
+    bool contains(NodeNum n) const { return find(n) != end(); }
+    size_t count(NodeNum n) const { return contains(n) ? 1 : 0; }
+
+    /// The value for n, or nullptr
+    const V *get(NodeNum n) const
+    {
+        const_iterator it = find(n);
+        return it != end() ? &it->second : nullptr;
+    }
+
+    /// The value for n, inserted zeroed if missing (like std::map)
+    V &operator[](NodeNum n)
+    {
+        changes++;
+        iterator it = lowerBound(n);
+        if (it != end() && it->first == n)
+            return it->second;
+        const size_t pos = it - begin();
+        if (entries.size() == entries.capacity())
+            entries.reserve(entries.capacity() + kGrowBy);
+        entries.insert(entries.begin() + pos, value_type(n, V{}));
+        return entries[pos].second;
+    }
+
+    /// @return entries removed (0 or 1)
+    size_t erase(NodeNum n)
+    {
+        iterator it = find(n);
+        if (it == end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    /// @return the entry after the removed one
+    iterator erase(const_iterator it)
+    {
+        changes++;
+        const size_t pos = it - begin();
+        entries.erase(entries.begin() + pos);
+        return begin() + pos;
+    }
+
+    /// Drop every entry and give the block back
+    void clear()
+    {
+        changes++;
+        entries.clear();
+        entries.shrink_to_fit();
+    }
+
+  private:
+    std::vector<value_type> entries; // sorted by NodeNum, unique
+    uint32_t changes = 0;
+
+    iterator lowerBound(NodeNum n)
+    {
+        return std::lower_bound(begin(), end(), n, [](const value_type &e, NodeNum key) { return e.first < key; });
+    }
+    const_iterator lowerBound(NodeNum n) const
+    {
+        return std::lower_bound(begin(), end(), n, [](const value_type &e, NodeNum key) { return e.first < key; });
+    }
+};
@@ -20,6 +20,9 @@ class SinglePortModule : public MeshModule
      */
     virtual bool wantPacket(const meshtastic_MeshPacket *p) override { return p->decoded.portnum == ourPortNum; }
 
+    /// Subclasses whose wantPacket() accepts other ports must override this (see MeshModule::dispatchPort)
+    virtual meshtastic_PortNum dispatchPort() const override { return ourPortNum; }
+
     /**
      * Return a mesh packet which has been preinited as a data packet with a particular port number.
      * You can then send this packet (after customizing any of the payload fields you might need) with
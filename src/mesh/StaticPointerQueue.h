@@ -70,6 +70,23 @@ template <class T, int MaxElements> class StaticPointerQueue
         return dequeue(&p, maxWait) ? p : nullptr;
     }
 
+    // Entry i counted from the oldest (0) without dequeuing it, or null past the end
+    T *at(int i) const { return (i >= 0 && i < count) ? buffer[(head + i) % MaxElements] : nullptr; }
+
+    // Take entry i (0 = oldest) out of the queue, closing the gap so the rest keep their order
+    T *removeAt(int i)
+    {
+        if (i < 0 || i >= count)
+            return nullptr;
+        T *p = buffer[(head + i) % MaxElements];
+        for (int j = i; j < count - 1; j++)
+            buffer[(head + j) % MaxElements] = buffer[(head + j + 1) % MaxElements];
+        tail = (tail + MaxElements - 1) % MaxElements;
+        buffer[tail] = nullptr;
+        count--;
+        return p;
+    }
+
     void setReader(concurrency::OSThread *t) { reader = t; }
 
     // For compatibility with PointerQueue interface
@@ -55,6 +55,13 @@ void StreamAPI::writeStream()
         if (!finishPendingFrame())
             return;
 
+#if STREAM_TX_BATCH_FRAMES > 1
+        if (txBatchBuf) {
+            writeStreamBatched();
+            return;
+        }
+#endif
+
         uint32_t len;
         do {
             // Send every packet we can
@@ -65,6 +72,40 @@ void StreamAPI::writeStream()
     }
 }
 
+#if STREAM_TX_BATCH_FRAMES > 1
+/// Allocate the batch buffer; a transport calls this once, before it starts writing.
+void StreamAPI::enableTxBatching(size_t frames)
+{
+    if (frames < 2)
+        return;
+    txBatchSize = frames * MAX_STREAM_BUF_SIZE;
+    txBatchBuf.reset(new uint8_t[txBatchSize]);
+}
+
+/**
+ * Drain getFromRadio() into consecutive 0x94C3 frames and emit them with one write, so an initial config download or a
+ * packet burst costs one stream write per runOncePart() instead of one per FromRadio.
+ */
+void StreamAPI::writeStreamBatched()
+{
+    do {
+        size_t used = 0;
+        // Only ask for another packet while a worst-case frame still fits: getFromRadio() dequeues it for good.
+        while (used + MAX_STREAM_BUF_SIZE <= txBatchSize) {
+            size_t len = getFromRadio(txBatchBuf.get() + used + HEADER_LEN);
+            if (len == 0)
+                break;
+            used += buildFrameHeader(txBatchBuf.get() + used, len);
+        }
+        if (used == 0 || !writeFramedBytes(txBatchBuf.get(), used, false))
+            return;
+        // A full batch means more may be waiting; keep going like the unbatched loop does.
+        if (used + MAX_STREAM_BUF_SIZE <= txBatchSize)
+            return;
+    } while (canWrite);
+}
+#endif
+
 /// Parse supplied bytes through the framed ToRadio receive state machine.
 int32_t StreamAPI::handleRecStream(const char *buf, uint16_t bufLen)
 {
@@ -191,11 +232,19 @@ size_t StreamAPI::buildFrameHeader(uint8_t *buf, size_t payloadLen)
 /// Write one framed payload using the transport's failure semantics.
 bool StreamAPI::writeFrame(uint8_t *buf, size_t len, bool bestEffort)
 {
-    (void)bestEffort;
     if (len == 0 || !canWrite)
         return false;
 
-    const size_t totalLen = buildFrameHeader(buf, len);
+    return writeFramedBytes(buf, buildFrameHeader(buf, len), bestEffort);
+}
+
+/// Write pre-framed bytes using the transport's failure semantics.
+bool StreamAPI::writeFramedBytes(uint8_t *buf, size_t totalLen, bool bestEffort)
+{
+    (void)bestEffort;
+    if (totalLen == 0 || !canWrite)
+        return false;
+
     // Serialize write-readiness checks, writes and write-failure handling
     // against concurrent stream writes/close.
     concurrency::LockGuard guard(&streamLock);
@@ -4,11 +4,26 @@
 #include "Stream.h"
 #include "concurrency/Lock.h"
 #include "concurrency/OSThread.h"
+#include "configuration.h"
 #include <cstdarg>
+#include <memory>
 
 // A To/FromRadio packet + our 32 bit header
 #define MAX_STREAM_BUF_SIZE (MAX_TO_FROM_RADIO_SIZE + sizeof(uint32_t))
 
+/// How many worst-case frames a transport that calls enableTxBatching() packs into one stream write.
+/// 1 compiles batching out entirely, which keeps the PhoneAPI hierarchy layout untouched on targets where extra members
+/// have upset USB-CDC enumeration (see PhoneAPI.h).
+#ifndef STREAM_TX_BATCH_FRAMES
+#if defined(ARCH_PORTDUINO)
+#define STREAM_TX_BATCH_FRAMES 16
+#elif defined(ARCH_ESP32)
+#define STREAM_TX_BATCH_FRAMES 4
+#else
+#define STREAM_TX_BATCH_FRAMES 1
+#endif
+#endif
+
 /**
  * A version of our 'phone' API that talks over a Stream.  So therefore well suited to use with serial links
  * or TCP connections.
@@ -69,6 +84,11 @@ class StreamAPI : public PhoneAPI
      */
     void writeStream();
 
+#if STREAM_TX_BATCH_FRAMES > 1
+    /// Pack as many ready frames as fit into txBatchBuf and hand them to the transport as one write.
+    void writeStreamBatched();
+#endif
+
   protected:
     /**
      * Send a FromRadio.rebooted = true packet to the phone
@@ -105,6 +125,14 @@ class StreamAPI : public PhoneAPI
     virtual bool canEncodeLogRecord() { return true; }
     /// Frame and write a payload, optionally using best-effort admission.
     virtual bool writeFrame(uint8_t *buf, size_t len, bool bestEffort);
+    /// Write bytes that already carry their 0x94C3 headers (one frame, or several back to back).
+    virtual bool writeFramedBytes(uint8_t *buf, size_t totalLen, bool bestEffort);
+
+#if STREAM_TX_BATCH_FRAMES > 1
+    /// Opt this transport into batched writes: each runOncePart() drains up to `frames` worst-case frames into one
+    /// buffer and emits it with a single stream write. The wire format is unchanged.
+    void enableTxBatching(size_t frames = STREAM_TX_BATCH_FRAMES);
+#endif
 
     concurrency::Lock streamLock;
 
@@ -129,4 +157,11 @@ class StreamAPI : public PhoneAPI
     /// interleave on the wire.
     meshtastic_FromRadio fromRadioScratchLog = {};
     uint8_t txBufLog[MAX_STREAM_BUF_SIZE] = {0};
+
+#if STREAM_TX_BATCH_FRAMES > 1
+    /// Batched main-path output, allocated by enableTxBatching(). Like txBuf it must stay untouched while a transport
+    /// retains part of it (finishPendingFrame() gates refills).
+    std::unique_ptr<uint8_t[]> txBatchBuf;
+    size_t txBatchSize = 0;
+#endif
 };
@@ -4,7 +4,10 @@
 #include <cstddef>
 #include <cstdint>
 
-/** Caller-owned frame storage must remain valid and unchanged until isIdle(). */
+/**
+ * Caller-owned frame storage must remain valid and unchanged until isIdle(). A "frame" here is any run of complete
+ * 0x94C3 frames, so a StreamAPI tx batch is retained and resumed exactly like a single frame.
+ */
 class StreamFrameWriter
 {
   public:
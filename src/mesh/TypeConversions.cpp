@@ -1,7 +1,121 @@
 #include "TypeConversions.h"
+#include "configuration.h"
 #include "mesh/generated/meshtastic/deviceonly.pb.h"
 #include "mesh/generated/meshtastic/mesh.pb.h"
 #include "meshUtils.h"
+#include <pb_encode.h>
+
+namespace
+{
+// The streaming encoder below writes the generated meshtastic_FromRadio / meshtastic_NodeInfo / meshtastic_User field tags in
+// ascending order and skips proto3 defaults, exactly as pb_encode does for the generated descriptors; test_type_conversions
+// checks the bytes against pb_encode of the same FromRadio.
+
+struct NodeInfoStreamSource {
+    const meshtastic_NodeInfoLite *lite;
+    bool isUs;
+    uint32_t ourLastHeard;
+};
+
+bool encodeVarintField(pb_ostream_t *stream, uint32_t tag, uint64_t value)
+{
+    return pb_encode_tag(stream, PB_WT_VARINT, tag) && pb_encode_varint(stream, value);
+}
+
+bool encodeStringField(pb_ostream_t *stream, uint32_t tag, const char *str)
+{
+    return pb_encode_tag(stream, PB_WT_STRING, tag) && pb_encode_string(stream, (const pb_byte_t *)str, strlen(str));
+}
+
+// Length-delimited submessages need their size up front, so run the writer once on a sizing stream and once for real.
+template <typename Writer> bool encodeSubmessageField(pb_ostream_t *stream, uint32_t tag, const Writer &writer)
+{
+    pb_ostream_t sizing = PB_OSTREAM_SIZING;
+    if (!writer(&sizing))
+        return false;
+    return pb_encode_tag(stream, PB_WT_STRING, tag) && pb_encode_varint(stream, sizing.bytes_written) && writer(stream);
+}
+
+bool encodeUserFields(pb_ostream_t *stream, const meshtastic_NodeInfoLite *lite)
+{
+    // Same id / sanitising rules as ConvertToUser(); the names are copied into small stack buffers only because
+    // sanitizeUtf8 works in place.
+    char id[sizeof(meshtastic_User::id)];
+    snprintf(id, sizeof(id), "!%08x", lite->num);
+    char longName[sizeof(meshtastic_User::long_name)];
+    strncpy(longName, lite->long_name, sizeof(longName));
+    longName[sizeof(longName) - 1] = '\0';
+    sanitizeUtf8(longName, sizeof(longName));
+    char shortName[sizeof(meshtastic_User::short_name)];
+    strncpy(shortName, lite->short_name, sizeof(shortName));
+    shortName[sizeof(shortName) - 1] = '\0';
+    sanitizeUtf8(shortName, sizeof(shortName));
+
+    if (!encodeStringField(stream, meshtastic_User_id_tag, id))
+        return false;
+    if (longName[0] && !encodeStringField(stream, meshtastic_User_long_name_tag, longName))
+        return false;
+    if (shortName[0] && !encodeStringField(stream, meshtastic_User_short_name_tag, shortName))
+        return false;
+    // macaddr is always zero for NodeInfoLite and therefore omitted.
+    if (lite->hw_model != 0 && !encodeVarintField(stream, meshtastic_User_hw_model_tag, (uint32_t)lite->hw_model))
+        return false;
+    if (nodeInfoLiteIsLicensed(lite) && !encodeVarintField(stream, meshtastic_User_is_licensed_tag, 1))
+        return false;
+    if (lite->role != 0 && !encodeVarintField(stream, meshtastic_User_role_tag, (uint32_t)lite->role))
+        return false;
+    if (lite->public_key.size > 0) {
+        if (!pb_encode_tag(stream, PB_WT_STRING, meshtastic_User_public_key_tag) ||
+            !pb_encode_string(stream, lite->public_key.bytes, lite->public_key.size))
+            return false;
+    }
+    if (nodeInfoLiteHasIsUnmessagable(lite) &&
+        !encodeVarintField(stream, meshtastic_User_is_unmessagable_tag, nodeInfoLiteIsUnmessagable(lite)))
+        return false;
+    return true;
+}
+
+bool encodeNodeInfoFields(pb_ostream_t *stream, const NodeInfoStreamSource &src)
+{
+    const meshtastic_NodeInfoLite *lite = src.lite;
+    if (lite->num != 0 && !encodeVarintField(stream, meshtastic_NodeInfo_num_tag, lite->num))
+        return false;
+    if (nodeInfoLiteHasUser(lite) &&
+        !encodeSubmessageField(stream, meshtastic_NodeInfo_user_tag,
+                               [lite](pb_ostream_t *s) { return encodeUserFields(s, lite); }))
+        return false;
+    // position and device_metrics are never bundled in the thin form.
+
+    // nanopb omits a proto3 float only when its bit pattern is all zero, so -0.0 still goes out.
+    float snr = src.isUs ? 0.0f : lite->snr;
+    uint32_t snrBits;
+    memcpy(&snrBits, &snr, sizeof(snrBits));
+    if (snrBits != 0 && (!pb_encode_tag(stream, PB_WT_32BIT, meshtastic_NodeInfo_snr_tag) || !pb_encode_fixed32(stream, &snr)))
+        return false;
+    uint32_t lastHeard = src.isUs ? src.ourLastHeard : lite->last_heard;
+    if (lastHeard != 0 &&
+        (!pb_encode_tag(stream, PB_WT_32BIT, meshtastic_NodeInfo_last_heard_tag) || !pb_encode_fixed32(stream, &lastHeard)))
+        return false;
+    if (lite->channel != 0 && !encodeVarintField(stream, meshtastic_NodeInfo_channel_tag, lite->channel))
+        return false;
+    if (!src.isUs && nodeInfoLiteViaMqtt(lite) && !encodeVarintField(stream, meshtastic_NodeInfo_via_mqtt_tag, 1))
+        return false;
+    if (lite->has_hops_away && !encodeVarintField(stream, meshtastic_NodeInfo_hops_away_tag, src.isUs ? 0 : lite->hops_away))
+        return false;
+    if ((src.isUs || nodeInfoLiteIsFavorite(lite)) && !encodeVarintField(stream, meshtastic_NodeInfo_is_favorite_tag, 1))
+        return false;
+    if (nodeInfoLiteIsIgnored(lite) && !encodeVarintField(stream, meshtastic_NodeInfo_is_ignored_tag, 1))
+        return false;
+    if (nodeInfoLiteIsKeyManuallyVerified(lite) &&
+        !encodeVarintField(stream, meshtastic_NodeInfo_is_key_manually_verified_tag, 1))
+        return false;
+    if (nodeInfoLiteIsMuted(lite) && !encodeVarintField(stream, meshtastic_NodeInfo_is_muted_tag, 1))
+        return false;
+    if (nodeInfoLiteHasXeddsaSigned(lite) && !encodeVarintField(stream, meshtastic_NodeInfo_has_xeddsa_signed_tag, 1))
+        return false;
+    return true;
+}
+} // namespace
 
 meshtastic_NodeInfo TypeConversions::ConvertToNodeInfo(const meshtastic_NodeInfoLite *lite,
                                                        const meshtastic_PositionLite *position,
@@ -65,6 +179,22 @@ meshtastic_NodeInfo TypeConversions::ConvertToNodeInfoThin(const meshtastic_Node
     return ConvertToNodeInfo(lite, nullptr, nullptr);
 }
 
+size_t TypeConversions::EncodeNodeInfoThinFromRadio(uint8_t *buf, size_t bufSize, const meshtastic_NodeInfoLite *lite, bool isUs,
+                                                    uint32_t ourLastHeard)
+{
+    if (!lite)
+        return 0;
+    // FromRadio.id is never set on this path, so node_info is the only field.
+    const NodeInfoStreamSource src = {lite, isUs, ourLastHeard};
+    pb_ostream_t stream = pb_ostream_from_buffer(buf, bufSize);
+    if (!encodeSubmessageField(&stream, meshtastic_FromRadio_node_info_tag,
+                               [&src](pb_ostream_t *s) { return encodeNodeInfoFields(s, src); })) {
+        LOG_ERROR("Panic: can't stream NodeInfo 0x%08x reason='%s'", lite->num, PB_GET_ERROR(&stream));
+        return 0;
+    }
+    return stream.bytes_written;
+}
+
 meshtastic_PositionLite TypeConversions::ConvertToPositionLite(meshtastic_Position position)
 {
     meshtastic_PositionLite lite = meshtastic_PositionLite_init_default;
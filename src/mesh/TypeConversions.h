@@ -14,6 +14,13 @@ class TypeConversions
     // Identity + link-state only; satellite payloads are replayed afterward.
     static meshtastic_NodeInfo ConvertToNodeInfoThin(const meshtastic_NodeInfoLite *lite);
 
+    // Streams FromRadio{node_info = ConvertToNodeInfoThin(lite)} straight from the NodeInfoLite into buf, byte-identical
+    // to pb_encode of the converted struct. When isUs is set the link-state fields are rewritten the way the phone
+    // expects for our own entry (hops 0, snr 0, not via MQTT, favorite, last_heard = ourLastHeard).
+    // Returns the encoded length, or 0 if buf is too small.
+    static size_t EncodeNodeInfoThinFromRadio(uint8_t *buf, size_t bufSize, const meshtastic_NodeInfoLite *lite, bool isUs,
+                                              uint32_t ourLastHeard);
+
     static meshtastic_PositionLite ConvertToPositionLite(meshtastic_Position position);
     static meshtastic_Position ConvertToPosition(meshtastic_PositionLite lite);
 
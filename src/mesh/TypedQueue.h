@@ -64,7 +64,7 @@ template <class T> class TypedQueue
 
 #else
 
-#include <queue>
+#include <deque>
 
 /**
  * A wrapper for freertos queues.  Note: each element object should be small
@@ -72,7 +72,7 @@ template <class T> class TypedQueue
  */
 template <class T> class TypedQueue
 {
-    std::queue<T> q;
+    std::deque<T> q;
     concurrency::OSThread *reader = NULL;
     int maxElements;
 
@@ -100,7 +100,7 @@ template <class T> class TypedQueue
             concurrency::mainDelay.interrupt();
         }
 
-        q.push(x);
+        q.push_back(x);
         return true;
     }
 
@@ -112,13 +112,26 @@ template <class T> class TypedQueue
             return false;
         else {
             *p = q.front();
-            q.pop();
+            q.pop_front();
             return true;
         }
     }
 
     // bool dequeueFromISR(T *p, BaseType_t *higherPriWoken) { return xQueueReceiveFromISR(h, p, higherPriWoken); }
 
+    // Entry i counted from the oldest (0) without dequeuing it, or a default T past the end
+    T at(int i) const { return (i >= 0 && i < (int)q.size()) ? q[i] : T(); }
+
+    // Take entry i (0 = oldest) out of the queue, keeping the rest in order
+    T removeAt(int i)
+    {
+        if (i < 0 || i >= (int)q.size())
+            return T();
+        T x = q[i];
+        q.erase(q.begin() + i);
+        return x;
+    }
+
     void setReader(concurrency::OSThread *t) { reader = t; }
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Hardware AES for the channel AES-CTR path on Linux/portduino: AES-NI on x86 (picked at runtime) and the ARMv8 crypto
+ * extensions on aarch64 builds that target them. Everywhere else HAS_AES_CTR_ACCEL is 0 and CryptoEngine keeps using the
+ * rweather software AES.
+ */
+#if defined(ARCH_PORTDUINO) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define AES_CTR_ACCEL_X86 1
+#elif defined(ARCH_PORTDUINO) && defined(__aarch64__) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#define AES_CTR_ACCEL_ARMV8 1
+#endif
+
+#if defined(AES_CTR_ACCEL_X86) || defined(AES_CTR_ACCEL_ARMV8)
+#define HAS_AES_CTR_ACCEL 1
+#else
+#define HAS_AES_CTR_ACCEL 0
+#endif
+
+#if HAS_AES_CTR_ACCEL
+
+/// Expanded encryption round keys (FIPS-197 byte order, as the AES instructions consume them)
+struct AesRoundKeys {
+    uint8_t bytes[15 * 16];
+    uint8_t rounds; ///< 10 for AES128, 14 for AES256
+};
+
+/// @return true if this CPU has the AES instructions (checked once)
+bool aesCtrAccelAvailable();
+
+/// Expand a 16 or 32 byte key
+void aesCtrAccelExpandKey(AesRoundKeys &rk, const uint8_t *key, size_t keyLen);
+
+/**
+ * AES-CTR in place with the same counter layout as rweather's CTR<> with setCounterSize(4): the last four nonce bytes are
+ * a big-endian block counter. `nonce` is not modified.
+ */
+void aesCtrAccelCrypt(const AesRoundKeys &rk, const uint8_t *nonce, uint8_t *bytes, size_t numBytes);
+
+#endif
@@ -9,15 +9,29 @@ template <typename T>
 ServerAPI<T>::ServerAPI(T &_client) : StreamAPI(&client), concurrency::OSThread("ServerAPI"), client(_client)
 {
     LOG_INFO("Incoming API connection");
+#if STREAM_TX_BATCH_FRAMES > 1
+    // One TCP send per runOncePart instead of one per FromRadio (config download, packet bursts)
+    enableTxBatching();
+#endif
+#if HAS_EPOLL_REACTOR
+    // Run as soon as the client sends something (or hangs up) rather than at the next poll
+    concurrency::mainReactor.watchForThread(client.fd(), this);
+#endif
 }
 
 template <typename T> ServerAPI<T>::~ServerAPI()
 {
+#if HAS_EPOLL_REACTOR
+    concurrency::mainReactor.unwatch(client.fd(), static_cast<concurrency::OSThread *>(this));
+#endif
     client.stop();
 }
 
 template <typename T> void ServerAPI<T>::close()
 {
+#if HAS_EPOLL_REACTOR
+    concurrency::mainReactor.unwatch(client.fd(), static_cast<concurrency::OSThread *>(this));
+#endif
     client.stop(); // drop tcp connection
     StreamAPI::close();
 }
@@ -81,9 +95,16 @@ template <class T, class U> void APIServerPort<T, U>::init()
 
 template <class T, class U> int32_t APIServerPort<T, U>::runOnce()
 {
-    // Clean up previous connection if its client already disconnected
-    if (openAPI && !openAPI->checkIsConnected()) {
-        openAPI.reset();
+    // Clean up sessions whose client already disconnected, keeping the rest oldest first
+    size_t numOpen = 0;
+    for (size_t i = 0; i < MAX_TCP_API_CLIENTS; i++) {
+        if (openAPIs[i] && !openAPIs[i]->checkIsConnected())
+            openAPIs[i].reset();
+        if (openAPIs[i]) {
+            if (i != numOpen)
+                openAPIs[numOpen] = std::move(openAPIs[i]);
+            numOpen++;
+        }
     }
 
 #ifdef ARCH_ESP32
@@ -98,8 +119,8 @@ template <class T, class U> int32_t APIServerPort<T, U>::runOnce()
     auto client = U::available();
 #endif
     if (client) {
-        // Close any previous connection (see FIXME in header file)
-        if (openAPI) {
+        // Every session slot busy: close the oldest one (see openAPIs)
+        if (numOpen == MAX_TCP_API_CLIENTS) {
 #if RAK_4631
             // RAK13800 Ethernet requests periodically take more time
             // This backoff addresses most cases keeping max wait < 1s
@@ -110,11 +131,14 @@ template <class T, class U> int32_t APIServerPort<T, U>::runOnce()
                 return waitTime;
             }
 #endif
-            LOG_INFO("Force close previous TCP connection");
-            openAPI.reset();
+            LOG_INFO("Force close oldest of %d TCP connections", MAX_TCP_API_CLIENTS);
+            openAPIs[0].reset();
+            for (size_t i = 1; i < numOpen; i++)
+                openAPIs[i - 1] = std::move(openAPIs[i]);
+            numOpen--;
         }
 
-        openAPI.reset(new T(client));
+        openAPIs[numOpen].reset(new T(client));
     }
 
 #if RAK_4631
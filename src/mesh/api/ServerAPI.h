@@ -1,6 +1,7 @@
 #pragma once
 
 #include "StreamAPI.h"
+#include "concurrency/EpollReactor.h"
 #include <memory>
 
 #define SERVER_API_DEFAULT_PORT 4403
@@ -31,6 +32,10 @@ template <class T> class ServerAPI : public StreamAPI, private concurrency::OSTh
     virtual void onConnectionChanged(bool connected) override {}
     virtual bool canWriteFrame(size_t frameLen) override;
     virtual void onFrameWriteFailed(size_t frameLen, size_t writtenLen) override;
+#if HAS_EPOLL_REACTOR
+    /// New packets for the client: run now instead of at the next poll
+    virtual void onNowHasData(uint32_t fromRadioNum) override { setIntervalFromNow(0); }
+#endif
 
     virtual int32_t runOnce() override; // Check for dropped client connections
 };
@@ -40,12 +45,13 @@ template <class T> class ServerAPI : public StreamAPI, private concurrency::OSTh
  */
 template <class T, class U> class APIServerPort : public U, private concurrency::OSThread
 {
-    /** The currently open port
+    /** The currently open sessions, oldest first.
      *
-     * FIXME: We currently only allow one open TCP connection at a time, because we depend on the loop() call in this class to
-     * delegate to the worker.  Once coroutines are implemented we can relax this restriction.
+     * Each ServerAPI is its own OSThread with its own PhoneAPI state machine, and mesh packets reach every session
+     * through MeshService's to-phone fan-out. When all MAX_TCP_API_CLIENTS slots are busy the oldest session is closed
+     * to make room, which with a single slot is the old one-connection behaviour.
      */
-    std::unique_ptr<T> openAPI;
+    std::unique_ptr<T> openAPIs[MAX_TCP_API_CLIENTS];
 #if defined(RAK_4631) || defined(RAK11310)
     // Track wait time for RAK13800 Ethernet requests
     int32_t waitTime = 100;
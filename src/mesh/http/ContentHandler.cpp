@@ -1,8 +1,11 @@
 #if !MESHTASTIC_EXCLUDE_WEBSERVER
+#include "MeshService.h"
 #include "NodeDB.h"
 #include "PowerFSM.h"
 #include "RadioLibInterface.h"
+#include "Router.h"
 #include "airtime.h"
+#include "concurrency/OSThread.h"
 #include "main.h"
 #include "mesh/http/ContentHelper.h"
 #include "mesh/http/WebServer.h"
@@ -670,6 +673,18 @@ void handleReport(HTTPRequest *req, HTTPResponse *res)
     out += jsonNum(airTime->utilizationTXPercent());
     out += "}";
 
+    // decode (perhapsDecode channel trials)
+    const DecodeTrialStats &trials = getDecodeTrialStats();
+    out += ",\"decode\":{\"attempts\":";
+    out += jsonNum((int)trials.attempts);
+    out += ",\"cache_hits\":";
+    out += jsonNum((int)trials.cacheHits);
+    out += ",\"cache_misses\":";
+    out += jsonNum((int)trials.cacheMisses);
+    out += ",\"pre_rejects\":";
+    out += jsonNum((int)trials.preRejects);
+    out += "}";
+
     // device
     out += ",\"device\":{\"reboot_counter\":";
     out += jsonNum((int)myNodeInfo.reboot_count);
@@ -714,6 +729,55 @@ void handleReport(HTTPRequest *req, HTTPResponse *res)
     out += jsonNum((int)RadioLibInterface::instance->getChannelNum() + 1);
     out += "}";
 
+    // threads (main loop time per OSThread, heaviest first)
+    out += ",\"threads\":{\"run_ms\":";
+    out += jsonNum((int)(concurrency::mainController.getTotalRunTimeUs() / 1000));
+    out += ",\"runs\":";
+    out += jsonNum((int)concurrency::mainController.getTotalRuns());
+    out += ",\"top\":[";
+    threadprof::Row rows[10];
+    size_t numRows = threadprof::snapshot(rows, sizeof(rows) / sizeof(rows[0]));
+    for (size_t i = 0; i < numRows; i++) {
+        if (i)
+            out += ",";
+        out += "{\"late_avg_ms\":";
+        out += jsonNum(rows[i].runs ? (int)(rows[i].totalLateMs / rows[i].runs) : 0);
+        out += ",\"late_max_ms\":";
+        out += jsonNum((int)rows[i].maxLateMs);
+        out += ",\"max_us\":";
+        out += jsonNum((int)rows[i].maxUs);
+        out += ",\"name\":";
+        out += jsonEscape(rows[i].name);
+        out += ",\"run_ms\":";
+        out += jsonNum((int)(rows[i].totalUs / 1000));
+        out += ",\"runs\":";
+        out += jsonNum((int)rows[i].runs);
+        out += "}";
+    }
+    out += "]}";
+
+    // tophone (toPhoneQueue occupancy and drop accounting)
+    const MeshService::ToPhoneDropStats &drops = service->getToPhoneDropStats();
+    out += ",\"tophone\":{\"capacity\":";
+    out += jsonNum(service->toPhoneQueueCapacity());
+    out += ",\"clients\":";
+    out += jsonNum((int)service->numPhoneClients());
+    out += ",\"enqueue_failed\":";
+    out += jsonNum((int)drops.enqueueFailed);
+    out += ",\"evicted\":";
+    out += jsonNum((int)drops.evicted);
+    out += ",\"fanout_buffered\":";
+    out += jsonNum((int)service->numPhoneFanoutBuffered());
+    out += ",\"fanout_skipped\":";
+    out += jsonNum((int)service->numPhoneFanoutSkipped());
+    out += ",\"queued\":";
+    out += jsonNum(service->numToPhoneQueued());
+    out += ",\"rejected\":";
+    out += jsonNum((int)drops.rejected);
+    out += ",\"undecodable\":";
+    out += jsonNum((int)drops.undecodable);
+    out += "}";
+
     // wifi
     out += ",\"wifi\":{\"ip\":";
     out += jsonEscape(wifiIP);
@@ -52,6 +52,32 @@
 #define MAX_RX_NOTIFICATION_TOPHONE 2
 #endif
 
+/// max concurrent TCP API sessions served by APIServerPort (see ServerAPI.h)
+#ifndef MAX_TCP_API_CLIENTS
+#if defined(ARCH_PORTDUINO)
+#define MAX_TCP_API_CLIENTS 4
+#elif defined(ARCH_ESP32)
+#define MAX_TCP_API_CLIENTS 2
+#else
+#define MAX_TCP_API_CLIENTS 1
+#endif
+#endif
+
+/// cursor slots in MeshService's to-phone fan-out: the TCP sessions plus BLE, serial, HTTP and the packet API
+#ifndef MAX_PHONE_API_CLIENTS
+#define MAX_PHONE_API_CLIENTS (MAX_TCP_API_CLIENTS + 4)
+#endif
+
+/// packets the to-phone fan-out keeps so slower clients can catch up with the fastest one (power of two). Each one
+/// stays allocated from packetPool until every client has read it.
+#ifndef MAX_PHONE_FANOUT_PACKETS
+#if defined(ARCH_PORTDUINO)
+#define MAX_PHONE_FANOUT_PACKETS 16
+#else
+#define MAX_PHONE_FANOUT_PACKETS 4
+#endif
+#endif
+
 /// Tighten this when the slim header shrinks; loosen only with deliberate
 /// awareness of MAX_NUM_NODES impact per platform.
 static_assert(sizeof(meshtastic_NodeInfoLite) <= 130, "NodeInfoLite size increased. Reconsider impact on MAX_NUM_NODES.");
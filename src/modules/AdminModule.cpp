@@ -8,8 +8,10 @@
 #include "PositionPrecision.h"
 #include "PowerFSM.h"
 #include "SPILock.h"
+#include "concurrency/ThreadProfiler.h"
 #include "gps/RTC.h"
 #include "input/InputBroker.h"
+#include "memory/MemAudit.h"
 #include "meshUtils.h"
 #include <FSCommon.h>
 #include <Throttle.h>
@@ -430,6 +432,14 @@ bool AdminModule::handleReceivedProtobuf(const meshtastic_MeshPacket &mp, meshta
     case meshtastic_AdminMessage_get_device_metadata_request_tag: {
         LOG_INFO("Client got device metadata");
         handleGetDeviceMetadata(mp);
+#ifdef DEBUG_HEAP
+        // Heap debug builds only: there is no admin message for diagnostics, so log them where a locally
+        // connected client's debug log stream can see them
+        if (mp.from == 0) {
+            memaudit::logBreakdown("admin");
+            threadprof::logBreakdown("admin");
+        }
+#endif
         break;
     }
     case meshtastic_AdminMessage_factory_reset_config_tag: {
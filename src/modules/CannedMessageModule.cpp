@@ -2169,16 +2169,16 @@ ProcessMessage CannedMessageModule::handleReceived(const meshtastic_MeshPacket &
 
             // Update last sent StoredMessage with ACK/NACK/RELAYED result
             if (!messageStore.getMessages().empty()) {
-                StoredMessage &last = const_cast<StoredMessage &>(messageStore.getMessages().back());
+                const StoredMessage &last = messageStore.getMessages().back();
                 if (last.sender == nodeDB->getNodeNum()) { // only update our own messages
                     if (wasBroadcast && isAck) {
-                        last.ackStatus = AckStatus::ACKED;
+                        messageStore.setAckStatus(last, AckStatus::ACKED);
                     } else if (isFromDest && isAck) {
-                        last.ackStatus = AckStatus::ACKED;
+                        messageStore.setAckStatus(last, AckStatus::ACKED);
                     } else if (!isFromDest && isAck) {
-                        last.ackStatus = AckStatus::RELAYED;
+                        messageStore.setAckStatus(last, AckStatus::RELAYED);
                     } else {
-                        last.ackStatus = AckStatus::NACKED;
+                        messageStore.setAckStatus(last, AckStatus::NACKED);
                     }
                 }
             }
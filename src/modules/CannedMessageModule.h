@@ -96,6 +96,8 @@ class CannedMessageModule : public SinglePortModule, public Observable<const UIF
             lastRxSnr = p->rx_snr;
         return (p->decoded.portnum == meshtastic_PortNum_ROUTING_APP) ? waitingForAck : false;
     }
+    // wantPacket() samples RSSI/SNR from every packet, not just the routing ACKs it accepts
+    virtual meshtastic_PortNum dispatchPort() const override { return meshtastic_PortNum_UNKNOWN_APP; }
 
   protected:
     // === Thread Entry Point ===
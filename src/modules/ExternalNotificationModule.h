@@ -86,6 +86,8 @@ class ExternalNotificationModule : public SinglePortModule, private concurrency:
     virtual int32_t runOnce() override;
 
     virtual bool wantPacket(const meshtastic_MeshPacket *p) override;
+    /// Text payloads span several ports (see MeshService::isTextPayload), so ask about every packet
+    virtual meshtastic_PortNum dispatchPort() const override { return meshtastic_PortNum_UNKNOWN_APP; }
 
     bool isNagging = false;
 
@@ -0,0 +1,513 @@
+#include "StoreForwardHistory.h"
+#include "FSCommon.h"
+#include "SPILock.h"
+#include "configuration.h"
+#include "memory/MemAudit.h"
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Only the targets that can run an S&F server (ESP32 with PSRAM, Linux) persist the log
+#if defined(FSCom) && (defined(ARCH_ESP32) || defined(ARCH_PORTDUINO))
+#define SF_HISTORY_PERSIST 1
+#else
+#define SF_HISTORY_PERSIST 0
+#endif
+
+#define SF_HISTORY_MAGIC 0x31484653u // "SFH1"
+
+// History file layout: this header, then StoredRecord + payload pairs (unpadded).
+struct HistoryFileHeader {
+    uint32_t magic;    // SF_HISTORY_MAGIC
+    uint32_t reserved; // 0
+};
+static_assert(sizeof(HistoryFileHeader) == 8, "header layout is part of the history file format");
+
+// A record as kept in the arena (padded to 4 B there) and in the file.
+struct StoredRecord {
+    uint32_t time;
+    uint32_t to;
+    uint32_t from;
+    uint32_t id;
+    uint32_t reply_id;
+    int32_t rx_rssi;
+    float rx_snr;
+    uint8_t channel;
+    uint8_t flags; // RECORD_EMOJI, RECORD_VIA_MQTT
+    uint8_t hop_start;
+    uint8_t hop_limit;
+    uint8_t transport_mechanism;
+    uint8_t payload_size;
+    uint16_t check; // over the fields above and the payload, so a torn file tail is caught
+};
+static_assert(sizeof(StoredRecord) == 36, "record layout is part of the history file format");
+static_assert(meshtastic_Constants_DATA_PAYLOAD_LEN <= 0xFF, "payload_size is stored in one byte");
+
+static constexpr uint8_t RECORD_EMOJI = 0x01;
+static constexpr uint8_t RECORD_VIA_MQTT = 0x02;
+
+static uint16_t recordCheck(const StoredRecord &r, const uint8_t *payload)
+{
+    // FNV-1a folded to 16 bits
+    uint32_t h = 2166136261u;
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(&r);
+    for (size_t i = 0; i < offsetof(StoredRecord, check); i++)
+        h = (h ^ p[i]) * 16777619u;
+    for (size_t i = 0; i < r.payload_size; i++)
+        h = (h ^ payload[i]) * 16777619u;
+    return (uint16_t)(h ^ (h >> 16));
+}
+
+size_t StoreForwardHistory::recordBytes(size_t payloadSize)
+{
+    return (sizeof(StoredRecord) + payloadSize + 3) & ~(size_t)3;
+}
+
+void StoreForwardHistory::SeqQueue::popFront()
+{
+    head++;
+    // Amortised O(1): shift the live tail down once the dead front outweighs it
+    if (head == v.size()) {
+        v.clear();
+        head = 0;
+    } else if (head >= 64 && head * 2 >= v.size()) {
+        v.erase(v.begin(), v.begin() + head);
+        head = 0;
+    }
+}
+
+StoreForwardHistory::~StoreForwardHistory()
+{
+    free(arena);
+    memaudit::set("sfhist", 0);
+}
+
+bool StoreForwardHistory::begin(size_t arenaBytes)
+{
+    free(arena);
+    arenaBytes &= ~(size_t)3;
+#if defined(ARCH_ESP32)
+    arena = static_cast<uint8_t *>(ps_malloc(arenaBytes));
+#else
+    arena = static_cast<uint8_t *>(malloc(arenaBytes));
+#endif
+    capacity = arena ? arenaBytes : 0;
+    head = tail = used = 0;
+    dataEnd = capacity;
+    firstSeq = nextSeq = 1;
+    offsets.clear();
+    byDest.clear();
+    lastTime = 0;
+    persisting = SF_HISTORY_PERSIST && fileName && arena;
+    reportMemory();
+    return arena != nullptr;
+}
+
+const uint8_t *StoreForwardHistory::recordAt(uint32_t seq) const
+{
+    return arena + offsets.at(seq - firstSeq);
+}
+
+uint32_t StoreForwardHistory::timeOf(uint32_t seq) const
+{
+    uint32_t t;
+    memcpy(&t, recordAt(seq) + offsetof(StoredRecord, time), sizeof(t));
+    return t;
+}
+
+NodeNum StoreForwardHistory::fromOf(uint32_t seq) const
+{
+    NodeNum n;
+    memcpy(&n, recordAt(seq) + offsetof(StoredRecord, from), sizeof(n));
+    return n;
+}
+
+void StoreForwardHistory::evictOldest()
+{
+    StoredRecord r;
+    memcpy(&r, arena + offsets.front(), sizeof(r));
+    const size_t bytes = recordBytes(r.payload_size);
+
+    auto it = byDest.find(r.to);
+    if (it != byDest.end()) {
+        it->second.popFront(); // records leave in sequence order, so ours is at the front
+        if (it->second.empty())
+            byDest.erase(it);
+    }
+    head = offsets.front() + bytes;
+    offsets.popFront();
+    firstSeq++;
+    used -= bytes;
+    evicted++;
+
+    if (head == dataEnd) {
+        head = 0;
+        dataEnd = capacity;
+    }
+}
+
+bool StoreForwardHistory::reserve(size_t bytes, size_t &offset)
+{
+    if (bytes > capacity)
+        return false;
+    for (;;) {
+        if (size() == 0) {
+            head = tail = used = 0;
+            dataEnd = capacity;
+        }
+        if (size() == 0 || head < tail) {
+            // Live records in [head, tail): use the room up to the end, else wrap to the start
+            if (capacity - tail >= bytes) {
+                offset = tail;
+                break;
+            }
+            dataEnd = tail;
+            tail = 0;
+            continue;
+        }
+        // Wrapped: live records in [head, dataEnd) and [0, tail); the gap is [tail, head)
+        if (head - tail >= bytes) {
+            offset = tail;
+            break;
+        }
+        evictOldest();
+    }
+    tail = offset + bytes;
+    used += bytes;
+    return true;
+}
+
+uint32_t StoreForwardHistory::store(const uint8_t *record, size_t bytes)
+{
+    StoredRecord r;
+    memcpy(&r, record, sizeof(r));
+    const size_t padded = recordBytes(r.payload_size);
+    size_t offset;
+    if (!arena || !reserve(padded, offset))
+        return 0;
+    memcpy(arena + offset, record, bytes);
+
+    const uint32_t seq = nextSeq++;
+    offsets.push(offset);
+    byDest[r.to].push(seq);
+    totalAdded++;
+    return seq;
+}
+
+uint32_t StoreForwardHistory::add(const PacketHistoryStruct &p)
+{
+    uint8_t buf[sizeof(StoredRecord) + meshtastic_Constants_DATA_PAYLOAD_LEN];
+    StoredRecord r;
+    memset(&r, 0, sizeof(r));
+    // Non-decreasing, so the time window is a binary search (an RTC step back can't reorder the log)
+    r.time = std::max(p.time, lastTime);
+    r.to = p.to;
+    r.from = p.from;
+    r.id = p.id;
+    r.reply_id = p.reply_id;
+    r.rx_rssi = p.rx_rssi;
+    r.rx_snr = p.rx_snr;
+    r.channel = p.channel;
+    r.flags = (p.emoji ? RECORD_EMOJI : 0) | (p.via_mqtt ? RECORD_VIA_MQTT : 0);
+    r.hop_start = p.hop_start;
+    r.hop_limit = p.hop_limit;
+    r.transport_mechanism = p.transport_mechanism;
+    r.payload_size = (uint8_t)std::min<size_t>(p.payload_size, meshtastic_Constants_DATA_PAYLOAD_LEN);
+    r.check = recordCheck(r, p.payload);
+    memcpy(buf, &r, sizeof(r));
+    memcpy(buf + sizeof(r), p.payload, r.payload_size);
+
+    const uint32_t seq = store(buf, sizeof(r) + r.payload_size);
+    if (seq)
+        lastTime = r.time;
+    if (numUnsaved() >= kFlushRecords)
+        flush();
+    reportMemory();
+    return seq;
+}
+
+const StoreForwardHistory::SeqQueue *StoreForwardHistory::queueFor(NodeNum dest) const
+{
+    auto it = byDest.find(dest);
+    return it != byDest.end() ? &it->second : nullptr;
+}
+
+// First entry of q at or past fromSeq and received after sinceTime; both grow along the queue
+size_t StoreForwardHistory::startOf(const SeqQueue &q, uint32_t fromSeq, uint32_t sinceTime) const
+{
+    const uint32_t *it = std::lower_bound(q.begin(), q.end(), fromSeq);
+    it = std::partition_point(it, q.end(), [&](uint32_t seq) { return timeOf(seq) <= sinceTime; });
+    return it - q.begin();
+}
+
+// Visit the matching sequence numbers in order, merging the broadcast list with dest's DM list.
+// visit(seq) returns false to stop.
+template <typename Visit>
+void StoreForwardHistory::forEachFor(NodeNum dest, uint32_t fromSeq, uint32_t sinceTime, Visit visit) const
+{
+    fromSeq = std::max(fromSeq, firstSeq);
+    const SeqQueue *bcast = queueFor(NODENUM_BROADCAST);
+    const SeqQueue *direct = dest != NODENUM_BROADCAST ? queueFor(dest) : nullptr;
+    size_t b = bcast ? startOf(*bcast, fromSeq, sinceTime) : 0;
+    size_t d = direct ? startOf(*direct, fromSeq, sinceTime) : 0;
+    const size_t bEnd = bcast ? bcast->size() : 0;
+    const size_t dEnd = direct ? direct->size() : 0;
+
+    while (b < bEnd || d < dEnd) {
+        uint32_t seq;
+        if (d >= dEnd || (b < bEnd && bcast->at(b) < direct->at(d)))
+            seq = bcast->at(b++);
+        else
+            seq = direct->at(d++);
+        // A client isn't sent its own messages back
+        if (fromOf(seq) == dest)
+            continue;
+        if (!visit(seq))
+            return;
+    }
+}
+
+uint32_t StoreForwardHistory::countFor(NodeNum dest, uint32_t fromSeq, uint32_t sinceTime) const
+{
+    uint32_t count = 0;
+    forEachFor(dest, fromSeq, sinceTime, [&](uint32_t) {
+        count++;
+        return true;
+    });
+    return count;
+}
+
+uint32_t StoreForwardHistory::nextFor(NodeNum dest, uint32_t fromSeq, uint32_t sinceTime, PacketHistoryStruct &out) const
+{
+    uint32_t found = 0;
+    forEachFor(dest, fromSeq, sinceTime, [&](uint32_t seq) {
+        found = seq;
+        return false;
+    });
+    if (!found)
+        return 0;
+
+    const uint8_t *rec = recordAt(found);
+    StoredRecord r;
+    memcpy(&r, rec, sizeof(r));
+    out.time = r.time;
+    out.to = r.to;
+    out.from = r.from;
+    out.id = r.id;
+    out.channel = r.channel;
+    out.reply_id = r.reply_id;
+    out.emoji = r.flags & RECORD_EMOJI;
+    out.payload_size = r.payload_size;
+    memcpy(out.payload, rec + sizeof(r), r.payload_size);
+    out.rx_rssi = r.rx_rssi;
+    out.rx_snr = r.rx_snr;
+    out.hop_start = r.hop_start;
+    out.hop_limit = r.hop_limit;
+    out.via_mqtt = r.flags & RECORD_VIA_MQTT;
+    out.transport_mechanism = r.transport_mechanism;
+    return found;
+}
+
+uint32_t StoreForwardHistory::estimatedCapacity() const
+{
+    if (!capacity)
+        return 0;
+    // Until something is stored, assume a short text message
+    const size_t avg = size() ? used / size() : recordBytes(48);
+    return capacity / avg;
+}
+
+void StoreForwardHistory::reportMemory() const
+{
+    size_t index = offsets.v.capacity() * sizeof(uint32_t);
+    for (const auto &kv : byDest)
+        index += sizeof(kv) + kv.second.v.capacity() * sizeof(uint32_t);
+    memaudit::set("sfhist", capacity + index);
+}
+
+size_t StoreForwardHistory::load()
+{
+#if SF_HISTORY_PERSIST
+    if (!persisting)
+        return 0;
+
+    size_t loaded = 0;
+    bool torn = false;
+    bool foreign = false;
+    uint32_t pos = 0;
+    {
+        concurrency::LockGuard g(spiLock);
+        auto f = FSCom.open(fileName, FILE_O_READ);
+        if (!f)
+            return 0;
+
+        HistoryFileHeader h;
+        if ((size_t)f.read((uint8_t *)&h, sizeof(h)) != sizeof(h) || h.magic != SF_HISTORY_MAGIC) {
+            foreign = true;
+        } else {
+            pos = sizeof(h);
+            uint8_t buf[sizeof(StoredRecord) + meshtastic_Constants_DATA_PAYLOAD_LEN];
+            for (;;) {
+                StoredRecord r;
+                const size_t got = (size_t)f.read((uint8_t *)&r, sizeof(r));
+                if (got == 0)
+                    break; // clean end
+                uint8_t *payload = buf + sizeof(r);
+                if (got != sizeof(r) || r.payload_size > meshtastic_Constants_DATA_PAYLOAD_LEN ||
+                    (r.payload_size && (size_t)f.read(payload, r.payload_size) != r.payload_size) ||
+                    recordCheck(r, payload) != r.check) {
+                    torn = true;
+                    break;
+                }
+                memcpy(buf, &r, sizeof(r));
+                if (store(buf, sizeof(r) + r.payload_size)) {
+                    lastTime = std::max(lastTime, r.time);
+                    loaded++;
+                }
+                pos += sizeof(r) + r.payload_size;
+            }
+        }
+        f.close();
+    }
+    fileBytes = pos;
+    unsavedFrom = nextSeq;
+
+    if (foreign) {
+        LOG_WARN("S&F history: %s is not a history log, starting over", fileName);
+        concurrency::LockGuard g(spiLock);
+        FSCom.remove(fileName);
+        fileBytes = 0;
+    } else if (torn) {
+        // Appends would land behind the bad bytes
+        LOG_WARN("S&F history: torn record at byte %u of %s, kept %u before it", (unsigned)pos, fileName, (unsigned)loaded);
+        rewriteFile();
+    } else {
+        LOG_INFO("S&F history: loaded %u records (%u B) from %s", (unsigned)loaded, (unsigned)pos, fileName);
+    }
+    reportMemory();
+    return loaded;
+#else
+    return 0;
+#endif
+}
+
+void StoreForwardHistory::stopPersisting()
+{
+    if (!persisting)
+        return;
+#if SF_HISTORY_PERSIST
+    {
+        concurrency::LockGuard g(spiLock);
+        if (FSCom.exists(fileName))
+            FSCom.remove(fileName);
+    }
+#endif
+    persisting = false;
+    fileBytes = 0;
+}
+
+bool StoreForwardHistory::flush()
+{
+    if (!numUnsaved())
+        return true;
+#if SF_HISTORY_PERSIST
+    // Records evicted from the arena before they were written are not in the file either
+    const uint32_t from = std::max(unsavedFrom, firstSeq);
+    bool ok = false;
+    uint32_t bytes = 0;
+    {
+        concurrency::LockGuard g(spiLock);
+        if (!FSCom.exists(fileName)) {
+            auto f = FSCom.open(fileName, FILE_O_WRITE);
+            if (!f)
+                return false;
+            const HistoryFileHeader h = {SF_HISTORY_MAGIC, 0};
+            ok = (size_t)f.write((const uint8_t *)&h, sizeof(h)) == sizeof(h);
+            f.close();
+            if (!ok) {
+                FSCom.remove(fileName); // so the retry starts from a fresh header
+                return false;
+            }
+            fileBytes = sizeof(h);
+        }
+        auto f = FSCom.open(fileName, "a");
+        if (f) {
+            ok = true;
+            for (uint32_t seq = from; ok && seq < nextSeq; seq++) {
+                StoredRecord r;
+                const uint8_t *rec = recordAt(seq);
+                memcpy(&r, rec, sizeof(r));
+                const size_t len = sizeof(r) + r.payload_size;
+                ok = (size_t)f.write(rec, len) == len;
+                bytes += len;
+            }
+            f.close();
+        }
+    }
+    if (!ok) {
+        LOG_WARN("S&F history: append to %s failed", fileName);
+        return rewriteFile(); // don't leave a partial record for the next append to land behind
+    }
+    // Only now are they in the file; a failed open above leaves them queued for the next flush
+    unsavedFrom = nextSeq;
+    fileBytes += bytes;
+    if (fileBytes > fileBudget)
+        return rewriteFile();
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Compaction: the newest records that fit in half the budget, written aside and renamed over the log
+bool StoreForwardHistory::rewriteFile()
+{
+#if SF_HISTORY_PERSIST
+    uint32_t keepFrom = nextSeq;
+    uint32_t bytes = sizeof(HistoryFileHeader);
+    while (keepFrom > firstSeq) {
+        StoredRecord r;
+        memcpy(&r, recordAt(keepFrom - 1), sizeof(r));
+        const uint32_t len = sizeof(r) + r.payload_size;
+        if (bytes + len > fileBudget / 2)
+            break;
+        bytes += len;
+        keepFrom--;
+    }
+
+    char tmpName[64];
+    snprintf(tmpName, sizeof(tmpName), "%s.tmp", fileName);
+    bool ok = false;
+    {
+        concurrency::LockGuard g(spiLock);
+        if (FSCom.exists(tmpName))
+            FSCom.remove(tmpName);
+        auto f = FSCom.open(tmpName, FILE_O_WRITE);
+        if (f) {
+            const HistoryFileHeader h = {SF_HISTORY_MAGIC, 0};
+            ok = (size_t)f.write((const uint8_t *)&h, sizeof(h)) == sizeof(h);
+            for (uint32_t seq = keepFrom; ok && seq < nextSeq; seq++) {
+                StoredRecord r;
+                const uint8_t *rec = recordAt(seq);
+                memcpy(&r, rec, sizeof(r));
+                const size_t len = sizeof(r) + r.payload_size;
+                ok = (size_t)f.write(rec, len) == len;
+            }
+            f.close();
+        }
+    }
+    ok = ok && renameFile(tmpName, fileName);
+    if (!ok) {
+        LOG_WARN("S&F history: can't rewrite %s, history is RAM only until reboot", fileName);
+        stopPersisting();
+        return false;
+    }
+    LOG_DEBUG("S&F history: rewrote %s with %u records (%u B)", fileName, (unsigned)(nextSeq - keepFrom), (unsigned)bytes);
+    fileBytes = bytes;
+    unsavedFrom = nextSeq;
+    return true;
+#else
+    return false;
+#endif
+}
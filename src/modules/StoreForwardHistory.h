@@ -0,0 +1,158 @@
+#pragma once
+
+#include "MeshTypes.h"
+#include "mesh/generated/meshtastic/mesh.pb.h"
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+/// One stored text message, unpacked: what S&F replays to a client
+struct PacketHistoryStruct {
+    uint32_t time;
+    uint32_t to;
+    uint32_t from;
+    uint32_t id;
+    uint8_t channel;
+    uint32_t reply_id;
+    bool emoji;
+    uint8_t payload[meshtastic_Constants_DATA_PAYLOAD_LEN];
+    pb_size_t payload_size;
+    int32_t rx_rssi;
+    float rx_snr;
+    uint8_t hop_start;
+    uint8_t hop_limit;
+    bool via_mqtt;
+    uint8_t transport_mechanism;
+};
+
+/**
+ * Store & Forward message history: a variable-length ring log with a per-destination index.
+ *
+ * Records are packed into one arena (PSRAM on ESP32) as a 36 B header plus only the payload
+ * bytes actually used, instead of a fixed PacketHistoryStruct with a full DATA_PAYLOAD_LEN
+ * buffer each - typical text messages take a fraction of the room. When the arena is full the
+ * oldest records are evicted one at a time rather than wiping the whole history.
+ *
+ * Every record gets a sequence number, one higher than the last. Each destination
+ * (NODENUM_BROADCAST for broadcasts) keeps the ascending list of its records' sequence
+ * numbers, so a history request for a client binary-searches its DM list and the broadcast
+ * list for the resume point (sequence number and time window) and walks only the matches.
+ * Timestamps are kept non-decreasing so the time window can be searched the same way.
+ *
+ * With a file name the log is also appended to the filesystem and loaded back by load() at
+ * boot. New records are written in batches, every kFlushRecords records or when the owner
+ * calls flush(), so a busy channel doesn't cost one file open per message; a power loss can
+ * take the unsaved tail with it. Once the file passes its budget it is rewritten with the
+ * newest half; a torn tail record ends the load.
+ */
+class StoreForwardHistory
+{
+  public:
+    /// Unsaved records that make add() append them to the file
+    static constexpr uint32_t kFlushRecords = 8;
+
+    /// Bytes a record with this payload occupies in the arena
+    static size_t recordBytes(size_t payloadSize);
+
+    /// @param fileName where to persist the log, or nullptr to keep it in RAM only
+    /// @param fileBudget size at which the file is rewritten with the newest half of the records
+    explicit StoreForwardHistory(const char *fileName = nullptr, uint32_t fileBudget = 256 * 1024)
+        : fileName(fileName), fileBudget(fileBudget)
+    {
+    }
+    ~StoreForwardHistory();
+    StoreForwardHistory(const StoreForwardHistory &) = delete;
+    StoreForwardHistory &operator=(const StoreForwardHistory &) = delete;
+
+    /// Allocate the arena (PSRAM when available). @return false if the allocation failed
+    bool begin(size_t arenaBytes);
+    /// Read back the persisted log. @return records loaded
+    size_t load();
+    /// Stop persisting and remove the file (e.g. under lockdown); RAM history is kept
+    void stopPersisting();
+
+    /// Store a message, evicting the oldest as needed. @return its sequence number, 0 if not stored
+    uint32_t add(const PacketHistoryStruct &p);
+    /// Append the records added since the last write to the file. @return false if the file could not be written
+    bool flush();
+    /// Records added but not written to the file yet
+    uint32_t numUnsaved() const { return persisting ? nextSeq - unsavedFrom : 0; }
+
+    /**
+     * Messages a client `dest` would be sent: broadcasts and DMs to it, not from it, with a sequence
+     * number >= fromSeq and received after sinceTime.
+     */
+    uint32_t countFor(NodeNum dest, uint32_t fromSeq, uint32_t sinceTime) const;
+    /// The first message countFor() would count, unpacked into out. @return its sequence number, 0 if none
+    uint32_t nextFor(NodeNum dest, uint32_t fromSeq, uint32_t sinceTime, PacketHistoryStruct &out) const;
+
+    size_t size() const { return nextSeq - firstSeq; }
+    /// Live records older than `seq`: its index in the old fixed-slot history, as sent in last_request
+    uint32_t indexOf(uint32_t seq) const { return seq <= firstSeq ? 0 : std::min(seq, nextSeq) - firstSeq; }
+    size_t capacityBytes() const { return capacity; }
+    size_t usedBytes() const { return used; }
+    /// Records the arena would hold at the current average size (for S&F stats)
+    uint32_t estimatedCapacity() const;
+    uint32_t getTotalAdded() const { return totalAdded; }
+    uint32_t getEvicted() const { return evicted; }
+
+  private:
+    /// Ascending uint32 queue: push at the back, pop at the front, compacted as the front advances
+    struct SeqQueue {
+        std::vector<uint32_t> v;
+        size_t head = 0;
+
+        size_t size() const { return v.size() - head; }
+        bool empty() const { return head == v.size(); }
+        const uint32_t *begin() const { return v.data() + head; }
+        const uint32_t *end() const { return v.data() + v.size(); }
+        uint32_t front() const { return v[head]; }
+        uint32_t at(size_t i) const { return v[head + i]; }
+        void push(uint32_t x) { v.push_back(x); }
+        void popFront();
+        void clear()
+        {
+            v.clear();
+            v.shrink_to_fit();
+            head = 0;
+        }
+    };
+
+    const char *fileName;
+    uint32_t fileBudget;
+    bool persisting = false;
+    uint32_t fileBytes = 0;
+
+    uint8_t *arena = nullptr;
+    size_t capacity = 0;
+    size_t head = 0;    // offset of the oldest record
+    size_t tail = 0;    // where the next record goes
+    size_t dataEnd = 0; // end of the records above tail once the log has wrapped
+    size_t used = 0;    // live record bytes
+
+    uint32_t firstSeq = 1;    // oldest live record
+    uint32_t nextSeq = 1;     // next to be assigned
+    uint32_t unsavedFrom = 1; // first record not written to the file yet
+    SeqQueue offsets;         // arena offset of firstSeq + i
+    std::unordered_map<NodeNum, SeqQueue> byDest;
+    uint32_t lastTime = 0;
+
+    uint32_t totalAdded = 0;
+    uint32_t evicted = 0;
+
+    const uint8_t *recordAt(uint32_t seq) const;
+    uint32_t timeOf(uint32_t seq) const;
+    NodeNum fromOf(uint32_t seq) const;
+    void evictOldest();
+    bool reserve(size_t bytes, size_t &offset);
+    uint32_t store(const uint8_t *record, size_t bytes);
+    const SeqQueue *queueFor(NodeNum dest) const;
+    size_t startOf(const SeqQueue &q, uint32_t fromSeq, uint32_t sinceTime) const;
+
+    template <typename Visit> void forEachFor(NodeNum dest, uint32_t fromSeq, uint32_t sinceTime, Visit visit) const;
+
+    bool rewriteFile();
+    void reportMemory() const;
+};
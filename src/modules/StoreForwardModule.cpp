@@ -28,6 +28,10 @@
 #include <iterator>
 #include <map>
 
+#ifdef MESHTASTIC_ENCRYPTED_STORAGE
+#include "security/EncryptedStorage.h"
+#endif
+
 StoreForwardModule *storeForwardModule;
 
 int32_t StoreForwardModule::runOnce()
@@ -54,6 +58,13 @@ int32_t StoreForwardModule::runOnce()
             sf.variant.heartbeat.secondary = 0; // TODO we always have one primary router for now
             storeForwardModule->sendMessage(NODENUM_BROADCAST, sf);
         }
+        // Write out a partial batch of stored messages once it has waited long enough
+        if (!this->history.numUnsaved()) {
+            lastHistorySave = millis();
+        } else if (!Throttle::isWithinTimespanMs(lastHistorySave, historySaveInterval)) {
+            this->history.flush();
+            lastHistorySave = millis();
+        }
         return (this->packetTimeMax);
     }
 #endif
@@ -73,22 +84,38 @@ void StoreForwardModule::populatePSRAM()
     LOG_DEBUG("Before PSRAM init: heap %d/%d PSRAM %d/%d", memGet.getFreeHeap(), memGet.getHeapSize(), memGet.getFreePsram(),
               memGet.getPsramSize());
 
-    /* Use a maximum of 3/4 the available PSRAM unless otherwise specified.
+    /* Use a maximum of 3/4 the available PSRAM unless otherwise specified, an eighth of it left for the
+        history index. A configured record count is room for that many full-size messages.
         Note: This needs to be done after every thing that would use PSRAM
     */
-    uint32_t numberOfPackets =
-        (this->records ? this->records : (((memGet.getFreePsram() / 4) * 3) / sizeof(PacketHistoryStruct)));
-    this->records = numberOfPackets;
-#if defined(ARCH_ESP32)
-    this->packetHistory.reset(static_cast<PacketHistoryStruct *>(ps_calloc(numberOfPackets, sizeof(PacketHistoryStruct))));
-#elif defined(ARCH_PORTDUINO)
-    this->packetHistory.reset(static_cast<PacketHistoryStruct *>(calloc(numberOfPackets, sizeof(PacketHistoryStruct))));
-
-#endif
+    size_t arenaBytes;
+    if (this->records) {
+        arenaBytes = this->records * StoreForwardHistory::recordBytes(meshtastic_Constants_DATA_PAYLOAD_LEN);
+    } else {
+        const size_t budget = (memGet.getFreePsram() / 4) * 3;
+        arenaBytes = budget - budget / 8;
+    }
+    if (!this->history.begin(arenaBytes))
+        LOG_ERROR("S&F - Can't allocate %u B of history", (unsigned)arenaBytes);
 
     LOG_DEBUG("After PSRAM init: heap %d/%d PSRAM %d/%d", memGet.getFreeHeap(), memGet.getHeapSize(), memGet.getFreePsram(),
               memGet.getPsramSize());
-    LOG_DEBUG("numberOfPackets for packetHistory - %u", numberOfPackets);
+    LOG_DEBUG("History arena %u B, ~%u messages", (unsigned)this->history.capacityBytes(),
+              (unsigned)this->history.estimatedCapacity());
+
+    if (historyMayPersist())
+        this->history.load();
+    else
+        this->history.stopPersisting();
+}
+
+bool StoreForwardModule::historyMayPersist()
+{
+#ifdef MESHTASTIC_ENCRYPTED_STORAGE
+    return !EncryptedStorage::isLockdownActive();
+#else
+    return true;
+#endif
 }
 
 /**
@@ -116,7 +143,8 @@ void StoreForwardModule::historySend(uint32_t secAgo, uint32_t to)
     sf.which_variant = meshtastic_StoreAndForward_history_tag;
     sf.variant.history.history_messages = queueSize;
     sf.variant.history.window = secAgo * 1000;
-    sf.variant.history.last_request = lastRequest[to];
+    // Clients know last_request as an index into the old fixed-slot history, not our sequence numbers
+    sf.variant.history.last_request = this->history.indexOf(lastRequest[to]);
     storeForwardModule->sendMessage(to, sf);
     setIntervalFromNow(this->packetTimeMax); // Delay start of sending payloads
 }
@@ -130,18 +158,9 @@ void StoreForwardModule::historySend(uint32_t secAgo, uint32_t to)
  */
 uint32_t StoreForwardModule::getNumAvailablePackets(NodeNum dest, uint32_t last_time)
 {
-    uint32_t count = 0;
+    // Client is only interested in packets not from itself and only in broadcast packets or packets towards it.
     lastRequest.emplace(dest, 0);
-    for (uint32_t i = lastRequest[dest]; i < this->packetHistoryTotalCount; i++) {
-        if (this->packetHistory[i].time && (this->packetHistory[i].time > last_time)) {
-            // Client is only interested in packets not from itself and only in broadcast packets or packets towards it.
-            if (this->packetHistory[i].from != dest &&
-                (this->packetHistory[i].to == NODENUM_BROADCAST || this->packetHistory[i].to == dest)) {
-                count++;
-            }
-        }
-    }
-    return count;
+    return this->history.countFor(dest, lastRequest[dest], last_time);
 }
 
 /**
@@ -184,31 +203,28 @@ void StoreForwardModule::historyAdd(const meshtastic_MeshPacket &mp)
 {
     const auto &p = mp.decoded;
 
-    if (this->packetHistoryTotalCount == this->records) {
-        LOG_WARN("S&F - PSRAM Full. Starting overwrite");
-        this->packetHistoryTotalCount = 0;
-        for (auto &i : lastRequest) {
-            i.second = 0; // Clear the last request index for each client device
-        }
-    }
-
-    this->packetHistory[this->packetHistoryTotalCount].time = getTime();
-    this->packetHistory[this->packetHistoryTotalCount].to = mp.to;
-    this->packetHistory[this->packetHistoryTotalCount].channel = mp.channel;
-    this->packetHistory[this->packetHistoryTotalCount].from = getFrom(&mp);
-    this->packetHistory[this->packetHistoryTotalCount].id = mp.id;
-    this->packetHistory[this->packetHistoryTotalCount].reply_id = p.reply_id;
-    this->packetHistory[this->packetHistoryTotalCount].emoji = (bool)p.emoji;
-    this->packetHistory[this->packetHistoryTotalCount].payload_size = p.payload.size;
-    this->packetHistory[this->packetHistoryTotalCount].rx_rssi = mp.rx_rssi;
-    this->packetHistory[this->packetHistoryTotalCount].rx_snr = mp.rx_snr;
-    this->packetHistory[this->packetHistoryTotalCount].hop_start = mp.hop_start;
-    this->packetHistory[this->packetHistoryTotalCount].hop_limit = mp.hop_limit;
-    this->packetHistory[this->packetHistoryTotalCount].via_mqtt = mp.via_mqtt;
-    this->packetHistory[this->packetHistoryTotalCount].transport_mechanism = mp.transport_mechanism;
-    memcpy(this->packetHistory[this->packetHistoryTotalCount].payload, p.payload.bytes, p.payload.size);
-
-    this->packetHistoryTotalCount++;
+    if (!historyMayPersist())
+        this->history.stopPersisting();
+
+    // Full history evicts its oldest records one at a time; clients resume by sequence number
+    PacketHistoryStruct h;
+    h.time = getTime();
+    h.to = mp.to;
+    h.channel = mp.channel;
+    h.from = getFrom(&mp);
+    h.id = mp.id;
+    h.reply_id = p.reply_id;
+    h.emoji = (bool)p.emoji;
+    h.payload_size = p.payload.size;
+    h.rx_rssi = mp.rx_rssi;
+    h.rx_snr = mp.rx_snr;
+    h.hop_start = mp.hop_start;
+    h.hop_limit = mp.hop_limit;
+    h.via_mqtt = mp.via_mqtt;
+    h.transport_mechanism = mp.transport_mechanism;
+    memcpy(h.payload, p.payload.bytes, p.payload.size);
+
+    this->history.add(h);
 }
 
 /**
@@ -239,62 +255,57 @@ bool StoreForwardModule::sendPayload(NodeNum dest, uint32_t last_time)
  */
 meshtastic_MeshPacket *StoreForwardModule::preparePayload(NodeNum dest, uint32_t last_time, bool local)
 {
-    for (uint32_t i = lastRequest[dest]; i < this->packetHistoryTotalCount; i++) {
-        if (this->packetHistory[i].time && (this->packetHistory[i].time > last_time)) {
-            /*  Copy the messages that were received by the server in the last msAgo
-                to the packetHistoryTXQueue structure.
-                Client not interested in packets from itself and only in broadcast packets or packets towards it. */
-            if (this->packetHistory[i].from != dest &&
-                (this->packetHistory[i].to == NODENUM_BROADCAST || this->packetHistory[i].to == dest)) {
-
-                meshtastic_MeshPacket *p = allocDataPacket();
-                if (!p)
-                    return nullptr;
-
-                p->to = local ? this->packetHistory[i].to : dest; // PhoneAPI can handle original `to`
-                p->from = this->packetHistory[i].from;
-                p->id = this->packetHistory[i].id;
-                p->channel = this->packetHistory[i].channel;
-                p->decoded.reply_id = this->packetHistory[i].reply_id;
-                p->rx_time = this->packetHistory[i].time;
-                p->decoded.emoji = (uint32_t)this->packetHistory[i].emoji;
-                p->rx_rssi = this->packetHistory[i].rx_rssi;
-                p->rx_snr = this->packetHistory[i].rx_snr;
-                p->hop_start = this->packetHistory[i].hop_start;
-                p->hop_limit = this->packetHistory[i].hop_limit;
-                p->via_mqtt = this->packetHistory[i].via_mqtt;
-                p->transport_mechanism = (meshtastic_MeshPacket_TransportMechanism)this->packetHistory[i].transport_mechanism;
-
-                // Let's assume that if the server received the S&F request that the client is in range.
-                //   TODO: Make this configurable.
-                p->want_ack = false;
-
-                if (local) { // PhoneAPI gets normal TEXT_MESSAGE_APP
-                    p->decoded.portnum = meshtastic_PortNum_TEXT_MESSAGE_APP;
-                    memcpy(p->decoded.payload.bytes, this->packetHistory[i].payload, this->packetHistory[i].payload_size);
-                    p->decoded.payload.size = this->packetHistory[i].payload_size;
-                } else {
-                    meshtastic_StoreAndForward sf = meshtastic_StoreAndForward_init_zero;
-                    sf.which_variant = meshtastic_StoreAndForward_text_tag;
-                    sf.variant.text.size = this->packetHistory[i].payload_size;
-                    memcpy(sf.variant.text.bytes, this->packetHistory[i].payload, this->packetHistory[i].payload_size);
-                    if (this->packetHistory[i].to == NODENUM_BROADCAST) {
-                        sf.rr = meshtastic_StoreAndForward_RequestResponse_ROUTER_TEXT_BROADCAST;
-                    } else {
-                        sf.rr = meshtastic_StoreAndForward_RequestResponse_ROUTER_TEXT_DIRECT;
-                    }
-
-                    p->decoded.payload.size = pb_encode_to_bytes(p->decoded.payload.bytes, sizeof(p->decoded.payload.bytes),
-                                                                 &meshtastic_StoreAndForward_msg, &sf);
-                }
+    /*  Copy the next message that was received by the server in the last msAgo.
+        Client not interested in packets from itself and only in broadcast packets or packets towards it. */
+    PacketHistoryStruct h;
+    const uint32_t seq = this->history.nextFor(dest, lastRequest[dest], last_time, h);
+    if (!seq)
+        return nullptr;
+
+    meshtastic_MeshPacket *p = allocDataPacket();
+    if (!p)
+        return nullptr;
+
+    p->to = local ? h.to : dest; // PhoneAPI can handle original `to`
+    p->from = h.from;
+    p->id = h.id;
+    p->channel = h.channel;
+    p->decoded.reply_id = h.reply_id;
+    p->rx_time = h.time;
+    p->decoded.emoji = (uint32_t)h.emoji;
+    p->rx_rssi = h.rx_rssi;
+    p->rx_snr = h.rx_snr;
+    p->hop_start = h.hop_start;
+    p->hop_limit = h.hop_limit;
+    p->via_mqtt = h.via_mqtt;
+    p->transport_mechanism = (meshtastic_MeshPacket_TransportMechanism)h.transport_mechanism;
 
-                lastRequest[dest] = i + 1; // Update the last request index for the client device
+    // Let's assume that if the server received the S&F request that the client is in range.
+    //   TODO: Make this configurable.
+    p->want_ack = false;
 
-                return p;
-            }
+    if (local) { // PhoneAPI gets normal TEXT_MESSAGE_APP
+        p->decoded.portnum = meshtastic_PortNum_TEXT_MESSAGE_APP;
+        memcpy(p->decoded.payload.bytes, h.payload, h.payload_size);
+        p->decoded.payload.size = h.payload_size;
+    } else {
+        meshtastic_StoreAndForward sf = meshtastic_StoreAndForward_init_zero;
+        sf.which_variant = meshtastic_StoreAndForward_text_tag;
+        sf.variant.text.size = h.payload_size;
+        memcpy(sf.variant.text.bytes, h.payload, h.payload_size);
+        if (h.to == NODENUM_BROADCAST) {
+            sf.rr = meshtastic_StoreAndForward_RequestResponse_ROUTER_TEXT_BROADCAST;
+        } else {
+            sf.rr = meshtastic_StoreAndForward_RequestResponse_ROUTER_TEXT_DIRECT;
         }
+
+        p->decoded.payload.size = pb_encode_to_bytes(p->decoded.payload.bytes, sizeof(p->decoded.payload.bytes),
+                                                     &meshtastic_StoreAndForward_msg, &sf);
     }
-    return nullptr;
+
+    lastRequest[dest] = seq + 1; // Resume after this message on the next call for the client device
+
+    return p;
 }
 
 /**
@@ -377,9 +388,9 @@ void StoreForwardModule::statsSend(uint32_t to)
 
     sf.rr = meshtastic_StoreAndForward_RequestResponse_ROUTER_STATS;
     sf.which_variant = meshtastic_StoreAndForward_stats_tag;
-    sf.variant.stats.messages_total = this->records;
-    sf.variant.stats.messages_saved = this->packetHistoryTotalCount;
-    sf.variant.stats.messages_max = this->records;
+    sf.variant.stats.messages_total = this->history.getTotalAdded();
+    sf.variant.stats.messages_saved = this->history.size();
+    sf.variant.stats.messages_max = this->history.estimatedCapacity();
     sf.variant.stats.up_time = millis() / 1000;
     sf.variant.stats.requests = this->requests;
     sf.variant.stats.requests_history = this->requests_history;
@@ -415,7 +426,7 @@ ProcessMessage StoreForwardModule::handleReceived(const meshtastic_MeshPacket &m
                 }
             } else {
                 storeForwardModule->historyAdd(mp);
-                LOG_INFO("S&F stored. Message history contains %u records now", this->packetHistoryTotalCount);
+                LOG_INFO("S&F stored. Message history contains %u records now", (unsigned)this->history.size());
             }
         } else if (!isFromUs(&mp) && mp.decoded.portnum == meshtastic_PortNum_STORE_FORWARD_APP) {
             auto &p = mp.decoded;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ProtobufModule.h"
+#include "StoreForwardHistory.h"
 #include "concurrency/OSThread.h"
 #include "mesh/generated/meshtastic/storeforward.pb.h"
 
@@ -10,47 +11,25 @@
 #include <memory>
 #include <unordered_map>
 
-struct PacketHistoryStruct {
-    uint32_t time;
-    uint32_t to;
-    uint32_t from;
-    uint32_t id;
-    uint8_t channel;
-    uint32_t reply_id;
-    bool emoji;
-    uint8_t payload[meshtastic_Constants_DATA_PAYLOAD_LEN];
-    pb_size_t payload_size;
-    int32_t rx_rssi;
-    float rx_snr;
-    uint8_t hop_start;
-    uint8_t hop_limit;
-    bool via_mqtt;
-    uint8_t transport_mechanism;
-};
-
 class StoreForwardModule : private concurrency::OSThread, public ProtobufModule<meshtastic_StoreAndForward>
 {
-    // packetHistory is allocated with ps_calloc / calloc, so it must be released with free(),
-    // not delete[].
-    struct CFreeDeleter {
-        void operator()(PacketHistoryStruct *p) const noexcept { free(p); }
-    };
-
     bool busy = 0;
     uint32_t busyTo = 0;
     char routerMessage[meshtastic_Constants_DATA_PAYLOAD_LEN] = {0};
 
-    std::unique_ptr<PacketHistoryStruct[], CFreeDeleter> packetHistory;
-    uint32_t packetHistoryTotalCount = 0;
+    // Message history, in PSRAM and persisted across reboots (see StoreForwardHistory.h)
+    StoreForwardHistory history{"/prefs/sf_history.log"};
+    unsigned long lastHistorySave = 0; // last time history had nothing waiting for the file
     uint32_t last_time = 0;
     uint32_t requestCount = 0;
 
-    uint32_t packetTimeMax = 5000; // Interval between sending history packets as a server.
+    uint32_t packetTimeMax = 5000;            // Interval between sending history packets as a server.
+    uint32_t historySaveInterval = 60 * 1000; // Longest a stored message waits for its batch to reach the file
 
     bool is_client = false;
     bool is_server = false;
 
-    // Unordered_map stores the last request for each nodeNum (`to` field)
+    // Next history sequence number to send each client (`to` field)
     std::unordered_map<NodeNum, uint32_t> lastRequest;
 
   public:
@@ -93,9 +72,12 @@ class StoreForwardModule : private concurrency::OSThread, public ProtobufModule<
             return false;
         }
     }
+    virtual meshtastic_PortNum dispatchPort() const override { return meshtastic_PortNum_UNKNOWN_APP; }
 
   private:
     void populatePSRAM();
+    /// Keep the history file only while storage isn't locked down (it holds message text in the clear)
+    bool historyMayPersist();
 
     // S&F Defaults
     uint32_t historyReturnMax = 25;     // Return maximum of 25 records by default.
@@ -7,6 +7,7 @@
 #include "RadioLibInterface.h"
 #include "Router.h"
 #include "TransmitHistory.h"
+#include "concurrency/ThreadProfiler.h"
 #include "configuration.h"
 #include "gps/RTC.h"
 #include "main.h"
@@ -166,6 +167,19 @@ meshtastic_Telemetry DeviceTelemetryModule::getLocalStatsTelemetry()
     LOG_INFO("num_packets_tx=%i, num_packets_rx=%i, num_packets_rx_bad=%i", telemetry.variant.local_stats.num_packets_tx,
              telemetry.variant.local_stats.num_packets_rx, telemetry.variant.local_stats.num_packets_rx_bad);
 
+    // LocalStats has no to-phone fields yet; log the drop accounting alongside it
+    if (service) {
+        const MeshService::ToPhoneDropStats &drops = service->getToPhoneDropStats();
+        LOG_INFO("tophone queued=%d/%d, evicted=%u, rejected=%u, undecodable=%u, failed=%u", service->numToPhoneQueued(),
+                 service->toPhoneQueueCapacity(), (unsigned)drops.evicted, (unsigned)drops.rejected, (unsigned)drops.undecodable,
+                 (unsigned)drops.enqueueFailed);
+        LOG_INFO("tophone clients=%u, fanout buffered=%u, skipped=%u", (unsigned)service->numPhoneClients(),
+                 (unsigned)service->numPhoneFanoutBuffered(), (unsigned)service->numPhoneFanoutSkipped());
+    }
+
+    // Which OSThreads the main loop spent its time in
+    threadprof::logBreakdown("stats");
+
     return telemetry;
 }
 
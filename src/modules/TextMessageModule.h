@@ -30,6 +30,8 @@ class TextMessageModule : public SinglePortModule, public Observable<const mesht
      */
     virtual ProcessMessage handleReceived(const meshtastic_MeshPacket &mp) override;
     virtual bool wantPacket(const meshtastic_MeshPacket *p) override;
+    /// Text payloads span several ports (see MeshService::isTextPayload), so ask about every packet
+    virtual meshtastic_PortNum dispatchPort() const override { return meshtastic_PortNum_UNKNOWN_APP; }
 
   private:
     uint32_t textPacketList[TEXT_PACKET_LIST_SIZE] = {0};
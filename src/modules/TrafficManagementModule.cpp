@@ -157,6 +157,8 @@ TrafficManagementModule::TrafficManagementModule() : MeshModule("TrafficManageme
 #endif
 
     memaudit::set("tmm", cache ? allocSize * sizeof(UnifiedCacheEntry) : 0);
+    if (cache && !cacheIndex.allocate(allocSize))
+        TM_LOG_WARN("Unified cache index allocation failed; lookups fall back to linear scans");
 #endif // TRAFFIC_MANAGEMENT_CACHE_SIZE > 0
 
 #if TMM_HAS_NODEINFO_CACHE
@@ -179,9 +181,12 @@ TrafficManagementModule::TrafficManagementModule() : MeshModule("TrafficManageme
     nodeInfoPayload = new NodeInfoPayloadEntry[nodeInfoTargetEntries()]();
 #endif
     memaudit::set("tmm_ni", nodeInfoPayload ? nodeInfoTargetEntries() * sizeof(NodeInfoPayloadEntry) : 0);
+    if (nodeInfoPayload && !nodeInfoIndex.allocate(nodeInfoTargetEntries()))
+        TM_LOG_WARN("NodeInfo cache index allocation failed; lookups fall back to linear scans");
 #else
     TM_LOG_DEBUG("NodeInfo cache not available on this target");
 #endif
+    memaudit::set("tmm_idx", cacheIndex.bytes() + nodeInfoIndex.bytes());
 
     setIntervalFromNow(kMaintenanceIntervalMs);
 }
@@ -209,6 +214,7 @@ TrafficManagementModule::~TrafficManagementModule()
         nodeInfoPayload = nullptr;
     }
     memaudit::set("tmm_ni", 0);
+    memaudit::set("tmm_idx", 0);
 }
 
 // =============================================================================
@@ -227,11 +233,85 @@ void TrafficManagementModule::incrementStat(uint32_t *field)
     (*field)++;
 }
 
+// =============================================================================
+// NodeNum -> Slot Index
+// =============================================================================
+
+bool TrafficManagementModule::NodeSlotIndex::allocate(uint16_t slots)
+{
+    release();
+    if (slots == 0 || slots >= NONE)
+        return false;
+    uint32_t buckets = 1;
+    while (buckets * 2 <= slots) // about two slots per bucket
+        buckets *= 2;
+    heads.reset(new uint16_t[buckets]);
+    next.reset(new uint16_t[slots]);
+    if (!heads || !next) {
+        release();
+        return false;
+    }
+    bucketMask = static_cast<uint16_t>(buckets - 1);
+    slotCount = slots;
+    clear();
+    return true;
+}
+
+void TrafficManagementModule::NodeSlotIndex::release()
+{
+    heads.reset();
+    next.reset();
+    bucketMask = 0;
+    slotCount = 0;
+    usedSlots = 0;
+    freeHint = 0;
+}
+
+void TrafficManagementModule::NodeSlotIndex::clear()
+{
+    freeHint = 0;
+    usedSlots = 0;
+    if (!ready())
+        return;
+    for (uint32_t b = 0; b <= bucketMask; b++)
+        heads[b] = NONE;
+    for (uint16_t i = 0; i < slotCount; i++)
+        next[i] = NONE;
+}
+
+void TrafficManagementModule::NodeSlotIndex::link(NodeNum node, uint16_t slot)
+{
+    if (slot == freeHint)
+        freeHint++;
+    if (!ready())
+        return;
+    const uint16_t b = bucketOf(node);
+    next[slot] = heads[b];
+    heads[b] = slot;
+    usedSlots++;
+}
+
+void TrafficManagementModule::NodeSlotIndex::unlink(NodeNum node, uint16_t slot)
+{
+    if (slot < freeHint)
+        freeHint = slot;
+    if (!ready())
+        return;
+    for (uint16_t *link = &heads[bucketOf(node)]; *link != NONE; link = &next[*link]) {
+        if (*link == slot) {
+            *link = next[slot];
+            next[slot] = NONE;
+            usedSlots--;
+            return;
+        }
+    }
+}
+
 // =============================================================================
 // Flat Unified Cache Operations
 // =============================================================================
 
-/// Find an existing entry for the given node (linear scan).
+/// Find an existing entry for the given node (hash index; linear scan if the index is missing).
 TrafficManagementModule::UnifiedCacheEntry *TrafficManagementModule::findEntry(NodeNum node)
 {
 #if TRAFFIC_MANAGEMENT_CACHE_SIZE == 0
@@ -241,6 +321,10 @@ TrafficManagementModule::UnifiedCacheEntry *TrafficManagementModule::findEntry(N
     if (!cache || node == 0)
         return nullptr;
 
+    if (cacheIndex.ready()) {
+        const uint16_t slot = cacheIndex.find(node, [this](uint16_t i) { return cache[i].node; });
+        return slot == NodeSlotIndex::NONE ? nullptr : &cache[slot];
+    }
     for (uint16_t i = 0; i < cacheSize(); i++) {
         if (cache[i].node == node)
             return &cache[i];
@@ -249,6 +333,15 @@ TrafficManagementModule::UnifiedCacheEntry *TrafficManagementModule::findEntry(N
 #endif
 }
 
+void TrafficManagementModule::clearEntry(UnifiedCacheEntry *entry)
+{
+#if TRAFFIC_MANAGEMENT_CACHE_SIZE > 0
+    if (entry->node != 0)
+        cacheIndex.unlink(entry->node, static_cast<uint16_t>(entry - cache));
+#endif
+    memset(entry, 0, sizeof(UnifiedCacheEntry));
+}
+
 int TrafficManagementModule::peekCachedRole(NodeNum node)
 {
 #if TRAFFIC_MANAGEMENT_CACHE_SIZE == 0
@@ -261,6 +354,48 @@ int TrafficManagementModule::peekCachedRole(NodeNum node)
 #endif
 }
 
+bool TrafficManagementModule::hasUnifiedEntryForTest(NodeNum node)
+{
+    concurrency::LockGuard guard(&cacheLock);
+    return findEntry(node) != nullptr;
+}
+
+bool TrafficManagementModule::touchUnifiedEntryForTest(NodeNum node)
+{
+    concurrency::LockGuard guard(&cacheLock);
+    return findOrCreateEntry(node, nullptr) != nullptr;
+}
+
+bool TrafficManagementModule::indexesConsistentForTest()
+{
+    concurrency::LockGuard guard(&cacheLock);
+    // Every occupied slot resolves to itself, the occupancy count matches, and no slot below the
+    // free hint is empty.
+    auto check = [](const NodeSlotIndex &index, uint16_t slots, auto nodeAt) {
+        uint16_t used = 0;
+        for (uint16_t i = 0; i < slots; i++) {
+            const NodeNum n = nodeAt(i);
+            if (n == 0) {
+                if (i < index.freeHint)
+                    return false;
+                continue;
+            }
+            used++;
+            if (index.ready() && index.find(n, nodeAt) != i)
+                return false;
+        }
+        return !index.ready() || index.used() == used;
+    };
+    bool ok = true;
+#if TRAFFIC_MANAGEMENT_CACHE_SIZE > 0
+    if (cache)
+        ok = ok && check(cacheIndex, cacheSize(), [this](uint16_t i) { return cache[i].node; });
+#endif
+    if (nodeInfoPayload)
+        ok = ok && check(nodeInfoIndex, nodeInfoTargetEntries(), [this](uint16_t i) { return nodeInfoPayload[i].node; });
+    return ok;
+}
+
 // The two caches are compile-time independent (TMM_HAS_NODEINFO_CACHE keys on PSRAM or
 // native tests, the
 // unified cache on a per-variant size that may be overridden to 0), so each is purged under
@@ -275,14 +410,14 @@ void TrafficManagementModule::purgeNode(NodeNum node)
 #if TRAFFIC_MANAGEMENT_CACHE_SIZE > 0
     UnifiedCacheEntry *entry = findEntry(node);
     if (entry) {
-        memset(entry, 0, sizeof(UnifiedCacheEntry));
+        clearEntry(entry);
         purged = true;
     }
 #endif
     // No NodeInfo-cache guard needed: without the cache this is a no-op stub returning null.
     NodeInfoPayloadEntry *info = findNodeInfoEntryMutable(node);
     if (info) {
-        memset(info, 0, sizeof(NodeInfoPayloadEntry));
+        clearNodeInfoEntry(info);
         purged = true;
     }
     // Log only real purges: removeNodeByNum() calls this for every deletion, including
@@ -301,10 +436,12 @@ void TrafficManagementModule::purgeAll()
 #if TRAFFIC_MANAGEMENT_CACHE_SIZE > 0
     if (cache)
         memset(cache, 0, static_cast<size_t>(cacheSize()) * sizeof(UnifiedCacheEntry));
+    cacheIndex.clear();
 #endif
     // nodeInfoPayload stays nullptr on builds without the NodeInfo cache; no guard needed.
     if (nodeInfoPayload)
         memset(nodeInfoPayload, 0, static_cast<size_t>(nodeInfoTargetEntries()) * sizeof(NodeInfoPayloadEntry));
+    nodeInfoIndex.clear();
     TM_LOG_INFO("Purged all traffic caches");
 #endif
 }
@@ -348,9 +485,10 @@ void TrafficManagementModule::updateCachedRoleFromNodeInfo(const meshtastic_Mesh
 #endif
 }
 
-/// Find or create the unified-cache entry for `node`. One linear pass tracks the match, the
-/// first empty slot, and the eviction victim: when full, the stalest entry loses, preferring
-/// entries without a next-hop hint or special role (the long-tail state this cache retains).
+/// Find or create the unified-cache entry for `node`. A hit comes from the index; a miss takes the
+/// first empty slot, or when full scores every entry for the eviction victim: the stalest entry
+/// loses, preferring entries without a next-hop hint or special role (the long-tail state this
+/// cache retains).
 TrafficManagementModule::UnifiedCacheEntry *TrafficManagementModule::findOrCreateEntry(NodeNum node, bool *isNew)
 {
 #if TRAFFIC_MANAGEMENT_CACHE_SIZE == 0
@@ -364,22 +502,25 @@ TrafficManagementModule::UnifiedCacheEntry *TrafficManagementModule::findOrCreat
     if (!cache || node == 0)
         return nullptr;
 
+    UnifiedCacheEntry *found = findEntry(node);
+    if (found)
+        return found;
+
     UnifiedCacheEntry *empty = nullptr;
+    for (uint16_t i = cacheIndex.freeHint; i < cacheSize(); i++) {
+        if (cache[i].node == 0) {
+            empty = &cache[i];
+            break;
+        }
+        cacheIndex.freeHint = i + 1;
+    }
+
     UnifiedCacheEntry *victim = nullptr;
     bool leastPreferredVictim = true;
     uint8_t victimRecency = UINT8_MAX;
 
-    for (uint16_t i = 0; i < cacheSize(); i++) {
+    for (uint16_t i = 0; !empty && i < cacheSize(); i++) {
         UnifiedCacheEntry &entry = cache[i];
-        if (entry.node == node)
-            return &entry;
-        if (entry.node == 0) {
-            if (!empty)
-                empty = &entry;
-            continue;
-        }
-        if (empty)
-            continue; // an empty slot beats any victim; stop scoring
         // "Preferred" entries are evicted last: a confirmed next-hop hint or a cached
         // special (non-CLIENT) role - the long-tail state this cache exists to retain.
         const bool preferred = entry.next_hop != 0 || entry.getCachedRole() != meshtastic_Config_DeviceConfig_Role_CLIENT;
@@ -409,8 +550,9 @@ TrafficManagementModule::UnifiedCacheEntry *TrafficManagementModule::findOrCreat
         return nullptr;
     if (!empty)
         TM_LOG_DEBUG("Unified cache full, evicting node 0x%08x", slot->node);
-    memset(slot, 0, sizeof(UnifiedCacheEntry));
+    clearEntry(slot);
     slot->node = node;
+    cacheIndex.link(node, static_cast<uint16_t>(slot - cache));
     if (isNew)
         *isNew = true;
     return slot;
@@ -430,6 +572,10 @@ const TrafficManagementModule::NodeInfoPayloadEntry *TrafficManagementModule::fi
     if (!nodeInfoPayload || node == 0)
         return nullptr;
 
+    if (nodeInfoIndex.ready()) {
+        const uint16_t slot = nodeInfoIndex.find(node, [this](uint16_t i) { return nodeInfoPayload[i].node; });
+        return slot == NodeSlotIndex::NONE ? nullptr : &nodeInfoPayload[slot];
+    }
     for (uint16_t i = 0; i < nodeInfoTargetEntries(); i++) {
         if (nodeInfoPayload[i].node == node)
             return &nodeInfoPayload[i];
@@ -437,6 +583,13 @@ const TrafficManagementModule::NodeInfoPayloadEntry *TrafficManagementModule::fi
     return nullptr;
 }
 
+void TrafficManagementModule::clearNodeInfoEntry(NodeInfoPayloadEntry *entry)
+{
+    if (entry->node != 0)
+        nodeInfoIndex.unlink(entry->node, static_cast<uint16_t>(entry - nodeInfoPayload));
+    memset(entry, 0, sizeof(NodeInfoPayloadEntry));
+}
+
 /// Find or create a NodeInfo payload entry. Victim selection is trust-tiered so the cache
 /// doubles as a pubkey pool: NodeDB membership outranks key trust, then keyless < TOFU key <
 /// signer-proven key; within a tier the oldest observation loses (never-observed = oldest).
@@ -449,23 +602,26 @@ TrafficManagementModule::findOrCreateNodeInfoEntry(NodeNum node, bool *usedEmpty
     if (!nodeInfoPayload || node == 0)
         return nullptr;
 
+    NodeInfoPayloadEntry *found = findNodeInfoEntryMutable(node);
+    if (found)
+        return found;
+
     NodeInfoPayloadEntry *empty = nullptr;
+    for (uint16_t i = nodeInfoIndex.freeHint; i < nodeInfoTargetEntries(); i++) {
+        if (nodeInfoPayload[i].node == 0) {
+            empty = &nodeInfoPayload[i];
+            break;
+        }
+        nodeInfoIndex.freeHint = i + 1;
+    }
+
     NodeInfoPayloadEntry *victim = nullptr;
     uint8_t victimTier = 0xFF;
     uint8_t victimAge = 0;
     const uint8_t nowObs = currentObsTick();
 
-    for (uint16_t i = 0; i < nodeInfoTargetEntries(); i++) {
+    for (uint16_t i = 0; !empty && i < nodeInfoTargetEntries(); i++) {
         NodeInfoPayloadEntry &entry = nodeInfoPayload[i];
-        if (entry.node == node)
-            return &entry;
-        if (entry.node == 0) {
-            if (!empty)
-                empty = &entry;
-            continue;
-        }
-        if (empty)
-            continue; // an empty slot beats any victim; stop scoring
         // Eviction tier (lower loses first): 0 keyless, 1 TOFU key, 2 signer-proven key;
         // +3 for NodeDB members - never shed a NodeDB-tier identity over a stranger.
         const uint8_t tier = static_cast<uint8_t>(((entry.user.public_key.size != 32) ? 0 : (entry.keySignerProven ? 2 : 1)) +
@@ -485,8 +641,9 @@ TrafficManagementModule::findOrCreateNodeInfoEntry(NodeNum node, bool *usedEmpty
         return nullptr;
     if (spareMembers && slot == victim && victim->isMember)
         return nullptr; // caller would rather skip than churn one member out for another
-    memset(slot, 0, sizeof(NodeInfoPayloadEntry));
+    clearNodeInfoEntry(slot);
     slot->node = node;
+    nodeInfoIndex.link(node, static_cast<uint16_t>(slot - nodeInfoPayload));
     if (usedEmptySlot)
         *usedEmptySlot = (slot == empty);
     return slot;
@@ -496,6 +653,8 @@ uint16_t TrafficManagementModule::countNodeInfoEntriesLocked() const
 {
     if (!nodeInfoPayload)
         return 0;
+    if (nodeInfoIndex.ready())
+        return nodeInfoIndex.used();
 
     uint16_t count = 0;
     for (uint16_t i = 0; i < nodeInfoTargetEntries(); i++) {
@@ -857,7 +1016,9 @@ void TrafficManagementModule::dropNodeInfoCacheForTest()
         delete[] nodeInfoPayload;
     nodeInfoPayload = nullptr;
     nodeInfoPayloadFromPsram = false;
+    nodeInfoIndex.release();
     memaudit::set("tmm_ni", 0);
+    memaudit::set("tmm_idx", cacheIndex.bytes());
 }
 
 int TrafficManagementModule::peekNodeInfoFlagsForTest(NodeNum node)
@@ -873,14 +1034,9 @@ int TrafficManagementModule::peekNodeInfoFlagsForTest(NodeNum node)
 void TrafficManagementModule::markKeySignerProvenForTest(NodeNum node)
 {
     concurrency::LockGuard guard(&cacheLock);
-    if (!nodeInfoPayload)
-        return;
-    for (uint16_t i = 0; i < nodeInfoTargetEntries(); i++) {
-        if (nodeInfoPayload[i].node == node) {
-            nodeInfoPayload[i].keySignerProven = true;
-            return;
-        }
-    }
+    NodeInfoPayloadEntry *entry = findNodeInfoEntryMutable(node);
+    if (entry)
+        entry->keySignerProven = true;
 }
 
 #else // !TMM_HAS_NODEINFO_CACHE: no-op stubs so call sites need no guards of their own
@@ -900,6 +1056,10 @@ uint16_t TrafficManagementModule::countNodeInfoEntriesLocked() const
 {
     return 0;
 }
+void TrafficManagementModule::clearNodeInfoEntry(NodeInfoPayloadEntry *entry)
+{
+    memset(entry, 0, sizeof(NodeInfoPayloadEntry));
+}
 void TrafficManagementModule::reconcileNodeInfoFromNodeDBLocked() {}
 void TrafficManagementModule::maintainNodeInfoCacheLocked() {}
 void TrafficManagementModule::onNodeIdentityCommitted(NodeNum, const meshtastic_User &, bool) {}
@@ -1015,6 +1175,7 @@ void TrafficManagementModule::flushCache()
 #if TRAFFIC_MANAGEMENT_CACHE_SIZE > 0
     TM_LOG_DEBUG("Flushing cache");
     memset(cache, 0, static_cast<size_t>(cacheSize()) * sizeof(UnifiedCacheEntry));
+    cacheIndex.clear();
 #endif
 }
 
@@ -1300,7 +1461,7 @@ int32_t TrafficManagementModule::runOnce()
 
         // If all data expired, free the slot entirely
         if (!anyValid) {
-            memset(&cache[i], 0, sizeof(UnifiedCacheEntry));
+            clearEntry(&cache[i]);
             expiredEntries++;
         } else {
             activeEntries++;
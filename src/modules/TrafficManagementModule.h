@@ -5,6 +5,7 @@
 #include "concurrency/OSThread.h"
 #include "mesh/generated/meshtastic/mesh.pb.h"
 #include "mesh/generated/meshtastic/telemetry.pb.h"
+#include <memory>
 
 #if HAS_TRAFFIC_MANAGEMENT
 
@@ -140,8 +141,60 @@ class TrafficManagementModule : public MeshModule, private concurrency::OSThread
     /// Test introspection: NodeInfo cache capacity (kNodeInfoCacheEntries), so tests can
     /// fill the cache exactly and force the tiered-LRU eviction paths.
     static constexpr uint16_t nodeInfoCacheCapacityForTest() { return kNodeInfoCacheEntries; }
+    /// Test introspection: unified cache capacity (TRAFFIC_MANAGEMENT_CACHE_SIZE).
+    static constexpr uint16_t unifiedCacheCapacityForTest() { return TRAFFIC_MANAGEMENT_CACHE_SIZE; }
+    /// Test introspection: true when `node` has a unified-cache entry (no creation, no stats).
+    bool hasUnifiedEntryForTest(NodeNum node);
+    /// Test hook: look up (or create) the unified entry for `node` the way the packet paths do.
+    bool touchUnifiedEntryForTest(NodeNum node);
+    /// Test introspection: true when both hash indexes agree with a full scan of their tables.
+    bool indexesConsistentForTest();
 
   private:
+    /// NodeNum -> slot hash index kept beside one of the flat tables, so the packed entry formats stay
+    /// unchanged: chained buckets, 2 bytes per bucket plus 2 per slot. Every change of an entry's
+    /// `node` goes through link()/unlink(). If allocation fails the table still works - lookups fall
+    /// back to the linear scan. Caller holds cacheLock.
+    class NodeSlotIndex
+    {
+      public:
+        static constexpr uint16_t NONE = 0xFFFF;
+
+        /// Allocate for `slots` entries (all empty). @return false on allocation failure.
+        bool allocate(uint16_t slots);
+        void release();
+        bool ready() const { return next != nullptr; }
+        /// Forget every entry (the table was zeroed).
+        void clear();
+        void link(NodeNum node, uint16_t slot);
+        void unlink(NodeNum node, uint16_t slot);
+        /// Occupied slots (valid only when ready()).
+        uint16_t used() const { return usedSlots; }
+        size_t bytes() const { return (static_cast<size_t>(bucketMask) + 1 + slotCount) * sizeof(uint16_t); }
+
+        /// @return the slot holding `node`, or NONE; `nodeAt(slot)` reads a slot's NodeNum from the table
+        template <typename NodeAt> uint16_t find(NodeNum node, NodeAt nodeAt) const
+        {
+            for (uint16_t s = heads[bucketOf(node)]; s != NONE; s = next[s])
+                if (nodeAt(s) == node)
+                    return s;
+            return NONE;
+        }
+
+        /// Lowest slot that may be empty: every slot below it is occupied. Maintained even when the
+        /// index itself could not be allocated, so finding a free slot never rescans the full prefix.
+        uint16_t freeHint = 0;
+
+      private:
+        uint16_t bucketOf(NodeNum node) const { return static_cast<uint16_t>((node * 2654435761u) >> 16) & bucketMask; }
+
+        std::unique_ptr<uint16_t[]> heads;
+        std::unique_ptr<uint16_t[]> next;
+        uint16_t bucketMask = 0;
+        uint16_t slotCount = 0;
+        uint16_t usedSlots = 0;
+    };
+
     // 10-byte packed entry, all platforms. Tick stamps are free-running modular counters with
     // non-zero presence sentinels; the 4-bit cached role rides the top bits of the two count
     // bytes (tier-3 role fallback). Full layout and rationale: docs/node_info_stores.md.
@@ -184,13 +237,13 @@ class TrafficManagementModule : public MeshModule, private concurrency::OSThread
     };
     static_assert(sizeof(UnifiedCacheEntry) == 10, "UnifiedCacheEntry should be 10 bytes");
 
-    /// Unified cache capacity. Plain array, linear scan (same idiom as WarmNodeStore); insertion
-    /// on a full cache evicts the stalest entry, preferring ones without a next_hop hint.
+    /// Unified cache capacity. Plain array found through cacheIndex; insertion on a full cache
+    /// evicts the stalest entry (full scan), preferring ones without a next_hop hint.
     static constexpr uint16_t cacheSize() { return TRAFFIC_MANAGEMENT_CACHE_SIZE; }
 
-    // NodeInfo cache (PSRAM-backed on hardware, heap in native tests): flat payload array,
-    // linear scan, trust/membership-tiered LRU eviction on insert. NodeInfo traffic is
-    // low-rate, so full scans are fine.
+    // NodeInfo cache (PSRAM-backed on hardware, heap in native tests): flat payload array found
+    // through nodeInfoIndex, trust/membership-tiered LRU eviction on insert (full scan; NodeInfo
+    // traffic is low-rate, but lookups also serve copyPublicKey on the decode path).
     static constexpr uint16_t kNodeInfoCacheEntries = 2000;
     /// NodeInfo cache capacity.
     static constexpr uint16_t nodeInfoTargetEntries() { return kNodeInfoCacheEntries; }
@@ -230,8 +283,9 @@ class TrafficManagementModule : public MeshModule, private concurrency::OSThread
     // =========================================================================
 
     mutable concurrency::Lock cacheLock; // Protects all cache access
-    UnifiedCacheEntry *cache = nullptr;  // Flat unified cache (linear scan; all platforms)
+    UnifiedCacheEntry *cache = nullptr;  // Flat unified cache (all platforms)
     bool cacheFromPsram = false;         // Tracks allocator for correct deallocation
+    NodeSlotIndex cacheIndex;            // NodeNum -> slot in `cache`
 
     struct NodeInfoPayloadEntry {
         // Node identifier for this slot; 0 means unused.
@@ -283,6 +337,7 @@ class TrafficManagementModule : public MeshModule, private concurrency::OSThread
 
     NodeInfoPayloadEntry *nodeInfoPayload = nullptr; // NodeInfo payloads (flat array; PSRAM on hardware, heap in tests)
     bool nodeInfoPayloadFromPsram = false;           // Tracks allocator for correct deallocation
+    NodeSlotIndex nodeInfoIndex;                     // NodeNum -> slot in `nodeInfoPayload`
 
     meshtastic_TrafficManagementStats stats;
 
@@ -310,6 +365,8 @@ class TrafficManagementModule : public MeshModule, private concurrency::OSThread
 
     /// Find an existing unified-cache entry (no creation).
     UnifiedCacheEntry *findEntry(NodeNum node);
+    /// Zero a unified-cache entry and drop it from cacheIndex.
+    void clearEntry(UnifiedCacheEntry *entry);
 
     /// Resolve a sender's device role for the position hot path. The tier-3 cache is
     /// authoritative once seeded (NodeDB is scanned only on first tracking), so the read is O(1)
@@ -333,6 +390,8 @@ class TrafficManagementModule : public MeshModule, private concurrency::OSThread
     NodeInfoPayloadEntry *findOrCreateNodeInfoEntry(NodeNum node, bool *usedEmptySlot, bool spareMembers = false);
     /// Number of occupied NodeInfo cache slots. Caller must hold cacheLock.
     uint16_t countNodeInfoEntriesLocked() const;
+    /// Zero a NodeInfo cache entry and drop it from nodeInfoIndex.
+    void clearNodeInfoEntry(NodeInfoPayloadEntry *entry);
 
     /// 60 s NodeInfo-cache maintenance under cacheLock: saturate the expired obsTick stamp (wrap-safety
     /// for the modular clock) and run the boot/hourly reconcile. Guarded by TMM_HAS_NODEINFO_CACHE alone
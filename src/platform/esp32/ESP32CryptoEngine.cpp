@@ -7,6 +7,7 @@ class ESP32CryptoEngine : public CryptoEngine
 {
 
     mbedtls_aes_context aes;
+    CryptoKey loadedKey = {{0}, -1}; ///< key currently expanded into `aes`
 
   public:
     ESP32CryptoEngine() { mbedtls_aes_init(&aes); }
@@ -19,11 +20,14 @@ class ESP32CryptoEngine : public CryptoEngine
      * @param bytes is updated in place
      *  TODO: return bool, and handle graciously when something fails
      */
-    virtual void encryptAESCtr(CryptoKey _key, uint8_t *_nonce, size_t numBytes, uint8_t *bytes) override
+    virtual void encryptAESCtr(const CryptoKey &_key, uint8_t *_nonce, size_t numBytes, uint8_t *bytes) override
     {
         if (_key.length > 0) {
             if (numBytes <= MAX_BLOCKSIZE) {
-                mbedtls_aes_setkey_enc(&aes, _key.bytes, _key.length * 8);
+                if (loadedKey.length != _key.length || memcmp(loadedKey.bytes, _key.bytes, _key.length) != 0) {
+                    mbedtls_aes_setkey_enc(&aes, _key.bytes, _key.length * 8);
+                    loadedKey = _key;
+                }
                 static uint8_t scratch[MAX_BLOCKSIZE];
                 uint8_t stream_block[16];
                 size_t nc_off = 0;
@@ -9,7 +9,7 @@ class NRF52CryptoEngine : public CryptoEngine
 
     ~NRF52CryptoEngine() {}
 
-    virtual void encryptAESCtr(CryptoKey _key, uint8_t *_nonce, size_t numBytes, uint8_t *bytes) override
+    virtual void encryptAESCtr(const CryptoKey &_key, uint8_t *_nonce, size_t numBytes, uint8_t *bytes) override
     {
         if (_key.length > 16) {
             AES_ctx ctx;
@@ -21,7 +21,8 @@ class NRF52CryptoEngine : public CryptoEngine
             uint8_t myLen = ctx.blockLen(numBytes);
             char encBuf[myLen] = {0};
             ctx.begin();
-            ctx.Process((char *)bytes, numBytes, _nonce, _key.bytes, _key.length, encBuf, ctx.encryptFlag, ctx.ctrMode);
+            ctx.Process((char *)bytes, numBytes, _nonce, (uint8_t *)_key.bytes, _key.length, encBuf, ctx.encryptFlag,
+                        ctx.ctrMode);
             ctx.end();
             nRFCrypto.end();
             memcpy(bytes, encBuf, numBytes);
@@ -1,6 +1,7 @@
 #ifdef ARCH_PORTDUINO
 
 #include "GpsdSerial.h"
+#include "concurrency/EpollReactor.h"
 #include "configuration.h"
 
 #include <cerrno>
@@ -146,6 +147,10 @@ bool GpsdSerial::connectToGpsd()
 
     _sockfd = fd;
     _rxBuf.clear();
+#if HAS_EPOLL_REACTOR
+    if (_readerThread)
+        concurrency::mainReactor.watchForThread(_sockfd, _readerThread);
+#endif
     LOG_INFO("gpsdSerial: connected to %s:%d", _host.c_str(), _port);
     return true;
 }
@@ -158,12 +163,19 @@ void GpsdSerial::begin(unsigned long /*baud*/, uint16_t /*config*/)
     connectToGpsd();
 }
 
+void GpsdSerial::disconnect()
+{
+#if HAS_EPOLL_REACTOR
+    concurrency::mainReactor.unwatch(_sockfd, _readerThread);
+#endif
+    closeSocket(_sockfd);
+    _sockfd = -1;
+}
+
 void GpsdSerial::end()
 {
-    if (_sockfd >= 0) {
-        closeSocket(_sockfd);
-        _sockfd = -1;
-    }
+    if (_sockfd >= 0)
+        disconnect();
     _rxBuf.clear();
 }
 
@@ -188,8 +200,7 @@ void GpsdSerial::fillBuffer()
     if (n == 0 || (n < 0 && !lastErrorWasWouldBlock())) {
         // gpsd closed the connection or a real error occurred.
         LOG_WARN("gpsdSerial: disconnected, will retry");
-        closeSocket(_sockfd);
-        _sockfd = -1;
+        disconnect();
         _rxBuf.clear();
     }
 }
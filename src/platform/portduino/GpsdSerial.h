@@ -2,6 +2,7 @@
 #ifdef ARCH_PORTDUINO
 
 #include "HardwareSerial.h"
+#include "concurrency/OSThread.h"
 #include <deque>
 #include <string>
 
@@ -22,13 +23,18 @@ class GpsdSerial : public HardwareSerial
     int _sockfd = -1;
     std::deque<uint8_t> _rxBuf;
     uint32_t _lastConnectAttemptMs = 0;
+    concurrency::OSThread *_readerThread = nullptr;
 
     bool connectToGpsd();
+    void disconnect();
     void fillBuffer();
 
   public:
     void setAddress(const std::string &host, int port = 2947);
 
+    // Thread that reads us; on Linux it is woken as soon as gpsd sends data instead of waiting for its next poll.
+    void setReaderThread(concurrency::OSThread *thread) { _readerThread = thread; }
+
     void begin(unsigned long baud) override { begin(baud, 0); }
     void begin(unsigned long baud, uint16_t config) override;
     void end() override;
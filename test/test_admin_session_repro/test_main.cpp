@@ -49,6 +49,7 @@ class MockNodeDB : public NodeDB
         testNodes.clear();
         meshNodes = &testNodes;
         numMeshNodes = 0;
+        invalidateNodeIndex();
     }
 
     void addNodeWithKey(NodeNum num, const uint8_t *key)
@@ -62,6 +63,7 @@ class MockNodeDB : public NodeDB
         testNodes.push_back(n);
         meshNodes = &testNodes;
         numMeshNodes = testNodes.size();
+        invalidateNodeIndex();
     }
 
     std::vector<meshtastic_NodeInfoLite> testNodes;
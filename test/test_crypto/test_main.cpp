@@ -2,6 +2,7 @@
 #include "CryptoEngine.h"
 
 #include "TestUtil.h"
+#include <Curve25519.h>
 #include <XEdDSA.h>
 #include <unity.h>
 
@@ -153,6 +154,82 @@ void test_PKC(void)
     TEST_ASSERT_EQUAL_MEMORY(expected_decrypted, decrypted, 10);
 }
 
+static void makePeer(uint8_t *priv, meshtastic_NodeInfoLite_public_key_t &pub)
+{
+    for (int i = 0; i < 32; i++)
+        priv[i] = (uint8_t)rand();
+    priv[0] &= 248;
+    priv[31] = (priv[31] & 127) | 64;
+    Curve25519::eval(pub.bytes, priv, 0);
+    pub.size = 32;
+}
+
+static int cachedPeers()
+{
+    int n = 0;
+    for (const auto &e : crypto->sharedKeyCache)
+        n += e.lastUsed ? 1 : 0;
+    return n;
+}
+
+static bool isCached(const meshtastic_NodeInfoLite_public_key_t &pub)
+{
+    for (const auto &e : crypto->sharedKeyCache)
+        if (e.lastUsed && memcmp(e.remotePublic, pub.bytes, 32) == 0)
+            return true;
+    return false;
+}
+
+// Repeat DMs reuse the derived key, the least recently used peer is the one evicted (and wiped),
+// and changing our private key flushes everything.
+void test_PKC_sharedKeyCache(void)
+{
+    srand(11);
+    uint8_t ourPriv[32], peerPriv[PKI_SHARED_KEY_CACHE_SIZE + 1][32];
+    meshtastic_NodeInfoLite_public_key_t ourPub, peerPub[PKI_SHARED_KEY_CACHE_SIZE + 1];
+    makePeer(ourPriv, ourPub);
+    for (int i = 0; i <= PKI_SHARED_KEY_CACHE_SIZE; i++)
+        makePeer(peerPriv[i], peerPub[i]);
+
+    uint8_t plain[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    uint8_t encrypted[64] __attribute__((__aligned__));
+    uint8_t decrypted[64] __attribute__((__aligned__));
+    uint8_t firstKey[32];
+
+    crypto->setDHPrivateKey(ourPriv);
+    TEST_ASSERT_EQUAL_INT(0, cachedPeers());
+    TEST_ASSERT(crypto->encryptCurve25519(1, 2, peerPub[0], 77, sizeof(plain), plain, encrypted));
+    memcpy(firstKey, crypto->shared_key, 32);
+    TEST_ASSERT_EQUAL_INT(1, cachedPeers());
+    TEST_ASSERT(crypto->encryptCurve25519(1, 2, peerPub[0], 78, sizeof(plain), plain, encrypted));
+    TEST_ASSERT_EQUAL_MEMORY(firstKey, crypto->shared_key, 32);
+    TEST_ASSERT_EQUAL_INT(1, cachedPeers());
+
+    // The peer derives the same key from its side (its own cache is flushed by the key switch)
+    crypto->setDHPrivateKey(peerPriv[0]);
+    TEST_ASSERT_EQUAL_INT(0, cachedPeers());
+    TEST_ASSERT(crypto->decryptCurve25519(2, ourPub, 78, sizeof(plain) + 12, encrypted, decrypted));
+    TEST_ASSERT_EQUAL_MEMORY(plain, decrypted, sizeof(plain));
+    TEST_ASSERT_EQUAL_MEMORY(firstKey, crypto->shared_key, 32);
+
+    // Fill the cache, touch peer 0 again, then one more peer pushes out peer 1
+    crypto->setDHPrivateKey(ourPriv);
+    for (int i = 0; i < PKI_SHARED_KEY_CACHE_SIZE; i++)
+        TEST_ASSERT(crypto->encryptCurve25519(1, 2, peerPub[i], 80 + i, sizeof(plain), plain, encrypted));
+    TEST_ASSERT(crypto->encryptCurve25519(1, 2, peerPub[0], 90, sizeof(plain), plain, encrypted));
+    TEST_ASSERT(crypto->encryptCurve25519(1, 2, peerPub[PKI_SHARED_KEY_CACHE_SIZE], 91, sizeof(plain), plain, encrypted));
+    TEST_ASSERT_EQUAL_INT(PKI_SHARED_KEY_CACHE_SIZE, cachedPeers());
+    TEST_ASSERT_TRUE(isCached(peerPub[0]));
+    TEST_ASSERT_FALSE(isCached(peerPub[1]));
+    TEST_ASSERT_TRUE(isCached(peerPub[PKI_SHARED_KEY_CACHE_SIZE]));
+
+    // Key rotation: nothing of the old keys may survive
+    crypto->setDHPrivateKey(peerPriv[1]);
+    const uint8_t *raw = (const uint8_t *)crypto->sharedKeyCache;
+    for (size_t i = 0; i < sizeof(crypto->sharedKeyCache); i++)
+        TEST_ASSERT_EQUAL_UINT8(0, raw[i]);
+}
+
 void test_XEdDSA(void)
 {
     uint8_t private_key[32];
@@ -245,6 +322,39 @@ void test_XEdDSA_curve_to_ed_cache(void)
     TEST_ASSERT_FALSE(crypto->xeddsa_verify(pubA, fromNode, packetId, portnum, message, sizeof(message), sigB));
 }
 
+static bool edKeyCached(const uint8_t *curvePub)
+{
+    for (const auto &e : crypto->edKeyCache)
+        if (e.lastUsed && memcmp(e.curvePubkey, curvePub, 32) == 0)
+            return true;
+    return false;
+}
+
+// A full cache of signers stays resident across rounds; one more signer evicts the least recently used.
+void test_XEdDSA_keyCache_manySigners(void)
+{
+    const int n = XEDDSA_KEY_CACHE_SIZE + 1;
+    static uint8_t pub[XEDDSA_KEY_CACHE_SIZE + 1][32], sig[XEDDSA_KEY_CACHE_SIZE + 1][64];
+    uint8_t priv[32];
+    uint8_t message[] = "many signers";
+    for (int i = 0; i < n; i++) {
+        crypto->generateKeyPair(pub[i], priv);
+        TEST_ASSERT(crypto->xeddsa_sign(0x100 + i, 7, 3, message, sizeof(message), sig[i]));
+    }
+
+    for (int round = 0; round < 2; round++)
+        for (int i = 0; i < XEDDSA_KEY_CACHE_SIZE; i++)
+            TEST_ASSERT_TRUE(crypto->xeddsa_verify(pub[i], 0x100 + i, 7, 3, message, sizeof(message), sig[i]));
+    for (int i = 0; i < XEDDSA_KEY_CACHE_SIZE; i++)
+        TEST_ASSERT_TRUE(edKeyCached(pub[i]));
+
+    TEST_ASSERT_TRUE(crypto->xeddsa_verify(pub[0], 0x100, 7, 3, message, sizeof(message), sig[0])); // touch signer 0
+    TEST_ASSERT_TRUE(crypto->xeddsa_verify(pub[n - 1], 0x100 + n - 1, 7, 3, message, sizeof(message), sig[n - 1]));
+    TEST_ASSERT_TRUE(edKeyCached(pub[0]));
+    TEST_ASSERT_FALSE(edKeyCached(pub[1]));
+    TEST_ASSERT_TRUE(edKeyCached(pub[n - 1]));
+}
+
 // A payload at the maximum signable size (DATA_PAYLOAD_LEN - signature) round-trips and detects tampering.
 void test_XEdDSA_max_payload(void)
 {
@@ -310,6 +420,56 @@ void test_AES_CTR(void)
     TEST_ASSERT_EQUAL_MEMORY(expected, plain, 16);
 }
 
+// The pre-cache implementation: a fresh CTR<AES> and key expansion for every call.
+static void referenceAESCtr(const CryptoKey &k, const uint8_t *nonce, size_t numBytes, uint8_t *bytes)
+{
+    std::unique_ptr<CTRCommon> ctr;
+    if (k.length == 16)
+        ctr = std::unique_ptr<CTRCommon>(new CTR<AES128>());
+    else
+        ctr = std::unique_ptr<CTRCommon>(new CTR<AES256>());
+    ctr->setKey(k.bytes, k.length);
+    ctr->setIV(nonce, 16);
+    ctr->setCounterSize(4);
+    ctr->encrypt(bytes, bytes, numBytes);
+}
+
+static void randomKey(CryptoKey &k, int8_t length)
+{
+    k.length = length;
+    for (int i = 0; i < 32; i++)
+        k.bytes[i] = (uint8_t)rand();
+}
+
+// Cached schedules and whole-block keystream must match CTR<> byte for byte: every length up to
+// MAX_BLOCKSIZE, counters about to wrap, and more distinct keys than the schedule cache holds.
+void test_AES_CTR_matchesReference(void)
+{
+    srand(7);
+    CryptoKey keys[AES_KEY_CACHE_SIZE + 3];
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+        randomKey(keys[i], (i & 1) ? 16 : 32);
+
+    uint8_t nonce[16], ours[MAX_BLOCKSIZE], theirs[MAX_BLOCKSIZE];
+    for (size_t len = 0; len <= MAX_BLOCKSIZE; len++) {
+        const CryptoKey &k = keys[len % (sizeof(keys) / sizeof(keys[0]))];
+        for (int i = 0; i < 16; i++)
+            nonce[i] = (uint8_t)rand();
+        if (len % 3 == 0)
+            memset(nonce + 12, 0xFF, 4); // counter wraps after the first block
+        for (size_t i = 0; i < len; i++)
+            ours[i] = theirs[i] = (uint8_t)rand();
+        uint8_t nonceCopy[16];
+        memcpy(nonceCopy, nonce, sizeof(nonce));
+
+        crypto->encryptAESCtr(k, nonce, len, ours);
+        referenceAESCtr(k, nonceCopy, len, theirs);
+        TEST_ASSERT_EQUAL_MEMORY(nonceCopy, nonce, 16);
+        if (len)
+            TEST_ASSERT_EQUAL_MEMORY(theirs, ours, len);
+    }
+}
+
 void setup()
 {
     // NOTE!!! Wait for >2 secs
@@ -323,11 +483,14 @@ void setup()
     RUN_TEST(test_ECB_AES256);
     RUN_TEST(test_DH25519);
     RUN_TEST(test_AES_CTR);
+    RUN_TEST(test_AES_CTR_matchesReference);
     RUN_TEST(test_PKC);
+    RUN_TEST(test_PKC_sharedKeyCache);
     RUN_TEST(test_XEdDSA);
     RUN_TEST(test_XEdDSA_cross_key_reject);
     RUN_TEST(test_XEdDSA_empty_key_sign_fails);
     RUN_TEST(test_XEdDSA_curve_to_ed_cache);
+    RUN_TEST(test_XEdDSA_keyCache_manySigners);
     RUN_TEST(test_XEdDSA_max_payload);
     RUN_TEST(test_XEdDSA_repeated_sign_is_randomized);
     exit(UNITY_END()); // stop unit testing
@@ -0,0 +1,177 @@
+/*
+ * Unit tests for EpollReactor - the epoll wait mainDelay sleeps in on Linux meshtasticd.
+ *
+ * Covers timeouts, wake() from another thread, InterruptableDelay::interrupt() ending the sleep, fd callbacks,
+ * edge-triggered rearming and ownership checks on unwatch.
+ */
+
+#include "TestUtil.h"
+#include <unity.h>
+
+#include "concurrency/EpollReactor.h"
+
+#if HAS_EPOLL_REACTOR
+
+#include "concurrency/OSThread.h"
+#include <Arduino.h>
+#include <sys/epoll.h>
+#include <thread>
+#include <unistd.h>
+
+using concurrency::EpollReactor;
+
+static int fds[2];
+static int calls;
+static uint32_t lastEvents;
+static void *lastCtx;
+
+static void onReady(void *ctx, uint32_t events)
+{
+    calls++;
+    lastEvents = events;
+    lastCtx = ctx;
+}
+
+void setUp(void)
+{
+    TEST_ASSERT_EQUAL(0, pipe(fds));
+    calls = 0;
+    lastEvents = 0;
+    lastCtx = nullptr;
+}
+
+void tearDown(void)
+{
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_wait_times_out()
+{
+    EpollReactor r;
+    TEST_ASSERT_TRUE(r.begin());
+    uint32_t start = millis();
+    TEST_ASSERT_FALSE(r.wait(30));
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(25, millis() - start);
+}
+
+void test_wake_from_other_thread_ends_wait()
+{
+    EpollReactor r;
+    TEST_ASSERT_TRUE(r.begin());
+    std::thread t([&r]() {
+        usleep(10 * 1000);
+        r.wake();
+    });
+    uint32_t start = millis();
+    TEST_ASSERT_TRUE(r.wait(5000));
+    t.join();
+    TEST_ASSERT_LESS_THAN_UINT32(1000, millis() - start);
+    TEST_ASSERT_EQUAL_UINT32(1, r.getInterruptWakeups());
+
+    // Several wakes before the wait collapse into one, and are consumed by it
+    r.wake();
+    r.wake();
+    TEST_ASSERT_TRUE(r.wait(0));
+    TEST_ASSERT_FALSE(r.wait(0));
+}
+
+void test_interruptable_delay_uses_reactor()
+{
+    std::thread t([]() {
+        usleep(10 * 1000);
+        concurrency::mainDelay.interrupt();
+    });
+    uint32_t start = millis();
+    TEST_ASSERT_FALSE(concurrency::mainDelay.delay(5000)); // false: interrupted
+    t.join();
+    TEST_ASSERT_LESS_THAN_UINT32(1000, millis() - start);
+}
+
+void test_fd_ready_runs_callback()
+{
+    EpollReactor r;
+    int owner;
+    TEST_ASSERT_TRUE(r.watch(fds[0], onReady, &owner));
+    TEST_ASSERT_EQUAL_UINT(1, r.numWatched());
+    TEST_ASSERT_FALSE(r.wait(0));
+    TEST_ASSERT_EQUAL(0, calls);
+
+    TEST_ASSERT_EQUAL(1, write(fds[1], "x", 1));
+    TEST_ASSERT_TRUE(r.wait(1000));
+    TEST_ASSERT_EQUAL(1, calls);
+    TEST_ASSERT_EQUAL_PTR(&owner, lastCtx);
+    TEST_ASSERT_TRUE(lastEvents & EPOLLIN);
+    TEST_ASSERT_EQUAL_UINT32(1, r.getFdWakeups());
+}
+
+void test_unread_data_does_not_spin()
+{
+    EpollReactor r;
+    int owner;
+    TEST_ASSERT_TRUE(r.watch(fds[0], onReady, &owner));
+    TEST_ASSERT_EQUAL(1, write(fds[1], "x", 1));
+    TEST_ASSERT_TRUE(r.wait(0));
+    // Edge triggered: the byte is still unread but we are not told again until more arrives
+    TEST_ASSERT_FALSE(r.wait(0));
+    TEST_ASSERT_EQUAL(1, write(fds[1], "y", 1));
+    TEST_ASSERT_TRUE(r.wait(0));
+    TEST_ASSERT_EQUAL(2, calls);
+}
+
+void test_unwatch_checks_owner()
+{
+    EpollReactor r;
+    int owner, stranger;
+    TEST_ASSERT_TRUE(r.watch(fds[0], onReady, &owner));
+    r.unwatch(fds[0], &stranger); // e.g. a stale fd number from a closed socket
+    TEST_ASSERT_EQUAL_UINT(1, r.numWatched());
+    r.unwatch(fds[0], &owner);
+    TEST_ASSERT_EQUAL_UINT(0, r.numWatched());
+
+    TEST_ASSERT_EQUAL(1, write(fds[1], "x", 1));
+    TEST_ASSERT_FALSE(r.wait(0));
+    TEST_ASSERT_EQUAL(0, calls);
+}
+
+void test_hangup_is_reported()
+{
+    EpollReactor r;
+    int owner;
+    TEST_ASSERT_TRUE(r.watch(fds[0], onReady, &owner));
+    close(fds[1]);
+    fds[1] = dup(fds[0]); // keep tearDown's close() balanced
+    TEST_ASSERT_TRUE(r.wait(1000));
+    TEST_ASSERT_TRUE(lastEvents & EPOLLHUP);
+}
+
+void setup()
+{
+    initializeTestEnvironment();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_wait_times_out);
+    RUN_TEST(test_wake_from_other_thread_ends_wait);
+    RUN_TEST(test_interruptable_delay_uses_reactor);
+    RUN_TEST(test_fd_ready_runs_callback);
+    RUN_TEST(test_unread_data_does_not_spin);
+    RUN_TEST(test_unwatch_checks_owner);
+    RUN_TEST(test_hangup_is_reported);
+    exit(UNITY_END());
+}
+
+#else
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void setup()
+{
+    initializeTestEnvironment();
+    UNITY_BEGIN();
+    exit(UNITY_END());
+}
+
+#endif // HAS_EPOLL_REACTOR
+
+void loop() {}
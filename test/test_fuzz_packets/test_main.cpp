@@ -69,6 +69,7 @@ class MockNodeDB : public NodeDB
         testNodes.clear();
         meshNodes = &testNodes;
         numMeshNodes = 0;
+        invalidateNodeIndex();
     }
     void addNode(NodeNum num)
     {
@@ -77,6 +78,7 @@ class MockNodeDB : public NodeDB
         testNodes.push_back(node);
         meshNodes = &testNodes;
         numMeshNodes = testNodes.size();
+        invalidateNodeIndex();
     }
     void setPublicKey(NodeNum num, const uint8_t *pubKey)
     {
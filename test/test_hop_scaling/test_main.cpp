@@ -37,6 +37,7 @@ class MockNodeDB : public NodeDB
     {
         testNodes.clear();
         numMeshNodes = 0;
+        invalidateNodeIndex();
     }
 
     void addTestNode(NodeNum num, uint8_t hopsAway, bool hasHops, uint32_t ageSecs, bool viaMqtt = false)
@@ -50,6 +51,7 @@ class MockNodeDB : public NodeDB
         testNodes.push_back(node);
         meshNodes = &testNodes;
         numMeshNodes = testNodes.size();
+        invalidateNodeIndex();
     }
 
     std::vector<meshtastic_NodeInfoLite> testNodes;
@@ -117,6 +117,7 @@ class MeshBeaconListenerModuleTestShim : public MeshBeaconListenerModule
 // Globals managed by setUp / tearDown.
 // ---------------------------------------------------------------------------
 static MockMeshService *mockSvc = nullptr;
+static const char phoneClient = 0; // stands in for the PhoneAPI reading the to-phone fan-out
 static MockRouter *mockRouter = nullptr;
 static AdminModuleTestShim *testAdmin = nullptr;
 static AirTime *testAirTime = nullptr;
@@ -1021,7 +1022,7 @@ static void test_listener_textMessage_notUnwrapped(void)
     TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, mockRouter->sentPackets.size(),
                                      "Received beacon text must not be re-injected into the mesh");
     // No synthesized TEXT_MESSAGE_APP delivered to the phone (no duplicate of the beacon's text).
-    meshtastic_MeshPacket *toPhone = service->getForPhone();
+    meshtastic_MeshPacket *toPhone = service->getForPhone(&phoneClient);
     TEST_ASSERT_NULL_MESSAGE(toPhone, "Listener must not inject a duplicate text packet to the phone");
 }
 
@@ -1370,8 +1371,8 @@ void tearDown(void)
     // and LeakSanitizer aborts the process at exit.
     if (mockSvc) {
         meshtastic_MeshPacket *p;
-        while ((p = mockSvc->getForPhone()) != nullptr)
-            mockSvc->releaseToPool(p);
+        while ((p = mockSvc->getForPhone(&phoneClient)) != nullptr)
+            mockSvc->releaseForPhone(&phoneClient, p);
     }
 
     service = nullptr;
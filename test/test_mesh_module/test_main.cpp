@@ -9,9 +9,11 @@
 #include "mesh/NodeDB.h"
 #include "mesh/RadioInterface.h"
 #include "mesh/Router.h"
+#include "mesh/SinglePortModule.h"
 #include "modules/NeighborInfoModule.h"
 #include "modules/RoutingModule.h"
 #include "support/MockMeshService.h"
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -168,10 +170,64 @@ class ReplyIgnoreModule : public MeshModule
     }
 };
 
+// Port-routed module (SinglePortModule::dispatchPort) that records the order it was handed packets in.
+class RoutedPortModule : public SinglePortModule
+{
+  public:
+    RoutedPortModule(const char *name, meshtastic_PortNum port, std::vector<const char *> *log = nullptr,
+                     ProcessMessage result = ProcessMessage::CONTINUE)
+        : SinglePortModule(name, port), log(log), result(result)
+    {
+    }
+
+  protected:
+    ProcessMessage handleReceived(const meshtastic_MeshPacket &mp) override
+    {
+        (void)mp;
+        if (log)
+            log->push_back(name);
+        return result;
+    }
+
+  private:
+    std::vector<const char *> *log;
+    ProcessMessage result;
+};
+
+// Fallback-list module: no dispatchPort(), asked about every packet; optionally sees encrypted packets too.
+class AskAlwaysModule : public MeshModule
+{
+  public:
+    AskAlwaysModule(const char *name, std::vector<const char *> *log = nullptr, bool wantsEncrypted = false)
+        : MeshModule(name), log(log)
+    {
+        isPromiscuous = true;
+        encryptedOk = wantsEncrypted;
+    }
+
+  protected:
+    bool wantPacket(const meshtastic_MeshPacket *p) override
+    {
+        (void)p;
+        return log != nullptr;
+    }
+
+    ProcessMessage handleReceived(const meshtastic_MeshPacket &mp) override
+    {
+        (void)mp;
+        log->push_back(name);
+        return ProcessMessage::CONTINUE;
+    }
+
+  private:
+    std::vector<const char *> *log;
+};
+
 static TestModule *testModule;
 static meshtastic_MeshPacket testPacket;
 static MockNodeDB *mockNodeDB;
 static MockMeshService *mockService;
+static const char phoneClient = 0; // stands in for the PhoneAPI reading the to-phone fan-out
 static MockRouter *mockRouter;
 static MockRoutingModule *mockRoutingModule;
 static NeighborInfoModule *realNeighborInfoModule;
@@ -256,8 +312,8 @@ void tearDown(void)
 
     while (auto *status = mockService->getQueueStatusForPhone())
         mockService->releaseQueueStatusToPool(status);
-    while (auto *toPhone = mockService->getForPhone())
-        mockService->releaseToPool(toPhone);
+    while (auto *toPhone = mockService->getForPhone(&phoneClient))
+        mockService->releaseForPhone(&phoneClient, toPhone);
     delete mockService;
     mockService = nullptr;
     service = nullptr;
@@ -486,12 +542,12 @@ static void test_localReplyToSelf_isDeliveredToPhone()
 
     service->sendToMesh(packetPool.allocCopy(reply)); // default src == RX_SRC_LOCAL, as callModules sends replies
 
-    meshtastic_MeshPacket *toPhone = mockService->getForPhone();
+    meshtastic_MeshPacket *toPhone = mockService->getForPhone(&phoneClient);
     TEST_ASSERT_NOT_NULL(toPhone);
     TEST_ASSERT_EQUAL_UINT32(0xABCD1234, toPhone->id);
     TEST_ASSERT_EQUAL_UINT32(0x12345678, toPhone->decoded.request_id);
-    mockService->releaseToPool(toPhone);
-    TEST_ASSERT_NULL(mockService->getForPhone()); // exactly one delivery
+    mockService->releaseForPhone(&phoneClient, toPhone);
+    TEST_ASSERT_NULL(mockService->getForPhone(&phoneClient)); // exactly one delivery
 
     meshtastic_QueueStatus *qs = mockService->getQueueStatusForPhone();
     TEST_ASSERT_NOT_NULL(qs);
@@ -520,13 +576,13 @@ static void test_phoneRequest_replyReachesPhone()
 
     TEST_ASSERT_EQUAL_UINT32(1, replyOwner->allocReplyCalls);
 
-    meshtastic_MeshPacket *toPhone = mockService->getForPhone();
+    meshtastic_MeshPacket *toPhone = mockService->getForPhone(&phoneClient);
     TEST_ASSERT_NOT_NULL(toPhone);
     TEST_ASSERT_EQUAL(meshtastic_PortNum_PRIVATE_APP, toPhone->decoded.portnum);
     TEST_ASSERT_EQUAL_UINT32(0x5EED0001, toPhone->decoded.request_id);
     TEST_ASSERT_EQUAL_UINT32(LOCAL_NODE, toPhone->to);
-    mockService->releaseToPool(toPhone);
-    TEST_ASSERT_NULL(mockService->getForPhone()); // the request itself must not echo back
+    mockService->releaseForPhone(&phoneClient, toPhone);
+    TEST_ASSERT_NULL(mockService->getForPhone(&phoneClient)); // the request itself must not echo back
 
     // One QueueStatus for the request, one for the reply, both reporting success
     uint32_t statuses = 0;
@@ -541,6 +597,179 @@ static void test_phoneRequest_replyReachesPhone()
     TEST_ASSERT_EQUAL_UINT32(0, mockRoutingModule->ackNaks.size());
 }
 
+static meshtastic_MeshPacket *makePhonePacket(meshtastic_PortNum port, PacketId id)
+{
+    meshtastic_MeshPacket *p = packetPool.allocZeroed();
+    p->from = REMOTE_NODE;
+    p->to = NODENUM_BROADCAST;
+    p->id = id;
+    p->which_payload_variant = meshtastic_MeshPacket_decoded_tag;
+    p->decoded.portnum = port;
+    return p;
+}
+
+// Drain the to-phone queue, returning the ids in delivery order.
+static std::vector<PacketId> drainPhoneQueue()
+{
+    std::vector<PacketId> ids;
+    while (meshtastic_MeshPacket *p = mockService->getForPhone(&phoneClient)) {
+        ids.push_back(p->id);
+        mockService->releaseForPhone(&phoneClient, p);
+    }
+    return ids;
+}
+
+// A full queue of periodic broadcasts makes room for fresh traffic by dropping its oldest entry.
+static void test_toPhone_fullQueueEvictsOldestLowRetention()
+{
+    const int capacity = mockService->toPhoneQueueCapacity();
+    for (int i = 0; i < capacity; i++)
+        mockService->sendToPhone(makePhonePacket(meshtastic_PortNum_POSITION_APP, 1 + i));
+    TEST_ASSERT_EQUAL_INT(capacity, mockService->numToPhoneQueued());
+
+    mockService->sendToPhone(makePhonePacket(meshtastic_PortNum_TELEMETRY_APP, 1000));
+    mockService->sendToPhone(makePhonePacket(meshtastic_PortNum_TEXT_MESSAGE_APP, 1001));
+
+    TEST_ASSERT_EQUAL_UINT32(2, mockService->getToPhoneDropStats().evicted);
+    TEST_ASSERT_EQUAL_UINT32(0, mockService->getToPhoneDropStats().rejected);
+    std::vector<PacketId> ids = drainPhoneQueue();
+    TEST_ASSERT_EQUAL_UINT32(capacity, ids.size());
+    TEST_ASSERT_EQUAL_UINT32(3, ids.front()); // 1 and 2 were evicted
+    TEST_ASSERT_EQUAL_UINT32(1000, ids[capacity - 2]);
+    TEST_ASSERT_EQUAL_UINT32(1001, ids[capacity - 1]);
+}
+
+// Text and admin packets are evicted last: the oldest packet of the lowest class queued goes first, an incoming
+// broadcast is turned away when everything queued outranks it, and text only displaces text once nothing else is left.
+static void test_toPhone_textAndAdminRetainedLongest()
+{
+    const int capacity = mockService->toPhoneQueueCapacity();
+    for (int i = 0; i < capacity; i++) {
+        const meshtastic_PortNum port = (i == 1)       ? meshtastic_PortNum_NODEINFO_APP
+                                        : (i % 2 == 0) ? meshtastic_PortNum_TEXT_MESSAGE_APP
+                                                       : meshtastic_PortNum_ADMIN_APP;
+        mockService->sendToPhone(makePhonePacket(port, 1 + i));
+    }
+    mockService->sendToPhone(makePhonePacket(meshtastic_PortNum_ROUTING_APP, 1000)); // evicts the nodeinfo (id 2)
+    TEST_ASSERT_EQUAL_UINT32(1, mockService->getToPhoneDropStats().evicted);
+
+    mockService->sendToPhone(makePhonePacket(meshtastic_PortNum_POSITION_APP, 1001)); // outranked by everything queued
+    TEST_ASSERT_EQUAL_UINT32(1, mockService->getToPhoneDropStats().rejected);
+
+    mockService->sendToPhone(makePhonePacket(meshtastic_PortNum_TEXT_MESSAGE_APP, 1002)); // evicts the routing packet
+    mockService->sendToPhone(makePhonePacket(meshtastic_PortNum_TEXT_MESSAGE_APP, 1003)); // evicts the oldest text (id 1)
+    TEST_ASSERT_EQUAL_UINT32(3, mockService->getToPhoneDropStats().evicted);
+
+    std::vector<PacketId> ids = drainPhoneQueue();
+    TEST_ASSERT_EQUAL_UINT32(capacity, ids.size());
+    for (PacketId gone : {(PacketId)1, (PacketId)2, (PacketId)1000, (PacketId)1001})
+        TEST_ASSERT_TRUE(std::find(ids.begin(), ids.end(), gone) == ids.end());
+    TEST_ASSERT_EQUAL_UINT32(3, ids.front());
+    TEST_ASSERT_EQUAL_UINT32(1002, ids[capacity - 2]);
+    TEST_ASSERT_EQUAL_UINT32(1003, ids.back());
+}
+
+// Port-routed and always-asked modules are still handed a packet in registration order, and a STOP still cuts off
+// every later module whichever list it sits on.
+static void test_portDispatch_keepsRegistrationOrderAndStop()
+{
+    std::vector<const char *> log;
+    registerDispatchModule(new AskAlwaysModule("always-1", &log));
+    auto *position = registerDispatchModule(new RoutedPortModule("position", meshtastic_PortNum_POSITION_APP, &log));
+    auto *telemetry = registerDispatchModule(new RoutedPortModule("telemetry", meshtastic_PortNum_TELEMETRY_APP, &log));
+    registerDispatchModule(new AskAlwaysModule("always-2", &log));
+    registerDispatchModule(new RoutedPortModule("position-stop", meshtastic_PortNum_POSITION_APP, &log, ProcessMessage::STOP));
+    registerDispatchModule(new AskAlwaysModule("always-3", &log));
+
+    meshtastic_MeshPacket packet = makeRequest(meshtastic_PortNum_POSITION_APP);
+    packet.decoded.want_response = false;
+    MeshModule::callModules(packet);
+
+    TEST_ASSERT_EQUAL_UINT32(4, log.size());
+    TEST_ASSERT_EQUAL_STRING("always-1", log[0]);
+    TEST_ASSERT_EQUAL_STRING("position", log[1]);
+    TEST_ASSERT_EQUAL_STRING("always-2", log[2]);
+    TEST_ASSERT_EQUAL_STRING("position-stop", log[3]);
+
+    // The telemetry module was never even asked about a position packet
+    TEST_ASSERT_EQUAL_UINT32(0, telemetry->getDispatchStats().offered);
+    TEST_ASSERT_EQUAL_UINT32(1, position->getDispatchStats().offered);
+    TEST_ASSERT_EQUAL_UINT32(1, position->getDispatchStats().handled);
+}
+
+// Encrypted packets have no portnum: only encryptedOk modules are offered them, port-routed ones are skipped.
+static void test_portDispatch_encryptedGoesToFallbackOnly()
+{
+    std::vector<const char *> log;
+    auto *routed = registerDispatchModule(new RoutedPortModule("routed", meshtastic_PortNum_TEXT_MESSAGE_APP, &log));
+    auto *plain = registerDispatchModule(new AskAlwaysModule("plain", &log));
+    registerDispatchModule(new AskAlwaysModule("encrypted-ok", &log, true));
+
+    meshtastic_MeshPacket packet = makeRequest(meshtastic_PortNum_TEXT_MESSAGE_APP);
+    packet.decoded.want_response = false;
+    packet.which_payload_variant = meshtastic_MeshPacket_encrypted_tag;
+    MeshModule::callModules(packet);
+
+    TEST_ASSERT_EQUAL_UINT32(1, log.size());
+    TEST_ASSERT_EQUAL_STRING("encrypted-ok", log[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, routed->getDispatchStats().offered);
+    TEST_ASSERT_EQUAL_UINT32(0, plain->getDispatchStats().offered);
+}
+
+// wantPacket() calls per packet with a module roster shaped like setupModules() on portduino - the single-port modules
+// routed by port, and the modules that override wantPacket() more broadly (traffic management, text message, neighbor
+// info, canned message, store & forward, external notification, routing) on the fallback list.
+static void test_portDispatch_modulesRoster_asksFewModules()
+{
+    static const meshtastic_PortNum routedPorts[] = {
+        meshtastic_PortNum_TEXT_MESSAGE_APP,  meshtastic_PortNum_ADMIN_APP,           meshtastic_PortNum_NODEINFO_APP,
+        meshtastic_PortNum_MESH_BEACON_APP,   meshtastic_PortNum_MESH_BEACON_APP,     meshtastic_PortNum_POSITION_APP,
+        meshtastic_PortNum_WAYPOINT_APP,      meshtastic_PortNum_TRACEROUTE_APP,      meshtastic_PortNum_DETECTION_SENSOR_APP,
+        meshtastic_PortNum_ATAK_PLUGIN,       meshtastic_PortNum_KEY_VERIFICATION_APP, meshtastic_PortNum_ATAK_PLUGIN_V2,
+        meshtastic_PortNum_NODE_STATUS_APP,   meshtastic_PortNum_REMOTE_HARDWARE_APP, meshtastic_PortNum_POWERSTRESS_APP,
+        meshtastic_PortNum_TELEMETRY_APP,     meshtastic_PortNum_TELEMETRY_APP,       meshtastic_PortNum_TELEMETRY_APP,
+        meshtastic_PortNum_TELEMETRY_APP,     meshtastic_PortNum_TELEMETRY_APP,       meshtastic_PortNum_TELEMETRY_APP,
+        meshtastic_PortNum_SERIAL_APP,        meshtastic_PortNum_AUDIO_APP,           meshtastic_PortNum_PAXCOUNTER_APP,
+        meshtastic_PortNum_RANGE_TEST_APP,
+    };
+    const size_t fallbackCount = 7;
+    std::vector<RoutedPortModule *> routed;
+    size_t fallbacks = 0;
+    for (size_t i = 0; i < sizeof(routedPorts) / sizeof(routedPorts[0]); i++) {
+        routed.push_back(registerDispatchModule(new RoutedPortModule("roster-routed", routedPorts[i])));
+        if (i % 4 == 1 && fallbacks < fallbackCount - 1) {
+            registerDispatchModule(new AskAlwaysModule("roster-fallback"));
+            fallbacks++;
+        }
+    }
+    registerDispatchModule(new AskAlwaysModule("roster-routing-shaped", nullptr, true)); // RoutingModule registers last
+
+    static const meshtastic_PortNum trafficMix[] = {meshtastic_PortNum_POSITION_APP, meshtastic_PortNum_TELEMETRY_APP,
+                                                    meshtastic_PortNum_NODEINFO_APP, meshtastic_PortNum_TEXT_MESSAGE_APP,
+                                                    meshtastic_PortNum_ROUTING_APP};
+    const int packets = 1000;
+    meshtastic_MeshPacket packet = makeRequest(meshtastic_PortNum_POSITION_APP);
+    packet.decoded.want_response = false;
+    packet.to = NODENUM_BROADCAST;
+
+    for (int i = 0; i < packets; i++) {
+        packet.decoded.portnum = trafficMix[i % 5];
+        MeshModule::callModules(packet);
+    }
+
+    uint64_t offered = 0;
+    for (auto *module : dispatchModules)
+        offered += module->getDispatchStats().offered;
+    // Every routed module only ever saw its own port
+    uint32_t routedOffered = 0;
+    for (auto *module : routed)
+        routedOffered += module->getDispatchStats().offered;
+
+    TEST_ASSERT_TRUE(offered < (uint64_t)packets * (fallbackCount + 7)); // well under "ask all ~34 modules"
+    TEST_ASSERT_TRUE(routedOffered > 0);
+    TEST_ASSERT_EQUAL_UINT32(0, routed[3]->getDispatchStats().offered); // MESH_BEACON_APP: not in the mix
+}
+
 void setup()
 {
     initializeTestEnvironment();
@@ -567,6 +796,11 @@ void setup()
     RUN_TEST(test_dispatch_realNeighborInfoCannotShadowTelemetryOwner);
     RUN_TEST(test_localReplyToSelf_isDeliveredToPhone);
     RUN_TEST(test_phoneRequest_replyReachesPhone);
+    RUN_TEST(test_toPhone_fullQueueEvictsOldestLowRetention);
+    RUN_TEST(test_toPhone_textAndAdminRetainedLongest);
+    RUN_TEST(test_portDispatch_keepsRegistrationOrderAndStop);
+    RUN_TEST(test_portDispatch_encryptedGoesToFallbackOnly);
+    RUN_TEST(test_portDispatch_modulesRoster_asksFewModules);
     exit(UNITY_END());
 }
 
@@ -0,0 +1,330 @@
+/*
+ * Unit tests for MeshPacketQueue - the radio TX queue.
+ *
+ * The queue keeps one FIFO per CompareMeshPacketFunc ordering class plus a (from,id) hash index. These tests
+ * check it against the previous implementation (a std::vector kept sorted with upper_bound, scanned front to
+ * back), which is reproduced below as the reference, up to backhaul-sized queue lengths.
+ */
+
+#include "MeshTypes.h"
+#include "TestUtil.h"
+#include <unity.h>
+
+#include "mesh/MeshPacketQueue.h"
+#include "mesh/NodeDB.h"
+#include "mesh/Router.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static constexpr NodeNum OUR_NODE = 0x0000BEEF;
+
+// ---------------------------------------------------------------------------
+// Reference: the sorted-vector queue MeshPacketQueue used to be (ordering and lookup only)
+// ---------------------------------------------------------------------------
+struct RefQueue {
+    std::vector<meshtastic_MeshPacket *> queue;
+
+    void enqueue(meshtastic_MeshPacket *p)
+    {
+        queue.insert(std::upper_bound(queue.begin(), queue.end(), p, CompareMeshPacketFunc), p);
+    }
+
+    meshtastic_MeshPacket *dequeue()
+    {
+        if (queue.empty())
+            return nullptr;
+        auto *p = queue.front();
+        queue.erase(queue.begin());
+        return p;
+    }
+
+    meshtastic_MeshPacket *remove(NodeNum from, PacketId id, bool tx_normal, bool tx_late, uint8_t hop_limit_lt)
+    {
+        for (auto it = queue.begin(); it != queue.end(); it++) {
+            auto p = *it;
+            if (getFrom(p) == from && p->id == id && ((tx_normal && !p->tx_after) || (tx_late && p->tx_after)) &&
+                (!hop_limit_lt || p->hop_limit < hop_limit_lt)) {
+                queue.erase(it);
+                return p;
+            }
+        }
+        return nullptr;
+    }
+};
+
+static meshtastic_MeshPacket makePacket(NodeNum from, PacketId id, meshtastic_MeshPacket_Priority pri, uint32_t txAfter = 0,
+                                        uint8_t hopLimit = 3)
+{
+    meshtastic_MeshPacket p = meshtastic_MeshPacket_init_zero;
+    p.from = from;
+    p.id = id;
+    p.priority = pri;
+    p.tx_after = txAfter;
+    p.hop_limit = hopLimit;
+    return p;
+}
+
+static const meshtastic_MeshPacket_Priority kPriorities[] = {
+    meshtastic_MeshPacket_Priority_BACKGROUND, meshtastic_MeshPacket_Priority_DEFAULT, meshtastic_MeshPacket_Priority_RELIABLE,
+    meshtastic_MeshPacket_Priority_RESPONSE,   meshtastic_MeshPacket_Priority_HIGH,    meshtastic_MeshPacket_Priority_ACK,
+};
+
+// Random packet pool: a few senders (one of them us, sometimes as from=0), small id space so (from,id)
+// duplicates and late/normal copies of one packet both occur.
+static std::vector<meshtastic_MeshPacket> makeRandomPackets(size_t n, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<meshtastic_MeshPacket> pkts;
+    pkts.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        uint32_t r = rng();
+        NodeNum from = (r % 4 == 0) ? ((r & 0x10) ? 0 : OUR_NODE) : 0x1000 + (r >> 8) % 8;
+        pkts.push_back(makePacket(from, 1 + (rng() % 64), kPriorities[rng() % 6], (rng() % 4 == 0) ? 1000 + rng() % 5000 : 0,
+                                  rng() % 8));
+    }
+    return pkts;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ===========================================================================
+// Ordering
+// ===========================================================================
+
+void test_equal_rank_is_fifo(void)
+{
+    MeshPacketQueue q(8);
+    meshtastic_MeshPacket a = makePacket(0x1001, 1, meshtastic_MeshPacket_Priority_DEFAULT);
+    meshtastic_MeshPacket b = makePacket(0x1002, 2, meshtastic_MeshPacket_Priority_DEFAULT);
+    meshtastic_MeshPacket c = makePacket(0x1003, 3, meshtastic_MeshPacket_Priority_DEFAULT);
+    q.enqueue(&a);
+    q.enqueue(&b);
+    q.enqueue(&c);
+
+    TEST_ASSERT_EQUAL_PTR(&a, q.dequeue());
+    TEST_ASSERT_EQUAL_PTR(&b, q.dequeue());
+    TEST_ASSERT_EQUAL_PTR(&c, q.dequeue());
+    TEST_ASSERT_NULL(q.dequeue());
+    TEST_ASSERT_TRUE(q.empty());
+}
+
+void test_priority_late_and_origin_order(void)
+{
+    MeshPacketQueue q(8);
+    meshtastic_MeshPacket lateAck = makePacket(0x1001, 1, meshtastic_MeshPacket_Priority_ACK, 5000);
+    meshtastic_MeshPacket bg = makePacket(0x1002, 2, meshtastic_MeshPacket_Priority_BACKGROUND);
+    meshtastic_MeshPacket ourHigh = makePacket(OUR_NODE, 3, meshtastic_MeshPacket_Priority_HIGH);
+    meshtastic_MeshPacket relayedHigh = makePacket(0x1003, 4, meshtastic_MeshPacket_Priority_HIGH);
+    q.enqueue(&lateAck);
+    q.enqueue(&bg);
+    q.enqueue(&ourHigh);
+    q.enqueue(&relayedHigh);
+
+    // Equal priority prefers packets already on the mesh; the late window goes last whatever its priority
+    TEST_ASSERT_EQUAL_PTR(&relayedHigh, q.getFront());
+    TEST_ASSERT_EQUAL_PTR(&relayedHigh, q.dequeue());
+    TEST_ASSERT_EQUAL_PTR(&ourHigh, q.dequeue());
+    TEST_ASSERT_EQUAL_PTR(&bg, q.dequeue());
+    TEST_ASSERT_EQUAL_PTR(&lateAck, q.dequeue());
+}
+
+// Random interleaved enqueue / dequeue / remove must track the sorted-vector reference exactly.
+void test_matches_sorted_vector_reference(void)
+{
+    for (uint32_t seed = 1; seed <= 20; seed++) {
+        std::vector<meshtastic_MeshPacket> pkts = makeRandomPackets(400, seed);
+        std::mt19937 rng(seed * 7919);
+        MeshPacketQueue q(pkts.size());
+        RefQueue ref;
+        size_t next = 0;
+
+        while (next < pkts.size() || !ref.queue.empty()) {
+            uint32_t op = rng() % 10;
+            if (op < 5 && next < pkts.size()) {
+                TEST_ASSERT_TRUE(q.enqueue(&pkts[next]));
+                ref.enqueue(&pkts[next]);
+                next++;
+            } else if (op < 8) {
+                TEST_ASSERT_EQUAL_PTR(ref.dequeue(), q.dequeue());
+            } else {
+                NodeNum from = (rng() % 4 == 0) ? OUR_NODE : 0x1000 + rng() % 8;
+                PacketId id = 1 + rng() % 64;
+                bool txNormal = rng() % 2, txLate = rng() % 2;
+                uint8_t hopLimitLt = rng() % 5;
+                TEST_ASSERT_EQUAL_PTR(ref.remove(from, id, txNormal, txLate, hopLimitLt),
+                                      q.remove(from, id, txNormal, txLate, hopLimitLt));
+            }
+            TEST_ASSERT_EQUAL_PTR(ref.queue.empty() ? nullptr : ref.queue.front(), q.getFront());
+            TEST_ASSERT_EQUAL_size_t(pkts.size() - ref.queue.size(), q.getFree());
+        }
+    }
+}
+
+// ===========================================================================
+// Lookup by (from,id)
+// ===========================================================================
+
+void test_find_and_remove_by_id(void)
+{
+    MeshPacketQueue q(8);
+    meshtastic_MeshPacket mine = makePacket(0, 7, meshtastic_MeshPacket_Priority_DEFAULT); // from=0 is us
+    meshtastic_MeshPacket other = makePacket(0x1001, 7, meshtastic_MeshPacket_Priority_DEFAULT);
+    q.enqueue(&mine);
+    q.enqueue(&other);
+
+    TEST_ASSERT_TRUE(q.find(OUR_NODE, 7));
+    TEST_ASSERT_EQUAL_PTR(&other, q.getPacketFromQueue(0x1001, 7));
+    TEST_ASSERT_FALSE(q.find(0x1001, 8));
+
+    TEST_ASSERT_EQUAL_PTR(&mine, q.remove(OUR_NODE, 7));
+    TEST_ASSERT_FALSE(q.find(OUR_NODE, 7));
+    TEST_ASSERT_NULL(q.remove(OUR_NODE, 7));
+    TEST_ASSERT_EQUAL_PTR(&other, q.dequeue());
+}
+
+// A normal and a late copy of one packet: the filters pick between them, and without filters the one
+// nearer the front goes first.
+void test_remove_filters_duplicates(void)
+{
+    MeshPacketQueue q(8);
+    meshtastic_MeshPacket late = makePacket(0x1001, 9, meshtastic_MeshPacket_Priority_DEFAULT, 5000, 2);
+    meshtastic_MeshPacket normal = makePacket(0x1001, 9, meshtastic_MeshPacket_Priority_DEFAULT, 0, 4);
+    q.enqueue(&late);
+    q.enqueue(&normal);
+
+    TEST_ASSERT_NULL(q.remove(0x1001, 9, true, true, 2)); // neither hop_limit is < 2
+    TEST_ASSERT_EQUAL_PTR(&late, q.remove(0x1001, 9, false, true));
+    q.enqueue(&late);
+    TEST_ASSERT_EQUAL_PTR(&normal, q.remove(0x1001, 9));
+    TEST_ASSERT_EQUAL_PTR(&late, q.remove(0x1001, 9));
+    TEST_ASSERT_TRUE(q.empty());
+}
+
+// Fill, cancel half by (from,id) as removePendingTXPacket does on relay cancel, then drain: the same
+// packets come out in the same order as from the reference, up to backhaul-sized queue lengths.
+void test_cancel_half_matches_sorted_vector(void)
+{
+    const size_t sizes[] = {16, 256, 1024};
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        std::vector<meshtastic_MeshPacket> pkts = makeRandomPackets(n, 42);
+        for (size_t i = 0; i < n; i++)
+            pkts[i].id = 1 + i; // unique ids so both sides remove the same packets
+
+        RefQueue ref;
+        MeshPacketQueue q(n);
+        for (auto &p : pkts) {
+            ref.enqueue(&p);
+            q.enqueue(&p);
+        }
+        for (size_t i = 0; i < n; i += 2) {
+            ref.remove(getFrom(&pkts[i]), pkts[i].id, true, true, 0);
+            q.remove(getFrom(&pkts[i]), pkts[i].id);
+        }
+        size_t left = 0;
+        while (meshtastic_MeshPacket *p = ref.dequeue()) {
+            TEST_ASSERT_EQUAL_PTR(p, q.dequeue());
+            left++;
+        }
+        TEST_ASSERT_NULL(q.dequeue());
+        TEST_ASSERT_EQUAL_size_t(n / 2, left);
+    }
+}
+
+// ===========================================================================
+// Full queue
+// ===========================================================================
+
+void test_full_queue_evicts_lowest_priority(void)
+{
+    MeshPacketQueue q(3);
+    meshtastic_MeshPacket *pkts[4];
+    const meshtastic_MeshPacket_Priority pri[4] = {meshtastic_MeshPacket_Priority_HIGH, meshtastic_MeshPacket_Priority_BACKGROUND,
+                                                   meshtastic_MeshPacket_Priority_DEFAULT, meshtastic_MeshPacket_Priority_ACK};
+    for (int i = 0; i < 4; i++) {
+        pkts[i] = packetPool.allocZeroed();
+        *pkts[i] = makePacket(0x1001, 100 + i, pri[i]);
+    }
+    bool dropped = false;
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(q.enqueue(pkts[i], &dropped));
+        TEST_ASSERT_FALSE(dropped);
+    }
+
+    TEST_ASSERT_TRUE(q.enqueue(pkts[3], &dropped)); // BACKGROUND is released to make room
+    TEST_ASSERT_TRUE(dropped);
+    TEST_ASSERT_FALSE(q.find(0x1001, 101));
+    TEST_ASSERT_EQUAL_PTR(pkts[3], q.dequeue());
+    TEST_ASSERT_EQUAL_PTR(pkts[0], q.dequeue());
+    TEST_ASSERT_EQUAL_PTR(pkts[2], q.dequeue());
+    packetPool.release(pkts[0]);
+    packetPool.release(pkts[2]);
+    packetPool.release(pkts[3]);
+}
+
+void test_full_queue_evicts_last_non_late_before_late(void)
+{
+    MeshPacketQueue q(3);
+    meshtastic_MeshPacket *low = packetPool.allocZeroed();
+    *low = makePacket(0x1001, 1, meshtastic_MeshPacket_Priority_BACKGROUND);
+    meshtastic_MeshPacket mid = makePacket(0x1001, 2, meshtastic_MeshPacket_Priority_DEFAULT);
+    meshtastic_MeshPacket late = makePacket(0x1001, 3, meshtastic_MeshPacket_Priority_DEFAULT, millis() + 60000);
+    meshtastic_MeshPacket high = makePacket(0x1001, 4, meshtastic_MeshPacket_Priority_HIGH);
+    q.enqueue(&mid);
+    q.enqueue(low);
+    q.enqueue(&late);
+
+    TEST_ASSERT_TRUE(q.enqueue(&high)); // back is late and not yet due, so the BACKGROUND packet goes
+    TEST_ASSERT_FALSE(q.find(0x1001, 1));
+    TEST_ASSERT_EQUAL_PTR(&high, q.dequeue());
+    TEST_ASSERT_EQUAL_PTR(&mid, q.dequeue());
+    TEST_ASSERT_EQUAL_PTR(&late, q.dequeue());
+}
+
+void test_full_queue_refuses_equal_priority(void)
+{
+    MeshPacketQueue q(2);
+    meshtastic_MeshPacket a = makePacket(0x1001, 1, meshtastic_MeshPacket_Priority_DEFAULT);
+    meshtastic_MeshPacket b = makePacket(0x1001, 2, meshtastic_MeshPacket_Priority_DEFAULT);
+    meshtastic_MeshPacket c = makePacket(0x1001, 3, meshtastic_MeshPacket_Priority_DEFAULT);
+    q.enqueue(&a);
+    q.enqueue(&b);
+
+    bool dropped = false;
+    TEST_ASSERT_FALSE(q.enqueue(&c, &dropped));
+    TEST_ASSERT_TRUE(dropped);
+    TEST_ASSERT_EQUAL_size_t(0, q.getFree());
+    TEST_ASSERT_TRUE(q.find(0x1001, 1));
+    TEST_ASSERT_TRUE(q.find(0x1001, 2));
+}
+
+void setup()
+{
+    initializeTestEnvironment();
+    if (!nodeDB)
+        nodeDB = new NodeDB();
+    myNodeInfo.my_node_num = OUR_NODE; // isFromUs() / getFrom() resolve against this
+
+    UNITY_BEGIN();
+    printf("\n=== ordering ===\n");
+    RUN_TEST(test_equal_rank_is_fifo);
+    RUN_TEST(test_priority_late_and_origin_order);
+    RUN_TEST(test_matches_sorted_vector_reference);
+
+    printf("\n=== lookup by (from,id) ===\n");
+    RUN_TEST(test_find_and_remove_by_id);
+    RUN_TEST(test_remove_filters_duplicates);
+    RUN_TEST(test_cancel_half_matches_sorted_vector);
+
+    printf("\n=== full queue ===\n");
+    RUN_TEST(test_full_queue_evicts_lowest_priority);
+    RUN_TEST(test_full_queue_evicts_last_non_late_before_late);
+    RUN_TEST(test_full_queue_refuses_equal_priority);
+    exit(UNITY_END());
+}
+
+void loop() {}
@@ -0,0 +1,337 @@
+/*
+ * Unit tests for MessageStore - the message history behind the screen and InkHUD message views.
+ *
+ * Covers the per-channel and per-peer views over the slot arena (order, reverse walks, peers),
+ * recycling the oldest slot once MAX_MESSAGES_SAVED is reached, the delete helpers, incremental
+ * saves (appends far smaller than a rewrite, reloaded intact, ACK updates and deletions included),
+ * loading the pre-log file format and a torn tail, and a thread view matching a copy filtered out of
+ * the whole history.
+ */
+
+#include "MeshTypes.h"
+#include "TestUtil.h"
+#include <unity.h>
+
+#include "FSCommon.h"
+#include "MessageStore.h"
+#include "SPILock.h"
+#include "mesh/NodeDB.h"
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+#define MSG_BUF_LEN 200
+#define TEST_MSG_FMT(fmt, ...)                                                                                                   \
+    do {                                                                                                                         \
+        char _buf[MSG_BUF_LEN];                                                                                                  \
+        snprintf(_buf, sizeof(_buf), fmt, __VA_ARGS__);                                                                          \
+        TEST_MESSAGE(_buf);                                                                                                      \
+    } while (0)
+
+static const char *kFile = "/Messages_test.msgs";
+
+static constexpr NodeNum SELF = 0x1000;
+static constexpr NodeNum ALICE = 0x1111;
+static constexpr NodeNum BOB = 0x2222;
+
+static MessageStore *store = nullptr;
+
+static StoredMessage message(uint32_t time, NodeNum from, NodeNum to, uint8_t channel, const char *text)
+{
+    StoredMessage m;
+    m.timestamp = time;
+    m.sender = from;
+    m.dest = to;
+    m.channelIndex = channel;
+    m.type = (to != 0 && to != NODENUM_BROADCAST) ? MessageType::DM_TO_US : MessageType::BROADCAST;
+    m.textLength = strlen(text);
+    m.textOffset = MessageStore::storeText(text, m.textLength);
+    return m;
+}
+
+static std::vector<uint32_t> times(const MessageStore::View &view)
+{
+    std::vector<uint32_t> out;
+    for (const auto &m : view)
+        out.push_back(m.timestamp);
+    return out;
+}
+
+static void assertTimes(const std::vector<uint32_t> &want, const MessageStore::View &view)
+{
+    const std::vector<uint32_t> got = times(view);
+    TEST_ASSERT_EQUAL_UINT32(want.size(), got.size());
+    TEST_ASSERT_EQUAL_UINT32(want.size(), view.size());
+    for (size_t i = 0; i < want.size() && i < got.size(); i++)
+        TEST_ASSERT_EQUAL_UINT32(want[i], got[i]);
+}
+
+static void removeFile()
+{
+    concurrency::LockGuard g(spiLock);
+    if (FSCom.exists(kFile))
+        FSCom.remove(kFile);
+}
+
+void setUp(void)
+{
+    removeFile();
+    store = new MessageStore("test");
+}
+
+void tearDown(void)
+{
+    delete store;
+    store = nullptr;
+    removeFile();
+}
+
+// Each conversation is its own list, oldest first; DMs file under the other party either way
+static void test_views_follow_threads()
+{
+    store->addLiveMessage(message(1, ALICE, NODENUM_BROADCAST, 0, "ch0 from alice"));
+    store->addLiveMessage(message(2, ALICE, SELF, 0, "dm from alice"));
+    store->addLiveMessage(message(3, SELF, NODENUM_BROADCAST, 1, "ch1 from me"));
+    store->addLiveMessage(message(4, SELF, ALICE, 0, "dm to alice"));
+    store->addLiveMessage(message(5, BOB, NODENUM_BROADCAST, 0, "ch0 from bob"));
+    store->addLiveMessage(message(6, BOB, SELF, 0, "dm from bob"));
+
+    assertTimes({1, 2, 3, 4, 5, 6}, store->getMessages());
+    assertTimes({1, 5}, store->getChannelMessages(0));
+    assertTimes({3}, store->getChannelMessages(1));
+    assertTimes({}, store->getChannelMessages(2));
+    assertTimes({2, 4}, store->getDirectMessages(ALICE));
+    assertTimes({6}, store->getDirectMessages(BOB));
+
+    // Newest first, the way the renderers walk them
+    const MessageStore::View ch0 = store->getChannelMessages(0);
+    std::vector<uint32_t> reversed;
+    for (auto it = ch0.rbegin(); it != ch0.rend(); ++it)
+        reversed.push_back(it->timestamp);
+    TEST_ASSERT_EQUAL_UINT32(2, reversed.size());
+    TEST_ASSERT_EQUAL_UINT32(5, reversed[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, reversed[1]);
+    TEST_ASSERT_EQUAL_UINT32(6, store->getMessages().back().timestamp);
+    TEST_ASSERT_EQUAL_STRING("dm to alice", MessageStore::getText(store->getDirectMessages(ALICE).back()));
+
+    std::vector<uint32_t> peers = store->getDirectPeers();
+    TEST_ASSERT_EQUAL_UINT32(2, peers.size());
+    TEST_ASSERT_TRUE((peers[0] == ALICE && peers[1] == BOB) || (peers[0] == BOB && peers[1] == ALICE));
+}
+
+// Past MAX_MESSAGES_SAVED the oldest message gives up its slot, whichever thread it was in
+static void test_full_store_recycles_oldest()
+{
+    const uint32_t total = MAX_MESSAGES_SAVED + 5;
+    for (uint32_t i = 1; i <= total; i++) {
+        if (i % 3 == 0)
+            store->addLiveMessage(message(i, ALICE, SELF, 0, "dm"));
+        else
+            store->addLiveMessage(message(i, BOB, NODENUM_BROADCAST, i % 2, "broadcast"));
+    }
+    const MessageStore::View all = store->getMessages();
+    TEST_ASSERT_EQUAL_UINT32(MAX_MESSAGES_SAVED, all.size());
+    TEST_ASSERT_EQUAL_UINT32(6, all.front().timestamp);
+    TEST_ASSERT_EQUAL_UINT32(total, all.back().timestamp);
+
+    const size_t threaded = store->getChannelMessages(0).size() + store->getChannelMessages(1).size() +
+                            store->getDirectMessages(ALICE).size();
+    TEST_ASSERT_EQUAL_UINT32(MAX_MESSAGES_SAVED, threaded);
+    for (const auto &m : store->getDirectMessages(ALICE))
+        TEST_ASSERT_TRUE(m.timestamp >= 6 && m.timestamp % 3 == 0);
+}
+
+static void test_delete_helpers()
+{
+    store->addLiveMessage(message(1, ALICE, NODENUM_BROADCAST, 0, "a"));
+    store->addLiveMessage(message(2, BOB, NODENUM_BROADCAST, 0, "b"));
+    store->addLiveMessage(message(3, ALICE, SELF, 0, "c"));
+    store->addLiveMessage(message(4, SELF, BOB, 0, "d"));
+    store->addLiveMessage(message(5, BOB, NODENUM_BROADCAST, 1, "e"));
+    store->addLiveMessage(message(6, SELF, ALICE, 0, "f"));
+
+    store->deleteOldestMessageInChannel(0);
+    assertTimes({2}, store->getChannelMessages(0));
+    store->deleteOldestMessageWithPeer(ALICE);
+    assertTimes({6}, store->getDirectMessages(ALICE));
+    store->deleteAllMessagesFromNode(BOB); // their broadcasts on every channel and the DM thread with them
+    assertTimes({6}, store->getMessages());
+    TEST_ASSERT_TRUE(store->getDirectMessages(BOB).empty());
+
+    store->addLiveMessage(message(7, ALICE, SELF, 0, "g"));
+    store->deleteAllMessagesWithPeer(ALICE);
+    TEST_ASSERT_TRUE(store->getMessages().empty());
+    TEST_ASSERT_FALSE(store->hasVisibleMessages());
+
+    // Freed slots are reused
+    for (uint32_t i = 0; i < MAX_MESSAGES_SAVED; i++)
+        store->addLiveMessage(message(100 + i, ALICE, NODENUM_BROADCAST, 0, "again"));
+    TEST_ASSERT_EQUAL_UINT32(100, store->getMessages().front().timestamp);
+}
+
+static size_t fileSize()
+{
+    concurrency::LockGuard g(spiLock);
+    auto f = FSCom.open(kFile, FILE_O_READ);
+    const size_t n = f ? f.size() : 0;
+    if (f)
+        f.close();
+    return n;
+}
+
+// A save after one new message appends that message, not the whole history; a reload sees every change
+static void test_incremental_save_round_trip()
+{
+    for (uint32_t i = 1; i < MAX_MESSAGES_SAVED; i++)
+        store->addLiveMessage(message(i, BOB, NODENUM_BROADCAST, 0, "a broadcast of a typical length for the mesh"));
+    store->saveToFlash();
+    const uint32_t snapshotBytes = store->getBytesWritten();
+    TEST_ASSERT_EQUAL_UINT32(snapshotBytes, fileSize());
+
+    store->addLiveMessage(message(500, SELF, ALICE, 2, "hello alice"));
+    store->saveToFlash();
+    const uint32_t appendBytes = store->getBytesWritten() - snapshotBytes;
+    TEST_MSG_FMT("%u messages: first save %u B, saving one more %u B", (unsigned)MAX_MESSAGES_SAVED, (unsigned)snapshotBytes,
+                 (unsigned)appendBytes);
+    TEST_ASSERT_TRUE(appendBytes * 8 < snapshotBytes);
+
+    // ACK result, a deletion and a recycled slot, saved together
+    store->setAckStatus(store->getDirectMessages(ALICE).back(), AckStatus::ACKED);
+    store->deleteOldestMessage(); // saves
+    store->addLiveMessage(message(501, ALICE, SELF, 2, "hi back"));
+    store->addLiveMessage(message(502, BOB, NODENUM_BROADCAST, 0, "newest")); // recycles the oldest again
+    store->saveToFlash();
+
+    MessageStore reloaded("test");
+    reloaded.loadFromFlash();
+    const std::vector<uint32_t> want = times(store->getMessages());
+    assertTimes(want, reloaded.getMessages());
+    TEST_ASSERT_EQUAL_UINT32(3, want.front());
+    assertTimes({500, 501}, reloaded.getDirectMessages(ALICE));
+    const StoredMessage &sent = reloaded.getDirectMessages(ALICE).front();
+    TEST_ASSERT_EQUAL_UINT8((uint8_t)AckStatus::ACKED, (uint8_t)sent.ackStatus);
+    TEST_ASSERT_EQUAL_UINT8(2, sent.channelIndex);
+    TEST_ASSERT_EQUAL_STRING("hello alice", MessageStore::getText(sent));
+    TEST_ASSERT_EQUAL_STRING("newest", MessageStore::getText(reloaded.getMessages().back()));
+
+    // Saves keep the file bounded: the log is rewritten before it grows past twice a full history
+    // (header, then per message a 5 B op, 18 B of fields and up to MAX_MESSAGE_SIZE of text)
+    const uint32_t before = store->getBytesWritten();
+    for (uint32_t i = 0; i < 20 * MAX_MESSAGES_SAVED; i++) {
+        store->addLiveMessage(message(1000 + i, BOB, NODENUM_BROADCAST, 0, "a broadcast of a typical length for the mesh"));
+        store->saveToFlash();
+    }
+    TEST_ASSERT_TRUE(fileSize() <= 8 + 2 * MAX_MESSAGES_SAVED * (5 + 18 + MAX_MESSAGE_SIZE));
+    TEST_ASSERT_TRUE(fileSize() < store->getBytesWritten() - before);
+    MessageStore last("test");
+    last.loadFromFlash();
+    assertTimes(times(store->getMessages()), last.getMessages());
+}
+
+// Files written before the log format load, as do logs cut off mid-record
+static void test_legacy_and_torn_files()
+{
+    struct __attribute__((packed)) LegacyRecord {
+        uint32_t timestamp;
+        uint32_t sender;
+        uint8_t channelIndex;
+        uint32_t dest;
+        uint8_t isBootRelative;
+        uint8_t ackStatus;
+        uint8_t type;
+        uint8_t xeddsaSigned;
+        uint16_t textLength;
+        char text[MAX_MESSAGE_SIZE];
+    };
+    {
+        concurrency::LockGuard g(spiLock);
+        auto f = FSCom.open(kFile, FILE_O_WRITE);
+        const uint8_t n = 2;
+        f.write(&n, 1);
+        for (uint32_t i = 0; i < n; i++) {
+            LegacyRecord r = {};
+            r.timestamp = 10 + i;
+            r.sender = ALICE;
+            r.dest = i ? SELF : NODENUM_BROADCAST;
+            r.type = i ? (uint8_t)MessageType::DM_TO_US : (uint8_t)MessageType::BROADCAST;
+            strcpy(r.text, i ? "old dm" : "old broadcast");
+            r.textLength = strlen(r.text);
+            f.write(reinterpret_cast<const uint8_t *>(&r), sizeof(r));
+        }
+        f.close();
+    }
+    store->loadFromFlash();
+    assertTimes({10}, store->getChannelMessages(0));
+    assertTimes({11}, store->getDirectMessages(ALICE));
+    TEST_ASSERT_EQUAL_STRING("old dm", MessageStore::getText(store->getDirectMessages(ALICE).front()));
+
+    // The next save rewrites it in the log format, then a torn append is dropped on load
+    store->addLiveMessage(message(12, BOB, NODENUM_BROADCAST, 0, "new"));
+    store->saveToFlash();
+    const size_t good = fileSize();
+    store->addLiveMessage(message(13, BOB, NODENUM_BROADCAST, 0, "torn away"));
+    store->saveToFlash();
+    {
+        std::vector<uint8_t> bytes;
+        concurrency::LockGuard g(spiLock);
+        auto f = FSCom.open(kFile, FILE_O_READ);
+        uint8_t buf[256];
+        int got;
+        while ((got = f.read(buf, sizeof(buf))) > 0)
+            bytes.insert(bytes.end(), buf, buf + got);
+        f.close();
+        FSCom.remove(kFile);
+        auto w = FSCom.open(kFile, FILE_O_WRITE);
+        w.write(bytes.data(), good + 7);
+        w.close();
+    }
+    MessageStore reloaded("test");
+    reloaded.loadFromFlash();
+    assertTimes({10, 11, 12}, reloaded.getMessages());
+}
+
+// A full store with 4 channels interleaved: walking a channel's view backwards gives exactly what the
+// old accessors produced by copying the matching messages out of the whole history.
+static void test_thread_view_matches_filtered_copy()
+{
+    for (uint32_t i = 0; i < MAX_MESSAGES_SAVED; i++)
+        store->addLiveMessage(message(i + 1, (i % 2) ? ALICE : BOB, NODENUM_BROADCAST, i % 4, "a broadcast"));
+
+    for (uint8_t ch = 0; ch < 4; ch++) {
+        std::deque<StoredMessage> filtered;
+        for (const auto &m : store->getMessages())
+            if (m.type == MessageType::BROADCAST && m.channelIndex == ch)
+                filtered.push_back(m);
+        TEST_ASSERT_EQUAL_UINT32((MAX_MESSAGES_SAVED + 3 - ch) / 4, filtered.size());
+
+        const MessageStore::View view = store->getChannelMessages(ch);
+        auto expected = filtered.rbegin();
+        for (auto it = view.rbegin(); it != view.rend(); ++it, ++expected) {
+            TEST_ASSERT_TRUE(expected != filtered.rend());
+            TEST_ASSERT_EQUAL_UINT32(expected->timestamp, it->timestamp);
+        }
+        TEST_ASSERT_TRUE(expected == filtered.rend());
+    }
+}
+
+void setup()
+{
+    initializeTestEnvironment();
+    if (!spiLock)
+        initSPI();
+    if (!nodeDB)
+        nodeDB = new NodeDB();
+    myNodeInfo.my_node_num = SELF; // outgoing DMs file under their destination
+
+    UNITY_BEGIN();
+    RUN_TEST(test_views_follow_threads);
+    RUN_TEST(test_full_store_recycles_oldest);
+    RUN_TEST(test_delete_helpers);
+    RUN_TEST(test_incremental_save_round_trip);
+    RUN_TEST(test_legacy_and_torn_files);
+    RUN_TEST(test_thread_view_matches_filtered_copy);
+    exit(UNITY_END());
+}
+
+void loop() {}
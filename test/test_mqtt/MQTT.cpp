@@ -59,8 +59,8 @@ class MockMeshService : public MeshService
     // through handleReceived() directly rather than via the (mock-overridden) enqueueReceivedMessage().
     ~MockMeshService()
     {
-        while (meshtastic_MeshPacket *p = getForPhone())
-            releaseToPool(p);
+        while (meshtastic_MeshPacket *p = getForPhone(this))
+            releaseForPhone(this, p);
     }
     void sendMqttMessageToClientProxy(meshtastic_MqttClientProxyMessage *m) override
     {
@@ -2,6 +2,7 @@
 //   M1 - NodeDB::resolveLastByte / resolveUniqueLastByte (ambiguity-aware last-byte resolution)
 //   M2 - NextHopRouter::getNextHop strict-neighbor gate + Router::shouldDecrementHopLimit favorite check
 //   M3 - NextHopRouter route-health freshness / failure decay
+//   Retransmission deadline heap (doRetransmissions only visits due packets; rollover-safe ordering)
 //
 // Time handling: the route-health helpers take `now` as a parameter so the 30-minute TTL logic is
 // pure and testable without a clock mock. getNextHop()/sinceLastSeen() use the real native clock;
@@ -41,6 +42,7 @@ class MockNodeDB : public NodeDB
         testNodes.clear();
         meshNodes = &testNodes;
         numMeshNodes = 0;
+        invalidateNodeIndex();
     }
 
     // ageSecs is how long ago we last heard the node; getTime() returns a large Unix timestamp on
@@ -62,6 +64,7 @@ class MockNodeDB : public NodeDB
         testNodes.push_back(node);
         meshNodes = &testNodes;
         numMeshNodes = testNodes.size();
+        invalidateNodeIndex();
     }
 
     std::vector<meshtastic_NodeInfoLite> testNodes;
@@ -96,6 +99,38 @@ class NextHopRouterTestShim : public NextHopRouter
         for (auto &h : routeHealth)
             h = RouteHealth{};
     }
+
+    using NextHopRouter::delayRetransmissions;
+    using NextHopRouter::doRetransmissions;
+    using NextHopRouter::dueMsec;
+    using NextHopRouter::findPendingPacket;
+    using NextHopRouter::pending;
+    using NextHopRouter::stopRetransmission;
+
+    // Queue a retransmission record due at `due`, bypassing setNextTx() (which needs the airtime model).
+    // `retx` follows startRetransmission(): 1 means the record expires (no resend) when it comes due.
+    PendingPacket *addPendingForTest(PacketId id, uint32_t due, uint8_t retx = NUM_INTERMEDIATE_RETX)
+    {
+        meshtastic_MeshPacket *p = packetPool.allocZeroed();
+        p->from = 0x22222222;
+        p->to = 0x33333333;
+        p->id = id;
+        GlobalPacketId key(p);
+        pending[key] = PendingPacket(p, retx);
+        PendingPacket *rec = &pending[key];
+        scheduleRetransmission(rec, due);
+        return rec;
+    }
+
+    void resetPendingForTest(uint32_t bias = 0)
+    {
+        while (!pending.empty())
+            stopRetransmission(pending.begin()->first);
+        retransmitQueue.clear();
+        retransmitBias = bias;
+    }
+
+    size_t retransmitQueueSize() const { return retransmitQueue.size(); }
 };
 
 // ---------------------------------------------------------------------------
@@ -150,6 +185,7 @@ void setUp(void)
     config.device.role = meshtastic_Config_DeviceConfig_Role_CLIENT;
     mockNodeDB->clearTestNodes();
     shim->resetRouteHealthForTest();
+    shim->resetPendingForTest();
 }
 
 void tearDown(void) {}
@@ -498,6 +534,107 @@ void test_rebroadcast_declined_send_releases_packet(void)
     TEST_ASSERT_EQUAL_MESSAGE(1, mockIface->sendCount, "the copy must have reached the mock radio");
 }
 
+// ===========================================================================
+// Retransmission deadline heap
+// ===========================================================================
+
+static GlobalPacketId pendingKey(PacketId id)
+{
+    return GlobalPacketId(0x22222222, id);
+}
+
+// Nothing due: doRetransmissions() reports the earliest deadline regardless of insertion order.
+void test_retx_next_wakeup_is_earliest_deadline(void)
+{
+    uint32_t now = millis();
+    shim->addPendingForTest(1, now + 50000);
+    shim->addPendingForTest(2, now + 10000);
+    shim->addPendingForTest(3, now + 30000);
+
+    int32_t d = shim->doRetransmissions();
+    TEST_ASSERT_INT32_WITHIN(1000, 10000, d);
+    TEST_ASSERT_EQUAL_size_t(3, shim->pending.size());
+}
+
+// A stopped retransmission leaves a stale heap entry behind that must not drive the wakeup.
+void test_retx_stopped_entry_is_skipped(void)
+{
+    uint32_t now = millis();
+    shim->addPendingForTest(1, now + 10000);
+    shim->addPendingForTest(2, now + 30000);
+    TEST_ASSERT_TRUE(shim->stopRetransmission(pendingKey(1)));
+
+    int32_t d = shim->doRetransmissions();
+    TEST_ASSERT_INT32_WITHIN(1000, 30000, d);
+    TEST_ASSERT_EQUAL_size_t(1, shim->retransmitQueueSize()); // the stale entry was shed
+}
+
+// An exhausted record that comes due is dropped; the later one is untouched.
+void test_retx_due_entry_expires(void)
+{
+    uint32_t now = millis();
+    shim->addPendingForTest(1, now - 5, 1);
+    shim->addPendingForTest(2, now + 20000);
+
+    int32_t d = shim->doRetransmissions();
+    TEST_ASSERT_NULL(shim->findPendingPacket(pendingKey(1)));
+    TEST_ASSERT_NOT_NULL(shim->findPendingPacket(pendingKey(2)));
+    TEST_ASSERT_INT32_WITHIN(1000, 20000, d);
+
+    TEST_ASSERT_TRUE(shim->stopRetransmission(pendingKey(2)));
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, shim->doRetransmissions());
+}
+
+// Airtime delays shift every deadline except the excluded packet's.
+void test_retx_delay_shifts_all_but_except(void)
+{
+    uint32_t now = millis();
+    PendingPacket *a = shim->addPendingForTest(1, now + 10000);
+    PendingPacket *b = shim->addPendingForTest(2, now + 12000);
+    uint32_t dueA = shim->dueMsec(*a), dueB = shim->dueMsec(*b);
+
+    shim->delayRetransmissions(5000);
+    TEST_ASSERT_EQUAL_UINT32(dueA + 5000, shim->dueMsec(*a));
+    TEST_ASSERT_EQUAL_UINT32(dueB + 5000, shim->dueMsec(*b));
+
+    GlobalPacketId keep = pendingKey(2);
+    shim->delayRetransmissions(4000, &keep);
+    TEST_ASSERT_EQUAL_UINT32(dueA + 9000, shim->dueMsec(*a));
+    TEST_ASSERT_EQUAL_UINT32(dueB + 5000, shim->dueMsec(*b));
+
+    // b is now the earlier of the two, and the heap must know it
+    TEST_ASSERT_INT32_WITHIN(1000, 17000, shim->doRetransmissions());
+}
+
+// Deadlines straddling the 32-bit wrap keep their order: a bias that puts one stored value just below
+// 2^32 and the other just above 0 must still wake for the earlier one and expire only it.
+void test_retx_order_survives_rollover(void)
+{
+    uint32_t now = millis();
+    shim->resetPendingForTest(now + 10000 + 0x80); // stored nextTxMsec = due - bias
+    shim->addPendingForTest(1, now + 20000);       // stored ~ +9.9s
+    shim->addPendingForTest(2, now - 5, 1);        // stored just below 2^32, i.e. earlier
+
+    int32_t d = shim->doRetransmissions();
+    TEST_ASSERT_NULL(shim->findPendingPacket(pendingKey(2)));
+    TEST_ASSERT_NOT_NULL(shim->findPendingPacket(pendingKey(1)));
+    TEST_ASSERT_INT32_WITHIN(1000, 20000, d);
+}
+
+// Repeated reschedules leave stale entries; the heap is compacted so it stays proportional to `pending`.
+void test_retx_heap_stays_bounded(void)
+{
+    uint32_t now = millis();
+    PendingPacket *a = shim->addPendingForTest(1, now + 10000);
+    GlobalPacketId keep = pendingKey(1);
+    for (int i = 0; i < 200; i++)
+        shim->delayRetransmissions(1, &keep); // each call re-pushes the excluded record
+
+    TEST_ASSERT_TRUE(shim->retransmitQueueSize() <= 2 * shim->pending.size() + 16);
+    TEST_ASSERT_INT32_WITHIN(1000, 10000, (int32_t)(shim->dueMsec(*a) - now));
+    TEST_ASSERT_INT32_WITHIN(1000, 10000, shim->doRetransmissions());
+}
+
 // ===========================================================================
 
 void setup()
@@ -553,6 +690,14 @@ void setup()
     RUN_TEST(test_rebroadcast_no_lora_broadcast_is_not_relayed);
     RUN_TEST(test_rebroadcast_declined_send_releases_packet);
 
+    printf("\n=== retransmission deadline heap ===\n");
+    RUN_TEST(test_retx_next_wakeup_is_earliest_deadline);
+    RUN_TEST(test_retx_stopped_entry_is_skipped);
+    RUN_TEST(test_retx_due_entry_expires);
+    RUN_TEST(test_retx_delay_shifts_all_but_except);
+    RUN_TEST(test_retx_order_survives_rollover);
+    RUN_TEST(test_retx_heap_stays_bounded);
+
     exit(UNITY_END());
 }
 
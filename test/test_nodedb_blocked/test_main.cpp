@@ -33,6 +33,7 @@ class NodeDBTestShim : public NodeDB
     {
         meshNodes->clear();
         numMeshNodes = 0;
+        invalidateNodeIndex();
     }
 
     void push(NodeNum num, uint32_t lastHeard, bool favorite, bool ignored, bool withUser, bool withKey,
@@ -55,6 +56,7 @@ class NodeDBTestShim : public NodeDB
         }
         meshNodes->push_back(n);
         numMeshNodes = meshNodes->size();
+        invalidateNodeIndex();
     }
 
     // Index 0 is our own node; the eviction/migration scans treat it as self.
@@ -0,0 +1,545 @@
+// Tests for the NodeDB NodeNum -> slot hash index behind getMeshNode() and for sortMeshDB()'s
+// permutation sort - src/mesh/NodeDB.cpp. Covers the index staying in sync across append,
+// eviction, removal, cleanup and sort, sort order parity with the old bubble sort, the last-byte
+// buckets behind resolveLastByte(), lookups and sorts up to 3000 nodes, plus the change generation
+// and cached NodeListView the screen renderers draw from.
+#include "MeshTypes.h" // BEFORE TestUtil.h - provides MAX_NUM_NODES via mesh-pb-constants.h
+#include "TestUtil.h"
+#include <unity.h>
+
+#if defined(ARCH_PORTDUINO)
+#define NDB_TEST_ENTRY extern "C"
+#else
+#define NDB_TEST_ENTRY
+#endif
+
+#include "mesh/NodeDB.h"
+#include "mesh/NodeListView.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Subclass shim: owns the hot store directly (meshNodes/numMeshNodes are public) and reaches the
+// private maintenance paths through the friend declaration in NodeDB.h.
+class NodeDBTestShim : public NodeDB
+{
+  public:
+    void runCleanup() { cleanupMeshDB(); }
+    void runSort()
+    {
+        lastSort = 0; // bypass the 5 s throttle
+        sortMeshDB();
+    }
+
+    void clearHot()
+    {
+        meshNodes->clear();
+        numMeshNodes = 0;
+        invalidateNodeIndex();
+    }
+
+    void push(NodeNum num, uint32_t lastHeard, bool withUser = true, bool favorite = false)
+    {
+        meshtastic_NodeInfoLite n = meshtastic_NodeInfoLite_init_zero;
+        n.num = num;
+        n.last_heard = lastHeard;
+        if (withUser)
+            nodeInfoLiteSetBit(&n, NODEINFO_BITFIELD_HAS_USER_MASK, true);
+        if (favorite)
+            nodeInfoLiteSetBit(&n, NODEINFO_BITFIELD_IS_FAVORITE_MASK, true);
+        meshNodes->push_back(n);
+        numMeshNodes = meshNodes->size();
+        invalidateNodeIndex();
+    }
+
+    // A direct rewrite that skips invalidateNodeIndex(), as a careless caller would
+    void pushUnindexed(NodeNum num)
+    {
+        meshtastic_NodeInfoLite n = meshtastic_NodeInfoLite_init_zero;
+        n.num = num;
+        meshNodes->push_back(n);
+        numMeshNodes = meshNodes->size();
+    }
+
+#if !MESHTASTIC_EXCLUDE_NODEDB_HASH
+    bool indexStale() const { return nodeIndexStale(); }
+#endif
+
+    // Reference answer: the pre-index linear scan.
+    meshtastic_NodeInfoLite *linearFind(NodeNum n)
+    {
+        for (int i = 0; i < numMeshNodes; i++)
+            if (meshNodes->at(i).num == n)
+                return &meshNodes->at(i);
+        return NULL;
+    }
+
+    // Reference answer: resolveLastByte()'s relaxed (requireDirectNeighbor == false) scope as a full scan.
+    ResolvedNode linearResolve(uint8_t lastByte)
+    {
+        ResolvedNode r;
+        for (int i = 0; i < numMeshNodes; i++) {
+            const meshtastic_NodeInfoLite *node = &meshNodes->at(i);
+            if (node->num == getNodeNum() || node->num == 0 || nodeInfoLiteIsIgnored(node) ||
+                getLastByteOfNodeNum(node->num) != lastByte)
+                continue;
+            const bool relevant = (node->has_hops_away && node->hops_away == 0) || nodeInfoLiteIsFavorite(node) ||
+                                  node->role == meshtastic_Config_DeviceConfig_Role_ROUTER;
+            if (!relevant)
+                continue;
+            if (r.status == LastByteResolution::Unique) {
+                r.status = LastByteResolution::Ambiguous;
+                r.num = 0;
+                return r;
+            }
+            r.status = LastByteResolution::Unique;
+            r.num = node->num;
+        }
+        return r;
+    }
+
+    // Reference answer: the pre-permutation reverse bubble sort, verbatim apart from the throttle.
+    void bubbleSort(std::vector<meshtastic_NodeInfoLite> &v)
+    {
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int i = numMeshNodes - 1; i > 0; i--) {
+                if (v[i - 1].num == getNodeNum()) {
+                    // noop
+                } else if (v[i].num == getNodeNum()) {
+                    std::swap(v[i], v[i - 1]);
+                    changed = true;
+                } else if (nodeInfoLiteIsFavorite(&v[i]) && !nodeInfoLiteIsFavorite(&v[i - 1])) {
+                    std::swap(v[i], v[i - 1]);
+                    changed = true;
+                } else if (!nodeInfoLiteIsFavorite(&v[i]) && nodeInfoLiteIsFavorite(&v[i - 1])) {
+                    // noop
+                } else if (v[i].last_heard > v[i - 1].last_heard) {
+                    std::swap(v[i], v[i - 1]);
+                    changed = true;
+                }
+            }
+        }
+    }
+};
+
+namespace
+{
+
+NodeDBTestShim *db = nullptr;
+
+constexpr NodeNum SELF = 0x0BADF00D;
+constexpr NodeNum BASE = 0x10000000;
+
+void seed(int count)
+{
+    db->push(SELF, 0xFFFFFFFFu);
+    for (int i = 1; i < count; i++)
+        db->push(BASE + i, /*last_heard=*/i);
+}
+
+// Every stored node resolves to its own slot, and a sample of absent nodes misses.
+void assertIndexMatchesScan()
+{
+    for (int i = 0; i < (int)db->getNumMeshNodes(); i++) {
+        const NodeNum n = db->meshNodes->at(i).num;
+        TEST_ASSERT_EQUAL_PTR(db->linearFind(n), db->getMeshNode(n));
+    }
+    for (NodeNum n = 0xDEAD0000; n < 0xDEAD0040; n++)
+        TEST_ASSERT_NULL(db->getMeshNode(n));
+}
+
+} // namespace
+
+void setUp(void)
+{
+    db->clearHot();
+}
+void tearDown(void) {}
+
+static void test_lookup_findsEverySeededNode(void)
+{
+    seed(MAX_NUM_NODES);
+    assertIndexMatchesScan();
+    TEST_ASSERT_EQUAL_UINT32(7, db->hotNodeLastHeard(BASE + 7));
+    TEST_ASSERT_EQUAL_UINT32(0, db->hotNodeLastHeard(0xDEADBEEF));
+}
+
+// getOrCreateMeshNode() appends in place: the new node must be visible without a rebuild
+// and the existing ones must keep resolving.
+static void test_append_keepsIndexInSync(void)
+{
+    seed(10);
+    TEST_ASSERT_NOT_NULL(db->getMeshNode(BASE + 1)); // build the index
+    meshtastic_NodeInfoLite *added = db->getOrCreateMeshNode(0x22220001);
+    TEST_ASSERT_NOT_NULL(added);
+    TEST_ASSERT_EQUAL_PTR(added, db->getMeshNode(0x22220001));
+    assertIndexMatchesScan();
+}
+
+// A full store evicts the oldest node and shifts the tail down one slot.
+static void test_eviction_shiftsAreReindexed(void)
+{
+    seed(MAX_NUM_NODES);
+    TEST_ASSERT_NOT_NULL(db->getMeshNode(BASE + 1));
+    TEST_ASSERT_NOT_NULL(db->getOrCreateMeshNode(0x33330001));
+    TEST_ASSERT_NULL(db->getMeshNode(BASE + 1)); // oldest evicted
+    TEST_ASSERT_NOT_NULL(db->getMeshNode(0x33330001));
+    assertIndexMatchesScan();
+}
+
+static void test_removeAndCleanup_reindex(void)
+{
+    seed(40);
+    TEST_ASSERT_NOT_NULL(db->getMeshNode(BASE + 5));
+    db->removeNodeByNum(BASE + 5);
+    TEST_ASSERT_NULL(db->getMeshNode(BASE + 5));
+    assertIndexMatchesScan();
+
+    db->push(0x44440001, 100, /*withUser=*/false); // no user info: cleanup purges it
+    TEST_ASSERT_NOT_NULL(db->getMeshNode(0x44440001));
+    db->runCleanup();
+    TEST_ASSERT_NULL(db->getMeshNode(0x44440001));
+    assertIndexMatchesScan();
+}
+
+static void test_sort_reindexes(void)
+{
+    seed(60);
+    TEST_ASSERT_NOT_NULL(db->getMeshNode(BASE + 1));
+    db->runSort(); // ascending last_heard -> fully reversed
+    assertIndexMatchesScan();
+}
+
+// Reseeding the store with the same count but different NodeNums must not serve stale slots.
+static void test_reseed_sameCount_invalidates(void)
+{
+    seed(20);
+    TEST_ASSERT_NOT_NULL(db->getMeshNode(BASE + 3));
+    db->clearHot();
+    db->push(SELF, 0xFFFFFFFFu);
+    for (int i = 1; i < 20; i++)
+        db->push(0x55550000 + i, i);
+    TEST_ASSERT_NULL(db->getMeshNode(BASE + 3));
+    TEST_ASSERT_NOT_NULL(db->getMeshNode(0x55550003));
+    assertIndexMatchesScan();
+}
+
+#if !MESHTASTIC_EXCLUDE_NODEDB_HASH
+// Lookups must not write the index (getMeshNode() may run from another task): the index is rebuilt
+// where the list changes, and a stale one is bypassed by the scan rather than rebuilt in place.
+static void test_lookup_isReadOnly(void)
+{
+    seed(20);
+    TEST_ASSERT_FALSE(db->indexStale()); // push() rebuilt it eagerly
+    db->pushUnindexed(0x66660001);
+    TEST_ASSERT_TRUE(db->indexStale());
+    TEST_ASSERT_NOT_NULL(db->getMeshNode(0x66660001));
+    TEST_ASSERT_NOT_NULL(db->getMeshNode(BASE + 7));
+    TEST_ASSERT_NULL(db->getMeshNode(0x66660002));
+    TEST_ASSERT_TRUE(db->indexStale()); // still stale: nothing rebuilt behind the caller's back
+    db->invalidateNodeIndex();
+    TEST_ASSERT_FALSE(db->indexStale());
+    assertIndexMatchesScan();
+}
+#endif
+
+// The index stays exact past MAX_NUM_NODES (pushed directly), where the bucket chains get long.
+static void test_lookup_largeDbMatchesScan(void)
+{
+    const int sizes[] = {250, 1000, 3000};
+    for (int s = 0; s < 3; s++) {
+        db->clearHot();
+        seed(sizes[s]);
+        assertIndexMatchesScan();
+    }
+}
+
+// Random 1000-node mesh (pushed directly, past MAX_NUM_NODES): about a third are relevant relays
+// (direct neighbor, router role or favorite), so most bytes see zero, one or several candidates.
+static void seedRelays(int count, uint32_t rngSeed)
+{
+    srand(rngSeed);
+    db->push(SELF, 0xFFFFFFFFu);
+    for (int i = 1; i < count; i++) {
+        const NodeNum num = ((NodeNum)rand() << 8) ^ (NodeNum)rand();
+        db->push(num ? num : 1, (uint32_t)i, true, (rand() % 30) == 0);
+        meshtastic_NodeInfoLite &n = db->meshNodes->back();
+        const int kind = rand() % 6;
+        if (kind == 0) {
+            n.has_hops_away = true;
+            n.hops_away = 0;
+        } else if (kind == 1) {
+            n.role = meshtastic_Config_DeviceConfig_Role_ROUTER;
+        } else if (kind == 2) {
+            nodeInfoLiteSetBit(&n, NODEINFO_BITFIELD_IS_IGNORED_MASK, true);
+            n.role = meshtastic_Config_DeviceConfig_Role_ROUTER; // relevant but ignored: never a candidate
+        }
+    }
+}
+
+static void assertResolveMatchesScan()
+{
+    for (int b = 0; b < 256; b++) {
+        const ResolvedNode expected = db->linearResolve((uint8_t)b);
+        const ResolvedNode got = db->resolveLastByte((uint8_t)b, /*requireDirectNeighbor=*/false);
+        if (b == 0) {
+            TEST_ASSERT_TRUE(got.status == LastByteResolution::None); // sentinel, never resolves
+            continue;
+        }
+        TEST_ASSERT_EQUAL_UINT8((uint8_t)expected.status, (uint8_t)got.status);
+        TEST_ASSERT_EQUAL_UINT32(expected.num, got.num);
+    }
+}
+
+// The bucket walk must agree with the full scan for every byte, including after appends
+// (incremental link), relevance changes (judged per query) and a sort (rebuild).
+static void test_lastByte_matchesFullScan(void)
+{
+    seedRelays(1000, 3);
+    assertResolveMatchesScan();
+
+    db->clearHot();
+    seedRelays(MAX_NUM_NODES - 20, 4);
+    assertResolveMatchesScan();
+    for (int i = 0; i < 20; i++) {
+        meshtastic_NodeInfoLite *n = db->getOrCreateMeshNode(0x66660000 + (i * 37));
+        TEST_ASSERT_NOT_NULL(n);
+        n->role = meshtastic_Config_DeviceConfig_Role_ROUTER; // role learned after insert
+    }
+    assertResolveMatchesScan();
+
+    db->runSort();
+    assertResolveMatchesScan();
+}
+
+// ...00 node numbers share bucket 0xFF with ...FF ones (getLastByteOfNodeNum's mapping).
+static void test_lastByte_zeroByteSharesFFBucket(void)
+{
+    db->push(SELF, 0xFFFFFFFFu);
+    db->push(0x11111100, 1);
+    db->meshNodes->back().role = meshtastic_Config_DeviceConfig_Role_ROUTER;
+    ResolvedNode r = db->resolveLastByte(0xFF, false);
+    TEST_ASSERT_TRUE(r.status == LastByteResolution::Unique);
+    TEST_ASSERT_EQUAL_UINT32(0x11111100, r.num);
+
+    TEST_ASSERT_NOT_NULL(db->getOrCreateMeshNode(0x222222FF));
+    db->getMeshNode(0x222222FF)->role = meshtastic_Config_DeviceConfig_Role_ROUTER;
+    r = db->resolveLastByte(0xFF, false);
+    TEST_ASSERT_TRUE(r.status == LastByteResolution::Ambiguous);
+}
+
+// Random mesh: self somewhere in the middle, ~1 in 16 favorites, last_heard collisions on purpose
+// so stability matters.
+static void seedShuffled(int count, uint32_t rngSeed)
+{
+    srand(rngSeed);
+    for (int i = 0; i < count; i++) {
+        if (i == count / 2)
+            db->push(SELF, (uint32_t)(rand() % 500));
+        else
+            db->push(BASE + i, (uint32_t)(rand() % 500), true, (rand() % 16) == 0);
+    }
+}
+
+static void assertSameOrder(const std::vector<meshtastic_NodeInfoLite> &expected)
+{
+    for (int i = 0; i < (int)db->getNumMeshNodes(); i++) {
+        TEST_ASSERT_EQUAL_UINT32(expected[i].num, db->meshNodes->at(i).num);
+        TEST_ASSERT_EQUAL_UINT32(expected[i].last_heard, db->meshNodes->at(i).last_heard);
+    }
+}
+
+// Self first, favorites next, then newest first - and ties kept in their previous order,
+// exactly as the adjacent-swap bubble sort left them.
+static void test_sort_matchesBubbleSortOrder(void)
+{
+    for (uint32_t rngSeed = 1; rngSeed <= 5; rngSeed++) {
+        db->clearHot();
+        seedShuffled(MAX_NUM_NODES, rngSeed);
+        std::vector<meshtastic_NodeInfoLite> expected(db->meshNodes->begin(), db->meshNodes->begin() + db->getNumMeshNodes());
+        db->bubbleSort(expected);
+        db->runSort();
+        assertSameOrder(expected);
+        TEST_ASSERT_EQUAL_UINT32(SELF, db->meshNodes->at(0).num);
+        assertIndexMatchesScan();
+    }
+}
+
+// A single node heard again moves to the front of the non-favorites; nothing else moves.
+static void test_sort_singleChangeMovesOneNode(void)
+{
+    seedShuffled(100, 42);
+    db->runSort();
+    const int lastSlot = (int)db->getNumMeshNodes() - 1;
+    meshtastic_NodeInfoLite *tail = &db->meshNodes->at(lastSlot);
+    const NodeNum heard = tail->num;
+    const bool fav = nodeInfoLiteIsFavorite(tail);
+    tail->last_heard = 100000;
+
+    std::vector<meshtastic_NodeInfoLite> expected(db->meshNodes->begin(), db->meshNodes->begin() + db->getNumMeshNodes());
+    db->bubbleSort(expected);
+    db->runSort();
+    assertSameOrder(expected);
+    if (!fav) {
+        int favorites = 0;
+        for (int i = 1; i < (int)db->getNumMeshNodes(); i++)
+            favorites += nodeInfoLiteIsFavorite(&db->meshNodes->at(i)) ? 1 : 0;
+        TEST_ASSERT_EQUAL_UINT32(heard, db->meshNodes->at(1 + favorites).num);
+    }
+    TEST_ASSERT_EQUAL_PTR(db->linearFind(heard), db->getMeshNode(heard));
+}
+
+// A full reshuffle and then one node at the tail heard again, at 1000 and 3000 nodes (pushed
+// directly, past MAX_NUM_NODES): the permutation sort still lands exactly where the bubble sort does.
+static void test_sort_largeDbMatchesBubbleSort(void)
+{
+    const int sizes[] = {1000, 3000};
+    for (int s = 0; s < 2; s++) {
+        db->clearHot();
+        seedShuffled(sizes[s], 7);
+        std::vector<meshtastic_NodeInfoLite> reference(db->meshNodes->begin(), db->meshNodes->begin() + db->getNumMeshNodes());
+        db->bubbleSort(reference);
+        db->runSort();
+        assertSameOrder(reference);
+
+        reference.back().last_heard = 100000;
+        db->meshNodes->at(db->getNumMeshNodes() - 1).last_heard = 100000;
+        db->bubbleSort(reference);
+        db->runSort();
+        assertSameOrder(reference);
+    }
+}
+
+// Anything that reshapes meshNodes moves the generation; plain lookups do not.
+static void test_generation_movesOnListChanges(void)
+{
+    seed(30);
+    uint32_t gen = db->getNodeListGeneration();
+    TEST_ASSERT_NOT_NULL(db->getMeshNode(BASE + 3));
+    TEST_ASSERT_EQUAL_UINT32(gen, db->getNodeListGeneration());
+
+    TEST_ASSERT_NOT_NULL(db->getOrCreateMeshNode(0x66660001));
+    TEST_ASSERT_NOT_EQUAL(gen, db->getNodeListGeneration());
+    gen = db->getNodeListGeneration();
+
+    db->runSort();
+    TEST_ASSERT_NOT_EQUAL(gen, db->getNodeListGeneration());
+    gen = db->getNodeListGeneration();
+
+    db->removeNodeByNum(BASE + 4);
+    TEST_ASSERT_NOT_EQUAL(gen, db->getNodeListGeneration());
+}
+
+// The view skips our own node, follows NodeDB order and only rebuilds after a change.
+static void test_view_rebuildsOnlyOnChange(void)
+{
+    seed(20);
+    NodeListView view(NodeListView::ALL_NODES, false);
+    TEST_ASSERT_TRUE(view.refresh());
+    TEST_ASSERT_FALSE(view.refresh());
+    TEST_ASSERT_EQUAL_UINT32(1, view.getRebuilds());
+    TEST_ASSERT_EQUAL_UINT32(19, view.size());
+    for (size_t i = 0; i < view.size(); i++)
+        TEST_ASSERT_EQUAL_PTR(&db->meshNodes->at(i + 1), view.node(i));
+
+    TEST_ASSERT_NOT_NULL(db->getOrCreateMeshNode(0x77770001));
+    TEST_ASSERT_TRUE(view.refresh());
+    TEST_ASSERT_EQUAL_UINT32(20, view.size());
+    TEST_ASSERT_EQUAL_UINT32(0x77770001, view.node(19)->num);
+
+    NodeListView withOwn(NodeListView::ALL_NODES, true);
+    withOwn.refresh();
+    TEST_ASSERT_EQUAL_UINT32(21, withOwn.size());
+}
+
+#if !MESHTASTIC_EXCLUDE_POSITIONDB
+// POSITIONED_NODES keeps only nodes with a position entry, with their coordinates cached,
+// and notices a position written after it was built.
+static void test_view_positionedNodes(void)
+{
+    seed(20);
+    db->nodePositions.clear();
+    db->nodePositions[BASE + 2].latitude_i = 515000000;
+    db->nodePositions[BASE + 7].time = 1234; // entry without a fix still counts, like hasNodePosition()
+
+    NodeListView view(NodeListView::POSITIONED_NODES, false);
+    view.refresh();
+    TEST_ASSERT_EQUAL_UINT32(2, view.size());
+    TEST_ASSERT_EQUAL_UINT32(BASE + 2, view.node(0)->num);
+    TEST_ASSERT_EQUAL_INT32(515000000, view.coords(0).latitude_i);
+    TEST_ASSERT_TRUE(view.hasFix(0));
+    TEST_ASSERT_FALSE(view.hasFix(1));
+
+    db->nodePositions[BASE + 7].longitude_i = -1000000;
+    TEST_ASSERT_TRUE(view.refresh());
+    TEST_ASSERT_TRUE(view.hasFix(1));
+    TEST_ASSERT_EQUAL_INT32(-1000000, view.coords(1).longitude_i);
+
+    db->nodePositions.clear();
+    TEST_ASSERT_TRUE(view.refresh());
+    TEST_ASSERT_TRUE(view.empty());
+}
+
+// The location list screen at 600 nodes (a third with positions), 8 visible rows, a position
+// update every 50 frames: refresh() rebuilds once per update and otherwise serves the cached list.
+static void test_view_rebuildsOncePerPositionUpdate(void)
+{
+    const int nodes = 600, frames = 2000, rows = 8;
+    seed(nodes);
+    db->nodePositions.clear();
+    for (int i = 1; i < nodes; i += 3)
+        db->nodePositions[BASE + i].latitude_i = i;
+
+    NodeListView view(NodeListView::POSITIONED_NODES, false);
+    for (int f = 0; f < frames; f++) {
+        if (f % 50 == 0)
+            db->nodePositions[BASE + 1].time = f;
+        view.refresh();
+        TEST_ASSERT_EQUAL_UINT32((nodes - 1 + 2) / 3, view.size());
+        for (int r = 0; r < rows && r < (int)view.size(); r++)
+            TEST_ASSERT_NOT_NULL(view.node(r));
+    }
+    TEST_ASSERT_EQUAL_UINT32(frames / 50, view.getRebuilds());
+    db->nodePositions.clear();
+}
+#endif
+
+NDB_TEST_ENTRY void setup()
+{
+    initializeTestEnvironment();
+    db = new NodeDBTestShim();
+    nodeDB = db;
+    myNodeInfo.my_node_num = SELF; // sortMeshDB pins getNodeNum() to slot 0
+
+    UNITY_BEGIN();
+    printf("\n=== NodeDB index correctness ===\n");
+    RUN_TEST(test_lookup_findsEverySeededNode);
+    RUN_TEST(test_append_keepsIndexInSync);
+    RUN_TEST(test_eviction_shiftsAreReindexed);
+    RUN_TEST(test_removeAndCleanup_reindex);
+    RUN_TEST(test_sort_reindexes);
+    RUN_TEST(test_reseed_sameCount_invalidates);
+#if !MESHTASTIC_EXCLUDE_NODEDB_HASH
+    RUN_TEST(test_lookup_isReadOnly);
+#endif
+    RUN_TEST(test_lookup_largeDbMatchesScan);
+    printf("\n=== NodeDB sort ===\n");
+    RUN_TEST(test_sort_matchesBubbleSortOrder);
+    RUN_TEST(test_sort_singleChangeMovesOneNode);
+    RUN_TEST(test_sort_largeDbMatchesBubbleSort);
+    printf("\n=== NodeDB last-byte buckets ===\n");
+    RUN_TEST(test_lastByte_matchesFullScan);
+    RUN_TEST(test_lastByte_zeroByteSharesFFBucket);
+    printf("\n=== NodeDB node list view ===\n");
+    RUN_TEST(test_generation_movesOnListChanges);
+    RUN_TEST(test_view_rebuildsOnlyOnChange);
+#if !MESHTASTIC_EXCLUDE_POSITIONDB
+    RUN_TEST(test_view_positionedNodes);
+    RUN_TEST(test_view_rebuildsOncePerPositionUpdate);
+#endif
+    exit(UNITY_END());
+}
+NDB_TEST_ENTRY void loop() {}
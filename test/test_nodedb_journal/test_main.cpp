@@ -0,0 +1,440 @@
+/*
+ * Unit tests for NodeDBJournal - the delta journal next to /prefs/nodes.proto.
+ *
+ * Covers an unchanged database costing no writes, a replay round trip (update, insert, removal), a journal written for
+ * another snapshot being ignored, a torn tail forcing the next save to be a snapshot, compaction once the journal
+ * outgrows its budget, and the bytes written over an hour of synthetic mesh churn against full rewrites.
+ */
+
+#include "TestUtil.h"
+#include <unity.h>
+
+#include "mesh/NodeDBJournal.h"
+
+#if HAS_NODEDB_JOURNAL
+
+#include "FSCommon.h"
+#include "SPILock.h"
+#include "mesh/generated/meshtastic/deviceonly.pb.h"
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <pb_decode.h>
+#include <vector>
+
+static const char *kJournal = "/prefs/test_nodes.jnl";
+
+// A node database in miniature: nodes plus two of the satellite maps NodeDB journals
+struct Mesh {
+    std::vector<meshtastic_NodeInfoLite> nodes;
+    std::map<NodeNum, meshtastic_PositionLite> positions;
+    std::map<NodeNum, meshtastic_DeviceMetrics> telemetry;
+
+    meshtastic_NodeInfoLite *node(NodeNum num)
+    {
+        for (auto &n : nodes)
+            if (n.num == num)
+                return &n;
+        return nullptr;
+    }
+};
+
+static Mesh makeMesh(int count)
+{
+    Mesh m;
+    for (int i = 0; i < count; i++) {
+        meshtastic_NodeInfoLite n = meshtastic_NodeInfoLite_init_default;
+        n.num = 0x1000 + i;
+        snprintf(n.long_name, sizeof(n.long_name), "Node %d", i);
+        snprintf(n.short_name, sizeof(n.short_name), "N%d", i % 100);
+        n.last_heard = 1700000000 + i;
+        n.snr = -5.0f + (i % 20);
+        n.channel = 0;
+        m.nodes.push_back(n);
+
+        meshtastic_PositionLite p = meshtastic_PositionLite_init_default;
+        p.latitude_i = 520000000 + i * 1000;
+        p.longitude_i = 40000000 + i * 1000;
+        p.altitude = 10 + i;
+        p.time = 1700000000 + i;
+        m.positions[n.num] = p;
+
+        if (i % 2 == 0) {
+            meshtastic_DeviceMetrics d = meshtastic_DeviceMetrics_init_default;
+            d.has_battery_level = true;
+            d.battery_level = 50 + i % 50;
+            d.has_voltage = true;
+            d.voltage = 3.7f;
+            m.telemetry[n.num] = d;
+        }
+    }
+    return m;
+}
+
+static void scanAll(NodeDBJournal &j, const Mesh &m)
+{
+    j.beginScan();
+    for (const auto &n : m.nodes)
+        j.scanMessage(NodeDBJournal::NODE, n.num, meshtastic_NodeInfoLite_fields, &n);
+    for (const auto &kv : m.positions)
+        j.scanMessage(NodeDBJournal::POSITION, kv.first, meshtastic_PositionLite_fields, &kv.second);
+    for (const auto &kv : m.telemetry)
+        j.scanMessage(NodeDBJournal::TELEMETRY, kv.first, meshtastic_DeviceMetrics_fields, &kv.second);
+    j.endScan();
+}
+
+// What saveNodeDatabaseSnapshot() encodes, for the snapshot's size and fingerprint
+static void snapshotOf(const Mesh &m, uint32_t &size, uint32_t &hash)
+{
+    meshtastic_NodeDatabase db;
+    db.version = 25;
+    db.nodes = m.nodes;
+    for (const auto &kv : m.positions) {
+        meshtastic_NodePositionEntry e = meshtastic_NodePositionEntry_init_default;
+        e.num = kv.first;
+        e.has_position = true;
+        e.position = kv.second;
+        db.positions.push_back(e);
+    }
+    for (const auto &kv : m.telemetry) {
+        meshtastic_NodeTelemetryEntry e = meshtastic_NodeTelemetryEntry_init_default;
+        e.num = kv.first;
+        e.has_device_metrics = true;
+        e.device_metrics = kv.second;
+        db.telemetry.push_back(e);
+    }
+    TEST_ASSERT_TRUE(NodeDBJournal::hashEncoded(meshtastic_NodeDatabase_fields, &db, size, hash));
+}
+
+// Save the way NodeDB does: append if the journal allows, else "write" a snapshot. @return bytes written to flash
+static uint32_t save(NodeDBJournal &j, const Mesh &m, uint32_t &snapSize, uint32_t &snapHash)
+{
+    scanAll(j, m);
+    const uint32_t before = j.getBytesAppended();
+    if (!j.wantsSnapshot() && j.appendPending())
+        return j.getBytesAppended() - before;
+    snapshotOf(m, snapSize, snapHash);
+    TEST_ASSERT_TRUE(j.snapshotWritten(snapSize, snapHash));
+    return snapSize + j.getJournalBytes(); // the snapshot plus the fresh journal header
+}
+
+// Replay target: applies records to a Mesh the way NodeDB::replayNodeJournal() does
+static void applyRecord(void *ctx, NodeDBJournal::Kind kind, NodeNum num, const uint8_t *payload, size_t len)
+{
+    Mesh &m = *static_cast<Mesh *>(ctx);
+    pb_istream_t stream = pb_istream_from_buffer(payload, payload ? len : 0);
+    switch (kind) {
+    case NodeDBJournal::NODE: {
+        meshtastic_NodeInfoLite *existing = m.node(num);
+        if (!payload) {
+            if (existing)
+                m.nodes.erase(m.nodes.begin() + (existing - m.nodes.data()));
+            break;
+        }
+        meshtastic_NodeInfoLite n = meshtastic_NodeInfoLite_init_default;
+        TEST_ASSERT_TRUE(pb_decode(&stream, meshtastic_NodeInfoLite_fields, &n));
+        if (existing)
+            *existing = n;
+        else
+            m.nodes.push_back(n);
+        break;
+    }
+    case NodeDBJournal::POSITION: {
+        meshtastic_PositionLite p = meshtastic_PositionLite_init_default;
+        if (!payload)
+            m.positions.erase(num);
+        else if (pb_decode(&stream, meshtastic_PositionLite_fields, &p))
+            m.positions[num] = p;
+        break;
+    }
+    case NodeDBJournal::TELEMETRY: {
+        meshtastic_DeviceMetrics d = meshtastic_DeviceMetrics_init_default;
+        if (!payload)
+            m.telemetry.erase(num);
+        else if (pb_decode(&stream, meshtastic_DeviceMetrics_fields, &d))
+            m.telemetry[num] = d;
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void setUp(void)
+{
+    concurrency::LockGuard g(spiLock);
+    FSCom.mkdir("/prefs");
+    if (FSCom.exists(kJournal))
+        FSCom.remove(kJournal);
+}
+
+void tearDown(void)
+{
+    concurrency::LockGuard g(spiLock);
+    if (FSCom.exists(kJournal))
+        FSCom.remove(kJournal);
+}
+
+static void test_unchanged_database_writes_nothing(void)
+{
+    NodeDBJournal j(kJournal);
+    Mesh m = makeMesh(20);
+    uint32_t size, hash;
+
+    scanAll(j, m);
+    TEST_ASSERT_TRUE(j.wantsSnapshot()); // nothing on disk to append to yet
+    save(j, m, size, hash);
+    TEST_ASSERT_EQUAL_UINT32(1, j.getSnapshots());
+
+    scanAll(j, m);
+    TEST_ASSERT_FALSE(j.wantsSnapshot());
+    TEST_ASSERT_TRUE(j.appendPending());
+    TEST_ASSERT_EQUAL_UINT32(0, j.getBytesAppended());
+    TEST_ASSERT_EQUAL_UINT32(1, j.getSnapshots());
+}
+
+static void test_replay_round_trip(void)
+{
+    Mesh m = makeMesh(10);
+    uint32_t size, hash;
+    {
+        NodeDBJournal j(kJournal);
+        save(j, m, size, hash);
+
+        m.node(0x1002)->last_heard += 600;
+        m.node(0x1002)->snr = 7.25f;
+        m.positions.erase(0x1003);
+        m.nodes.erase(m.nodes.begin() + 4); // 0x1004, with its position and telemetry
+        m.positions.erase(0x1004);
+        m.telemetry.erase(0x1004);
+        meshtastic_NodeInfoLite n = meshtastic_NodeInfoLite_init_default;
+        n.num = 0x2000;
+        strcpy(n.long_name, "Newcomer");
+        m.nodes.push_back(n);
+
+        const uint32_t written = save(j, m, size, hash);
+        TEST_ASSERT_EQUAL_UINT32(1, j.getSnapshots()); // appended, not rewritten
+        TEST_ASSERT_TRUE(written > 0);
+        TEST_ASSERT_TRUE(written < 400);
+    }
+
+    // Boot: the snapshot as it was plus the journal gives what was in RAM
+    Mesh loaded = makeMesh(10);
+    NodeDBJournal j2(kJournal);
+    uint32_t baseSize, baseHash;
+    snapshotOf(loaded, baseSize, baseHash);
+    TEST_ASSERT_EQUAL_INT(6, j2.replay(baseSize, baseHash, applyRecord, &loaded)); // 3 nodes, 2 positions, 1 telemetry
+
+    TEST_ASSERT_EQUAL(m.nodes.size(), loaded.nodes.size());
+    TEST_ASSERT_EQUAL(m.positions.size(), loaded.positions.size());
+    TEST_ASSERT_EQUAL(m.telemetry.size(), loaded.telemetry.size());
+    TEST_ASSERT_NULL(loaded.node(0x1004));
+    TEST_ASSERT_NOT_NULL(loaded.node(0x2000));
+    TEST_ASSERT_EQUAL_STRING("Newcomer", loaded.node(0x2000)->long_name);
+    TEST_ASSERT_EQUAL_UINT32(m.node(0x1002)->last_heard, loaded.node(0x1002)->last_heard);
+    TEST_ASSERT_EQUAL_FLOAT(7.25f, loaded.node(0x1002)->snr);
+    TEST_ASSERT_TRUE(loaded.positions.find(0x1003) == loaded.positions.end());
+
+    // Adopting the replayed state means the next save only appends what changes from here
+    scanAll(j2, loaded);
+    j2.adoptScan();
+    scanAll(j2, loaded);
+    TEST_ASSERT_FALSE(j2.wantsSnapshot());
+}
+
+static void test_journal_for_other_snapshot_is_ignored(void)
+{
+    Mesh m = makeMesh(5);
+    uint32_t size, hash;
+    {
+        NodeDBJournal j(kJournal);
+        save(j, m, size, hash);
+        m.node(0x1001)->last_heard++;
+        save(j, m, size, hash);
+    }
+
+    NodeDBJournal j2(kJournal);
+    int calls = 0;
+    auto count = [](void *ctx, NodeDBJournal::Kind, NodeNum, const uint8_t *, size_t) { (*static_cast<int *>(ctx))++; };
+    TEST_ASSERT_EQUAL_INT(-1, j2.replay(size, hash ^ 1, count, &calls));
+    TEST_ASSERT_EQUAL_INT(0, calls);
+
+    scanAll(j2, m);
+    j2.adoptScan();
+    scanAll(j2, m);
+    TEST_ASSERT_TRUE(j2.wantsSnapshot()); // first save after boot restarts the journal
+}
+
+static void test_torn_tail_forces_snapshot(void)
+{
+    Mesh m = makeMesh(5);
+    uint32_t size, hash;
+    {
+        NodeDBJournal j(kJournal);
+        save(j, m, size, hash);
+        m.node(0x1001)->last_heard++;
+        save(j, m, size, hash);
+        m.node(0x1002)->last_heard++;
+        save(j, m, size, hash);
+    }
+
+    // Power lost halfway through the last append
+    std::vector<uint8_t> buf;
+    {
+        concurrency::LockGuard g(spiLock);
+        auto f = FSCom.open(kJournal, FILE_O_READ);
+        TEST_ASSERT_TRUE((bool)f);
+        buf.resize(f.size());
+        f.read(buf.data(), buf.size());
+        f.close();
+        f = FSCom.open(kJournal, FILE_O_WRITE);
+        TEST_ASSERT_TRUE((bool)f);
+        f.write(buf.data(), buf.size() - 3);
+        f.close();
+    }
+
+    Mesh loaded = makeMesh(5);
+    uint32_t baseSize, baseHash;
+    snapshotOf(loaded, baseSize, baseHash);
+    NodeDBJournal j2(kJournal);
+    TEST_ASSERT_EQUAL_INT(1, j2.replay(baseSize, baseHash, applyRecord, &loaded));
+    TEST_ASSERT_EQUAL_UINT32(m.node(0x1001)->last_heard, loaded.node(0x1001)->last_heard);
+
+    scanAll(j2, loaded);
+    j2.adoptScan();
+    scanAll(j2, loaded);
+    TEST_ASSERT_TRUE(j2.wantsSnapshot());
+}
+
+static void test_compacts_past_budget(void)
+{
+    NodeDBJournal j(kJournal);
+    Mesh m = makeMesh(50);
+    uint32_t size, hash;
+    save(j, m, size, hash);
+
+    int saves = 0;
+    while (j.getSnapshots() == 1 && saves < 1000) {
+        for (auto &n : m.nodes)
+            n.last_heard++;
+        save(j, m, size, hash);
+        saves++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, j.getSnapshots());
+    TEST_ASSERT_TRUE(saves > 1);
+    TEST_ASSERT_TRUE(j.getJournalBytes() <= NodeDBJournal::kMaxBudget);
+}
+
+// A delta that would not fit the journal's budget (half the snapshot) is not buffered at all: the save is a snapshot
+static void test_oversized_delta_is_not_buffered(void)
+{
+    NodeDBJournal j(kJournal);
+    Mesh m = makeMesh(100);
+    uint32_t size, hash;
+    save(j, m, size, hash);
+
+    for (auto &n : m.nodes) {
+        n.last_heard += 60;
+        n.snr += 1.0f;
+    }
+    for (auto &kv : m.positions)
+        kv.second.latitude_i += 10;
+    j.beginScan();
+    for (const auto &n : m.nodes)
+        j.scanMessage(NodeDBJournal::NODE, n.num, meshtastic_NodeInfoLite_fields, &n);
+    for (const auto &kv : m.positions)
+        j.scanMessage(NodeDBJournal::POSITION, kv.first, meshtastic_PositionLite_fields, &kv.second);
+    for (const auto &kv : m.telemetry)
+        j.scanMessage(NodeDBJournal::TELEMETRY, kv.first, meshtastic_DeviceMetrics_fields, &kv.second);
+    TEST_ASSERT_EQUAL_size_t(0, j.endScan());
+    TEST_ASSERT_TRUE(j.wantsSnapshot());
+
+    save(j, m, size, hash);
+    TEST_ASSERT_EQUAL_UINT32(2, j.getSnapshots());
+    TEST_ASSERT_EQUAL_UINT32(0, j.getAppends());
+}
+
+// An hour of a busy mesh, saving once a minute (the NodeDB save throttle): every minute a tenth of the nodes are heard
+// again, a few report a new position or telemetry, and every ten minutes a node is evicted for a newcomer. The journal
+// (compactions included) must write under a third of what full rewrites would.
+static void test_hour_of_churn_writes_less_than_rewrites(void)
+{
+    const int kNodes = 200;
+    NodeDBJournal j(kJournal);
+    Mesh m = makeMesh(kNodes);
+    uint32_t size, hash;
+    save(j, m, size, hash);
+
+    uint32_t rng = 12345;
+    auto next = [&rng](uint32_t n) {
+        rng = rng * 1103515245u + 12345u;
+        return (rng >> 8) % n;
+    };
+
+    uint64_t journaled = 0, fullRewrites = 0;
+    NodeNum newcomer = 0x8000;
+    for (int minute = 1; minute <= 60; minute++) {
+        for (int k = 0; k < kNodes / 10; k++) {
+            auto &n = m.nodes[next(m.nodes.size())];
+            n.last_heard = 1700000000 + minute * 60;
+            n.snr = (float)next(40) / 4 - 5;
+            n.hops_away = next(4);
+        }
+        for (int k = 0; k < kNodes / 40; k++) {
+            auto &p = m.positions[m.nodes[next(m.nodes.size())].num];
+            p.latitude_i += next(2000);
+            p.time = 1700000000 + minute * 60;
+        }
+        for (int k = 0; k < kNodes / 100; k++) {
+            auto &d = m.telemetry[m.nodes[next(m.nodes.size())].num];
+            d.has_battery_level = true;
+            d.battery_level = next(101);
+        }
+        if (minute % 10 == 0) {
+            size_t victim = next(m.nodes.size());
+            m.positions.erase(m.nodes[victim].num);
+            m.telemetry.erase(m.nodes[victim].num);
+            m.nodes[victim].num = newcomer++;
+        }
+
+        journaled += save(j, m, size, hash);
+        uint32_t fullSize, fullHash;
+        snapshotOf(m, fullSize, fullHash);
+        fullRewrites += fullSize;
+    }
+
+    TEST_ASSERT_TRUE(journaled * 3 < fullRewrites);
+}
+
+void setup()
+{
+    initializeTestEnvironment();
+    if (!spiLock)
+        initSPI();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_unchanged_database_writes_nothing);
+    RUN_TEST(test_replay_round_trip);
+    RUN_TEST(test_journal_for_other_snapshot_is_ignored);
+    RUN_TEST(test_torn_tail_forces_snapshot);
+    RUN_TEST(test_compacts_past_budget);
+    RUN_TEST(test_oversized_delta_is_not_buffered);
+    RUN_TEST(test_hour_of_churn_writes_less_than_rewrites);
+    exit(UNITY_END());
+}
+
+#else
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void setup()
+{
+    initializeTestEnvironment();
+    UNITY_BEGIN();
+    exit(UNITY_END());
+}
+
+#endif
+
+void loop() {}
@@ -10,6 +10,7 @@
 //   Group C  routing pipeline ordering (authenticate before duplicate/retry/relay state)
 //   Group D  encoding invariants the routing gates depend on
 //   Group E  decoded-ingress policy (checkXeddsaReceivePolicy, the plaintext-MQTT trust boundary)
+//   Group F  perhapsDecode channel trials (per-sender channel cache, portnum pre-check)
 
 #include "MeshTypes.h" // include BEFORE TestUtil.h
 #include "TestUtil.h"
@@ -60,6 +61,7 @@ class MockNodeDB : public NodeDB
         testNodes.clear();
         meshNodes = &testNodes;
         numMeshNodes = 0;
+        invalidateNodeIndex();
     }
 
     // Add a bare node and return a stable handle (fetch via getMeshNode so the pointer stays valid
@@ -71,6 +73,7 @@ class MockNodeDB : public NodeDB
         testNodes.push_back(node);
         meshNodes = &testNodes;
         numMeshNodes = testNodes.size();
+        invalidateNodeIndex();
     }
 
     void setPublicKey(NodeNum num, const uint8_t *pubKey)
@@ -149,18 +152,18 @@ class AuthPipelineRouter : public ReliableRouter
     void remember(const meshtastic_MeshPacket *p) { wasSeenRecently(p, true); }
     void forgetRelayer(uint8_t relay, PacketId id, NodeNum from) { removeRelayer(relay, id, from); }
     bool handleUpgrade(meshtastic_MeshPacket *p) { return perhapsHandleUpgradedPacket(p); }
-    void addPending(const meshtastic_MeshPacket &p, uint32_t nextTx)
+    void addPending(const meshtastic_MeshPacket &p, uint32_t due)
     {
         auto *copy = packetPool.allocCopy(p);
         TEST_ASSERT_NOT_NULL(copy);
         const GlobalPacketId key(copy);
         pending.emplace(key, PendingPacket(copy, NUM_INTERMEDIATE_RETX));
-        pending.at(key).nextTxMsec = nextTx;
+        scheduleRetransmission(&pending.at(key), due);
     }
-    uint32_t pendingNextTx(NodeNum from, PacketId id)
+    uint32_t pendingDue(NodeNum from, PacketId id)
     {
         PendingPacket *entry = findPendingPacket(from, id);
-        return entry ? entry->nextTxMsec : 0;
+        return entry ? dueMsec(*entry) : 0;
     }
     size_t pendingCount() const { return pending.size(); }
     void clearPending()
@@ -207,6 +210,7 @@ static AuthPipelineRoutingModule *pipelineRouting = nullptr;
 static AuthPipelineModule *pipelineModule = nullptr;
 static AuthPipelineMqtt *pipelineMqtt = nullptr;
 static MeshService *pipelineService = nullptr;
+static const char phoneClient = 0; // stands in for the PhoneAPI reading the to-phone fan-out
 
 // ---------------------------------------------------------------------------
 // Helpers
@@ -396,13 +400,16 @@ void setUp(void)
     pipelineRouting->ackCalls = 0;
     pipelineModule->calls = 0;
     pipelineMqtt->clearQueue();
-    while (meshtastic_MeshPacket *queued = pipelineService->getForPhone())
-        packetPool.release(queued);
+    while (meshtastic_MeshPacket *queued = pipelineService->getForPhone(&phoneClient))
+        pipelineService->releaseForPhone(&phoneClient, queued);
     resetRoutingAuthEvaluationCount();
 }
 
+static void disableSecondaryChannel();
+
 void tearDown(void)
 {
+    disableSecondaryChannel(); // Group F configures channel 1; initDefaults() alone would keep it
     delete mockNodeDB;
     mockNodeDB = nullptr;
     nodeDB = nullptr;
@@ -1020,7 +1027,7 @@ static void assertNoRejectedPipelineEffects(NodeNum sender, uint32_t lastHeardBe
     TEST_ASSERT_EQUAL(0, pipelineRouter->txRelayCanceled);
     TEST_ASSERT_EQUAL(0, pipelineModule->calls);
     TEST_ASSERT_EQUAL(0, pipelineMqtt->queueSize());
-    TEST_ASSERT_NULL(pipelineService->getForPhone());
+    TEST_ASSERT_NULL(pipelineService->getForPhone(&phoneClient));
     const meshtastic_NodeInfoLite *node = mockNodeDB->getMeshNode(sender);
     TEST_ASSERT_NOT_NULL(node);
     TEST_ASSERT_EQUAL_UINT32(lastHeardBefore, node->last_heard);
@@ -1077,14 +1084,15 @@ void test_C3_invalid_repeated_packet_cannot_ack_or_change_retry_state(void)
     prior.hop_start = 2;
     prior.transport_mechanism = meshtastic_MeshPacket_TransportMechanism_TRANSPORT_LORA;
     pipelineRouter->remember(&prior);
-    pipelineRouter->addPending(prior, UINT32_MAX);
+    const uint32_t due = millis() + 600000;
+    pipelineRouter->addPending(prior, due);
     const uint32_t lastHeard = mockNodeDB->getMeshNode(LOCAL_NODE)->last_heard;
 
     meshtastic_MeshPacket invalid = makeSignedWirePacket(LOCAL_NODE, NODENUM_BROADCAST, id, 2, 2, 0, 0x34, false);
     runPipelineIngress(invalid);
     assertNoRejectedPipelineEffects(LOCAL_NODE, lastHeard);
     TEST_ASSERT_EQUAL(1, pipelineRouter->pendingCount());
-    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, pipelineRouter->pendingNextTx(LOCAL_NODE, id));
+    TEST_ASSERT_EQUAL_UINT32(due, pipelineRouter->pendingDue(LOCAL_NODE, id));
 }
 
 void test_C4_invalid_fallback_packet_cannot_relay(void)
@@ -1160,7 +1168,7 @@ void test_C6_opaque_unknown_channel_is_relay_only(void)
     TEST_ASSERT_EQUAL(0, pipelineRouting->ackCalls);
     TEST_ASSERT_EQUAL(0, pipelineModule->calls);
     TEST_ASSERT_EQUAL(0, pipelineMqtt->queueSize());
-    TEST_ASSERT_NULL(pipelineService->getForPhone());
+    TEST_ASSERT_NULL(pipelineService->getForPhone(&phoneClient));
     TEST_ASSERT_FALSE(pipelineRouter->historyContains(&opaque));
     TEST_ASSERT_NULL(mockNodeDB->getMeshNode(REMOTE_NODE));
 
@@ -1173,7 +1181,7 @@ void test_C6_opaque_unknown_channel_is_relay_only(void)
     TEST_ASSERT_EQUAL(0, pipelineRouting->ackCalls);
     TEST_ASSERT_EQUAL(0, pipelineModule->calls);
     TEST_ASSERT_EQUAL(0, pipelineMqtt->queueSize());
-    TEST_ASSERT_NULL(pipelineService->getForPhone());
+    TEST_ASSERT_NULL(pipelineService->getForPhone(&phoneClient));
     TEST_ASSERT_FALSE(pipelineRouter->historyContains(&addressed));
 
     const meshtastic_Config_DeviceConfig_RebroadcastMode blockedModes[] = {
@@ -1193,7 +1201,7 @@ void test_C6_opaque_unknown_channel_is_relay_only(void)
         TEST_ASSERT_EQUAL(0, pipelineRouting->ackCalls);
         TEST_ASSERT_EQUAL(0, pipelineModule->calls);
         TEST_ASSERT_EQUAL(0, pipelineMqtt->queueSize());
-        TEST_ASSERT_NULL(pipelineService->getForPhone());
+        TEST_ASSERT_NULL(pipelineService->getForPhone(&phoneClient));
         TEST_ASSERT_FALSE(pipelineRouter->historyContains(&blocked));
     }
 }
@@ -1602,6 +1610,102 @@ void test_E13_decoded_unsigned_nodeinfo_padded_inside_payload_dropped(void)
     TEST_ASSERT_FALSE(p.xeddsa_signed);
 }
 
+// ===========================================================================
+// Group F - perhapsDecode channel trials
+// ===========================================================================
+
+// Secondary channel 1 with its own PSK, tuned so its hash collides with the primary's. The hash is an
+// xor over name and key bytes, so flipping the last key byte can move it to any value.
+static void addCollidingSecondaryChannel()
+{
+    meshtastic_Channel ch = meshtastic_Channel_init_zero;
+    ch.index = 1;
+    ch.role = meshtastic_Channel_Role_SECONDARY;
+    ch.has_settings = true;
+    strcpy(ch.settings.name, "trials");
+    ch.settings.psk.size = 16;
+    for (int i = 0; i < 16; i++)
+        ch.settings.psk.bytes[i] = 0x40 + i;
+    channels.setChannel(ch);
+    channels.onConfigChanged();
+
+    ch.settings.psk.bytes[15] ^= (uint8_t)(channels.getHash(1) ^ channels.getHash(0));
+    channels.setChannel(ch);
+    channels.onConfigChanged();
+    TEST_ASSERT_EQUAL_INT16_MESSAGE(channels.getHash(0), channels.getHash(1), "test setup failed to collide the hashes");
+}
+
+static void disableSecondaryChannel()
+{
+    meshtastic_Channel ch = meshtastic_Channel_init_zero;
+    ch.index = 1; // no settings -> fixupChannel disables it
+    channels.setChannel(ch);
+    channels.onConfigChanged();
+}
+
+// F1: traffic on the second of two colliding channels costs both attempts once, then goes straight to
+// the remembered channel.
+void test_F1_trial_cache_tries_last_good_channel_first(void)
+{
+    addCollidingSecondaryChannel();
+    resetDecodeTrials();
+
+    meshtastic_MeshPacket p = makeDecoded(REMOTE_NODE, NODENUM_BROADCAST, meshtastic_PortNum_POSITION_APP, SMALL_PAYLOAD);
+    p.channel = 1;
+    meshtastic_MeshPacket wire = channelEncode(p);
+    TEST_ASSERT_EQUAL(DECODE_SUCCESS, perhapsDecode(&wire));
+    TEST_ASSERT_EQUAL_UINT8(1, wire.channel);
+    DecodeTrialStats stats = getDecodeTrialStats();
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(2, stats.attempts, "first packet must try the primary, then the secondary");
+    TEST_ASSERT_EQUAL_UINT32(1, stats.cacheMisses);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.cacheHits);
+
+    p.id++;
+    wire = channelEncode(p);
+    TEST_ASSERT_EQUAL(DECODE_SUCCESS, perhapsDecode(&wire));
+    TEST_ASSERT_EQUAL_UINT8(1, wire.channel);
+    stats = getDecodeTrialStats();
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(3, stats.attempts, "second packet must go straight to the remembered channel");
+    TEST_ASSERT_EQUAL_UINT32(1, stats.cacheHits);
+}
+
+// F2: a stale entry only reorders the trials - the primary still decodes its own traffic.
+void test_F2_trial_cache_wrong_entry_falls_back(void)
+{
+    addCollidingSecondaryChannel();
+    resetDecodeTrials();
+
+    meshtastic_MeshPacket p = makeDecoded(REMOTE_NODE, NODENUM_BROADCAST, meshtastic_PortNum_POSITION_APP, SMALL_PAYLOAD);
+    p.channel = 1;
+    meshtastic_MeshPacket wire = channelEncode(p);
+    TEST_ASSERT_EQUAL(DECODE_SUCCESS, perhapsDecode(&wire));
+
+    p.id++;
+    p.channel = 0;
+    wire = channelEncode(p);
+    TEST_ASSERT_EQUAL(DECODE_SUCCESS, perhapsDecode(&wire));
+    TEST_ASSERT_EQUAL_UINT8(0, wire.channel);
+    DecodeTrialStats stats = getDecodeTrialStats();
+    TEST_ASSERT_EQUAL_UINT32(4, stats.attempts);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.cacheMisses);
+}
+
+// F3: a well-formed Data without a portnum (always rejected as UNKNOWN_APP) is now turned away by the
+// two-byte pre-check, and still counts as a matched channel.
+void test_F3_portnum_precheck_rejects_without_decode(void)
+{
+    resetDecodeTrials();
+
+    meshtastic_MeshPacket p = makeDecoded(REMOTE_NODE, NODENUM_BROADCAST, meshtastic_PortNum_POSITION_APP, 0);
+    uint8_t wire[] = {0x12, 0x03, 'a', 'b', 'c'}; // field 2 (payload) only
+    encryptAsChannelPacket(&p, wire, sizeof(wire));
+    TEST_ASSERT_EQUAL(DECODE_FAILURE, perhapsDecode(&p));
+    DecodeTrialStats stats = getDecodeTrialStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.attempts);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.preRejects);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.cacheMisses);
+}
+
 void setup()
 {
     initializeTestEnvironment();
@@ -1692,6 +1796,11 @@ void setup()
     RUN_TEST(test_E12_decoded_unsigned_waypoint_padded_inside_payload_dropped);
     RUN_TEST(test_E13_decoded_unsigned_nodeinfo_padded_inside_payload_dropped);
 
+    printf("\n=== Group F: perhapsDecode channel trials ===\n");
+    RUN_TEST(test_F1_trial_cache_tries_last_good_channel_first);
+    RUN_TEST(test_F2_trial_cache_wrong_entry_falls_back);
+    RUN_TEST(test_F3_portnum_precheck_rejects_without_decode);
+
     exit(UNITY_END());
 }
 
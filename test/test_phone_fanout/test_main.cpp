@@ -0,0 +1,250 @@
+/*
+ * Unit tests for PhoneFanout - the shared to-phone packet stream MeshService hands out to every API client.
+ *
+ * Covers a single client (same as the old dequeue), two clients seeing the same packets at their own pace, new clients
+ * joining mid-stream, overflow skipping a lagging client, pinned packets surviving overflow without stalling the
+ * others, detach, foreign packets and the cursor limit.
+ */
+
+#include "TestUtil.h"
+#include <unity.h>
+
+#include "mesh/PhoneFanout.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// The fan-out only moves pointers around; encode a sequence number in each one.
+static uint32_t *token(uintptr_t n)
+{
+    return reinterpret_cast<uint32_t *>(n);
+}
+
+static uintptr_t value(uint32_t *p)
+{
+    return reinterpret_cast<uintptr_t>(p);
+}
+
+static std::deque<uint32_t *> source;
+static std::vector<uintptr_t> released;
+
+static void releaseToken(uint32_t *p)
+{
+    released.push_back(value(p));
+}
+
+static uint32_t *pull()
+{
+    if (source.empty())
+        return nullptr;
+    uint32_t *p = source.front();
+    source.pop_front();
+    return p;
+}
+
+using Fanout = PhoneFanout<uint32_t, 4, 3>;
+
+// Client handles are just distinct addresses
+static int clientA, clientB, clientC;
+
+// Read the next packet for `client` and finish with it; 0 when nothing is waiting
+static uintptr_t readOne(Fanout &f, const void *client)
+{
+    uint32_t *p = f.peek(client, pull);
+    if (!p)
+        return 0;
+    TEST_ASSERT_TRUE(f.done(client, p));
+    return value(p);
+}
+
+static void feed(uintptr_t from, uintptr_t to)
+{
+    for (uintptr_t i = from; i <= to; i++)
+        source.push_back(token(i));
+}
+
+void setUp(void)
+{
+    source.clear();
+    released.clear();
+}
+
+void tearDown(void) {}
+
+void test_single_client_frees_as_it_reads()
+{
+    Fanout f(releaseToken);
+    feed(1, 3);
+    for (uintptr_t i = 1; i <= 3; i++) {
+        TEST_ASSERT_EQUAL_UINT(i, readOne(f, &clientA));
+        TEST_ASSERT_EQUAL_UINT(0, f.numBuffered());
+        TEST_ASSERT_EQUAL_UINT(i, released.size());
+    }
+    TEST_ASSERT_EQUAL_UINT(0, readOne(f, &clientA));
+    TEST_ASSERT_EQUAL_UINT(1, f.numClients());
+}
+
+void test_two_clients_each_see_every_packet_once()
+{
+    Fanout f(releaseToken);
+    TEST_ASSERT_NULL(f.peek(&clientA, pull)); // attach both before traffic arrives
+    TEST_ASSERT_NULL(f.peek(&clientB, pull));
+    feed(1, 3);
+
+    for (uintptr_t i = 1; i <= 3; i++)
+        TEST_ASSERT_EQUAL_UINT(i, readOne(f, &clientA));
+    TEST_ASSERT_EQUAL_UINT(3, f.numBuffered()); // B has not read them yet
+    TEST_ASSERT_EQUAL_UINT(0, released.size());
+    TEST_ASSERT_TRUE(source.empty()); // pulled once, not copied per client
+
+    for (uintptr_t i = 1; i <= 3; i++)
+        TEST_ASSERT_EQUAL_UINT(i, readOne(f, &clientB));
+    TEST_ASSERT_EQUAL_UINT(0, f.numBuffered());
+    TEST_ASSERT_EQUAL_UINT(3, released.size());
+    TEST_ASSERT_EQUAL_UINT(0, f.getSkipped());
+}
+
+void test_new_client_starts_at_oldest_buffered()
+{
+    Fanout f(releaseToken);
+    TEST_ASSERT_NULL(f.peek(&clientA, pull));
+    TEST_ASSERT_NULL(f.peek(&clientB, pull));
+    feed(1, 2);
+    TEST_ASSERT_EQUAL_UINT(1, readOne(f, &clientA));
+    TEST_ASSERT_EQUAL_UINT(2, readOne(f, &clientA));
+    TEST_ASSERT_EQUAL_UINT(1, readOne(f, &clientB)); // 2 is still buffered for B
+
+    // C joins now and picks up what is still buffered, then live traffic
+    TEST_ASSERT_EQUAL_UINT(2, readOne(f, &clientC));
+    feed(3, 3);
+    TEST_ASSERT_EQUAL_UINT(3, readOne(f, &clientC));
+    TEST_ASSERT_EQUAL_UINT(2, readOne(f, &clientB));
+    TEST_ASSERT_EQUAL_UINT(3, readOne(f, &clientB));
+    TEST_ASSERT_EQUAL_UINT(3, readOne(f, &clientA));
+    TEST_ASSERT_EQUAL_UINT(0, f.numBuffered());
+}
+
+void test_overflow_skips_lagging_client()
+{
+    Fanout f(releaseToken);
+    TEST_ASSERT_NULL(f.peek(&clientA, pull));
+    TEST_ASSERT_NULL(f.peek(&clientB, pull));
+    feed(1, 6);
+    for (uintptr_t i = 1; i <= 6; i++)
+        TEST_ASSERT_EQUAL_UINT(i, readOne(f, &clientA)); // the ring holds 4, so 1 and 2 are dropped for B
+    TEST_ASSERT_EQUAL_UINT(4, f.numBuffered());
+    TEST_ASSERT_EQUAL_UINT(2, released.size());
+
+    TEST_ASSERT_EQUAL_UINT(3, readOne(f, &clientB));
+    TEST_ASSERT_EQUAL_UINT(2, f.getSkipped());
+    for (uintptr_t i = 4; i <= 6; i++)
+        TEST_ASSERT_EQUAL_UINT(i, readOne(f, &clientB));
+    TEST_ASSERT_EQUAL_UINT(6, released.size());
+}
+
+void test_pinned_packet_survives_overflow()
+{
+    Fanout f(releaseToken);
+    TEST_ASSERT_NULL(f.peek(&clientA, pull));
+    feed(1, 6);
+    uint32_t *pinned = f.peek(&clientB, pull); // B joins, pulls 1 and keeps it
+    TEST_ASSERT_EQUAL_UINT(1, value(pinned));
+    TEST_ASSERT_EQUAL_PTR(pinned, f.peek(&clientB, pull)); // peeking again returns the same packet
+
+    // Full with the oldest pinned: A still gets 5 and 6, and 1 leaves the ring without being freed under B
+    for (uintptr_t i = 1; i <= 6; i++)
+        TEST_ASSERT_EQUAL_UINT(i, readOne(f, &clientA));
+    TEST_ASSERT_TRUE(source.empty());
+    TEST_ASSERT_EQUAL_UINT(4, f.numBuffered());
+    TEST_ASSERT_EQUAL_UINT(1, released.size()); // only 2, which nobody pinned
+    TEST_ASSERT_EQUAL_UINT(2, released[0]);
+    TEST_ASSERT_EQUAL_PTR(pinned, f.peek(&clientB, pull));
+
+    // B lets go: 1 is freed, and B carries on from the oldest packet still buffered
+    TEST_ASSERT_TRUE(f.done(&clientB, pinned));
+    TEST_ASSERT_EQUAL_UINT(2, released.size());
+    TEST_ASSERT_EQUAL_UINT(1, released[1]);
+    TEST_ASSERT_EQUAL_UINT(3, readOne(f, &clientB));
+    TEST_ASSERT_EQUAL_UINT(1, f.getSkipped()); // 2 overflowed before B got to it
+}
+
+void test_shared_pin_freed_by_last_holder()
+{
+    Fanout f(releaseToken);
+    TEST_ASSERT_NULL(f.peek(&clientA, pull));
+    feed(1, 5);
+    uint32_t *pinnedB = f.peek(&clientB, pull);
+    uint32_t *pinnedC = f.peek(&clientC, pull);
+    TEST_ASSERT_EQUAL_PTR(pinnedB, pinnedC);
+
+    for (uintptr_t i = 1; i <= 5; i++)
+        TEST_ASSERT_EQUAL_UINT(i, readOne(f, &clientA)); // 1 overflows while B and C both hold it
+    TEST_ASSERT_EQUAL_UINT(0, released.size());
+
+    TEST_ASSERT_TRUE(f.done(&clientB, pinnedB));
+    TEST_ASSERT_EQUAL_UINT(0, released.size()); // C still has it
+    f.detach(&clientC);
+    TEST_ASSERT_EQUAL_UINT(1, released.size());
+    TEST_ASSERT_EQUAL_UINT(1, released[0]);
+}
+
+void test_detach_frees_packets_only_it_needed()
+{
+    Fanout f(releaseToken);
+    TEST_ASSERT_NULL(f.peek(&clientA, pull));
+    TEST_ASSERT_NULL(f.peek(&clientB, pull));
+    feed(1, 3);
+    for (uintptr_t i = 1; i <= 3; i++)
+        TEST_ASSERT_EQUAL_UINT(i, readOne(f, &clientA));
+    TEST_ASSERT_NOT_NULL(f.peek(&clientB, pull)); // B pins 1
+
+    f.detach(&clientB);
+    TEST_ASSERT_EQUAL_UINT(1, f.numClients());
+    TEST_ASSERT_EQUAL_UINT(0, f.numBuffered());
+    TEST_ASSERT_EQUAL_UINT(3, released.size());
+}
+
+void test_foreign_packet_is_not_claimed()
+{
+    Fanout f(releaseToken);
+    feed(1, 1);
+    uint32_t *p = f.peek(&clientA, pull);
+    TEST_ASSERT_FALSE(f.done(&clientA, token(99))); // e.g. a Store & Forward packet; caller frees it
+    TEST_ASSERT_FALSE(f.done(&clientB, p));         // not B's packet
+    TEST_ASSERT_TRUE(f.done(&clientA, p));
+    TEST_ASSERT_EQUAL_UINT(1, released.size());
+}
+
+void test_cursor_slots_are_bounded()
+{
+    PhoneFanout<uint32_t, 4, 1> f(releaseToken);
+    feed(1, 2);
+    TEST_ASSERT_TRUE(f.attach(&clientA));
+    TEST_ASSERT_TRUE(f.attach(&clientA)); // already attached
+    TEST_ASSERT_FALSE(f.attach(&clientB)); // no slot left, so the caller can turn B away
+    TEST_ASSERT_NOT_NULL(f.peek(&clientA, pull));
+    TEST_ASSERT_NULL(f.peek(&clientB, pull));
+    TEST_ASSERT_EQUAL_UINT(1, source.size());
+
+    f.detach(&clientA);
+    TEST_ASSERT_TRUE(f.attach(&clientB)); // the slot is free again
+}
+
+void setup()
+{
+    initializeTestEnvironment();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_single_client_frees_as_it_reads);
+    RUN_TEST(test_two_clients_each_see_every_packet_once);
+    RUN_TEST(test_new_client_starts_at_oldest_buffered);
+    RUN_TEST(test_overflow_skips_lagging_client);
+    RUN_TEST(test_pinned_packet_survives_overflow);
+    RUN_TEST(test_shared_pin_freed_by_last_holder);
+    RUN_TEST(test_detach_frees_packets_only_it_needed);
+    RUN_TEST(test_foreign_packet_is_not_claimed);
+    RUN_TEST(test_cursor_slots_are_bounded);
+    exit(UNITY_END());
+}
+
+void loop() {}
@@ -0,0 +1,142 @@
+/*
+ * Unit tests for SatelliteStore - the sorted flat store behind NodeDB's per-node positions, telemetry, environment and
+ * status.
+ *
+ * Covers std::map-compatible behaviour (zeroed insert, overwrite, erase by key and iterator, NodeNum-ordered iteration),
+ * existence checks, the change generation, growth in kGrowBy steps with clear() giving the block back, and a footprint
+ * comparison against the std::map it replaced at the MAX_SATELLITE_NODES cap.
+ */
+
+#include "TestUtil.h"
+#include <unity.h>
+
+#include "mesh/SatelliteStore.h"
+#include "mesh/generated/meshtastic/deviceonly.pb.h"
+#include "mesh/mesh-pb-constants.h"
+#include <cstdio>
+#include <vector>
+
+#define MSG_BUF_LEN 200
+#define TEST_MSG_FMT(fmt, ...)                                                                                                   \
+    do {                                                                                                                         \
+        char _buf[MSG_BUF_LEN];                                                                                                  \
+        snprintf(_buf, sizeof(_buf), fmt, __VA_ARGS__);                                                                          \
+        TEST_MESSAGE(_buf);                                                                                                      \
+    } while (0)
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void test_insert_is_zeroed_and_overwrites()
+{
+    SatelliteStore<meshtastic_PositionLite> store;
+    meshtastic_PositionLite &p = store[0x1234];
+    TEST_ASSERT_EQUAL_INT32(0, p.latitude_i);
+    TEST_ASSERT_EQUAL_UINT32(0, p.time);
+    p.latitude_i = 42;
+
+    store[0x1234].time = 7; // same entry, not a second one
+    TEST_ASSERT_EQUAL_UINT32(1, store.size());
+    const meshtastic_PositionLite *got = store.get(0x1234);
+    TEST_ASSERT_NOT_NULL(got);
+    TEST_ASSERT_EQUAL_INT32(42, got->latitude_i);
+    TEST_ASSERT_EQUAL_UINT32(7, got->time);
+}
+
+static void test_iterates_in_nodenum_order()
+{
+    SatelliteStore<meshtastic_DeviceMetrics> store;
+    const NodeNum nums[] = {0x50, 0x10, 0xfffffff0, 0x30, 0x20};
+    for (NodeNum n : nums)
+        store[n].battery_level = n & 0xff;
+
+    NodeNum prev = 0;
+    size_t seen = 0;
+    for (const auto &kv : store) {
+        TEST_ASSERT_TRUE(seen == 0 || kv.first > prev);
+        TEST_ASSERT_EQUAL_UINT32(kv.first & 0xff, kv.second.battery_level);
+        prev = kv.first;
+        seen++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, seen);
+}
+
+static void test_find_contains_and_erase()
+{
+    SatelliteStore<meshtastic_StatusMessage> store;
+    for (NodeNum n = 1; n <= 10; n++)
+        store[n * 3];
+
+    TEST_ASSERT_TRUE(store.contains(9));
+    TEST_ASSERT_FALSE(store.contains(10));
+    TEST_ASSERT_EQUAL_UINT32(1, store.count(30));
+    TEST_ASSERT_TRUE(store.find(31) == store.end());
+    TEST_ASSERT_NULL(store.get(4));
+
+    const uint32_t gen = store.generation();
+    TEST_ASSERT_TRUE(store.contains(9) && store.get(9) != nullptr);
+    TEST_ASSERT_EQUAL_UINT32(gen, store.generation()); // lookups leave it alone
+    TEST_ASSERT_EQUAL_UINT32(1, store.erase(9));
+    TEST_ASSERT_NOT_EQUAL(gen, store.generation());
+    TEST_ASSERT_EQUAL_UINT32(0, store.erase(9));
+    TEST_ASSERT_FALSE(store.contains(9));
+
+    auto next = store.erase(store.find(3));
+    TEST_ASSERT_TRUE(next != store.end());
+    TEST_ASSERT_EQUAL_UINT32(6, next->first);
+    TEST_ASSERT_EQUAL_UINT32(8, store.size());
+    TEST_ASSERT_TRUE(store.contains(6));
+    TEST_ASSERT_TRUE(store.contains(30));
+}
+
+static void test_grows_in_steps_and_clear_frees()
+{
+    typedef SatelliteStore<meshtastic_EnvironmentMetrics> Store;
+    Store store;
+    TEST_ASSERT_EQUAL_UINT32(0, store.bytes());
+
+    store[1];
+    TEST_ASSERT_EQUAL_UINT32(Store::kGrowBy * sizeof(Store::value_type), store.bytes());
+    for (NodeNum n = 2; n <= Store::kGrowBy + 1; n++)
+        store[n];
+    TEST_ASSERT_EQUAL_UINT32(2 * Store::kGrowBy * sizeof(Store::value_type), store.bytes());
+
+    // Erasing keeps the block for the next insert
+    store.erase(1);
+    TEST_ASSERT_EQUAL_UINT32(2 * Store::kGrowBy * sizeof(Store::value_type), store.bytes());
+
+    store.clear();
+    TEST_ASSERT_TRUE(store.empty());
+    TEST_ASSERT_EQUAL_UINT32(0, store.bytes());
+}
+
+// Heap footprint of a full store versus the std::map it replaced, whose rb-tree nodes carry
+// three pointers and a color on top of the value (16 B on 32-bit targets, before allocator rounding)
+static void test_footprint_vs_map()
+{
+    typedef SatelliteStore<meshtastic_PositionLite> Store;
+    Store store;
+    for (NodeNum n = 0; n < MAX_SATELLITE_NODES; n++)
+        store[0x10000 + n * 7];
+    const size_t flat = store.bytes();
+    const size_t mapped = MAX_SATELLITE_NODES * (sizeof(Store::value_type) + 4 * sizeof(void *));
+    TEST_MSG_FMT("%u positions: flat %u B in 1 block, std::map ~%u B in %u blocks", (unsigned)MAX_SATELLITE_NODES,
+                 (unsigned)flat, (unsigned)mapped, (unsigned)MAX_SATELLITE_NODES);
+    TEST_ASSERT_EQUAL_UINT32(MAX_SATELLITE_NODES, store.size());
+    TEST_ASSERT_TRUE(flat < mapped);
+}
+
+void setup()
+{
+    initializeTestEnvironment();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_insert_is_zeroed_and_overwrites);
+    RUN_TEST(test_iterates_in_nodenum_order);
+    RUN_TEST(test_find_contains_and_erase);
+    RUN_TEST(test_grows_in_steps_and_clear_frees);
+    RUN_TEST(test_footprint_vs_map);
+    exit(UNITY_END());
+}
+
+void loop() {}
@@ -0,0 +1,196 @@
+/*
+ * Unit tests for concurrency::Scheduler - the deadline heap that runs every OSThread.
+ *
+ * Covers running only what is due, one run per pass, the delay returned to the main loop, setInterval() re-sorting a waiting
+ * thread, threads disabled and re-enabled through `enabled`, removal while a pass is running, run accounting, and one
+ * busy thread among many idle ones.
+ */
+
+#include "TestUtil.h"
+#include <unity.h>
+
+#include "concurrency/OSThread.h"
+#include <vector>
+
+using concurrency::OSThread;
+using concurrency::Scheduler;
+
+static constexpr uint32_t LATER = 60000; // long enough that it never comes due during a test
+
+static std::vector<int> ran;
+
+// Records its id when run and asks for `next` msec until the next run
+class Probe : public OSThread
+{
+  public:
+    int id;
+    int32_t next;
+    OSThread *victim = nullptr; // deleted from runOnce() when set
+
+    Probe(Scheduler *s, int id, uint32_t period, int32_t next = LATER) : OSThread("Probe", period, s), id(id), next(next) {}
+
+  protected:
+    int32_t runOnce() override
+    {
+        ran.push_back(id);
+        if (victim) {
+            delete victim;
+            victim = nullptr;
+        }
+        return next;
+    }
+};
+
+void setUp(void)
+{
+    ran.clear();
+}
+
+void tearDown(void) {}
+
+static void test_runs_only_due_threads(void)
+{
+    Scheduler s;
+    Probe idle(&s, 1, LATER);
+    Probe b(&s, 2, 0);
+    Probe a(&s, 3, 0);
+
+    s.runOrDelay();
+    TEST_ASSERT_EQUAL(2, ran.size());
+    TEST_ASSERT_EQUAL_UINT32(1, a.getRunCount());
+    TEST_ASSERT_EQUAL_UINT32(1, b.getRunCount());
+    TEST_ASSERT_EQUAL_UINT32(0, idle.getRunCount());
+    TEST_ASSERT_EQUAL(3, s.size());
+}
+
+static void test_thread_runs_once_per_pass(void)
+{
+    Scheduler s;
+    Probe busy(&s, 1, 0, 0); // always wants to run again at once
+
+    TEST_ASSERT_EQUAL(0, s.runOrDelay());
+    TEST_ASSERT_EQUAL(1, ran.size());
+    TEST_ASSERT_EQUAL(0, s.runOrDelay());
+    TEST_ASSERT_EQUAL(2, ran.size());
+}
+
+static void test_delay_is_time_to_next_deadline(void)
+{
+    Scheduler s;
+    Probe a(&s, 1, LATER);
+    Probe b(&s, 2, 5000);
+
+    long d = s.runOrDelay();
+    TEST_ASSERT_TRUE(ran.empty());
+    TEST_ASSERT_INT_WITHIN(100, 5000, d);
+}
+
+static void test_set_interval_resorts_waiting_thread(void)
+{
+    Scheduler s;
+    Probe a(&s, 1, LATER);
+    Probe b(&s, 2, LATER);
+
+    TEST_ASSERT_GREATER_THAN(LATER - 1000, s.runOrDelay());
+    b.setInterval(0); // e.g. a queue push waking its reader
+    s.runOrDelay();
+    TEST_ASSERT_EQUAL(1, ran.size());
+    TEST_ASSERT_EQUAL(2, ran[0]);
+
+    ran.clear();
+    a.setIntervalFromNow(0);
+    s.runOrDelay();
+    TEST_ASSERT_EQUAL(1, ran.size());
+    TEST_ASSERT_EQUAL(1, ran[0]);
+}
+
+static void test_disabled_thread_waits_until_enabled(void)
+{
+    Scheduler s;
+    Probe a(&s, 1, 0);
+    a.enabled = false; // the way ServerAPI and others switch themselves off
+
+    s.runOrDelay();
+    s.runOrDelay();
+    TEST_ASSERT_TRUE(ran.empty());
+
+    a.enabled = true;
+    s.runOrDelay();
+    TEST_ASSERT_EQUAL(1, ran.size());
+}
+
+static void test_disable_pushes_thread_out(void)
+{
+    Scheduler s;
+    Probe a(&s, 1, 0);
+    a.disable();
+    TEST_ASSERT_GREATER_THAN(LATER, s.runOrDelay());
+    TEST_ASSERT_TRUE(ran.empty());
+}
+
+static void test_thread_deleted_during_pass(void)
+{
+    Scheduler s;
+    Probe *first = new Probe(&s, 1, 0);
+    Probe *second = new Probe(&s, 2, 0);
+    // Whichever runs first deletes the other, like APIServerPort dropping a ServerAPI
+    first->victim = second;
+    second->victim = first;
+
+    s.runOrDelay();
+    TEST_ASSERT_EQUAL(1, ran.size());
+    TEST_ASSERT_EQUAL(1, s.size());
+    delete (ran[0] == 1 ? first : second);
+    TEST_ASSERT_EQUAL(0, s.size());
+    TEST_ASSERT_EQUAL(INT32_MAX, s.runOrDelay());
+}
+
+static void test_run_accounting(void)
+{
+    Scheduler s;
+    Probe a(&s, 1, 0, 0);
+    for (int i = 0; i < 5; i++)
+        s.runOrDelay();
+    TEST_ASSERT_EQUAL_UINT32(5, a.getRunCount());
+    TEST_ASSERT_EQUAL_UINT32(5, s.getTotalRuns());
+    TEST_ASSERT_EQUAL_UINT64(a.getRunTimeUs(), s.getTotalRunTimeUs());
+}
+
+// A busy thread among MAX_THREADS - 1 idle ones runs every pass; the idle ones never do
+static void test_busy_thread_among_idle_threads(void)
+{
+    Scheduler s;
+    std::vector<Probe *> idle;
+    for (int i = 0; i < MAX_THREADS - 1; i++)
+        idle.push_back(new Probe(&s, 100 + i, LATER));
+    Probe busy(&s, 1, 0, 0);
+
+    const int passes = 1000;
+    for (int i = 0; i < passes; i++)
+        s.runOrDelay();
+    TEST_ASSERT_EQUAL_UINT32(passes, busy.getRunCount());
+
+    for (auto *p : idle) {
+        TEST_ASSERT_EQUAL_UINT32(0, p->getRunCount());
+        delete p;
+    }
+}
+
+void setup()
+{
+    initializeTestEnvironment();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_runs_only_due_threads);
+    RUN_TEST(test_thread_runs_once_per_pass);
+    RUN_TEST(test_delay_is_time_to_next_deadline);
+    RUN_TEST(test_set_interval_resorts_waiting_thread);
+    RUN_TEST(test_disabled_thread_waits_until_enabled);
+    RUN_TEST(test_disable_pushes_thread_out);
+    RUN_TEST(test_thread_deleted_during_pass);
+    RUN_TEST(test_run_accounting);
+    RUN_TEST(test_busy_thread_among_idle_threads);
+    exit(UNITY_END());
+}
+
+void loop() {}
@@ -0,0 +1,172 @@
+/*
+ * Unit tests for SPSCPointerQueue - the lock-free pointer ring between the radio and Router.
+ *
+ * Covers FIFO/full/empty behaviour for the inline and heap-backed forms, the setReader() wake-up, and a stress run
+ * with a real producer thread and consumer thread.
+ */
+
+#include "TestUtil.h"
+#include <unity.h>
+
+#include "concurrency/OSThread.h"
+#include "mesh/SPSCPointerQueue.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+// The queue only moves pointers around; encode a sequence number in each one.
+static uint32_t *token(uintptr_t n)
+{
+    return reinterpret_cast<uint32_t *>(n);
+}
+
+static uintptr_t value(uint32_t *p)
+{
+    return reinterpret_cast<uintptr_t>(p);
+}
+
+// OSThread whose interval can be observed, to check the setReader() wake-up
+class WakeProbe : public concurrency::OSThread
+{
+  public:
+    WakeProbe() : OSThread("WakeProbe", 60000) {}
+    unsigned long currentInterval() const { return interval; }
+
+  protected:
+    int32_t runOnce() override { return INT32_MAX; }
+};
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ---------------------------------------------------------------------------
+// Single-threaded behaviour
+// ---------------------------------------------------------------------------
+
+static void test_fifo_full_and_empty_inline(void)
+{
+    SPSCPointerQueue<uint32_t, 4> q;
+    TEST_ASSERT_TRUE(q.isEmpty());
+    TEST_ASSERT_EQUAL_INT(4, q.getMaxLen());
+    TEST_ASSERT_NULL(q.dequeuePtr(0));
+
+    for (uintptr_t i = 1; i <= 4; i++)
+        TEST_ASSERT_TRUE(q.enqueue(token(i), 0));
+    TEST_ASSERT_FALSE(q.enqueue(token(5), 0)); // full
+    TEST_ASSERT_EQUAL_INT(4, q.numUsed());
+    TEST_ASSERT_EQUAL_INT(0, q.numFree());
+
+    for (uintptr_t i = 1; i <= 4; i++)
+        TEST_ASSERT_EQUAL_UINT32(i, value(q.dequeuePtr(0)));
+    TEST_ASSERT_TRUE(q.isEmpty());
+    TEST_ASSERT_EQUAL_INT(4, q.numFree());
+}
+
+// Indices wrap many times around a small heap-backed ring without losing order or miscounting.
+static void test_wraparound_heap_backed(void)
+{
+    SPSCPointerQueue<uint32_t> q(3);
+    TEST_ASSERT_EQUAL_INT(3, q.getMaxLen());
+
+    uintptr_t next = 1, expect = 1;
+    for (int round = 0; round < 100; round++) {
+        const int burst = 1 + round % 3;
+        for (int i = 0; i < burst; i++)
+            TEST_ASSERT_TRUE(q.enqueue(token(next++), 0));
+        TEST_ASSERT_EQUAL_INT(burst, q.numUsed());
+        while (uint32_t *p = q.dequeuePtr(0))
+            TEST_ASSERT_EQUAL_UINT32(expect++, value(p));
+    }
+    TEST_ASSERT_EQUAL_UINT32(next, expect);
+}
+
+// Router's drop-oldest: the producer may dequeue to make room when it shares the consumer's thread.
+static void test_drop_oldest_on_full(void)
+{
+    SPSCPointerQueue<uint32_t, 2> q;
+    q.enqueue(token(1), 0);
+    q.enqueue(token(2), 0);
+    while (!q.enqueue(token(3), 0))
+        TEST_ASSERT_EQUAL_UINT32(1, value(q.dequeuePtr(0)));
+    TEST_ASSERT_EQUAL_UINT32(2, value(q.dequeuePtr(0)));
+    TEST_ASSERT_EQUAL_UINT32(3, value(q.dequeuePtr(0)));
+}
+
+// enqueue() and enqueueFromISR() both schedule the reader to run at once; a refused enqueue does not.
+static void test_reader_is_woken(void)
+{
+    WakeProbe probe;
+    SPSCPointerQueue<uint32_t, 1> q;
+    q.setReader(&probe);
+
+    TEST_ASSERT_EQUAL_UINT32(60000, probe.currentInterval());
+    TEST_ASSERT_TRUE(q.enqueue(token(1), 0));
+    TEST_ASSERT_EQUAL_UINT32(0, probe.currentInterval());
+
+    probe.setInterval(60000);
+    TEST_ASSERT_FALSE(q.enqueue(token(2), 0)); // full: nothing new to read
+    TEST_ASSERT_EQUAL_UINT32(60000, probe.currentInterval());
+
+    q.dequeuePtr(0);
+    BaseType_t woken = 0;
+    TEST_ASSERT_TRUE(q.enqueueFromISR(token(3), &woken));
+    TEST_ASSERT_EQUAL_UINT32(0, probe.currentInterval());
+}
+
+// ---------------------------------------------------------------------------
+// Concurrent producer / consumer
+// ---------------------------------------------------------------------------
+
+// A producer thread and a consumer thread hammer a small ring; every item must arrive exactly once, in order.
+static void test_stress_concurrent_producer_consumer(void)
+{
+    constexpr uintptr_t kItems = 500000;
+    SPSCPointerQueue<uint32_t, 8> q;
+    std::atomic<bool> orderOk{true};
+    std::atomic<uintptr_t> received{0};
+
+    std::thread consumer([&] {
+        uintptr_t expect = 1;
+        while (expect <= kItems) {
+            uint32_t *p = q.dequeuePtr(0);
+            if (!p) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (value(p) != expect)
+                orderOk = false;
+            expect++;
+        }
+        received = expect - 1;
+    });
+    std::thread producer([&] {
+        for (uintptr_t i = 1; i <= kItems; i++)
+            while (!q.enqueue(token(i), 0))
+                std::this_thread::yield();
+    });
+    producer.join();
+    consumer.join();
+
+    TEST_ASSERT_TRUE(orderOk.load());
+    TEST_ASSERT_EQUAL_UINT32(kItems, received.load());
+    TEST_ASSERT_TRUE(q.isEmpty());
+}
+
+void setup()
+{
+    initializeTestEnvironment();
+
+    UNITY_BEGIN();
+    printf("\n=== single thread ===\n");
+    RUN_TEST(test_fifo_full_and_empty_inline);
+    RUN_TEST(test_wraparound_heap_backed);
+    RUN_TEST(test_drop_oldest_on_full);
+    RUN_TEST(test_reader_is_woken);
+
+    printf("\n=== concurrent ===\n");
+    RUN_TEST(test_stress_concurrent_producer_consumer);
+    exit(UNITY_END());
+}
+
+void loop() {}
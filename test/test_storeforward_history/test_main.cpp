@@ -0,0 +1,318 @@
+/*
+ * Unit tests for StoreForwardHistory - the Store & Forward message log.
+ *
+ * Covers which messages a client is offered (broadcasts and DMs to it, not its own), resuming by sequence number and
+ * the time window, evicting the oldest records one at a time once the arena is full, how many more messages fit than
+ * with fixed PacketHistoryStruct slots, the persisted log surviving a restart (including a torn tail and the
+ * rewrite at its budget), and lookups in a large history matching the old linear scan.
+ */
+
+#include "TestUtil.h"
+#include <unity.h>
+
+#include "FSCommon.h"
+#include "SPILock.h"
+#include "modules/StoreForwardHistory.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#define MSG_BUF_LEN 200
+#define TEST_MSG_FMT(fmt, ...)                                                                                                   \
+    do {                                                                                                                         \
+        char _buf[MSG_BUF_LEN];                                                                                                  \
+        snprintf(_buf, sizeof(_buf), fmt, __VA_ARGS__);                                                                          \
+        TEST_MESSAGE(_buf);                                                                                                      \
+    } while (0)
+
+static const char *kLog = "/prefs/test_sf_history.log";
+
+static constexpr NodeNum ALICE = 0x1111;
+static constexpr NodeNum BOB = 0x2222;
+static constexpr NodeNum CAROL = 0x3333;
+
+static PacketHistoryStruct message(uint32_t time, NodeNum from, NodeNum to, const char *text, uint32_t id = 0)
+{
+    PacketHistoryStruct p;
+    memset(&p, 0, sizeof(p));
+    p.time = time;
+    p.from = from;
+    p.to = to;
+    p.id = id ? id : time;
+    p.channel = 1;
+    p.rx_snr = 6.25f;
+    p.rx_rssi = -90;
+    p.hop_start = 3;
+    p.hop_limit = 2;
+    p.payload_size = strlen(text);
+    memcpy(p.payload, text, p.payload_size);
+    return p;
+}
+
+static void removeLog()
+{
+    concurrency::LockGuard g(spiLock);
+    if (FSCom.exists(kLog))
+        FSCom.remove(kLog);
+}
+
+void setUp(void)
+{
+    {
+        concurrency::LockGuard g(spiLock);
+        FSCom.mkdir("/prefs");
+    }
+    removeLog();
+}
+void tearDown(void)
+{
+    removeLog();
+}
+
+// Broadcasts and DMs to the client, in order, never its own messages
+static void test_client_sees_broadcasts_and_its_dms()
+{
+    StoreForwardHistory h;
+    TEST_ASSERT_TRUE(h.begin(16 * 1024));
+    h.add(message(100, ALICE, NODENUM_BROADCAST, "hello all"));
+    h.add(message(101, ALICE, BOB, "hi bob"));
+    h.add(message(102, BOB, NODENUM_BROADCAST, "bob here"));
+    h.add(message(103, CAROL, ALICE, "hi alice"));
+    h.add(message(104, CAROL, NODENUM_BROADCAST, "carol here"));
+
+    TEST_ASSERT_EQUAL_UINT32(3, h.countFor(BOB, 0, 0)); // 100, 101, 104
+    TEST_ASSERT_EQUAL_UINT32(3, h.countFor(ALICE, 0, 0)); // 102, 103, 104
+
+    uint32_t seq = 0;
+    const uint32_t expected[] = {100, 101, 104};
+    for (uint32_t want : expected) {
+        PacketHistoryStruct out;
+        seq = h.nextFor(BOB, seq + 1, 0, out);
+        TEST_ASSERT_NOT_EQUAL(0, seq);
+        TEST_ASSERT_EQUAL_UINT32(want, out.time);
+    }
+    PacketHistoryStruct out;
+    TEST_ASSERT_EQUAL_UINT32(0, h.nextFor(BOB, seq + 1, 0, out));
+}
+
+// Everything a record carries comes back out, and the time window excludes older messages
+static void test_fields_round_trip_and_time_window()
+{
+    StoreForwardHistory h;
+    TEST_ASSERT_TRUE(h.begin(16 * 1024));
+    PacketHistoryStruct in = message(500, ALICE, BOB, "field check", 0xABCD);
+    in.reply_id = 77;
+    in.emoji = true;
+    in.via_mqtt = true;
+    in.transport_mechanism = 3;
+    h.add(message(400, ALICE, BOB, "too old"));
+    h.add(in);
+
+    TEST_ASSERT_EQUAL_UINT32(1, h.countFor(BOB, 0, 450));
+    PacketHistoryStruct out;
+    TEST_ASSERT_NOT_EQUAL(0, h.nextFor(BOB, 0, 450, out));
+    TEST_ASSERT_EQUAL_UINT32(in.time, out.time);
+    TEST_ASSERT_EQUAL_UINT32(in.from, out.from);
+    TEST_ASSERT_EQUAL_UINT32(in.to, out.to);
+    TEST_ASSERT_EQUAL_UINT32(in.id, out.id);
+    TEST_ASSERT_EQUAL_UINT32(77, out.reply_id);
+    TEST_ASSERT_TRUE(out.emoji);
+    TEST_ASSERT_TRUE(out.via_mqtt);
+    TEST_ASSERT_EQUAL_UINT8(3, out.transport_mechanism);
+    TEST_ASSERT_EQUAL_INT32(-90, out.rx_rssi);
+    TEST_ASSERT_EQUAL_FLOAT(6.25f, out.rx_snr);
+    TEST_ASSERT_EQUAL_UINT8(3, out.hop_start);
+    TEST_ASSERT_EQUAL_UINT8(2, out.hop_limit);
+    TEST_ASSERT_EQUAL_UINT32(in.payload_size, out.payload_size);
+    TEST_ASSERT_EQUAL_MEMORY(in.payload, out.payload, in.payload_size);
+
+    // Records before the RTC was set (time 0) are never offered, as before
+    StoreForwardHistory early;
+    TEST_ASSERT_TRUE(early.begin(4096));
+    early.add(message(0, ALICE, NODENUM_BROADCAST, "no clock"));
+    TEST_ASSERT_EQUAL_UINT32(0, early.countFor(BOB, 0, 0));
+}
+
+// A full arena drops its oldest records one at a time; the newest are always there
+static void test_full_arena_evicts_oldest()
+{
+    StoreForwardHistory h;
+    const size_t rec = StoreForwardHistory::recordBytes(20);
+    TEST_ASSERT_TRUE(h.begin(rec * 10 + 8)); // room for ten, with slack that forces a wrap
+    char text[21];
+    for (uint32_t i = 1; i <= 35; i++) {
+        snprintf(text, sizeof(text), "message number %05u", (unsigned)i);
+        TEST_ASSERT_NOT_EQUAL(0, h.add(message(1000 + i, (i % 2) ? ALICE : CAROL, (i % 3) ? NODENUM_BROADCAST : BOB, text)));
+        TEST_ASSERT_TRUE(h.usedBytes() <= h.capacityBytes());
+    }
+    TEST_ASSERT_EQUAL_UINT32(10, h.size());
+    TEST_ASSERT_EQUAL_UINT32(25, h.getEvicted());
+    // last_request keeps its old meaning: the resume point's index among the records still held
+    TEST_ASSERT_EQUAL_UINT32(0, h.indexOf(0));
+    TEST_ASSERT_EQUAL_UINT32(0, h.indexOf(26));
+    TEST_ASSERT_EQUAL_UINT32(4, h.indexOf(30));
+    TEST_ASSERT_EQUAL_UINT32(10, h.indexOf(100));
+
+    // Bob gets every one of the last ten: broadcasts and DMs, none from him
+    uint32_t seq = 0, expect = 1026;
+    PacketHistoryStruct out;
+    while ((seq = h.nextFor(BOB, seq + 1, 0, out)) != 0) {
+        TEST_ASSERT_EQUAL_UINT32(expect, out.time);
+        snprintf(text, sizeof(text), "message number %05u", (unsigned)(expect - 1000));
+        TEST_ASSERT_EQUAL_MEMORY(text, out.payload, 20);
+        expect++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(1036, expect);
+}
+
+// The same PSRAM holds several times as many typical messages as fixed PacketHistoryStruct slots
+static void test_capacity_vs_fixed_slots()
+{
+    const size_t arenaBytes = 64 * 1024;
+    StoreForwardHistory h;
+    TEST_ASSERT_TRUE(h.begin(arenaBytes));
+    const char *texts[] = {"ok", "on my way", "anyone copy on the north ridge?", "battery at 40%, heading back to camp now",
+                           "meet at the trailhead at 0900 tomorrow, bring the spare radio and a charged power bank"};
+    uint32_t i = 0;
+    while (h.getEvicted() == 0) {
+        h.add(message(1 + i, ALICE, NODENUM_BROADCAST, texts[i % 5]));
+        i++;
+    }
+    const size_t held = h.size();
+    const size_t fixed = arenaBytes / sizeof(PacketHistoryStruct);
+    TEST_MSG_FMT("64 KB arena: %u messages in the log vs %u fixed slots (%u B each)", (unsigned)held, (unsigned)fixed,
+                 (unsigned)sizeof(PacketHistoryStruct));
+    TEST_ASSERT_TRUE(held >= 3 * fixed);
+}
+
+#if defined(ARCH_PORTDUINO)
+// History comes back after a restart, torn tails are cut, and the file is rewritten at its budget
+static void test_persists_across_restart()
+{
+    {
+        StoreForwardHistory h(kLog);
+        TEST_ASSERT_TRUE(h.begin(16 * 1024));
+        TEST_ASSERT_EQUAL_UINT32(0, h.load());
+        h.add(message(10, ALICE, NODENUM_BROADCAST, "first"));
+        h.add(message(11, CAROL, BOB, "second"));
+        h.add(message(12, ALICE, BOB, "third"));
+        // Short of a batch, nothing is written until the owner flushes
+        TEST_ASSERT_EQUAL_UINT32(3, h.numUnsaved());
+        TEST_ASSERT_FALSE(FSCom.exists(kLog));
+        TEST_ASSERT_TRUE(h.flush());
+        TEST_ASSERT_EQUAL_UINT32(0, h.numUnsaved());
+    }
+    {
+        StoreForwardHistory h(kLog);
+        TEST_ASSERT_TRUE(h.begin(16 * 1024));
+        TEST_ASSERT_EQUAL_UINT32(3, h.load());
+        TEST_ASSERT_EQUAL_UINT32(3, h.countFor(BOB, 0, 0));
+        PacketHistoryStruct out;
+        TEST_ASSERT_NOT_EQUAL(0, h.nextFor(CAROL, 0, 0, out));
+        TEST_ASSERT_EQUAL_MEMORY("first", out.payload, 5);
+        h.add(message(13, CAROL, NODENUM_BROADCAST, "fourth"));
+        h.flush();
+    }
+
+    // Chop the last record in half
+    std::vector<uint8_t> bytes;
+    {
+        concurrency::LockGuard g(spiLock);
+        auto f = FSCom.open(kLog, FILE_O_READ);
+        uint8_t buf[256];
+        int got;
+        while ((got = f.read(buf, sizeof(buf))) > 0)
+            bytes.insert(bytes.end(), buf, buf + got);
+        f.close();
+        FSCom.remove(kLog);
+        auto w = FSCom.open(kLog, FILE_O_WRITE);
+        w.write(bytes.data(), bytes.size() - 4);
+        w.close();
+    }
+    {
+        StoreForwardHistory h(kLog);
+        TEST_ASSERT_TRUE(h.begin(16 * 1024));
+        TEST_ASSERT_EQUAL_UINT32(3, h.load());
+        h.add(message(14, ALICE, NODENUM_BROADCAST, "fifth"));
+        h.flush();
+    }
+    {
+        StoreForwardHistory h(kLog);
+        TEST_ASSERT_TRUE(h.begin(16 * 1024));
+        TEST_ASSERT_EQUAL_UINT32(4, h.load()); // the torn record is gone, the one after it is intact
+    }
+
+    // A small budget keeps the file bounded and the newest records in it
+    removeLog();
+    {
+        StoreForwardHistory h(kLog, 2048);
+        TEST_ASSERT_TRUE(h.begin(64 * 1024));
+        for (uint32_t i = 1; i <= 200; i++) {
+            h.add(message(i, ALICE, NODENUM_BROADCAST, "a message of a typical length for the log"));
+            TEST_ASSERT_TRUE(h.numUnsaved() < StoreForwardHistory::kFlushRecords); // full batches go out on their own
+        }
+        h.flush();
+        concurrency::LockGuard g(spiLock);
+        auto f = FSCom.open(kLog, FILE_O_READ);
+        TEST_ASSERT_TRUE(f.size() <= 2048);
+        f.close();
+    }
+    {
+        StoreForwardHistory h(kLog, 2048);
+        TEST_ASSERT_TRUE(h.begin(64 * 1024));
+        const size_t loaded = h.load();
+        TEST_ASSERT_TRUE(loaded > 10);
+        PacketHistoryStruct out;
+        uint32_t seq = 0, last = 0;
+        while ((seq = h.nextFor(BOB, seq + 1, 0, out)) != 0)
+            last = out.time;
+        TEST_ASSERT_EQUAL_UINT32(200, last);
+    }
+}
+#endif
+
+// A client asking for its DMs in a large history: the log walks only the client's and the broadcast
+// lists, and must count exactly what the old layout's scan over every record found.
+static void test_large_history_lookup_matches_scan()
+{
+    const uint32_t total = 20000;
+    StoreForwardHistory h;
+    TEST_ASSERT_TRUE(h.begin(total * StoreForwardHistory::recordBytes(64)));
+    std::vector<PacketHistoryStruct> fixed;
+    fixed.reserve(total);
+    for (uint32_t i = 1; i <= total; i++) {
+        // Mostly DMs between 500 nodes, one broadcast in 50
+        const NodeNum to = (i % 50 == 0) ? NODENUM_BROADCAST : 0x10000 + (i * 7919) % 500;
+        PacketHistoryStruct p = message(i, 0x20000 + i % 300, to, "a DM of an ordinary sort of length");
+        h.add(p);
+        fixed.push_back(p);
+    }
+    const NodeNum client = 0x10000 + 123;
+
+    uint32_t scanCount = 0;
+    for (uint32_t i = 0; i < fixed.size(); i++)
+        if (fixed[i].time && fixed[i].from != client && (fixed[i].to == NODENUM_BROADCAST || fixed[i].to == client))
+            scanCount++;
+    TEST_ASSERT_TRUE(scanCount > 0);
+    TEST_ASSERT_EQUAL_UINT32(scanCount, h.countFor(client, 0, 0));
+}
+
+void setup()
+{
+    initializeTestEnvironment();
+    if (!spiLock)
+        initSPI();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_client_sees_broadcasts_and_its_dms);
+    RUN_TEST(test_fields_round_trip_and_time_window);
+    RUN_TEST(test_full_arena_evicts_oldest);
+    RUN_TEST(test_capacity_vs_fixed_slots);
+#if defined(ARCH_PORTDUINO)
+    RUN_TEST(test_persists_across_restart);
+#endif
+    RUN_TEST(test_large_history_lookup_matches_scan);
+    exit(UNITY_END());
+}
+
+void loop() {}
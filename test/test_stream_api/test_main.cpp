@@ -180,6 +180,30 @@ class LogHookStreamAPI : public StreamAPI
     }
 };
 
+#if STREAM_TX_BATCH_FRAMES > 1
+/// StreamAPI with batched writes enabled; records generic short-write failures.
+class BatchingStreamAPI : public StreamAPI
+{
+  public:
+    /// Construct over a scripted stream with room for `frames` worst-case frames per write.
+    BatchingStreamAPI(Stream *stream, size_t frames) : StreamAPI(stream) { enableTxBatching(frames); }
+
+    /// Keep connection-timeout handling inactive during tests.
+    bool checkIsConnected() override { return true; }
+
+    unsigned failureCalls = 0;
+    size_t failedFrameLen = 0;
+
+  protected:
+    /// Capture generic short-write failure metadata.
+    void onFrameWriteFailed(size_t frameLen, size_t) override
+    {
+        failureCalls++;
+        failedFrameLen = frameLen;
+    }
+};
+#endif
+
 /// Assert byte-for-byte equality between expected and captured stream output.
 static void assertBytesEqual(const std::vector<uint8_t> &expected, const std::vector<uint8_t> &actual)
 {
@@ -364,6 +388,72 @@ void test_stream_api_finishes_pending_before_advancing_phone_api()
     TEST_ASSERT_EQUAL_UINT32(42, decoded.clientNotification.reply_id);
 }
 
+#if STREAM_TX_BATCH_FRAMES > 1
+/// Split captured output into 0x94C3 frame payloads, failing on any malformed header.
+static std::vector<std::vector<uint8_t>> splitFrames(const std::vector<uint8_t> &output)
+{
+    std::vector<std::vector<uint8_t>> frames;
+    size_t pos = 0;
+    while (pos < output.size()) {
+        TEST_ASSERT_TRUE(pos + 4 <= output.size());
+        TEST_ASSERT_EQUAL_HEX8(0x94, output[pos]);
+        TEST_ASSERT_EQUAL_HEX8(0xc3, output[pos + 1]);
+        size_t len = ((size_t)output[pos + 2] << 8) | output[pos + 3];
+        TEST_ASSERT_TRUE(pos + 4 + len <= output.size());
+        frames.emplace_back(output.begin() + pos + 4, output.begin() + pos + 4 + len);
+        pos += 4 + len;
+    }
+    return frames;
+}
+
+/// Verify every ready FromRadio goes out back to back in a single write and flush.
+void test_stream_api_batches_ready_frames_into_one_write()
+{
+    ScopedMeshService scopedService;
+    ScriptedStream stream;
+    BatchingStreamAPI api(&stream, 4);
+    api.sendConfigComplete();
+    api.sendNotification(meshtastic_LogRecord_Level_WARNING, 1, "first");
+    api.sendNotification(meshtastic_LogRecord_Level_WARNING, 2, "second");
+
+    api.runOncePart(nullptr, 0);
+
+    TEST_ASSERT_EQUAL_UINT(1, stream.requestedLengths.size());
+    TEST_ASSERT_EQUAL_UINT(1, stream.flushCount);
+    auto frames = splitFrames(stream.output);
+    TEST_ASSERT_EQUAL_UINT(2, frames.size());
+    for (size_t i = 0; i < frames.size(); i++) {
+        meshtastic_FromRadio decoded = meshtastic_FromRadio_init_zero;
+        TEST_ASSERT_TRUE(pb_decode_from_bytes(frames[i].data(), frames[i].size(), &meshtastic_FromRadio_msg, &decoded));
+        TEST_ASSERT_EQUAL_UINT(meshtastic_FromRadio_clientNotification_tag, decoded.which_payload_variant);
+        TEST_ASSERT_EQUAL_UINT32(i + 1, decoded.clientNotification.reply_id);
+    }
+
+    // Nothing left: the next pass must not issue an empty write.
+    api.runOncePart(nullptr, 0);
+    TEST_ASSERT_EQUAL_UINT(1, stream.requestedLengths.size());
+}
+
+/// Verify a short batched write reports the whole batch to the transport's failure hook.
+void test_stream_api_short_batch_write_reports_whole_batch()
+{
+    ScopedMeshService scopedService;
+    ScriptedStream stream;
+    BatchingStreamAPI api(&stream, 4);
+    api.sendConfigComplete();
+    api.sendNotification(meshtastic_LogRecord_Level_WARNING, 1, "first");
+    api.sendNotification(meshtastic_LogRecord_Level_WARNING, 2, "second");
+    stream.queueWrite(5);
+
+    api.runOncePart(nullptr, 0);
+
+    TEST_ASSERT_EQUAL_UINT(1, stream.requestedLengths.size());
+    TEST_ASSERT_EQUAL_UINT(0, stream.flushCount);
+    TEST_ASSERT_EQUAL_UINT(1, api.failureCalls);
+    TEST_ASSERT_EQUAL_UINT(stream.requestedLengths[0], api.failedFrameLen);
+}
+#endif
+
 /// Verify framed logs honor the encoding gate and use best-effort writes.
 void test_stream_api_gates_logs_and_marks_them_best_effort()
 {
@@ -540,6 +630,10 @@ void setup()
     RUN_TEST(test_stream_api_full_write_frames_and_flushes);
     RUN_TEST(test_stream_api_short_write_reports_failure_without_flush);
     RUN_TEST(test_stream_api_finishes_pending_before_advancing_phone_api);
+#if STREAM_TX_BATCH_FRAMES > 1
+    RUN_TEST(test_stream_api_batches_ready_frames_into_one_write);
+    RUN_TEST(test_stream_api_short_batch_write_reports_whole_batch);
+#endif
     RUN_TEST(test_stream_api_gates_logs_and_marks_them_best_effort);
     RUN_TEST(test_lockdown_admin_gate_ignores_wire_from);
     RUN_TEST(test_lockdown_admin_gate_rejects_undecodable_admin);
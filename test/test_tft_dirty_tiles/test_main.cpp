@@ -0,0 +1,361 @@
+/*
+ * Unit tests for TFTDirtyTiles - the changed-area tracking behind TFTDisplay::display().
+ *
+ * Covers tile detection against the previous frame and from a blank panel, horizontal and vertical
+ * merging with the staging-buffer cap, edge tiles on sizes that are not a multiple of the tile,
+ * staging against a per-pixel reference, and that replaying the rectangles over the previous frame
+ * always reproduces the new one. Ends with typical screens (clock tick, list scroll, page switch,
+ * menu overlay) pushed to a counting panel, against the row-by-row diff it replaced.
+ */
+
+#include "TestUtil.h"
+#include <unity.h>
+
+#include "graphics/TFTDirtyTiles.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#define MSG_BUF_LEN 200
+#define TEST_MSG_FMT(fmt, ...)                                                                                                   \
+    do {                                                                                                                         \
+        char _buf[MSG_BUF_LEN];                                                                                                  \
+        snprintf(_buf, sizeof(_buf), fmt, __VA_ARGS__);                                                                          \
+        TEST_MESSAGE(_buf);                                                                                                      \
+    } while (0)
+
+using graphics::TFTDirtyRect;
+using graphics::TFTDirtyTiles;
+
+static constexpr uint16_t ON_BE = 0xFFFF;
+static constexpr uint16_t OFF_BE = 0x0000;
+
+// OLEDDisplay page-ordered 1bpp framebuffer
+struct Frame {
+    uint16_t width;
+    uint16_t height;
+    std::vector<uint8_t> bytes;
+
+    Frame(uint16_t w, uint16_t h) : width(w), height(h), bytes(w * ((h + 7) / 8), 0) {}
+    void set(uint32_t x, uint32_t y, bool on = true)
+    {
+        uint8_t &b = bytes[x + (y / 8) * width];
+        b = on ? (b | (1 << (y & 7))) : (b & ~(1 << (y & 7)));
+    }
+    bool get(uint32_t x, uint32_t y) const { return bytes[x + (y / 8) * width] & (1 << (y & 7)); }
+    void fill(uint32_t x0, uint32_t y0, uint32_t w, uint32_t h, bool on)
+    {
+        for (uint32_t y = y0; y < y0 + h && y < height; y++)
+            for (uint32_t x = x0; x < x0 + w && x < width; x++)
+                set(x, y, on);
+    }
+};
+
+// Glyph-like noise for one line of text: rows y0+2..y0+9 of [x0, x0+w)
+static void drawText(Frame &f, uint32_t x0, uint32_t y0, uint32_t w, uint32_t seed)
+{
+    for (uint32_t y = y0 + 2; y < y0 + 10 && y < f.height; y++) {
+        for (uint32_t x = x0; x < x0 + w && x < f.width; x++) {
+            seed = seed * 1103515245u + 12345u;
+            f.set(x, y, ((seed >> 16) & 3) == 0);
+        }
+    }
+}
+
+// A simulated panel: RGB565 pixels, plus transfer counters
+struct Panel {
+    uint16_t width;
+    std::vector<uint16_t> pixels;
+    uint32_t transfers = 0;
+    uint32_t pushed = 0;
+
+    Panel(const Frame &f) : width(f.width), pixels(f.width * f.height)
+    {
+        for (uint32_t y = 0; y < f.height; y++)
+            for (uint32_t x = 0; x < f.width; x++)
+                pixels[y * width + x] = f.get(x, y) ? ON_BE : OFF_BE;
+    }
+    void pushImage(uint32_t x, uint32_t y, uint32_t w, uint32_t h, const uint16_t *data)
+    {
+        for (uint32_t r = 0; r < h; r++)
+            memcpy(&pixels[(y + r) * width + x], data + r * w, w * sizeof(uint16_t));
+        transfers++;
+        pushed += w * h;
+    }
+};
+
+// Same pipeline as TFTDisplay::display(): collect, stage each rect into the shared buffer, push
+static void pushTiles(TFTDirtyTiles &tiles, const Frame &next, const Frame &prev, Panel &panel, bool fromBlank = false)
+{
+    const uint32_t cap = next.width * TFTDirtyTiles::kTileRows;
+    std::vector<uint16_t> staging(cap);
+    for (const TFTDirtyRect &r : tiles.collect(next.bytes.data(), prev.bytes.data(), next.width, next.height, fromBlank, cap)) {
+        TEST_ASSERT_TRUE((uint32_t)r.width * r.height <= cap);
+        TFTDirtyTiles::stage(next.bytes.data(), next.width, r, ON_BE, OFF_BE, false, staging.data());
+        panel.pushImage(r.x, r.y, r.width, r.height, staging.data());
+    }
+}
+
+// The per-row diff TFTDisplay::display() used before: one transfer per changed row
+static void pushRows(const Frame &next, const Frame &prev, Panel &panel)
+{
+    std::vector<uint16_t> line(next.width);
+    for (uint32_t y = 0; y < next.height; y++) {
+        // fast-forward over unchanged pages, as the old code did
+        const size_t page = (y / 8) * next.width;
+        if ((y & 7) == 0 && memcmp(&next.bytes[page], &prev.bytes[page], next.width) == 0) {
+            y += 7;
+            continue;
+        }
+        uint32_t first = 0, last = next.width - 1;
+        while (first < next.width && next.get(first, y) == prev.get(first, y))
+            first++;
+        if (first == next.width)
+            continue;
+        while (last > first && next.get(last, y) == prev.get(last, y))
+            last--;
+        first &= ~1U;
+        last |= 1U;
+        if (last >= next.width)
+            last = next.width - 1;
+        for (uint32_t x = first; x <= last; x++)
+            line[x] = next.get(x, y) ? ON_BE : OFF_BE;
+        panel.pushImage(first, y, last - first + 1, 1, &line[first]);
+    }
+}
+
+static void assertPanelShows(const Panel &panel, const Frame &f)
+{
+    for (uint32_t y = 0; y < f.height; y++)
+        for (uint32_t x = 0; x < f.width; x++)
+            if (panel.pixels[y * f.width + x] != (f.get(x, y) ? ON_BE : OFF_BE)) {
+                TEST_MSG_FMT("Mismatch at %u,%u", (unsigned)x, (unsigned)y);
+                TEST_FAIL();
+            }
+}
+
+static void assertRect(const TFTDirtyRect &r, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    TEST_ASSERT_EQUAL_UINT16(x, r.x);
+    TEST_ASSERT_EQUAL_UINT16(y, r.y);
+    TEST_ASSERT_EQUAL_UINT16(w, r.width);
+    TEST_ASSERT_EQUAL_UINT16(h, r.height);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void test_unchanged_frame_has_no_rects()
+{
+    Frame a(320, 240);
+    drawText(a, 10, 10, 200, 1);
+    Frame b = a;
+    TFTDirtyTiles tiles;
+    TEST_ASSERT_EQUAL(0, tiles.collect(b.bytes.data(), a.bytes.data(), 320, 240, false, 320 * 8).size());
+}
+
+static void test_single_pixel_marks_its_tile()
+{
+    Frame a(320, 240);
+    Frame b = a;
+    b.set(40, 13);
+    TFTDirtyTiles tiles;
+    const auto &rects = tiles.collect(b.bytes.data(), a.bytes.data(), 320, 240, false, 320 * 8);
+    TEST_ASSERT_EQUAL(1, rects.size());
+    assertRect(rects[0], 32, 8, 32, 8);
+}
+
+static void test_adjacent_tiles_merge_across_and_down()
+{
+    Frame a(320, 240);
+    Frame b = a;
+    b.fill(70, 20, 60, 20, true); // columns 64..159, pages 2..4
+    b.set(300, 100);              // unrelated tile
+    TFTDirtyTiles tiles;
+    const auto &rects = tiles.collect(b.bytes.data(), a.bytes.data(), 320, 240, false, 320 * 8);
+    TEST_ASSERT_EQUAL(2, rects.size());
+    assertRect(rects[0], 64, 16, 96, 24);
+    assertRect(rects[1], 288, 96, 32, 8);
+}
+
+static void test_stacking_respects_pixel_cap()
+{
+    Frame a(320, 240);
+    Frame b = a;
+    b.fill(0, 0, 64, 240, true); // 64 px wide, full height
+    TFTDirtyTiles tiles;
+    const auto &rects = tiles.collect(b.bytes.data(), a.bytes.data(), 320, 240, false, 320 * 8);
+    // 64 x 40 = 2560 = cap, so the column splits into six 40-row rects
+    TEST_ASSERT_EQUAL(6, rects.size());
+    for (size_t i = 0; i < rects.size(); i++)
+        assertRect(rects[i], 0, i * 40, 64, 40);
+}
+
+static void test_different_spans_do_not_stack()
+{
+    Frame a(320, 240);
+    Frame b = a;
+    b.fill(0, 0, 64, 8, true);
+    b.fill(0, 8, 96, 8, true);
+    TFTDirtyTiles tiles;
+    const auto &rects = tiles.collect(b.bytes.data(), a.bytes.data(), 320, 240, false, 320 * 8);
+    TEST_ASSERT_EQUAL(2, rects.size());
+    assertRect(rects[0], 0, 0, 64, 8);
+    assertRect(rects[1], 0, 8, 96, 8);
+}
+
+static void test_from_blank_only_sends_lit_tiles()
+{
+    Frame blank(320, 240);
+    Frame b(320, 240);
+    b.set(5, 5);
+    b.set(200, 230);
+    // previous contents are irrelevant after a blank: the panel was just cleared
+    Frame stale(320, 240);
+    stale.fill(0, 0, 320, 240, true);
+    TFTDirtyTiles tiles;
+    const auto &rects = tiles.collect(b.bytes.data(), stale.bytes.data(), 320, 240, true, 320 * 8);
+    TEST_ASSERT_EQUAL(2, rects.size());
+    assertRect(rects[0], 0, 0, 32, 8);
+    assertRect(rects[1], 192, 224, 32, 8);
+
+    Panel panel(blank);
+    pushTiles(tiles, b, stale, panel, true);
+    assertPanelShows(panel, b);
+}
+
+static void test_edge_tiles_on_odd_sizes()
+{
+    // 135x241 (e.g. a rotated T-Display with one extra row): last tile is 7 px wide, last page 1 row
+    Frame a(135, 241);
+    Frame b = a;
+    b.set(134, 240);
+    TFTDirtyTiles tiles;
+    const auto &rects = tiles.collect(b.bytes.data(), a.bytes.data(), 135, 241, false, 135 * 8);
+    TEST_ASSERT_EQUAL(1, rects.size());
+    assertRect(rects[0], 128, 240, 7, 1);
+
+    Panel panel(a);
+    pushTiles(tiles, b, a, panel);
+    assertPanelShows(panel, b);
+}
+
+static void test_stage_matches_reference()
+{
+    Frame f(100, 30);
+    drawText(f, 0, 0, 100, 7);
+    drawText(f, 0, 12, 100, 9);
+    const TFTDirtyRect r = {3, 5, 50, 19};
+    std::vector<uint16_t> out(r.width * r.height, 0x1234);
+    TFTDirtyTiles::stage(f.bytes.data(), f.width, r, ON_BE, OFF_BE, false, out.data());
+    for (uint32_t y = 0; y < r.height; y++)
+        for (uint32_t x = 0; x < r.width; x++)
+            TEST_ASSERT_EQUAL_HEX16(f.get(r.x + x, r.y + y) ? ON_BE : OFF_BE, out[y * r.width + x]);
+}
+
+static void test_random_frames_replay_exactly()
+{
+    uint32_t seed = 42;
+    Frame prev(240, 135);
+    drawText(prev, 0, 0, 240, seed);
+    Panel panel(prev);
+    TFTDirtyTiles tiles;
+    for (int i = 0; i < 200; i++) {
+        Frame next = prev;
+        const int edits = 1 + (i % 5);
+        for (int e = 0; e < edits; e++) {
+            seed = seed * 1664525u + 1013904223u;
+            const uint32_t x = (seed >> 8) % 240, y = (seed >> 20) % 135;
+            const uint32_t w = 1 + (seed % 90), h = 1 + ((seed >> 4) % 40);
+            next.fill(x, y, w, h, (seed >> 3) & 1);
+        }
+        pushTiles(tiles, next, prev, panel);
+        assertPanelShows(panel, next);
+        prev = next;
+    }
+}
+
+// Typical screens on a 320x240 panel, previous frame -> next frame
+
+static Frame baseScreen(uint32_t seed)
+{
+    Frame f(320, 240);
+    f.fill(0, 0, 320, 14, true); // header bar
+    drawText(f, 4, 1, 120, seed);
+    for (uint32_t line = 0; line < 18; line++)
+        drawText(f, 4, 18 + line * 12, 200 + (line * 37) % 110, seed + line + 1);
+    return f;
+}
+
+struct Scenario {
+    const char *name;
+    Frame prev;
+    Frame next;
+};
+
+static std::vector<Scenario> scenarios()
+{
+    std::vector<Scenario> out;
+
+    Frame clockNext = baseScreen(1);
+    clockNext.fill(268, 0, 48, 14, true);
+    drawText(clockNext, 270, 1, 44, 99); // only the minute digits change
+    out.push_back({"clock tick", baseScreen(1), clockNext});
+
+    Frame scrolled = baseScreen(1);
+    for (uint32_t y = 18; y < 240; y++)
+        for (uint32_t x = 0; x < 320; x++)
+            scrolled.set(x, y, (y + 12 < 240) ? baseScreen(1).get(x, y + 12) : false);
+    out.push_back({"list scroll", baseScreen(1), scrolled});
+
+    out.push_back({"page switch", baseScreen(1), baseScreen(500)});
+
+    Frame menu = baseScreen(1);
+    menu.fill(80, 60, 160, 120, false);
+    menu.fill(80, 60, 160, 1, true);
+    menu.fill(80, 179, 160, 1, true);
+    menu.fill(80, 60, 1, 120, true);
+    menu.fill(239, 60, 1, 120, true);
+    for (uint32_t item = 0; item < 8; item++)
+        drawText(menu, 90, 64 + item * 14, 100, 700 + item);
+    out.push_back({"menu overlay", baseScreen(1), menu});
+    return out;
+}
+
+static void test_typical_screens_use_fewer_transfers()
+{
+    for (const Scenario &s : scenarios()) {
+        Panel rowPanel(s.prev), tilePanel(s.prev);
+        TFTDirtyTiles tiles;
+        pushRows(s.next, s.prev, rowPanel);
+        pushTiles(tiles, s.next, s.prev, tilePanel);
+        assertPanelShows(rowPanel, s.next);
+        assertPanelShows(tilePanel, s.next);
+
+        TEST_MSG_FMT("%-12s rows: %4u transfers %6u px | tiles: %3u transfers %6u px", s.name, (unsigned)rowPanel.transfers,
+                     (unsigned)rowPanel.pushed, (unsigned)tilePanel.transfers, (unsigned)tilePanel.pushed);
+        TEST_ASSERT_TRUE(tilePanel.transfers * 4 <= rowPanel.transfers);
+        // tiles trade some over-draw for far fewer transfers; never worse than a full screen
+        TEST_ASSERT_TRUE(tilePanel.pushed <= 320u * 240u);
+    }
+}
+
+void setup()
+{
+    initializeTestEnvironment();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_unchanged_frame_has_no_rects);
+    RUN_TEST(test_single_pixel_marks_its_tile);
+    RUN_TEST(test_adjacent_tiles_merge_across_and_down);
+    RUN_TEST(test_stacking_respects_pixel_cap);
+    RUN_TEST(test_different_spans_do_not_stack);
+    RUN_TEST(test_from_blank_only_sends_lit_tiles);
+    RUN_TEST(test_edge_tiles_on_odd_sizes);
+    RUN_TEST(test_stage_matches_reference);
+    RUN_TEST(test_random_frames_replay_exactly);
+    RUN_TEST(test_typical_screens_use_fewer_transfers);
+    exit(UNITY_END());
+}
+
+void loop() {}
@@ -0,0 +1,157 @@
+// Unit tests for the per-OSThread runtime profiler - src/concurrency/ThreadProfiler.cpp.
+// Covers record() arithmetic, slot caching, rows shared by name, heaviest-first
+// snapshots, reset, and OSThread::run() feeding it. The table is a process-global
+// with no way to free rows, so tests use distinct names.
+#include "TestUtil.h"
+#include "concurrency/OSThread.h"
+#include "concurrency/ThreadProfiler.h"
+#include <cstring>
+#include <unity.h>
+
+#if MESHTASTIC_THREAD_PROFILE
+
+namespace
+{
+
+// Look a row up by name in a fresh snapshot; returns false if it is not there.
+bool rowFor(const char *name, threadprof::Row &out)
+{
+    threadprof::Row rows[threadprof::kMaxRows];
+    size_t n = threadprof::snapshot(rows, threadprof::kMaxRows);
+    for (size_t i = 0; i < n; i++) {
+        if (strcmp(rows[i].name, name) == 0) {
+            out = rows[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+class Sleeper : public concurrency::OSThread
+{
+  public:
+    explicit Sleeper(const char *name) : OSThread(name, 0, nullptr) {}
+    void runNow() { run(); }
+
+  protected:
+    int32_t runOnce() override
+    {
+        delay(2);
+        return 1000;
+    }
+};
+
+} // namespace
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_tp_record_accumulates()
+{
+    int8_t slot = -1;
+    threadprof::record(slot, "tp_acc", 100, 0);
+    TEST_ASSERT_TRUE(slot >= 0);
+    threadprof::record(slot, "tp_acc", 300, 7);
+    threadprof::record(slot, "tp_acc", 200, 3);
+
+    threadprof::Row r;
+    TEST_ASSERT_TRUE(rowFor("tp_acc", r));
+    TEST_ASSERT_EQUAL_UINT32(3, r.runs);
+    TEST_ASSERT_EQUAL_UINT64(600, r.totalUs);
+    TEST_ASSERT_EQUAL_UINT32(300, r.maxUs);
+    TEST_ASSERT_EQUAL_UINT32(7, r.maxLateMs);
+    TEST_ASSERT_EQUAL_UINT64(10, r.totalLateMs);
+}
+
+void test_tp_sameName_sharesRow()
+{
+    // Two instances of one thread class (e.g. TCP sessions) land in one row
+    int8_t a = -1, b = -1;
+    threadprof::record(a, "tp_shared", 10, 0);
+    threadprof::record(b, "tp_shared", 20, 0);
+    TEST_ASSERT_EQUAL_INT8(a, b);
+
+    threadprof::Row r;
+    TEST_ASSERT_TRUE(rowFor("tp_shared", r));
+    TEST_ASSERT_EQUAL_UINT32(2, r.runs);
+    TEST_ASSERT_EQUAL_UINT64(30, r.totalUs);
+}
+
+void test_tp_longName_isTruncated()
+{
+    int8_t slot = -1;
+    threadprof::record(slot, "tp_a_rather_long_thread_name", 1, 0);
+    threadprof::Row r;
+    TEST_ASSERT_TRUE(rowFor("tp_a_rather_lon", r));
+    TEST_ASSERT_EQUAL_UINT32(1, r.runs);
+}
+
+void test_tp_snapshot_heaviestFirst()
+{
+    int8_t slot = -1;
+    threadprof::record(slot, "tp_heavy", 50000000, 0); // more than any other test row
+
+    threadprof::Row rows[2];
+    size_t n = threadprof::snapshot(rows, 2);
+    TEST_ASSERT_EQUAL(2, n);
+    TEST_ASSERT_EQUAL_STRING("tp_heavy", rows[0].name);
+    TEST_ASSERT_TRUE(rows[0].totalUs >= rows[1].totalUs);
+}
+
+void test_tp_osthread_run_isRecorded()
+{
+    Sleeper s("tp_sleeper");
+    s.runNow();
+    s.runNow();
+
+    threadprof::Row r;
+    TEST_ASSERT_TRUE(rowFor("tp_sleeper", r));
+    TEST_ASSERT_EQUAL_UINT32(2, r.runs);
+    TEST_ASSERT_TRUE(r.maxUs >= 1000);
+    TEST_ASSERT_EQUAL_UINT32(2, s.getRunCount());
+    TEST_ASSERT_EQUAL_UINT64(s.getRunTimeUs(), r.totalUs);
+}
+
+void test_tp_reset_keepsRows()
+{
+    int8_t slot = -1;
+    threadprof::record(slot, "tp_reset", 5, 5);
+    threadprof::reset();
+
+    threadprof::Row r;
+    TEST_ASSERT_TRUE(rowFor("tp_reset", r));
+    TEST_ASSERT_EQUAL_UINT32(0, r.runs);
+    TEST_ASSERT_EQUAL_UINT64(0, r.totalUs);
+    threadprof::record(slot, "tp_reset", 9, 0);
+    TEST_ASSERT_TRUE(rowFor("tp_reset", r));
+    TEST_ASSERT_EQUAL_UINT32(1, r.runs);
+}
+
+void setup()
+{
+    initializeTestEnvironment();
+    UNITY_BEGIN();
+    RUN_TEST(test_tp_record_accumulates);
+    RUN_TEST(test_tp_sameName_sharesRow);
+    RUN_TEST(test_tp_longName_isTruncated);
+    RUN_TEST(test_tp_snapshot_heaviestFirst);
+    RUN_TEST(test_tp_osthread_run_isRecorded);
+    RUN_TEST(test_tp_reset_keepsRows);
+    exit(UNITY_END());
+}
+
+#else
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void setup()
+{
+    initializeTestEnvironment();
+    UNITY_BEGIN();
+    exit(UNITY_END());
+}
+
+#endif // MESHTASTIC_THREAD_PROFILE
+
+void loop() {}
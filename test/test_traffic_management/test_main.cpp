@@ -105,6 +105,7 @@ class MockNodeDB : public NodeDB
         (*meshNodes)[1].num = n;
         (*meshNodes)[1].next_hop = nextHop;
         numMeshNodes = 2;
+        invalidateNodeIndex();
     }
 
     // Seed a full identity (name, 32-byte key of `keyByte`, optional signer bit) into the
@@ -127,6 +128,7 @@ class MockNodeDB : public NodeDB
     void rollHotStore()
     {
         numMeshNodes = 1;
+        invalidateNodeIndex();
         clearCachedNode();
     }
 
@@ -143,6 +145,7 @@ class MockNodeDB : public NodeDB
         nodeInfoLiteSetBit(&(*meshNodes)[1], NODEINFO_BITFIELD_HAS_USER_MASK, true);
         strncpy((*meshNodes)[1].long_name, longName, sizeof((*meshNodes)[1].long_name) - 1);
         numMeshNodes = 2;
+        invalidateNodeIndex();
     }
 
   private:
@@ -196,11 +199,15 @@ class TrafficManagementModuleTestShim : public TrafficManagementModule
     using TrafficManagementModule::dropNodeInfoCacheForTest;
     using TrafficManagementModule::flushCache;
     using TrafficManagementModule::handleReceived;
+    using TrafficManagementModule::hasUnifiedEntryForTest;
+    using TrafficManagementModule::indexesConsistentForTest;
     using TrafficManagementModule::markKeySignerProvenForTest;
     using TrafficManagementModule::nodeInfoCacheCapacityForTest;
     using TrafficManagementModule::peekCachedRole;
     using TrafficManagementModule::peekNodeInfoFlagsForTest;
     using TrafficManagementModule::runOnce;
+    using TrafficManagementModule::touchUnifiedEntryForTest;
+    using TrafficManagementModule::unifiedCacheCapacityForTest;
 
     bool ignoreRequestFlag() const { return ignoreRequest; }
 };
@@ -1864,6 +1871,95 @@ static void test_tm_nodeinfo_eviction_withinTierStalestLoses(void)
     TEST_ASSERT_TRUE(module.copyPublicKey(kFillBase + 0, key, nullptr)); // fresher same-tier entry survives
 }
 
+/**
+ * The NodeNum -> slot hash indexes stay in step with both tables through tiered-LRU eviction,
+ * purges, the maintenance sweep and flushes: every occupied slot resolves to itself.
+ */
+static void test_tm_index_consistentThroughEvictionAndPurge(void)
+{
+    mockNodeDB->clearCachedNode();
+    mockNodeDB->rollHotStore();
+    static TrafficManagementModuleTestShim module; // static: OSThread-derived, and large
+    module.purgeAll();
+
+    // NodeInfo table: fill, then churn past capacity so every insert evicts.
+    constexpr NodeNum kFillBase = 0x40000000, kChurnBase = 0x54000000;
+    const uint16_t cap = TrafficManagementModuleTestShim::nodeInfoCacheCapacityForTest();
+    fillNodeInfoCacheWithTofuStrangers(module, cap, kFillBase);
+    TEST_ASSERT_TRUE(module.indexesConsistentForTest());
+    TrafficManagementModule::s_testNowMs += 2UL * 180000UL;
+    for (NodeNum i = 0; i < 50; i++)
+        module.handleReceived(makeNodeInfoPacketWithKey(kChurnBase + i, "churn", 0x60));
+    TEST_ASSERT_TRUE(module.indexesConsistentForTest());
+    uint8_t key[32] = {0};
+    TEST_ASSERT_TRUE(module.copyPublicKey(kChurnBase + 49, key, nullptr));
+    TEST_ASSERT_FALSE(module.copyPublicKey(kFillBase + 0, key, nullptr));
+
+    module.purgeNode(kChurnBase + 10);
+    module.purgeNode(kFillBase + 500);
+    TEST_ASSERT_TRUE(module.indexesConsistentForTest());
+    TEST_ASSERT_FALSE(module.copyPublicKey(kChurnBase + 10, key, nullptr));
+    module.handleReceived(makeNodeInfoPacketWithKey(kChurnBase + 100, "refill", 0x61)); // reuses a purged slot
+    TEST_ASSERT_TRUE(module.indexesConsistentForTest());
+    TEST_ASSERT_TRUE(module.copyPublicKey(kChurnBase + 100, key, nullptr));
+
+    // Unified table: run past capacity (stalest-first eviction), then let the sweep expire it all.
+    const uint16_t ucap = TrafficManagementModuleTestShim::unifiedCacheCapacityForTest();
+    for (uint32_t i = 0; i < ucap + 100u; i++) {
+        TEST_ASSERT_TRUE(module.touchUnifiedEntryForTest(0x60000000 + i));
+        if (i % 97 == 0)
+            TrafficManagementModule::s_testNowMs += 360000UL; // age earlier entries by a pos tick
+    }
+    TEST_ASSERT_TRUE(module.indexesConsistentForTest());
+    TEST_ASSERT_TRUE(module.hasUnifiedEntryForTest(0x60000000 + ucap + 99));
+    module.purgeNode(0x60000000 + ucap + 50);
+    TEST_ASSERT_FALSE(module.hasUnifiedEntryForTest(0x60000000 + ucap + 50));
+    TEST_ASSERT_TRUE(module.indexesConsistentForTest());
+
+    TrafficManagementModule::s_testNowMs += 48UL * 60UL * 60UL * 1000UL;
+    module.runOnce();
+    TEST_ASSERT_TRUE(module.indexesConsistentForTest());
+    module.flushCache();
+    TEST_ASSERT_FALSE(module.hasUnifiedEntryForTest(0x60000000 + ucap + 99));
+    TEST_ASSERT_TRUE(module.touchUnifiedEntryForTest(0x61000000));
+    TEST_ASSERT_TRUE(module.indexesConsistentForTest());
+    module.purgeAll();
+    TEST_ASSERT_TRUE(module.indexesConsistentForTest());
+}
+
+/**
+ * Both tables at full capacity: every stored NodeNum resolves (the NodeInfo hit with its own key)
+ * and NodeNums that were never inserted miss, with the indexes still consistent afterwards.
+ */
+static void test_tm_index_fullCapacity_hitsAndMisses(void)
+{
+    mockNodeDB->clearCachedNode();
+    mockNodeDB->rollHotStore();
+    static TrafficManagementModuleTestShim module;
+    module.purgeAll();
+
+    constexpr NodeNum kBase = 0x70000000;
+    const uint16_t cap = TrafficManagementModuleTestShim::nodeInfoCacheCapacityForTest();
+    const uint16_t ucap = TrafficManagementModuleTestShim::unifiedCacheCapacityForTest();
+    fillNodeInfoCacheWithTofuStrangers(module, cap, kBase);
+    for (uint32_t i = 0; i < ucap; i++)
+        module.touchUnifiedEntryForTest(kBase + i);
+
+    uint8_t key[32], expected[32];
+    memset(expected, 0x0F, sizeof(expected));
+    for (uint32_t i = 0; i < cap; i++) {
+        TEST_ASSERT_TRUE(module.copyPublicKey(kBase + i, key, nullptr));
+        TEST_ASSERT_EQUAL_MEMORY(expected, key, sizeof(key));
+    }
+    for (uint32_t i = 0; i < ucap; i++)
+        TEST_ASSERT_TRUE(module.hasUnifiedEntryForTest(kBase + i));
+    for (uint32_t i = 0; i < 64; i++) {
+        TEST_ASSERT_FALSE(module.copyPublicKey(0x7F000000u + i, key, nullptr));
+        TEST_ASSERT_FALSE(module.hasUnifiedEntryForTest(0x7F000000u + i));
+    }
+    TEST_ASSERT_TRUE(module.indexesConsistentForTest());
+}
+
 /**
  * Member saturation: with every slot holding a NodeDB member, the write-through hooks skip
  * rather than churn one member out for another (spareMembers), while the packet path - a
@@ -3257,6 +3353,8 @@ TM_TEST_ENTRY void setup()
     RUN_TEST(test_tm_nodeinfo_eviction_keyedTiersOutrankKeyless);
     RUN_TEST(test_tm_nodeinfo_eviction_tofuLosesBeforeProvenAndMember);
     RUN_TEST(test_tm_nodeinfo_eviction_withinTierStalestLoses);
+    RUN_TEST(test_tm_index_consistentThroughEvictionAndPurge);
+    RUN_TEST(test_tm_index_fullCapacity_hitsAndMisses);
     RUN_TEST(test_tm_nodeinfo_memberSaturated_hooksSkipPacketPathEvicts);
     RUN_TEST(test_tm_nodeinfo_resetNodes_purgesAllCaches);
     RUN_TEST(test_tm_nodeinfo_cache_dropsFrameCarryingOwnerKey);
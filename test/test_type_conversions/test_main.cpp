@@ -5,6 +5,7 @@
 //   - wire-level decode acceptance of legacy 39-byte long_names
 //   - public_key / hw_model / role pass-through
 //   - thin vs bundled NodeInfo emission
+//   - streamed FromRadio{node_info} encoding byte-identical to pb_encode of the thin struct
 //
 // All exercised via the explicit-args overload of ConvertToNodeInfo so we don't
 // touch the global nodeDB pointer (which isn't initialized in this test env).
@@ -414,6 +415,141 @@ void test_convert_to_node_info_user_only_when_has_user_bit_set(void)
     TEST_ASSERT_EQUAL_STRING("!00000001", info2.user.id);
 }
 
+// ---------- streamed FromRadio{node_info} -------------------------------------
+
+// Reference encoding: the old PhoneAPI path (thin conversion, our-node overrides, full FromRadio struct).
+static size_t encodeViaStruct(uint8_t *buf, const meshtastic_NodeInfoLite *lite, bool isUs, uint32_t ourLastHeard)
+{
+    meshtastic_NodeInfo info = TypeConversions::ConvertToNodeInfoThin(lite);
+    if (isUs) {
+        info.hops_away = 0;
+        info.last_heard = ourLastHeard;
+        info.snr = 0;
+        info.via_mqtt = false;
+        info.is_favorite = true;
+    }
+    meshtastic_FromRadio fr = meshtastic_FromRadio_init_zero;
+    fr.which_payload_variant = meshtastic_FromRadio_node_info_tag;
+    fr.node_info = info;
+    return pb_encode_to_bytes(buf, meshtastic_FromRadio_size, &meshtastic_FromRadio_msg, &fr);
+}
+
+static void assertStreamMatchesStruct(const meshtastic_NodeInfoLite &lite, bool isUs, uint32_t ourLastHeard = 0)
+{
+    uint8_t expected[meshtastic_FromRadio_size];
+    uint8_t streamed[meshtastic_FromRadio_size];
+    size_t expectedLen = encodeViaStruct(expected, &lite, isUs, ourLastHeard);
+    size_t streamedLen = TypeConversions::EncodeNodeInfoThinFromRadio(streamed, sizeof(streamed), &lite, isUs, ourLastHeard);
+    TEST_ASSERT_TRUE(expectedLen > 0);
+    TEST_ASSERT_EQUAL_size_t(expectedLen, streamedLen);
+    TEST_ASSERT_EQUAL_MEMORY(expected, streamed, expectedLen);
+}
+
+static meshtastic_NodeInfoLite makeFullLite(uint32_t num)
+{
+    meshtastic_NodeInfoLite lite = meshtastic_NodeInfoLite_init_default;
+    lite.num = num;
+    lite.snr = -7.25f;
+    lite.last_heard = 1700000000;
+    lite.channel = 2;
+    lite.has_hops_away = true;
+    lite.hops_away = 3;
+    TypeConversions::CopyUserToNodeInfoLite(&lite, makeUser("Streamed Node", "SN"));
+    lite.public_key.size = 32;
+    for (int i = 0; i < 32; i++)
+        lite.public_key.bytes[i] = (uint8_t)(i * 7 + 1);
+    return lite;
+}
+
+void test_stream_node_info_minimal_matches_struct(void)
+{
+    meshtastic_NodeInfoLite lite = meshtastic_NodeInfoLite_init_default;
+    lite.num = 0xAA;
+    assertStreamMatchesStruct(lite, false);
+}
+
+void test_stream_node_info_full_matches_struct(void)
+{
+    meshtastic_NodeInfoLite lite = makeFullLite(0x12345678);
+    assertStreamMatchesStruct(lite, false);
+
+    // Every bitfield flag and the optional is_unmessagable
+    const uint32_t masks[] = {NODEINFO_BITFIELD_VIA_MQTT_MASK,
+                              NODEINFO_BITFIELD_IS_FAVORITE_MASK,
+                              NODEINFO_BITFIELD_IS_IGNORED_MASK,
+                              NODEINFO_BITFIELD_IS_KEY_MANUALLY_VERIFIED_MASK,
+                              NODEINFO_BITFIELD_IS_MUTED_MASK,
+                              NODEINFO_BITFIELD_HAS_XEDDSA_SIGNED_MASK,
+                              NODEINFO_BITFIELD_IS_LICENSED_MASK,
+                              NODEINFO_BITFIELD_HAS_IS_UNMESSAGABLE_MASK};
+    for (uint32_t mask : masks) {
+        nodeInfoLiteSetBit(&lite, mask, true);
+        assertStreamMatchesStruct(lite, false);
+    }
+    nodeInfoLiteSetBit(&lite, NODEINFO_BITFIELD_IS_UNMESSAGABLE_MASK, true);
+    assertStreamMatchesStruct(lite, false);
+    // A non-default role (CLIENT is 0 and omitted)
+    lite.role = meshtastic_Config_DeviceConfig_Role_ROUTER;
+    assertStreamMatchesStruct(lite, false);
+
+    // Zero hops is still sent because hops_away is optional
+    lite.hops_away = 0;
+    assertStreamMatchesStruct(lite, false);
+    // -0.0 is not a proto3 default on the wire
+    lite.snr = -0.0f;
+    assertStreamMatchesStruct(lite, false);
+}
+
+void test_stream_node_info_without_user_matches_struct(void)
+{
+    meshtastic_NodeInfoLite lite = makeFullLite(0x01020304);
+    nodeInfoLiteSetBit(&lite, NODEINFO_BITFIELD_HAS_USER_MASK, false);
+    assertStreamMatchesStruct(lite, false);
+}
+
+void test_stream_node_info_our_node_overrides(void)
+{
+    meshtastic_NodeInfoLite lite = makeFullLite(0x0000BEEF);
+    nodeInfoLiteSetBit(&lite, NODEINFO_BITFIELD_VIA_MQTT_MASK, true);
+    assertStreamMatchesStruct(lite, true, 1800000000);
+    assertStreamMatchesStruct(lite, true, 0);
+}
+
+void test_stream_node_info_utf8_names_sanitized_like_struct(void)
+{
+    meshtastic_NodeInfoLite lite = makeFullLite(0x55);
+    // Split a 2-byte UTF-8 sequence at the end of the stored long name
+    memset(lite.long_name, 'x', sizeof(lite.long_name) - 2);
+    lite.long_name[sizeof(lite.long_name) - 2] = (char)0xC3;
+    lite.long_name[sizeof(lite.long_name) - 1] = '\0';
+    assertStreamMatchesStruct(lite, false);
+}
+
+void test_stream_node_info_rejects_short_buffer(void)
+{
+    meshtastic_NodeInfoLite lite = makeFullLite(0x66);
+    uint8_t buf[16];
+    TEST_ASSERT_EQUAL_size_t(0, TypeConversions::EncodeNodeInfoThinFromRadio(buf, sizeof(buf), &lite, false, 0));
+}
+
+// A 1000-node config download streams exactly as many bytes as the old struct path.
+void test_stream_node_info_1000_bytes_match_struct(void)
+{
+    const int count = 1000;
+    std::vector<meshtastic_NodeInfoLite> nodes;
+    nodes.reserve(count);
+    for (int i = 0; i < count; i++)
+        nodes.push_back(makeFullLite(0x10000 + i));
+
+    uint8_t buf[meshtastic_FromRadio_size];
+    size_t structBytes = 0, streamBytes = 0;
+    for (const auto &n : nodes)
+        structBytes += encodeViaStruct(buf, &n, false, 0);
+    for (const auto &n : nodes)
+        streamBytes += TypeConversions::EncodeNodeInfoThinFromRadio(buf, sizeof(buf), &n, false, 0);
+    TEST_ASSERT_EQUAL_size_t(structBytes, streamBytes);
+}
+
 // Regression for UnitConversions::displaySafeFloat: drop non-finite values and clamp magnitude so a
 // crafted telemetry float can't overflow Arduino String(float)'s fixed char[33].
 static void test_displaySafeFloat_bounds_and_finiteness()
@@ -476,6 +612,13 @@ void setup()
     RUN_TEST(test_convert_to_node_info_extracts_bitfield_bools);
     RUN_TEST(test_convert_to_node_info_extracts_bitfield_bools_none_set);
     RUN_TEST(test_convert_to_node_info_user_only_when_has_user_bit_set);
+    RUN_TEST(test_stream_node_info_minimal_matches_struct);
+    RUN_TEST(test_stream_node_info_full_matches_struct);
+    RUN_TEST(test_stream_node_info_without_user_matches_struct);
+    RUN_TEST(test_stream_node_info_our_node_overrides);
+    RUN_TEST(test_stream_node_info_utf8_names_sanitized_like_struct);
+    RUN_TEST(test_stream_node_info_rejects_short_buffer);
+    RUN_TEST(test_stream_node_info_1000_bytes_match_struct);
     RUN_TEST(test_displaySafeFloat_bounds_and_finiteness);
     exit(UNITY_END());
 }